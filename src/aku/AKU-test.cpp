@@ -4,7 +4,17 @@
 #include <aku/AKU-test.h>
 #include <moaiext-test/MOAITestMgr.h>
 
+#include <moaiext-test/MOAITest_MOAIGridMesh.h>
+#include <moaiext-test/MOAITest_MOAIKtxHeader.h>
+#include <moaiext-test/MOAITest_MOAILayer.h>
+#include <moaiext-test/MOAITest_MOAIParticleEngine.h>
+#include <moaiext-test/MOAITest_MOAIParticleMgr.h>
+#include <moaiext-test/MOAITest_MOAIParticleSystem.h>
+#include <moaiext-test/MOAITest_MOAIPartitionResultBuffer.h>
+#include <moaiext-test/MOAITest_MOAITextureAtlas.h>
 #include <moaiext-test/MOAITest_sample.h>
+#include <moaiext-test/MOAITest_USColor.h>
+#include <moaiext-test/MOAITest_USCull.h>
 #include <moaiext-test/MOAITest_USQuaternion.h>
 
 //================================================================//
@@ -18,7 +28,17 @@ void AKUTestInit () {
 	
 	REGISTER_LUA_CLASS ( MOAITestMgr )
 	
+	REGISTER_MOAI_TEST ( MOAITest_MOAIGridMesh )
+	REGISTER_MOAI_TEST ( MOAITest_MOAIKtxHeader )
+	REGISTER_MOAI_TEST ( MOAITest_MOAILayer )
+	REGISTER_MOAI_TEST ( MOAITest_MOAIParticleEngine )
+	REGISTER_MOAI_TEST ( MOAITest_MOAIParticleMgr )
+	REGISTER_MOAI_TEST ( MOAITest_MOAIParticleSystem )
+	REGISTER_MOAI_TEST ( MOAITest_MOAIPartitionResultBuffer )
+	REGISTER_MOAI_TEST ( MOAITest_MOAITextureAtlas )
 	REGISTER_MOAI_TEST ( MOAITest_sample )
+	REGISTER_MOAI_TEST ( MOAITest_USColor )
+	REGISTER_MOAI_TEST ( MOAITest_USCull )
 	REGISTER_MOAI_TEST ( MOAITest_USQuaternion )
 }
 
@@ -3,6 +3,7 @@
 
 #include "pch.h"
 #include <moaicore/MOAIAnim.h>
+#include <moaicore/MOAIAnimCurve.h>
 #include <moaicore/MOAIAnimCurveBase.h>
 #include <moaicore/MOAILogMessages.h>
 
@@ -117,8 +118,18 @@ void MOAIAnim::Apply ( float t ) {
 		if ( curve && target ) {
 			
 			if ( !link.mRelative ) {
-				curve->GetValue ( attrOp, t );
-				target->ApplyAttrOp ( link.mAttrID, attrOp, MOAIAttrOp::SET );
+			
+				if ( link.mFloatCurve ) {
+					float& value = *link.mDirect.mValue;
+					value = link.mFloatCurve->GetValue ( t, link.mKeyHint );
+					if ( link.mDirect.mClamp ) {
+						value = USFloat::Clamp ( value, 0.0f, 1.0f );
+					}
+				}
+				else {
+					curve->GetValue ( attrOp, t, link.mKeyHint );
+					target->ApplyAttrOp ( link.mAttrID, attrOp, MOAIAttrOp::SET );
+				}
 			}
 			target->ScheduleUpdate ();
 		}
@@ -144,12 +155,24 @@ void MOAIAnim::Apply ( float t0, float t1 ) {
 		
 		if ( curve && target ) {
 			
-			if ( link.mRelative ) {
-				curve->GetDelta ( attrOp, t0, t1 );
+			if ( link.mFloatCurve ) {
+				float& value = *link.mDirect.mValue;
+				if ( link.mRelative ) {
+					value += link.mFloatCurve->GetDelta ( t0, t1, link.mKeyHint );
+				}
+				else {
+					value = link.mFloatCurve->GetValue ( t1, link.mKeyHint );
+				}
+				if ( link.mDirect.mClamp ) {
+					value = USFloat::Clamp ( value, 0.0f, 1.0f );
+				}
+			}
+			else if ( link.mRelative ) {
+				curve->GetDelta ( attrOp, t0, t1, link.mKeyHint );
 				target->ApplyAttrOp ( link.mAttrID, attrOp, MOAIAttrOp::ADD );
 			}
 			else {
-				curve->GetValue ( attrOp, t1 );
+				curve->GetValue ( attrOp, t1, link.mKeyHint );
 				target->ApplyAttrOp ( link.mAttrID, attrOp, MOAIAttrOp::SET );
 			}
 			target->ScheduleUpdate ();
@@ -238,6 +261,14 @@ void MOAIAnim::SetLink ( u32 linkID, MOAIAnimCurveBase* curve, MOAINode* target,
 	link.mTarget	= target;
 	link.mAttrID	= attrID;
 	link.mRelative	= relative;
+	link.mKeyHint	= 0;
+	
+	// float curves driving plain float attributes skip the attribute dispatch
+	link.mDirect		= MOAIDirectAttr ();
+	link.mFloatCurve	= curve ? curve->AsType < MOAIAnimCurve >() : 0;
+	if ( link.mFloatCurve && !target->GetDirectAttr ( attrID, link.mDirect )) {
+		link.mFloatCurve = 0;
+	}
 	
 	float length = curve->GetLength ();
 
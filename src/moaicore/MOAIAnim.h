@@ -7,6 +7,7 @@
 #include <moaicore/MOAILua.h>
 #include <moaicore/MOAITimer.h>
 
+class MOAIAnimCurve;
 class MOAIAnimCurveBase;
 
 //================================================================//
@@ -19,6 +20,20 @@ public:
 	MOAIWeakPtr < MOAINode > mTarget;
 	u32 mAttrID;
 	bool mRelative;
+	u32 mKeyHint;	// curve key found by the last apply; playback rarely jumps far
+	
+	// set when a float curve drives a plain float attribute (transform or color
+	// component); the value is then written in place, skipping ApplyAttrOp
+	MOAIAnimCurve* mFloatCurve;
+	MOAIDirectAttr mDirect;
+	
+	//----------------------------------------------------------------//
+	MOAIAnimLink () :
+		mAttrID ( 0 ),
+		mRelative ( false ),
+		mKeyHint ( 0 ),
+		mFloatCurve ( 0 ) {
+	}
 };
 
 //================================================================//
@@ -11,6 +11,27 @@
 // local
 //================================================================//
 
+//----------------------------------------------------------------//
+/**	@name	bake
+	@text	Resample the curve at a fixed rate into a lookup table. While
+			baked, the curve is evaluated by interpolating linearly between
+			the two nearest samples instead of searching and easing between
+			key frames. Setting a key or reserving keys discards the table;
+			bake again once the keys are in place.
+	
+	@in		MOAIAnimCurve self
+	@opt	number sampleRate		Samples per unit of time. Omit or pass 0 to discard the table.
+	@out	nil
+*/
+int MOAIAnimCurve::_bake ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAIAnimCurve, "U" );
+
+	float sampleRate = state.GetValue < float >( 2, 0.0f );
+	self->Bake ( sampleRate );
+
+	return 0;
+}
+
 //----------------------------------------------------------------//
 /**	@name	getValueAtTime
 	@text	Return the interpolated value given a point in time along the curve. This does not change
@@ -70,6 +91,36 @@ void MOAIAnimCurve::ApplyValueAttrOp ( MOAIAttrOp& attrOp, u32 op ) {
 	this->mValue = attrOp.Apply ( this->mValue, op, MOAIAttrOp::ATTR_READ_WRITE );
 }
 
+//----------------------------------------------------------------//
+void MOAIAnimCurve::Bake ( float sampleRate ) {
+
+	this->mBakedSamples.Clear ();
+	this->mBakeRate = 0.0f;
+
+	u32 total = this->mKeys.Size ();
+	float length = this->GetLength ();
+	
+	if (( total < 2 ) || ( length <= 0.0f ) || ( sampleRate <= 0.0f )) return;
+	
+	u32 intervals = ( u32 )USFloat::Ceil ( length * sampleRate );
+	intervals = intervals ? intervals : 1;
+	
+	this->mBakedSamples.Init ( intervals + 1 );
+	
+	float startTime = this->mKeys [ 0 ].mTime;
+	u32 keyID = 0;
+	
+	for ( u32 i = 0; i <= intervals; ++i ) {
+	
+		// sample the keys directly; wrapping would fold the last sample back to the first
+		float time = ( i < intervals ) ? startTime + (( length * ( float )i ) / ( float )intervals ) : this->mKeys [ total - 1 ].mTime;
+		keyID = this->FindKeyID ( time, keyID );
+		
+		this->mBakedSamples [ i ] = this->GetValue ( this->GetSpanAt ( time, keyID ));
+	}
+	this->mBakeRate = ( float )intervals / length;
+}
+
 //----------------------------------------------------------------//
 void MOAIAnimCurve::Draw ( u32 resolution ) const {
 
@@ -102,6 +153,50 @@ void MOAIAnimCurve::Draw ( u32 resolution ) const {
 	gfxDevice.EndPrim ();
 }
 
+//----------------------------------------------------------------//
+bool MOAIAnimCurve::GetBakedDelta ( MOAIAttrOp& attrOp, float t0, float t1 ) const {
+
+	if ( !this->mBakedSamples.Size ()) return false;
+
+	attrOp.SetValue < float >( this->GetBakedValue ( t1 ) - this->GetBakedValue ( t0 ));
+	return true;
+}
+
+//----------------------------------------------------------------//
+float MOAIAnimCurve::GetBakedValue ( float time ) const {
+
+	float cycle;
+	float wrapTime = this->WrapTime ( time, cycle );
+	
+	u32 last = this->mBakedSamples.Size () - 1;
+	float pos = ( wrapTime - this->mKeys [ 0 ].mTime ) * this->mBakeRate;
+	
+	float value;
+	if ( pos <= 0.0f ) {
+		value = this->mBakedSamples [ 0 ];
+	}
+	else {
+		u32 i = ( u32 )pos;
+		if ( i >= last ) {
+			value = this->mBakedSamples [ last ];
+		}
+		else {
+			float v0 = this->mBakedSamples [ i ];
+			value = v0 + (( this->mBakedSamples [ i + 1 ] - v0 ) * ( pos - ( float )i ));
+		}
+	}
+	return value + ( this->GetCurveDelta () * cycle );
+}
+
+//----------------------------------------------------------------//
+bool MOAIAnimCurve::GetBakedValue ( MOAIAttrOp& attrOp, float time ) const {
+
+	if ( !this->mBakedSamples.Size ()) return false;
+
+	attrOp.SetValue < float >( this->GetBakedValue ( time ));
+	return true;
+}
+
 //----------------------------------------------------------------//
 float MOAIAnimCurve::GetCurveDelta () const {
 
@@ -121,6 +216,20 @@ void MOAIAnimCurve::GetDelta ( MOAIAttrOp& attrOp, const MOAIAnimKeySpan& span0,
 	attrOp.SetValue < float >( v1 - v0 );
 }
 
+//----------------------------------------------------------------//
+float MOAIAnimCurve::GetDelta ( float t0, float t1, u32& keyHint ) const {
+
+	if (( t0 == t1 ) || ( this->mKeys.Size () < 2 )) return 0.0f;
+	
+	if ( this->mBakedSamples.Size ()) {
+		return this->GetBakedValue ( t1 ) - this->GetBakedValue ( t0 );
+	}
+	
+	float v0 = this->GetValue ( this->GetSpan ( t0, keyHint ));
+	float v1 = this->GetValue ( this->GetSpan ( t1, keyHint ));
+	return v1 - v0;
+}
+
 //----------------------------------------------------------------//
 float MOAIAnimCurve::GetSample ( u32 id ) {
 
@@ -133,10 +242,23 @@ float MOAIAnimCurve::GetSample ( u32 id ) {
 //----------------------------------------------------------------//
 float MOAIAnimCurve::GetValue ( float time ) const {
 
+	if ( this->mBakedSamples.Size ()) {
+		return this->GetBakedValue ( time );
+	}
+
 	MOAIAnimKeySpan span = this->GetSpan ( time );
 	return this->GetValue ( span );
 }
 
+//----------------------------------------------------------------//
+float MOAIAnimCurve::GetValue ( float time, u32& keyHint ) const {
+
+	if ( this->mBakedSamples.Size ()) {
+		return this->GetBakedValue ( time );
+	}
+	return this->GetValue ( this->GetSpan ( time, keyHint ));
+}
+
 //----------------------------------------------------------------//
 float MOAIAnimCurve::GetValue ( const MOAIAnimKeySpan& span ) const {
 
@@ -163,7 +285,8 @@ void MOAIAnimCurve::GetZero ( MOAIAttrOp& attrOp ) const {
 
 //----------------------------------------------------------------//
 MOAIAnimCurve::MOAIAnimCurve () :
-	mValue ( 0.0f ) {
+	mValue ( 0.0f ),
+	mBakeRate ( 0.0f ) {
 	
 	RTTI_SINGLE ( MOAIAnimCurveBase )
 }
@@ -175,7 +298,7 @@ MOAIAnimCurve::~MOAIAnimCurve () {
 //----------------------------------------------------------------//
 void MOAIAnimCurve::OnDepNodeUpdate () {
 
-	this->mValue = this->GetValue ( this->mTime );
+	this->mValue = this->GetValue ( this->mTime, this->mKeyHint );
 }
 
 //----------------------------------------------------------------//
@@ -190,6 +313,7 @@ void MOAIAnimCurve::RegisterLuaFuncs ( MOAILuaState& state ) {
 	MOAIAnimCurveBase::RegisterLuaFuncs ( state );
 
 	luaL_Reg regTable [] = {
+		{ "bake",				_bake },
 		{ "getValueAtTime",		_getValueAtTime },
 		{ "setKey",				_setKey },
 		{ NULL, NULL }
@@ -202,6 +326,7 @@ void MOAIAnimCurve::RegisterLuaFuncs ( MOAILuaState& state ) {
 void MOAIAnimCurve::ReserveSamples ( u32 total ) {
 
 	this->mSamples.Init ( total );
+	this->Bake ( 0.0f );
 }
 
 //----------------------------------------------------------------//
@@ -209,5 +334,6 @@ void MOAIAnimCurve::SetSample ( u32 id, float value ) {
 
 	if ( id < this->mKeys.Size ()) {
 		this->mSamples [ id ] = value;
+		this->Bake ( 0.0f );
 	}
 }
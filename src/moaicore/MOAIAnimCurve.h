@@ -22,11 +22,18 @@ private:
 	USLeanArray < float > mSamples;
 	float mValue;
 
+	USLeanArray < float > mBakedSamples;	// evenly spaced over the curve's length, first key to last
+	float mBakeRate;						// baked samples per unit of time
+
 	//----------------------------------------------------------------//
+	static int		_bake				( lua_State* L );
 	static int		_getValueAtTime		( lua_State* L );
 	static int		_setKey				( lua_State* L );
 
 	//----------------------------------------------------------------//
+	bool			GetBakedDelta		( MOAIAttrOp& attrOp, float t0, float t1 ) const;
+	float			GetBakedValue		( float time ) const;
+	bool			GetBakedValue		( MOAIAttrOp& attrOp, float time ) const;
 	float			GetCurveDelta		() const;
 	float			GetValue			( const MOAIAnimKeySpan& span ) const;
 
@@ -36,10 +43,13 @@ public:
 	
 	//----------------------------------------------------------------//
 	void			ApplyValueAttrOp	( MOAIAttrOp& attrOp, u32 op );
+	void			Bake				( float sampleRate );
 	void			Draw				( u32 resolution ) const;
 	void			GetDelta			( MOAIAttrOp& attrOp, const MOAIAnimKeySpan& span0, const MOAIAnimKeySpan& span1 ) const;
+	float			GetDelta			( float t0, float t1, u32& keyHint ) const;
 	float			GetSample			( u32 id );
 	float			GetValue			( float time ) const;
+	float			GetValue			( float time, u32& keyHint ) const;
 	void			GetValue			( MOAIAttrOp& attrOp, const MOAIAnimKeySpan& span ) const;
 	void			GetZero				( MOAIAttrOp& attrOp ) const;
 					MOAIAnimCurve		();
@@ -87,6 +87,13 @@ bool MOAIAnimCurveBase::ApplyAttrOp ( u32 attrID, MOAIAttrOp& attrOp, u32 op ) {
 	return false;
 }
 
+//----------------------------------------------------------------//
+bool MOAIAnimCurveBase::CanUpdateInParallel () {
+
+	// sampling a curve only writes the curve's own value
+	return true;
+}
+
 //----------------------------------------------------------------//
 void MOAIAnimCurveBase::Clear () {
 
@@ -109,16 +116,61 @@ u32 MOAIAnimCurveBase::FindKeyID ( float time ) const {
 	return index;
 }
 
+//----------------------------------------------------------------//
+// playback mostly moves forward a little at a time, so try the key found last
+// time and the one after it before falling back on the binary search. a hint is
+// only taken when the time falls strictly inside its span; on a key time the
+// search decides, so both paths always agree.
+u32 MOAIAnimCurveBase::FindKeyID ( float time, u32 keyHint ) const {
+
+	u32 total = this->mKeys.Size ();
+
+	for ( u32 i = keyHint; ( i < keyHint + 2 ) && (( i + 1 ) < total ); ++i ) {
+	
+		const MOAIAnimKey& k0 = this->mKeys [ i ];
+		if ( time <= k0.mTime ) break;
+		
+		if ( time < this->mKeys [ i + 1 ].mTime ) {
+			return i;
+		}
+	}
+	return this->FindKeyID ( time );
+}
+
+//----------------------------------------------------------------//
+bool MOAIAnimCurveBase::GetBakedDelta ( MOAIAttrOp& attrOp, float t0, float t1 ) const {
+	UNUSED ( attrOp );
+	UNUSED ( t0 );
+	UNUSED ( t1 );
+
+	return false;
+}
+
+//----------------------------------------------------------------//
+bool MOAIAnimCurveBase::GetBakedValue ( MOAIAttrOp& attrOp, float time ) const {
+	UNUSED ( attrOp );
+	UNUSED ( time );
+
+	return false;
+}
+
 //----------------------------------------------------------------//
 void MOAIAnimCurveBase::GetDelta ( MOAIAttrOp& attrOp, float t0, float t1 ) {
 	
+	u32 keyHint = NULL_KEY_ID;
+	this->GetDelta ( attrOp, t0, t1, keyHint );
+}
+
+//----------------------------------------------------------------//
+void MOAIAnimCurveBase::GetDelta ( MOAIAttrOp& attrOp, float t0, float t1, u32& keyHint ) {
+	
 	if (( t0 == t1 ) || ( this->mKeys.Size () < 2 )) {
 		this->GetZero ( attrOp );
 	}
-	else {
+	else if ( !this->GetBakedDelta ( attrOp, t0, t1 )) {
 
-		MOAIAnimKeySpan s0 = this->GetSpan ( t0 );
-		MOAIAnimKeySpan s1 = this->GetSpan ( t1 );
+		MOAIAnimKeySpan s0 = this->GetSpan ( t0, keyHint );
+		MOAIAnimKeySpan s1 = this->GetSpan ( t1, keyHint );
 		
 		this->GetDelta ( attrOp, s0, s1 );
 	}
@@ -142,23 +194,40 @@ float MOAIAnimCurveBase::GetLength () const {
 //----------------------------------------------------------------//
 MOAIAnimKeySpan MOAIAnimCurveBase::GetSpan ( float time ) const {
 
+	u32 keyHint = NULL_KEY_ID;
+	return this->GetSpan ( time, keyHint );
+}
+
+//----------------------------------------------------------------//
+MOAIAnimKeySpan MOAIAnimCurveBase::GetSpan ( float time, u32& keyHint ) const {
+
+	assert ( this->mKeys.Size ());
+	
+	float cycle;
+	float wrapTime = this->WrapTime ( time, cycle );
+	keyHint = this->FindKeyID ( wrapTime, keyHint );
+	
+	MOAIAnimKeySpan span = this->GetSpanAt ( wrapTime, keyHint );
+	span.mCycle = cycle;
+	return span;
+}
+
+//----------------------------------------------------------------//
+// wrapTime must already lie within the curve; keyID is the key found for it
+MOAIAnimKeySpan MOAIAnimCurveBase::GetSpanAt ( float wrapTime, u32 keyID ) const {
+
 	MOAIAnimKeySpan span;
-	span.mKeyID = NULL_KEY_ID;
+	span.mKeyID = keyID;
 	span.mTime = 0.0f;
 	span.mCycle = 0.0f;
 
-	u32 total = this->mKeys.Size ();
-	u32 endID = total - 1;
-	assert ( total );
-	
-	float wrapTime = this->WrapTime ( time, span.mCycle );
-	span.mKeyID = this->FindKeyID ( wrapTime );
+	u32 endID = this->mKeys.Size () - 1;
 
 	if ( span.mKeyID == endID ) {
 		return span;
 	}
 	
-	MOAIAnimKey k0 = this->mKeys [ span.mKeyID ];
+	const MOAIAnimKey& k0 = this->mKeys [ span.mKeyID ];
 	
 	if ( k0.mMode == USInterpolate::kFlat ) {
 		return span;
@@ -168,7 +237,7 @@ MOAIAnimKeySpan MOAIAnimCurveBase::GetSpan ( float time ) const {
 		return span;
 	}
 	
-	MOAIAnimKey k1 = this->mKeys [ span.mKeyID + 1 ];
+	const MOAIAnimKey& k1 = this->mKeys [ span.mKeyID + 1 ];
 	
 	if ( k1.mTime > k0.mTime ) {
 		span.mTime = ( wrapTime - k0.mTime ) / ( k1.mTime - k0.mTime );
@@ -179,14 +248,24 @@ MOAIAnimKeySpan MOAIAnimCurveBase::GetSpan ( float time ) const {
 //----------------------------------------------------------------//
 void MOAIAnimCurveBase::GetValue ( MOAIAttrOp& attrOp, float time ) {
 	
-	MOAIAnimKeySpan span = this->GetSpan ( time );
-	this->GetValue ( attrOp, span );
+	u32 keyHint = NULL_KEY_ID;
+	this->GetValue ( attrOp, time, keyHint );
+}
+
+//----------------------------------------------------------------//
+void MOAIAnimCurveBase::GetValue ( MOAIAttrOp& attrOp, float time, u32& keyHint ) {
+	
+	if ( !this->GetBakedValue ( attrOp, time )) {
+		MOAIAnimKeySpan span = this->GetSpan ( time, keyHint );
+		this->GetValue ( attrOp, span );
+	}
 }
 
 //----------------------------------------------------------------//
 MOAIAnimCurveBase::MOAIAnimCurveBase () :
 	mTime ( 0.0f ),
-	mWrapMode ( CLAMP ) {
+	mWrapMode ( CLAMP ),
+	mKeyHint ( NULL_KEY_ID ) {
 	
 	RTTI_SINGLE ( MOAINode )
 }
@@ -257,6 +336,12 @@ float MOAIAnimCurveBase::WrapTime ( float t, float &repeat ) const {
 	float startTime = this->mKeys [ 0 ].mTime;
 	float length = GetLength ();
 
+	// already inside the curve; every mode leaves the time as it is
+	if (( startTime <= t ) && ( t < ( startTime + length ))) {
+		repeat = 0.0f;
+		return t;
+	}
+
 	float time = ( t - startTime ) / length; // normalize time
 	float wrappedT = 0.0f;
 	repeat = 0.0f;
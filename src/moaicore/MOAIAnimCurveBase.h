@@ -63,6 +63,7 @@ protected:
 
 	float	mTime;
 	u32		mWrapMode;
+	u32		mKeyHint;	// key found by the last OnDepNodeUpdate
 
 	//----------------------------------------------------------------//
 	static int			_getLength			( lua_State* L );
@@ -71,8 +72,13 @@ protected:
 
 	//----------------------------------------------------------------//
 	virtual void		ApplyValueAttrOp	( MOAIAttrOp& attrOp, u32 op ) = 0;
+	bool				CanUpdateInParallel	();
+	virtual bool		GetBakedDelta		( MOAIAttrOp& attrOp, float t0, float t1 ) const;
+	virtual bool		GetBakedValue		( MOAIAttrOp& attrOp, float time ) const;
 	virtual void		GetDelta			( MOAIAttrOp& attrOp, const MOAIAnimKeySpan& span0, const MOAIAnimKeySpan& span1 ) const = 0;
 	MOAIAnimKeySpan		GetSpan				( float time ) const;
+	MOAIAnimKeySpan		GetSpan				( float time, u32& keyHint ) const;
+	MOAIAnimKeySpan		GetSpanAt			( float wrapTime, u32 keyID ) const;
 	virtual void		GetValue			( MOAIAttrOp& attrOp, const MOAIAnimKeySpan& span ) const = 0;
 	virtual void		GetZero				( MOAIAttrOp& attrOp ) const = 0;
 	virtual void		ReserveSamples		( u32 total ) = 0;
@@ -99,10 +105,13 @@ public:
 	void				Clear					();
 	virtual void		Draw					( u32 resolution ) const;
 	u32					FindKeyID				( float time ) const;
+	u32					FindKeyID				( float time, u32 keyHint ) const;
 	void				GetDelta				( MOAIAttrOp& attrOp, float t0, float t1 );
+	void				GetDelta				( MOAIAttrOp& attrOp, float t0, float t1, u32& keyHint );
 	const MOAIAnimKey&	GetKey					( u32 id ) const;
 	float				GetLength				() const;
 	void				GetValue				( MOAIAttrOp& attrOp, float time );
+	void				GetValue				( MOAIAttrOp& attrOp, float time, u32& keyHint );
 						MOAIAnimCurveBase		();
 						~MOAIAnimCurveBase		();
 	void				RegisterLuaClass		( MOAILuaState& state );
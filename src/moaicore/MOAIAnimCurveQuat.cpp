@@ -166,7 +166,7 @@ MOAIAnimCurveQuat::~MOAIAnimCurveQuat () {
 //----------------------------------------------------------------//
 void MOAIAnimCurveQuat::OnDepNodeUpdate () {
 
-	this->mValue = this->GetValue ( this->mTime );
+	this->mValue = this->GetValue ( this->GetSpan ( this->mTime, this->mKeyHint ));
 }
 
 //----------------------------------------------------------------//
@@ -161,7 +161,7 @@ MOAIAnimCurveVec::~MOAIAnimCurveVec () {
 //----------------------------------------------------------------//
 void MOAIAnimCurveVec::OnDepNodeUpdate () {
 
-	this->mValue = this->GetValue ( this->mTime );
+	this->mValue = this->GetValue ( this->GetSpan ( this->mTime, this->mKeyHint ));
 }
 
 //----------------------------------------------------------------//
@@ -315,6 +315,7 @@ void MOAIBitmapFontReader::RenderGlyph ( MOAIFont& font, MOAIGlyph& glyph ) {
 				width,
 				height
 			);
+			glyphCache->InvalidateGlyph ( glyph );
 		}
 	}
 }
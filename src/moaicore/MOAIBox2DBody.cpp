@@ -962,7 +962,7 @@ void MOAIBox2DBody::OnDepNodeUpdate () {
 		m [ USAffine3D::C3_R0 ] = ( float )transform.p.x * scale;
 		m [ USAffine3D::C3_R1 ] = ( float )transform.p.y * scale;
 		
-		this->mWorldToLocalMtx.Inverse ( this->mLocalToWorldMtx );
+		this->SetWorldToLocalDirty ();
 	}
 }
 
@@ -1052,6 +1052,15 @@ bool MOAIBox2DBody::ApplyAttrOp ( u32 attrID, MOAIAttrOp& attrOp, u32 op ) {
 	return MOAITransformBase::ApplyAttrOp (attrID, attrOp, op );
 }
 
+//----------------------------------------------------------------//
+bool MOAIBox2DBody::GetDirectAttr ( u32 attrID, MOAIDirectAttr& attr ) {
+	UNUSED ( attrID );
+	UNUSED ( attr );
+
+	// the body's transform lives in Box2D; every write has to go through ApplyAttrOp
+	return false;
+}
+
 //----------------------------------------------------------------//
 void MOAIBox2DBody::SetBody ( b2Body* body ) {
 
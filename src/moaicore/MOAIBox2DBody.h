@@ -66,6 +66,7 @@ private:
 	
 	//----------------------------------------------------------------//
 	bool			ApplyAttrOp				( u32 attrID, MOAIAttrOp& attrOp, u32 op );
+	bool			GetDirectAttr			( u32 attrID, MOAIDirectAttr& attr );
 	void			SetBody					( b2Body* body );
 	void			OnDepNodeUpdate			();
 
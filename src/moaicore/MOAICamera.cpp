@@ -132,6 +132,13 @@ int MOAICamera::_setOrtho ( lua_State* L ) {
 // MOAICamera
 //================================================================//
 
+//----------------------------------------------------------------//
+bool MOAICamera::CanUpdateInParallel () {
+
+	// the lens settings aren't touched by the update; it only builds the transform
+	return true;
+}
+
 //----------------------------------------------------------------//
 USMatrix4x4 MOAICamera::GetBillboardMtx () const {
 
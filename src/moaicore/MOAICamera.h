@@ -35,6 +35,9 @@ private:
 	static int		_setNearPlane		( lua_State* L );
 	static int		_setOrtho			( lua_State* L );
 	
+	//----------------------------------------------------------------//
+	bool			CanUpdateInParallel	();
+	
 public:
 	
 	DECL_LUA_FACTORY ( MOAICamera )
@@ -187,12 +187,36 @@ bool MOAIColor::ApplyAttrOp ( u32 attrID, MOAIAttrOp& attrOp, u32 op ) {
 	return false;
 }
 
+//----------------------------------------------------------------//
+bool MOAIColor::CanUpdateInParallel () {
+
+	// only a plain color; props are colors too and their update has side effects
+	return this->GetLuaClass () == &MOAILuaFactoryClass < MOAIColor >::Get ();
+}
+
 //----------------------------------------------------------------//
 USColorVec MOAIColor::GetColorTrait () {
 
 	return this->mColor;
 }
 
+//----------------------------------------------------------------//
+bool MOAIColor::GetDirectAttr ( u32 attrID, MOAIDirectAttr& attr ) {
+
+	if ( MOAIColorAttr::Check ( attrID )) {
+
+		attr.mClamp = true;
+
+		switch ( UNPACK_ATTR ( attrID )) {
+			case ATTR_R_COL:	attr.mValue = &this->mR;	return true;
+			case ATTR_G_COL:	attr.mValue = &this->mG;	return true;
+			case ATTR_B_COL:	attr.mValue = &this->mB;	return true;
+			case ATTR_A_COL:	attr.mValue = &this->mA;	return true;
+		}
+	}
+	return false;
+}
+
 //----------------------------------------------------------------//
 MOAIColor::MOAIColor () {
 	
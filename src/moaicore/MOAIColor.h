@@ -57,7 +57,9 @@ public:
 	
 	//----------------------------------------------------------------//
 	bool			ApplyAttrOp			( u32 attrID, MOAIAttrOp& attrOp, u32 op );
+	bool			CanUpdateInParallel	();
 	USColorVec		GetColorTrait		();
+	bool			GetDirectAttr		( u32 attrID, MOAIDirectAttr& attr );
 					MOAIColor			();
 					~MOAIColor			();
 	void			OnDepNodeUpdate		();
@@ -831,7 +831,7 @@ void MOAICpBody::OnDepNodeUpdate () {
 		m [ USAffine3D::C3_R1 ] = ( float )pos.y;
 		m [ USAffine3D::C3_R2 ] = 0.0f;
 		
-		this->mWorldToLocalMtx.Inverse ( this->mLocalToWorldMtx );
+		this->SetWorldToLocalDirty ();
 	}
 }
 
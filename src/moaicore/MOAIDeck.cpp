@@ -10,10 +10,13 @@
 #include <moaicore/MOAIGrid.h>
 #include <moaicore/MOAILogMessages.h>
 #include <moaicore/MOAIMultiTexture.h>
+#include <moaicore/MOAIQuadBrush.h>
+#include <moaicore/MOAIRenderMgr.h>
 #include <moaicore/MOAIShader.h>
 #include <moaicore/MOAIShaderMgr.h>
 #include <moaicore/MOAISurfaceSampler2D.h>
 #include <moaicore/MOAITexture.h>
+#include <moaicore/MOAITextureAtlas.h>
 #include <moaicore/MOAITextureBase.h>
 #include <moaicore/MOAITransform.h>
 
@@ -87,18 +90,34 @@ int MOAIDeck::_setShader ( lua_State* L ) {
 
 //----------------------------------------------------------------//
 /**	@name	setTexture
-	@text	Set or load a texture for this deck.
+	@text	Set or load a texture for this deck. Only MOAIGfxQuad2D,
+			MOAIGfxQuadDeck2D and MOAITileDeck2D accept a
+			MOAITextureAtlasRegion; other decks log an error and keep
+			their texture.
 	
 	@in		MOAIDeck self
-	@in		variant texture		A MOAITexture, MOAIMultiTexture, MOAIDataBuffer or a path to a texture file
+	@in		variant texture		A MOAITexture, MOAIMultiTexture, MOAITextureAtlasRegion, MOAIDataBuffer or a path to a texture file
 	@opt	number transform	Any bitwise combination of MOAITextureBase.QUANTIZE, MOAITextureBase.TRUECOLOR, MOAITextureBase.PREMULTIPLY_ALPHA
 	@out	MOAIGfxState texture
 */
 int MOAIDeck::_setTexture ( lua_State* L ) {
 	MOAI_LUA_SETUP ( MOAIDeck, "U" )
 
-	MOAIGfxState* texture = MOAITexture::AffirmTexture ( state, 2 );
+	MOAITextureAtlasRegion* region = state.GetLuaObject < MOAITextureAtlasRegion >( 2, false );
+	
+	// the region is only a corner of a shared page; a deck that can't map its UVs into it would draw the whole page
+	if ( region && !self->CanRemapUVs ()) {
+		MOAILog ( state, MOAILogMessages::MOAIDeck_NoAtlasRegions_S, self->TypeName ());
+		return 0;
+	}
+	
+	MOAIGfxState* texture = region ? region->GetTexture () : MOAITexture::AffirmTexture ( state, 2 );
+	
+	self->mAtlasRegion.Set ( *self, region );
 	self->mTexture.Set ( *self, texture );
+	
+	// quads already written out were mapped for the old texture
+	self->SetContentDirty ();
 
 	if ( texture ) {
 		self->mTexture->PushLuaUserdata ( state );
@@ -111,6 +130,18 @@ int MOAIDeck::_setTexture ( lua_State* L ) {
 // MOAIDeck
 //================================================================//
 
+//----------------------------------------------------------------//
+bool MOAIDeck::CanRemapUVs () {
+
+	return false;
+}
+
+//----------------------------------------------------------------//
+bool MOAIDeck::CanWriteQuads () {
+
+	return false;
+}
+
 //----------------------------------------------------------------//
 bool MOAIDeck::Contains ( u32 idx, MOAIDeckRemapper* remapper, const USVec2D& vec ) {
 	
@@ -208,11 +239,17 @@ void MOAIDeck::GetGfxState ( MOAIDeckGfxState& gfxState ) {
 MOAIDeck::MOAIDeck () :
 	mContentMask ( 0xffffffff ),
 	mDefaultShaderID ( MOAIShaderMgr::DECK2D_SHADER ),
-	mBoundsDirty ( true ) {
+	mBoundsDirty ( true ),
+	mContentVersion ( 0 ) {
 	
 	RTTI_SINGLE ( MOAILuaObject )
 	
 	this->mMaxBounds.Init ( 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f );
+	
+	this->mDirtyBoundsLink.Data ( this );
+	if ( MOAIRenderMgr::IsValid ()) {
+		MOAIRenderMgr::Get ().AffirmDeckBounds ( *this );
+	}
 }
 
 //----------------------------------------------------------------//
@@ -220,6 +257,7 @@ MOAIDeck::~MOAIDeck () {
 
 	this->mShader.Set ( *this, 0 );
 	this->mTexture.Set ( *this, 0 );
+	this->mAtlasRegion.Set ( *this, 0 );
 	this->mBoundsDeck.Set ( *this, 0 );
 }
 
@@ -241,8 +279,52 @@ void MOAIDeck::RegisterLuaFuncs ( MOAILuaState& state ) {
 	luaL_register ( state, 0, regTable );
 }
 
+//----------------------------------------------------------------//
+void MOAIDeck::RemapUVs ( float& uOff, float& vOff, float& uScale, float& vScale ) {
+
+	if ( this->mAtlasRegion ) {
+		this->mAtlasRegion->RemapUVs ( uOff, vOff, uScale, vScale );
+	}
+}
+
 //----------------------------------------------------------------//
 void MOAIDeck::SetBoundsDirty () {
 
 	this->mBoundsDirty = true;
+	this->SetContentDirty ();
+	
+	// layers may cull on worker threads, which must not rebuild the bounds themselves
+	if ( MOAIRenderMgr::IsValid ()) {
+		MOAIRenderMgr::Get ().AffirmDeckBounds ( *this );
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAIDeck::SetContentDirty () {
+
+	this->mContentVersion++;
+}
+
+//----------------------------------------------------------------//
+bool MOAIDeck::WriteQuad ( u32 idx, MOAIQuadVertex* vtx, float xOff, float yOff, float zOff, float xScl, float yScl ) {
+
+	if ( !idx || ( idx & MOAITileFlags::HIDDEN )) return false;
+	
+	xScl = ( idx & MOAITileFlags::XFLIP ) ? -xScl : xScl;
+	yScl = ( idx & MOAITileFlags::YFLIP ) ? -yScl : yScl;
+	
+	return this->WriteQuadIndex ( idx & MOAITileFlags::CODE_MASK, vtx, xOff, yOff, zOff, xScl, yScl );
+}
+
+//----------------------------------------------------------------//
+bool MOAIDeck::WriteQuadIndex ( u32 idx, MOAIQuadVertex* vtx, float xOff, float yOff, float zOff, float xScl, float yScl ) {
+	UNUSED ( idx );
+	UNUSED ( vtx );
+	UNUSED ( xOff );
+	UNUSED ( yOff );
+	UNUSED ( zOff );
+	UNUSED ( xScl );
+	UNUSED ( yScl );
+	
+	return false;
 }
@@ -11,8 +11,10 @@ class MOAIDeckRemapper;
 class MOAICellCoord;
 class MOAIGfxState;
 class MOAIGrid;
+class MOAIQuadVertex;
 class MOAIShader;
 class MOAISurfaceSampler2D;
+class MOAITextureAtlasRegion;
 
 //================================================================//
 // MOAIDeckGfxState
@@ -43,6 +45,12 @@ public:
 */
 class MOAIDeck :
 	public virtual MOAILuaObject {
+private:
+
+	friend class MOAIRenderMgr;
+
+	USLeanLink < MOAIDeck* > mDirtyBoundsLink; // queued with MOAIRenderMgr while mMaxBounds is stale
+
 protected:
 
 	enum {
@@ -54,6 +62,7 @@ protected:
 	// TODO: refactor; not all decks need thse (or will be limited to these)
 	MOAILuaSharedPtr < MOAIGfxState > mShader;
 	MOAILuaSharedPtr < MOAIGfxState > mTexture;
+	MOAILuaSharedPtr < MOAITextureAtlasRegion > mAtlasRegion; // set when mTexture is an atlas page; UVs are mapped into the region
 	
 	u32 mContentMask;
 	SET ( u32, ContentMask, mContentMask )
@@ -62,6 +71,8 @@ protected:
 
 	USBox mMaxBounds;
 	bool mBoundsDirty;
+	
+	u32 mContentVersion; // bumped whenever cached geometry built from the deck goes stale
 
 	//----------------------------------------------------------------//
 	static int				_setBoundsDeck			( lua_State* L );
@@ -72,13 +83,22 @@ protected:
 	virtual USBox			ComputeMaxBounds		() = 0;
 	virtual void			DrawIndex				( u32 idx, float xOff, float yOff, float zOff, float xScl, float yScl, float zScl );
 	virtual USBox			GetItemBounds			( u32 idx ) = 0;
+	void					RemapUVs				( float& uOff, float& vOff, float& uScale, float& vScale );
 	void					SetBoundsDirty			();
+	void					SetContentDirty			();
+	virtual bool			WriteQuadIndex			( u32 idx, MOAIQuadVertex* vtx, float xOff, float yOff, float zOff, float xScl, float yScl );
 
 public:
 	
 	GET ( u32, ContentMask, mContentMask )
+	GET ( u32, ContentVersion, mContentVersion )
+	GET ( u32, DefaultShaderID, mDefaultShaderID )
+	GET ( MOAIGfxState*, Shader, mShader )
+	GET ( MOAIGfxState*, Texture, mTexture )
 	
 	//----------------------------------------------------------------//
+	virtual bool			CanRemapUVs				();
+	virtual bool			CanWriteQuads			();
 	virtual bool			Contains				( u32 idx, MOAIDeckRemapper* remapper, const USVec2D& vec );
 	void					Draw					( u32 idx, MOAIDeckRemapper* remapper );
 	void					Draw					( u32 idx, MOAIDeckRemapper* remapper, float xOff, float yOff, float zOff, float xScl, float yScl, float zScl );
@@ -89,6 +109,7 @@ public:
 							~MOAIDeck				();
 	void					RegisterLuaClass		( MOAILuaState& state );
 	void					RegisterLuaFuncs		( MOAILuaState& state );
+	bool					WriteQuad				( u32 idx, MOAIQuadVertex* vtx, float xOff, float yOff, float zOff, float xScl, float yScl );
 };
 
 #endif
@@ -211,13 +211,13 @@ int MOAIFont::_setDefaultSize ( lua_State* L ) {
 
 //----------------------------------------------------------------//
 /**	@name	setFlags
-	@text	Set flags to control font loading behavior. Right now the
-			only supported flag is FONT_AUTOLOAD_KERNING which may be used
-			to enable automatic loading of kern tables. This flag is initially
-			true by default.
+	@text	Set flags to control font loading behavior. FONT_AUTOLOAD_KERNING
+			may be used to enable automatic loading of kern tables. This flag
+			is initially true by default. FONT_ASYNC_RENDER renders new glyphs
+			on a worker thread (currently only supported by MOAIFreeTypeFontReader).
 
 	@in		MOAIFont self
-	@opt	number flags			Flags are FONT_AUTOLOAD_KERNING or DEFAULT_FLAGS. DEFAULT_FLAGS is the same as FONT_AUTOLOAD_KERNING.
+	@opt	number flags			Flags are FONT_AUTOLOAD_KERNING, FONT_ASYNC_RENDER or DEFAULT_FLAGS. DEFAULT_FLAGS is the same as FONT_AUTOLOAD_KERNING.
 									Alternatively, pass '0' to clear the flags.
 	@out	nil
 */
@@ -318,16 +318,16 @@ void MOAIFont::AffirmGlyph ( float size, u32 c ) {
 //----------------------------------------------------------------//
 // iterate through the pending glyphs in each set and attempt to
 // update them to match target - i.e. metrics or metrics and bitmap
-void MOAIFont::BuildKerning ( MOAIGlyph* glyphs, MOAIGlyph* pendingGlyphs ) {
+void MOAIFont::BuildKerning ( MOAIGlyphSet& glyphSet, MOAIGlyph* glyphs, MOAIGlyph* pendingGlyphs ) {
 
 	if ( !this->mReader->HasKerning ()) return;
-	MOAIKernVec kernTable [ MOAIGlyph::MAX_KERN_TABLE_SIZE ]; // TODO: handle overflow cases
+	USLeanStack < MOAIKernVec, 64 > kernTable;
 
 	// iterate over the orignal glyphs and add kerning info for new glyphs
 	for ( MOAIGlyph* glyphIt = glyphs; glyphIt; glyphIt = glyphIt->mNext ) {
 		MOAIGlyph& glyph = *glyphIt;
 		
-		u32 kernTableSize = 0;
+		kernTable.Reset ();
 		u32 oldTableSize = glyph.mKernTable.Size ();
 		
 		// iterate over just the new glyphs; check each one against olf glyphs for kerning info
@@ -336,27 +336,19 @@ void MOAIFont::BuildKerning ( MOAIGlyph* glyphs, MOAIGlyph* pendingGlyphs ) {
 			
 			// skip if glyph is already in old glyph's kerning table
 			// may happen if glyphs are purged and then re-added
-			bool unknown = true;
-			for ( u32 i = 0; i < oldTableSize; ++i ) {
-				if ( glyph.mKernTable [ i ].mName == glyph2.mCode ) {
-					unknown = false;
-					break;
-				}
-			} 
+			if ( oldTableSize && glyphSet.HasKernPair ( glyph.mCode, glyph2.mCode )) continue;
 			
-			if ( unknown ) {
-				MOAIKernVec kernVec;
-				if ( this->mReader->GetKernVec ( glyph, glyph2, kernVec )) {
-					assert ( kernTableSize < MOAIGlyph::MAX_KERN_TABLE_SIZE );
-					kernTable [ kernTableSize++ ] = kernVec;
-				}
+			MOAIKernVec kernVec;
+			if ( this->mReader->GetKernVec ( glyph, glyph2, kernVec )) {
+				kernTable.Push ( kernVec );
 			}
 		}
 		
 		// resize the old kerning table and copy in the new kern vecs (if any)
+		u32 kernTableSize = kernTable.GetTop ();
 		if ( kernTableSize ) {
 			glyph.mKernTable.Resize ( oldTableSize + kernTableSize );
-			memcpy ( &glyph.mKernTable [ oldTableSize ], kernTable, sizeof ( MOAIKernVec ) * kernTableSize );
+			memcpy ( &glyph.mKernTable [ oldTableSize ], kernTable.Data (), sizeof ( MOAIKernVec ) * kernTableSize );
 		}
 	}
 	
@@ -364,7 +356,7 @@ void MOAIFont::BuildKerning ( MOAIGlyph* glyphs, MOAIGlyph* pendingGlyphs ) {
 	for ( MOAIGlyph* glyphIt = pendingGlyphs; glyphIt; glyphIt = glyphIt->mNext ) {
 		MOAIGlyph& glyph = *glyphIt;
 		
-		u32 kernTableSize = 0;
+		kernTable.Reset ();
 		
 		// iterate over the original glyphs
 		for ( MOAIGlyph* glyphIt2 = glyphs; glyphIt2; glyphIt2 = glyphIt2->mNext ) {
@@ -372,8 +364,7 @@ void MOAIFont::BuildKerning ( MOAIGlyph* glyphs, MOAIGlyph* pendingGlyphs ) {
 			
 			MOAIKernVec kernVec;
 			if ( this->mReader->GetKernVec ( glyph, glyph2, kernVec )) {
-				assert ( kernTableSize < MOAIGlyph::MAX_KERN_TABLE_SIZE );
-				kernTable [ kernTableSize++ ] = kernVec;
+				kernTable.Push ( kernVec );
 			}
 		}
 		
@@ -383,17 +374,20 @@ void MOAIFont::BuildKerning ( MOAIGlyph* glyphs, MOAIGlyph* pendingGlyphs ) {
 			
 			MOAIKernVec kernVec;
 			if ( this->mReader->GetKernVec ( glyph, glyph2, kernVec )) {
-				assert ( kernTableSize < MOAIGlyph::MAX_KERN_TABLE_SIZE );
-				kernTable [ kernTableSize++ ] = kernVec;
+				kernTable.Push ( kernVec );
 			}
 		}
 		
 		// init the kern table
+		u32 kernTableSize = kernTable.GetTop ();
 		if ( kernTableSize ) {
 			glyph.mKernTable.Init ( kernTableSize );
-			memcpy ( glyph.mKernTable, kernTable, sizeof ( MOAIKernVec ) * kernTableSize );
+			memcpy ( glyph.mKernTable, kernTable.Data (), sizeof ( MOAIKernVec ) * kernTableSize );
 		}
 	}
+	
+	// the set's pair table is gathered again on the next lookup
+	glyphSet.mKernDirty = true;
 }
 
 //----------------------------------------------------------------//
@@ -494,7 +488,7 @@ void MOAIFont::ProcessGlyphs () {
 		
 		// build kerning tables (if face has kerning info)
 		if (( this->mFlags & FONT_AUTOLOAD_KERNING ) && this->mReader->HasKerning ()) {
-			this->BuildKerning ( glyphs, pendingGlyphs );
+			this->BuildKerning ( glyphSet, glyphs, pendingGlyphs );
 		}
 		
 		//----------------------------------------------------------------//
@@ -553,36 +547,37 @@ void MOAIFont::RebuildKerning ( float size ) {
 //----------------------------------------------------------------//
 void MOAIFont::RebuildKerning ( MOAIGlyphSet& glyphSet ) {
 	
-	MOAIKernVec kernTable [ MOAIGlyph::MAX_KERN_TABLE_SIZE ];
+	USLeanStack < MOAIKernVec, 64 > kernTable;
 	
 	// get the face metrics
 	this->mReader->SetFaceSize ( glyphSet.mSize );
 
-	u32 kernTableSize = 0;
-
 	// iterate over the orignal glyphs and add kerning info for new glyphs
 	for ( MOAIGlyph* glyphIt = glyphSet.mGlyphs; glyphIt; glyphIt = glyphIt->mNext ) {
 		MOAIGlyph& glyph = *glyphIt;
 		
+		kernTable.Reset ();
+		
 		// iterate over just the new glyphs; check each one against old glyphs for kerning info
 		for ( MOAIGlyph* glyphIt2 = glyphSet.mGlyphs; glyphIt2; glyphIt2 = glyphIt2->mNext ) {
 			MOAIGlyph& glyph2 = *glyphIt2;
 			
 			MOAIKernVec kernVec;
 			if ( this->mReader->GetKernVec ( glyph, glyph2, kernVec )) {
-				assert ( kernTableSize < MOAIGlyph::MAX_KERN_TABLE_SIZE );
-				kernTable [ kernTableSize++ ] = kernVec;
+				kernTable.Push ( kernVec );
 			}
 		}
 		
 		// init (or clear) the kern table
+		u32 kernTableSize = kernTable.GetTop ();
 		glyph.mKernTable.Resize ( kernTableSize );
 		
 		// copy in the new kern vecs (if any)
 		if ( kernTableSize ) {
-			memcpy ( glyph.mKernTable, kernTable, sizeof ( MOAIKernVec ) * kernTableSize );
+			memcpy ( glyph.mKernTable, kernTable.Data (), sizeof ( MOAIKernVec ) * kernTableSize );
 		}
 	}
+	glyphSet.mKernDirty = true;
 }
 
 //----------------------------------------------------------------//
@@ -590,6 +585,7 @@ void MOAIFont::RegisterLuaClass ( MOAILuaState& state ) {
 	
 	state.SetField ( -1, "DEFAULT_FLAGS",			( u32 )DEFAULT_FLAGS );
 	state.SetField ( -1, "FONT_AUTOLOAD_KERNING",	( u32 )FONT_AUTOLOAD_KERNING );
+	state.SetField ( -1, "FONT_ASYNC_RENDER",		( u32 )FONT_ASYNC_RENDER );
 }
 
 //----------------------------------------------------------------//
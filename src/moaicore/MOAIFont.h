@@ -57,8 +57,14 @@ class MOAITextureBase;
 			being rendered. The default behavior is to load kerning information automatically.
 			It is possible to prevent kerning information from being loaded. In this case,
 			kerning tables may be loaded manually if so desired.</p>
+			
+			<p>If FONT_ASYNC_RENDER is set and the font reader supports it, glyph metrics
+			are still loaded right away but the glyphs themselves are rendered on a
+			worker thread. Text using a glyph is laid out as usual, but the glyph isn't
+			drawn until its image has been copied into the glyph cache.</p>
 	
 	@const	FONT_AUTOLOAD_KERNING
+	@const	FONT_ASYNC_RENDER
 	@const	DEFAULT_FLAGS
 */
 class MOAIFont :
@@ -97,7 +103,7 @@ protected:
 	#endif
 
 	//----------------------------------------------------------------//
-	void				BuildKerning			( MOAIGlyph* glyphs, MOAIGlyph* pendingGlyphs );
+	void				BuildKerning			( MOAIGlyphSet& glyphSet, MOAIGlyph* glyphs, MOAIGlyph* pendingGlyphs );
 	void				RebuildKerning			( MOAIGlyphSet& glyphSet );
 
 public:
@@ -106,9 +112,11 @@ public:
 	
 	GET ( cc8*, Filename, mFilename );
 	GET ( MOAIGlyphCacheBase*, Cache, mCache );
+	GET ( u32, Flags, mFlags );
 	
 	enum {
 		FONT_AUTOLOAD_KERNING		= 0x01,
+		FONT_ASYNC_RENDER			= 0x02,
 	};
 	
 	static const u32 DEFAULT_FLAGS = FONT_AUTOLOAD_KERNING;
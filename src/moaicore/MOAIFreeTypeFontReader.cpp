@@ -5,8 +5,10 @@
 #include <moaicore/MOAIFont.h>
 #include <moaicore/MOAIFreeTypeFontReader.h>
 #include <moaicore/MOAIGlyphCacheBase.h>
+#include <moaicore/MOAIGlyphSet.h>
 #include <moaicore/MOAIImageTexture.h>
 #include <moaicore/MOAILogMessages.h>
+#include <moaicore/MOAISim.h>
 
 SUPPRESS_EMPTY_FILE_WARNING
 #if USE_FREETYPE
@@ -22,6 +24,47 @@ public:
 	int			mPenY;
 };
 
+//================================================================//
+// BitmapParams
+//================================================================//
+class BitmapParams {
+public:
+
+	u8*			mBitmap;
+	int			mWidth;
+	int			mHeight;
+	int			mPenX;
+	int			mPenY;
+};
+
+//----------------------------------------------------------------//
+static void _renderBitmapSpan ( const int y, const int count, const FT_Span* const spans, void* const user ) {
+
+	if ( !user ) return;
+	
+	BitmapParams* render = ( BitmapParams* )user;
+
+	int line = render->mPenY - y;
+	if (( line < 0 ) || ( line >= render->mHeight )) return;
+	
+	u8* row = &render->mBitmap [ line * render->mWidth ];
+
+	for ( int i = 0; i < count; ++i ) {
+		
+		const FT_Span& span = spans [ i ];
+		
+		int x0 = render->mPenX + span.x;
+		int x1 = x0 + span.len;
+		
+		x0 = x0 < 0 ? 0 : x0;
+		x1 = x1 > render->mWidth ? render->mWidth : x1;
+		
+		if ( x0 < x1 ) {
+			memset ( &row [ x0 ], span.coverage, x1 - x0 );
+		}
+	}
+}
+
 //----------------------------------------------------------------//
 static void _renderSpan ( const int y, const int count, const FT_Span* const spans, void* const user ) {
 
@@ -47,14 +90,139 @@ static void _renderSpan ( const int y, const int count, const FT_Span* const spa
 	}
 }
 
+//================================================================//
+// MOAIGlyphRenderTask
+//================================================================//
+
+//----------------------------------------------------------------//
+void MOAIGlyphRenderTask::Execute () {
+
+	this->mBitmap.Init ( this->mBitmapSize );
+	this->mBitmap.Fill ( 0 );
+
+	FT_Face face = this->mReader->AffirmRenderFace ( this->mFilename );
+	if ( !face ) return;
+	
+	FT_Library library = this->mReader->mRenderLibrary;
+
+	BitmapParams render;
+	FT_Raster_Params params;
+	memset ( &params, 0, sizeof ( params ));
+	params.flags = FT_RASTER_FLAG_AA | FT_RASTER_FLAG_DIRECT;
+	params.gray_spans = _renderBitmapSpan;
+	params.user = &render;
+
+	float size = 0.0f;
+
+	u32 totalGlyphs = this->mGlyphs.GetTop ();
+	for ( u32 i = 0; i < totalGlyphs; ++i ) {
+		MOAIGlyphRaster& raster = this->mGlyphs [ i ];
+		
+		if ( raster.mSize != size ) {
+			size = raster.mSize;
+			FT_Set_Char_Size ( face, 0, ( u32 )( size * 64.0f ), DPI, DPI );
+		}
+		
+		u32 index = FT_Get_Char_Index ( face, raster.mCode );
+		FT_Load_Glyph ( face, index, FT_LOAD_NO_BITMAP );
+		
+		if ( face->glyph->format != FT_GLYPH_FORMAT_OUTLINE ) continue;
+		
+		render.mBitmap = &this->mBitmap [ raster.mOffset ];
+		render.mWidth = raster.mWidth;
+		render.mHeight = raster.mHeight;
+		render.mPenX = -raster.mBearingX;
+		render.mPenY = raster.mBearingY;
+		
+		FT_Outline_Render ( library, &face->glyph->outline, &params );
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAIGlyphRenderTask::Init ( MOAIFreeTypeFontReader& reader, MOAIFont& font ) {
+
+	this->mReader = &reader;
+	this->mFont = &font;
+	this->mFilename = font.GetFilename ();
+	
+	// the font has to outlive the task
+	this->mFont->Retain ();
+}
+
+//----------------------------------------------------------------//
+MOAIGlyphRenderTask::MOAIGlyphRenderTask () :
+	mReader ( 0 ),
+	mFont ( 0 ),
+	mBitmapSize ( 0 ) {
+}
+
+//----------------------------------------------------------------//
+MOAIGlyphRenderTask::~MOAIGlyphRenderTask () {
+
+	if ( this->mFont ) {
+		this->mFont->Release ();
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAIGlyphRenderTask::PushGlyph ( const MOAIGlyphRaster& raster ) {
+
+	MOAIGlyphRaster top = raster;
+	top.mOffset = this->mBitmapSize;
+	this->mGlyphs.Push ( top );
+	
+	this->mBitmapSize += ( u32 )( raster.mWidth * raster.mHeight );
+}
+
+//----------------------------------------------------------------//
+void MOAIGlyphRenderTask::Render () {
+
+	this->Start ();
+}
+
 //================================================================//
 // MOAIFreeTypeFontReader
 //================================================================//
 
+//----------------------------------------------------------------//
+FT_Face MOAIFreeTypeFontReader::AffirmRenderFace ( cc8* filename ) {
+
+	if ( this->mRenderFace && ( this->mRenderFilename == filename )) return this->mRenderFace;
+	
+	// the font was loaded from another file since the last batch
+	if ( this->mRenderFace ) {
+		FT_Done_Face ( this->mRenderFace );
+		this->mRenderFace = 0;
+	}
+	
+	if ( !this->mRenderLibrary ) {
+		if ( FT_Init_FreeType ( &this->mRenderLibrary )) {
+			this->mRenderLibrary = 0;
+			return 0;
+		}
+	}
+	
+	if ( FT_New_Face ( this->mRenderLibrary, filename, 0, &this->mRenderFace )) {
+		this->mRenderFace = 0;
+		return 0;
+	}
+	
+	this->mRenderFilename = filename;
+	return this->mRenderFace;
+}
+
 //----------------------------------------------------------------//
 void MOAIFreeTypeFontReader::CloseFont () {
 
 	assert ( this->mFace );
+	
+	if ( this->mRenderTask ) {
+	
+		// hold on to the reader until the task has been published
+		this->Retain ();
+		this->mRenderTask->Render ();
+		this->mRenderTask = 0;
+	}
 
 	FT_Done_Face ( this->mFace );
 	FT_Done_FreeType ( this->mLibrary );
@@ -98,7 +266,11 @@ bool MOAIFreeTypeFontReader::HasKerning () {
 MOAIFreeTypeFontReader::MOAIFreeTypeFontReader () :
 	mLibrary ( 0 ),
 	mFace ( 0 ),
-	mFaceHeight ( 0.0f ) {
+	mFaceSize ( 0.0f ),
+	mFaceHeight ( 0.0f ),
+	mRenderTask ( 0 ),
+	mRenderLibrary ( 0 ),
+	mRenderFace ( 0 ) {
 	
 	RTTI_BEGIN
 		RTTI_EXTEND ( MOAIFontReader )
@@ -107,6 +279,54 @@ MOAIFreeTypeFontReader::MOAIFreeTypeFontReader () :
 
 //----------------------------------------------------------------//
 MOAIFreeTypeFontReader::~MOAIFreeTypeFontReader () {
+
+	// safe on the main thread: the reader is retained until all of its render tasks are published
+	if ( this->mRenderFace ) {
+		FT_Done_Face ( this->mRenderFace );
+	}
+	
+	if ( this->mRenderLibrary ) {
+		FT_Done_FreeType ( this->mRenderLibrary );
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAIFreeTypeFontReader::OnGlyphsRendered ( MOAIGlyphRenderTask* task ) {
+
+	MOAIFont& font = *task->mFont;
+	MOAIGlyphCacheBase* glyphCache = font.GetCache ();
+	bool useCache = glyphCache && glyphCache->IsDynamic ();
+
+	u32 totalGlyphs = task->mGlyphs.GetTop ();
+	for ( u32 i = 0; i < totalGlyphs; ++i ) {
+		MOAIGlyphRaster& raster = task->mGlyphs [ i ];
+		
+		// the font may have been reloaded while the task was running
+		MOAIGlyphSet* glyphSet = font.GetGlyphSet ( raster.mSize );
+		if ( !( glyphSet && ( glyphSet->GetSize () == raster.mSize ))) continue;
+		
+		MOAIGlyph* glyph = glyphSet->GetGlyph ( raster.mCode );
+		if ( !glyph || glyph->mReady ) continue;
+		
+		glyph->mReady = true;
+		if ( !useCache ) continue;
+		
+		MOAIImage* image = glyphCache->GetGlyphImage ( *glyph );
+		if ( !image ) continue;
+		
+		const u8* bitmap = &task->mBitmap [ raster.mOffset ];
+		for ( int y = 0; y < raster.mHeight; ++y ) {
+			for ( int x = 0; x < raster.mWidth; ++x, ++bitmap ) {
+				if ( *bitmap ) {
+					image->SetPixel ( glyph->mSrcX + x, glyph->mSrcY + y, *bitmap );
+				}
+			}
+		}
+		
+		// dirty regions on a page are merged and uploaded once when the page is next bound
+		glyphCache->InvalidateGlyph ( *glyph );
+	}
+	this->Release ();
 }
 
 //----------------------------------------------------------------//
@@ -172,6 +392,28 @@ void MOAIFreeTypeFontReader::RenderGlyph ( MOAIFont& font, MOAIGlyph& glyph ) {
 	if ( useCache ) {
 		glyphCache->PlaceGlyph ( font, glyph );
 		
+		if ( font.GetFlags () & MOAIFont::FONT_ASYNC_RENDER ) {
+			
+			// metrics and placement are needed for layout now; the pixels can wait
+			if ( !this->mRenderTask ) {
+				this->mRenderTask = MOAISim::Get ().GetGlyphThread ().NewTask < MOAIGlyphRenderTask >();
+				this->mRenderTask->SetDelegate ( this, &MOAIFreeTypeFontReader::OnGlyphsRendered );
+				this->mRenderTask->Init ( *this, font );
+			}
+			
+			MOAIGlyphRaster raster;
+			raster.mSize = this->mFaceSize;
+			raster.mCode = glyph.mCode;
+			raster.mWidth = glyphWidth + 2;
+			raster.mHeight = ( int )this->mFaceHeight + 2;
+			raster.mBearingX = bearingX;
+			raster.mBearingY = bearingY;
+			
+			this->mRenderTask->PushGlyph ( raster );
+			glyph.mReady = false;
+			return;
+		}
+		
 		MOAIImage* image = glyphCache->GetGlyphImage ( glyph );
 		if ( image ) {
 			
@@ -180,6 +422,7 @@ void MOAIFreeTypeFontReader::RenderGlyph ( MOAIFont& font, MOAIGlyph& glyph ) {
 			render.mPenY = glyph.mSrcY + bearingY;
 			
 			FT_Outline_Render ( this->mLibrary, &face->glyph->outline, &params );
+			glyphCache->InvalidateGlyph ( glyph );
 		}
 	}
 }
@@ -199,6 +442,7 @@ void MOAIFreeTypeFontReader::SerializeOut ( MOAILuaState& state, MOAISerializer&
 //----------------------------------------------------------------//
 void MOAIFreeTypeFontReader::SetFaceSize ( float size ) {
 
+	this->mFaceSize = size;
 	FT_Set_Char_Size ( this->mFace, 0, ( u32 )( size * 64.0f ), DPI, DPI );
 
 	int yMin = FT_MulFix ( this->mFace->bbox.yMin, this->mFace->size->metrics.y_scale ) >> 6;
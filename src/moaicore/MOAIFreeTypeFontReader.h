@@ -13,6 +13,59 @@
 
 #include <moaicore/MOAIFontReader.h>
 
+class MOAIFreeTypeFontReader;
+
+//================================================================//
+// MOAIGlyphRaster
+//================================================================//
+class MOAIGlyphRaster {
+private:
+
+	friend class MOAIFreeTypeFontReader;
+	friend class MOAIGlyphRenderTask;
+
+	float		mSize;
+	u32			mCode;
+	int			mWidth;		// width of the glyph's slot in the cache
+	int			mHeight;	// height of the glyph's slot in the cache
+	int			mBearingX;
+	int			mBearingY;
+	u32			mOffset;	// start of the glyph's pixels in the task's bitmap
+};
+
+//================================================================//
+// MOAIGlyphRenderTask
+//================================================================//
+// Renders glyphs on MOAISim's glyph thread using the FreeType library and
+// face its reader keeps open for the glyph thread. Each glyph is rendered into a bitmap the size of its
+// slot in the glyph cache; the bitmaps are copied into the cache when the
+// task is published on the main thread.
+class MOAIGlyphRenderTask :
+	public USTask < MOAIGlyphRenderTask > {
+private:
+
+	friend class MOAIFreeTypeFontReader;
+
+	MOAIFreeTypeFontReader*				mReader;
+	MOAIFont*							mFont;
+	STLString							mFilename;
+	USLeanStack < MOAIGlyphRaster, 64 >	mGlyphs;
+	USLeanArray < u8 >					mBitmap;
+	u32									mBitmapSize;
+
+	//----------------------------------------------------------------//
+	void			Execute					();
+
+public:
+
+	//----------------------------------------------------------------//
+	void			Init					( MOAIFreeTypeFontReader& reader, MOAIFont& font );
+					MOAIGlyphRenderTask		();
+					~MOAIGlyphRenderTask	();
+	void			PushGlyph				( const MOAIGlyphRaster& raster );
+	void			Render					();
+};
+
 //================================================================//
 // MOAIFreeTypeFontReader
 //================================================================//
@@ -24,9 +77,23 @@ class MOAIFreeTypeFontReader :
 	public MOAIFontReader {
 private:
 
+	friend class MOAIGlyphRenderTask;
+
 	FT_Library		mLibrary;
 	FT_Face			mFace;
+	float			mFaceSize;
 	float			mFaceHeight;
+	
+	MOAIGlyphRenderTask*	mRenderTask; // glyphs to render on the glyph thread once the font is closed
+
+	// only touched on the glyph thread; kept open between batches
+	FT_Library		mRenderLibrary;
+	FT_Face			mRenderFace;
+	STLString		mRenderFilename;
+
+	//----------------------------------------------------------------//
+	FT_Face			AffirmRenderFace			( cc8* filename );
+	void			OnGlyphsRendered			( MOAIGlyphRenderTask* task );
 
 public:
 	
@@ -8,9 +8,11 @@
 #include <moaicore/MOAIGfxResource.h>
 #include <moaicore/MOAILogMessages.h>
 #include <moaicore/MOAIMultiTexture.h>
+#include <moaicore/MOAIRenderMgr.h>
 #include <moaicore/MOAIShader.h>
 #include <moaicore/MOAIShaderMgr.h>
 #include <moaicore/MOAISim.h>
+#include <moaicore/MOAITexture.h>
 #include <moaicore/MOAITextureBase.h>
 #include <moaicore/MOAIVertexFormat.h>
 #include <moaicore/MOAIVertexFormatMgr.h>
@@ -72,6 +74,52 @@ int MOAIGfxDevice::_getMaxTextureUnits ( lua_State* L ) {
 	return 1;
 }
 
+//----------------------------------------------------------------//
+/**	@name	getTextureResidency
+	@text	Returns texture memory use against the budget set with
+			setTextureBudget, along with how many evictable textures
+			are on the GPU, how many are evicted and waiting to be
+			bound again, how many evictions there have been in total
+			and how much of the memory in use could be evicted.
+
+	@out	number bytes
+	@out	number budget			0 if there is no budget.
+	@out	number residentTextures
+	@out	number evictedTextures
+	@out	number evictions
+	@out	number evictableBytes	The part of bytes counted against the budget.
+*/
+int MOAIGfxDevice::_getTextureResidency ( lua_State* L ) {
+
+	MOAIGfxDevice& gfxDevice = MOAIGfxDevice::Get ();
+	
+	u32 resident = 0;
+	u32 evicted = 0;
+	size_t evictable = 0;
+	
+	ResourceIt resourceIt = gfxDevice.mResources.Head ();
+	for ( ; resourceIt; resourceIt = resourceIt->Next ()) {
+		MOAIGfxResource* resource = resourceIt->Data ();
+		
+		if ( resource->mState == MOAIGfxResource::STATE_EVICTED ) {
+			evicted++;
+		}
+		else if ( resource->IsResident () && resource->GetEvictableSize ()) {
+			evictable += resource->GetEvictableSize ();
+			resident++;
+		}
+	}
+	
+	lua_pushnumber ( L, gfxDevice.mTextureMemoryUsage );
+	lua_pushnumber ( L, gfxDevice.mTextureBudget );
+	lua_pushnumber ( L, resident );
+	lua_pushnumber ( L, evicted );
+	lua_pushnumber ( L, gfxDevice.mEvictionCount );
+	lua_pushnumber ( L, evictable );
+	
+	return 6;
+}
+
 //----------------------------------------------------------------//
 /**	@name	getViewSize
 	@text	Returns the width and height of the view
@@ -229,14 +277,94 @@ int MOAIGfxDevice::_setPointSize ( lua_State* L ) {
 	return 0;
 }
 
+//----------------------------------------------------------------//
+/**	@name	setTextureBudget
+	@text	Sets how much memory renewable textures (loaded from a file,
+			image or data) may use at the end of a frame. Other textures,
+			such as frame buffers and font pages, can't be evicted and
+			don't count against the budget. Over budget, textures are
+			evicted starting with the one bound longest ago, but only
+			once they have gone unbound for minAge frames, so textures
+			drawn every few frames or just uploaded stay resident. An
+			evicted texture is reloaded the next time it is bound;
+			textures loaded from files come back in the background and
+			are not drawn until they are uploaded.
+
+	@opt	number bytes		Default value is 0, for no limit.
+	@opt	number minAge		Default value is 8.
+	@out	nil
+*/
+int MOAIGfxDevice::_setTextureBudget ( lua_State* L ) {
+
+	MOAILuaState state ( L );
+
+	MOAIGfxDevice& gfxDevice = MOAIGfxDevice::Get ();
+
+	gfxDevice.mTextureBudget = state.GetValue < u32 >( 1, 0 );
+	gfxDevice.mEvictionAge = state.GetValue < u32 >( 2, DEFAULT_EVICTION_AGE );
+	return 0;
+}
+
+//----------------------------------------------------------------//
+/**	@name	setTextureUploadBudget
+	@text	Sets how many bytes of asynchronously loaded texture data
+			may be sent to the GPU each frame. At least one texture is
+			uploaded per frame, however large it is.
+
+	@opt	number bytes		Default value is 2MB. Pass 0 for no limit.
+	@out	nil
+*/
+int MOAIGfxDevice::_setTextureUploadBudget ( lua_State* L ) {
+
+	MOAILuaState state ( L );
+
+	MOAIGfxDevice::Get ().mUploadBudget = state.GetValue < u32 >( 1, DEFAULT_UPLOAD_BUDGET );
+	return 0;
+}
+
 //================================================================//
 // MOAIGfxDevice
 //================================================================//
 
+//----------------------------------------------------------------//
+void MOAIGfxDevice::AffirmQuadIndices () {
+
+	if ( !this->mQuadIndices.Size ()) {
+	
+		this->mQuadIndices.Init ( MAX_QUADS * 6 );
+		
+		// matches the vertex order written by TransformAndWriteQuad
+		for ( u32 i = 0; i < MAX_QUADS; ++i ) {
+		
+			u16* indices = &this->mQuadIndices [ i * 6 ];
+			u16 base = ( u16 )( i * 4 );
+			
+			indices [ 0 ] = base;
+			indices [ 1 ] = base + 3;
+			indices [ 2 ] = base + 2;
+			indices [ 3 ] = base;
+			indices [ 4 ] = base + 2;
+			indices [ 5 ] = base + 1;
+		}
+	}
+	
+	if ( this->mUseVertexBuffers && !this->mQuadIndexBufferID ) {
+	
+		glGenBuffers ( 1, &this->mQuadIndexBufferID );
+		if ( this->mQuadIndexBufferID ) {
+		
+			glBindBuffer ( GL_ELEMENT_ARRAY_BUFFER, this->mQuadIndexBufferID );
+			glBufferData ( GL_ELEMENT_ARRAY_BUFFER, this->mQuadIndices.Size () * sizeof ( u16 ), this->mQuadIndices.Data (), GL_STATIC_DRAW );
+			glBindBuffer ( GL_ELEMENT_ARRAY_BUFFER, 0 );
+		}
+	}
+}
+
 //----------------------------------------------------------------//
 void MOAIGfxDevice::BeginDrawing () {
 
 	mDrawCount = 0;
+	mUploadSize = 0;
 
 	if ( this->mClearFlags & GL_COLOR_BUFFER_BIT ) {
 	
@@ -320,6 +448,10 @@ void MOAIGfxDevice::BeginPrim () {
 		u32 primBytes = this->mPrimSize * this->mVertexFormat->GetVertexSize ();
 
 		this->mMaxPrims = ( u32 )( this->mSize / primBytes );
+		
+		if (( this->mPrimType == PRIM_QUADS ) && ( this->mMaxPrims > MAX_QUADS )) {
+			this->mMaxPrims = MAX_QUADS;
+		}
 		this->mPrimTop = this->mTop + primBytes;
 	}
 }
@@ -334,6 +466,16 @@ void MOAIGfxDevice::BeginPrim ( u32 primType ) {
 //----------------------------------------------------------------//
 void MOAIGfxDevice::Clear () {
 
+	if ( this->mVertexBufferID ) {
+		this->PushDeleter ( MOAIGfxDeleter::DELETE_BUFFER, this->mVertexBufferID );
+		this->mVertexBufferID = 0;
+	}
+	
+	if ( this->mQuadIndexBufferID ) {
+		this->PushDeleter ( MOAIGfxDeleter::DELETE_BUFFER, this->mQuadIndexBufferID );
+		this->mQuadIndexBufferID = 0;
+	}
+
 	this->ProcessDeleters ();
 
 	if ( this->mBuffer ) {
@@ -369,6 +511,7 @@ void MOAIGfxDevice::ClearErrors () {
 void MOAIGfxDevice::DetectContext () {
 
 	this->mHasContext = true;
+	this->mContextID++;
 
 	#ifdef __GLEW_H__
 		static bool initGlew = true;
@@ -406,6 +549,20 @@ void MOAIGfxDevice::DetectContext () {
 	this->mIsProgrammable = ( this->mMajorVersion >= 2 );
 	this->mIsFramebufferSupported = true;
 	
+	// buffer objects are core in GL 1.5 and GLES 1.1
+	if ( this->mIsOpenGLES ) {
+		this->mUseVertexBuffers = (( this->mMajorVersion > 1 ) || ( this->mMinorVersion >= 1 ));
+	}
+	else {
+		this->mUseVertexBuffers = (( this->mMajorVersion > 1 ) || ( this->mMinorVersion >= 5 ));
+	}
+	
+	// any buffers we had belonged to the old context
+	this->mVertexBufferID = 0;
+	this->mVertexBufferSize = 0;
+	this->mVertexBufferCursor = 0;
+	this->mQuadIndexBufferID = 0;
+	
 	#if defined ( __GLEW_H__ )
 	
 		// if framebuffer object is not in code, check to see if it's available as
@@ -469,8 +626,38 @@ void MOAIGfxDevice::DrawPrims () {
 		if ( vertexSize ) {
 			u32 count = this->mPrimSize ? this->mPrimCount * this->mPrimSize : ( u32 )( this->mTop / vertexSize );
 			if ( count > 0 ) {
-				glDrawArrays ( this->mPrimType, 0, count );
+				
+				size_t base = this->UploadPrims ( count * vertexSize );
+				
+				// with a buffer object bound the format's pointers are offsets into it. nothing
+				// else draws from mBuffer, so the client pointers don't need to be restored after.
+				if ( this->mUseVertexBuffers ) {
+					this->mVertexFormat->Bind (( void* )base );
+				}
+				
+				if ( this->mPrimType == PRIM_QUADS ) {
+				
+					this->AffirmQuadIndices ();
+					
+					// unbound right after so anything drawing with client side index arrays,
+					// the host app included, doesn't have them read as offsets into it
+					if ( this->mQuadIndexBufferID ) {
+						glBindBuffer ( GL_ELEMENT_ARRAY_BUFFER, this->mQuadIndexBufferID );
+						glDrawElements ( GL_TRIANGLES, this->mPrimCount * 6, GL_UNSIGNED_SHORT, 0 );
+						glBindBuffer ( GL_ELEMENT_ARRAY_BUFFER, 0 );
+					}
+					else {
+						glDrawElements ( GL_TRIANGLES, this->mPrimCount * 6, GL_UNSIGNED_SHORT, this->mQuadIndices.Data ());
+					}
+				}
+				else {
+					glDrawArrays ( this->mPrimType, 0, count );
+				}
 				this->mDrawCount++;
+				
+				if ( this->mUseVertexBuffers ) {
+					glBindBuffer ( GL_ARRAY_BUFFER, 0 );
+				}
 			}
 		}
 	}
@@ -499,6 +686,35 @@ void MOAIGfxDevice::DrawPrims () {
 //	}
 //}
 
+//----------------------------------------------------------------//
+void MOAIGfxDevice::DrawQuadBuffer ( const MOAIVertexFormat& format, GLuint bufferID, u32 totalQuads ) {
+
+	if ( !( bufferID && totalQuads )) return;
+	if ( totalQuads > MAX_QUADS ) return;
+
+	// flushes anything pending and forgets the current format; the next
+	// SetVertexFormat () rebinds it against the staging buffer
+	this->SetVertexFormat ();
+
+	this->AffirmQuadIndices ();
+
+	glBindBuffer ( GL_ARRAY_BUFFER, bufferID );
+	format.Bind ( 0 );
+
+	if ( this->mQuadIndexBufferID ) {
+		glBindBuffer ( GL_ELEMENT_ARRAY_BUFFER, this->mQuadIndexBufferID );
+		glDrawElements ( GL_TRIANGLES, totalQuads * 6, GL_UNSIGNED_SHORT, 0 );
+		glBindBuffer ( GL_ELEMENT_ARRAY_BUFFER, 0 );
+	}
+	else {
+		glDrawElements ( GL_TRIANGLES, totalQuads * 6, GL_UNSIGNED_SHORT, this->mQuadIndices.Data ());
+	}
+	this->mDrawCount++;
+
+	format.Unbind ();
+	glBindBuffer ( GL_ARRAY_BUFFER, 0 );
+}
+
 //----------------------------------------------------------------//
 void MOAIGfxDevice::EndPrim () {
 
@@ -507,9 +723,58 @@ void MOAIGfxDevice::EndPrim () {
 	}
 	++this->mPrimCount;
 	
-	if (( this->mPrimSize == 0 ) || ( this->mPrimCount >= this->mMaxPrims )) {
+	if ( this->mPrimSize == 0 ) {
 		this->Flush ();
 	}
+	else if ( this->mPrimCount >= this->mMaxPrims ) {
+		this->Flush ();
+		this->GrowBuffer ();
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAIGfxDevice::EvictResources () {
+
+	if ( !this->mTextureBudget ) return;
+	if ( this->mTextureMemoryUsage <= this->mTextureBudget ) return;
+	
+	u32 renderCount = MOAIRenderMgr::Get ().GetRenderCounter ();
+	
+	// only evictable textures count against the budget; evicting can't bring the rest down
+	size_t evictable = 0;
+	
+	this->mEvictionQueue.Reset ();
+	
+	ResourceIt resourceIt = this->mResources.Head ();
+	for ( ; resourceIt; resourceIt = resourceIt->Next ()) {
+		MOAIGfxResource* resource = resourceIt->Data ();
+		
+		if ( !( resource->IsResident () && resource->GetEvictableSize ())) continue;
+		evictable += resource->GetEvictableSize ();
+		
+		// too recently bound (or created); evicting it would likely mean reloading it within a few frames
+		if (( renderCount - resource->mLastRenderCount ) < this->mEvictionAge ) continue;
+		
+		USRadixKey32 < MOAIGfxResource* > key;
+		key.mKey = resource->mLastRenderCount;
+		key.mData = resource;
+		this->mEvictionQueue.Push ( key );
+	}
+	
+	u32 total = this->mEvictionQueue.GetTop ();
+	RadixSort32 < USRadixKey32 < MOAIGfxResource* > >( this->mEvictionQueue.Data (), total );
+	
+	for ( u32 i = 0; ( i < total ) && ( evictable > this->mTextureBudget ); ++i ) {
+	
+		MOAIGfxResource* resource = this->mEvictionQueue [ i ].mData;
+		size_t size = resource->GetEvictableSize ();
+		
+		if ( resource->Evict ()) {
+			evictable -= size;
+			this->mEvictionCount++;
+		}
+	}
+	this->mEvictionQueue.Reset ();
 }
 
 //----------------------------------------------------------------//
@@ -552,6 +817,23 @@ cc8* MOAIGfxDevice::GetErrorString ( int error ) const {
 	return "";
 }
 
+//----------------------------------------------------------------//
+void MOAIGfxDevice::GrowBuffer () {
+
+	// only called right after a flush, when a run of prims outgrew the buffer
+	if ( this->mTop || ( this->mSize >= MAX_BUFFER_SIZE )) return;
+	
+	bool rebind = ( this->mVertexFormat && ( this->mVertexFormatBuffer == this->mBuffer ));
+	
+	free ( this->mBuffer );
+	this->Reserve ( this->mSize << 1 );
+	
+	if ( rebind ) {
+		this->mVertexFormat->Bind ( this->mBuffer );
+		this->mVertexFormatBuffer = this->mBuffer;
+	}
+}
+
 //----------------------------------------------------------------//
 u32 MOAIGfxDevice::GetHeight () const {
 
@@ -727,7 +1009,10 @@ MOAIGfxDevice::MOAIGfxDevice () :
 	mCpuUVTransform ( false ),
 	mDefaultFrameBuffer ( 0 ),
 	mDeviceScale ( 1.0f ),
+	mDrawCount ( 0 ),
+	mUploadSize ( 0 ),
 	mHasContext ( false ),
+	mContextID ( 0 ),
 	mIsFramebufferSupported ( 0 ),
 	mIsOpenGLES ( false ),
 	mIsProgrammable ( false ),
@@ -741,6 +1026,10 @@ MOAIGfxDevice::MOAIGfxDevice () :
 	mPrimSize ( 0 ),
 	mPrimTop ( 0 ),
 	mPrimType ( 0xffffffff ),
+	mUploadBudget ( DEFAULT_UPLOAD_BUDGET ),
+	mTextureBudget ( 0 ),
+	mEvictionAge ( DEFAULT_EVICTION_AGE ),
+	mEvictionCount ( 0 ),
 	mShader ( 0 ),
 	mSize ( 0 ),
 	mActiveTextures ( 0 ),
@@ -755,7 +1044,12 @@ MOAIGfxDevice::MOAIGfxDevice () :
 	mVertexMtxOutput ( VTX_STAGE_MODEL ),
 	mWidth ( 0 ),
 	mHeight ( 0 ),
-	mLandscape ( 0 ) {
+	mLandscape ( 0 ),
+	mUseVertexBuffers ( false ),
+	mVertexBufferID ( 0 ),
+	mVertexBufferSize ( 0 ),
+	mVertexBufferCursor ( 0 ),
+	mQuadIndexBufferID ( 0 ) {
 	
 	RTTI_SINGLE ( MOAIGlobalEventSource )
 	
@@ -793,6 +1087,27 @@ void MOAIGfxDevice::ProcessDeleters () {
 	this->mDeleterStack.Reset ();
 }
 
+//----------------------------------------------------------------//
+void MOAIGfxDevice::ProcessUploads () {
+
+	size_t uploaded = 0;
+
+	while ( this->mPendingUploads.size ()) {
+		
+		MOAITexture* texture = this->mPendingUploads.front ();
+		size_t size = texture->GetUploadSize ();
+		
+		if ( uploaded && this->mUploadBudget && (( uploaded + size ) > this->mUploadBudget )) break;
+		
+		this->mPendingUploads.pop_front ();
+		
+		texture->Upload ();
+		texture->Release ();
+		
+		uploaded += size;
+	}
+}
+
 //----------------------------------------------------------------//
 void MOAIGfxDevice::PushDeleter ( u32 type, GLuint id ) {
 
@@ -803,6 +1118,13 @@ void MOAIGfxDevice::PushDeleter ( u32 type, GLuint id ) {
 	this->mDeleterStack.Push ( deleter );
 }
 
+//----------------------------------------------------------------//
+void MOAIGfxDevice::PushUpload ( MOAITexture& texture ) {
+
+	texture.Retain ();
+	this->mPendingUploads.push_back ( &texture );
+}
+
 //----------------------------------------------------------------//
 void MOAIGfxDevice::ReadFrameBuffer	( MOAIImage * img ) {
 
@@ -838,6 +1160,7 @@ void MOAIGfxDevice::RegisterLuaClass ( MOAILuaState& state ) {
 
 	luaL_Reg regTable [] = {
 		{ "getMaxTextureUnits",			_getMaxTextureUnits },
+		{ "getTextureResidency",		_getTextureResidency },
 		{ "getViewSize",				_getViewSize },
 		{ "isProgrammable",				_isProgrammable },
 		{ "setClearColor",				_setClearColor },
@@ -846,6 +1169,8 @@ void MOAIGfxDevice::RegisterLuaClass ( MOAILuaState& state ) {
 		{ "setPenColor",				_setPenColor },
 		{ "setPenWidth",				_setPenWidth },
 		{ "setPointSize",				_setPointSize },
+		{ "setTextureBudget",			_setTextureBudget },
+		{ "setTextureUploadBudget",		_setTextureUploadBudget },
 		{ NULL, NULL }
 	};
 
@@ -1208,6 +1533,10 @@ void MOAIGfxDevice::SetPrimType ( u32 primType ) {
 				this->mPrimSize = 3;
 				break;
 			
+			case PRIM_QUADS:
+				this->mPrimSize = 4;
+				break;
+			
 			case GL_POINTS:
 			case GL_LINE_LOOP:
 			case GL_LINE_STRIP:
@@ -1627,6 +1956,7 @@ void MOAIGfxDevice::TransformAndWriteQuad ( USVec4D* vtx, USVec2D* uv ) {
 		this->mUVTransform.TransformQuad ( uv );
 	}
 	
+	this->SetPrimType ( PRIM_QUADS );
 	this->BeginPrim ();
 	
 		// left top
@@ -1634,36 +1964,60 @@ void MOAIGfxDevice::TransformAndWriteQuad ( USVec4D* vtx, USVec2D* uv ) {
 		this->Write ( uv [ 0 ]);
 		this->WriteFinalColor4b ();
 		
-		// left bottom
-		this->Write ( vtx [ 3 ]);
-		this->Write ( uv [ 3 ]);
-		this->WriteFinalColor4b ();	
+		// right top
+		this->Write ( vtx [ 1 ]);
+		this->Write ( uv [ 1 ]);
+		this->WriteFinalColor4b ();
 	
 		// right bottom
 		this->Write ( vtx[ 2 ]);
 		this->Write ( uv [ 2 ]);
 		this->WriteFinalColor4b ();
 		
+		// left bottom
+		this->Write ( vtx [ 3 ]);
+		this->Write ( uv [ 3 ]);
+		this->WriteFinalColor4b ();
+		
 	this->EndPrim ();
+}
+
+//----------------------------------------------------------------//
+size_t MOAIGfxDevice::UploadPrims ( u32 size ) {
+
+	this->mUploadSize += size;
+
+	if ( this->mUseVertexBuffers && !this->mVertexBufferID ) {
 	
-	this->BeginPrim ();
+		glGenBuffers ( 1, &this->mVertexBufferID );
+		this->mVertexBufferSize = 0;
+		this->mVertexBufferCursor = 0;
+		
+		// fall back on client arrays
+		if ( !this->mVertexBufferID ) {
+			this->mUseVertexBuffers = false;
+		}
+	}
 	
-		// left top
-		this->Write ( vtx [ 0 ]);
-		this->Write ( uv [ 0 ]);
-		this->WriteFinalColor4b ();	
+	if ( !this->mUseVertexBuffers ) return ( size_t )this->mBuffer;
 	
-		// right bottom
-		this->Write ( vtx [ 2 ]);
-		this->Write ( uv [ 2 ]);
-		this->WriteFinalColor4b ();	
+	glBindBuffer ( GL_ARRAY_BUFFER, this->mVertexBufferID );
 	
-		// right top
-		this->Write ( vtx [ 1 ]);
-		this->Write ( uv [ 1 ]);
-		this->WriteFinalColor4b ();
+	u32 ringSize = this->mSize * VERTEX_RING_SEGMENTS;
+	u32 cursor = ( this->mVertexBufferCursor + 3 ) & ~3;
+	
+	if (( this->mVertexBufferSize != ringSize ) || (( cursor + size ) > ringSize )) {
 		
-	this->EndPrim ();
+		// orphan the old storage instead of waiting on draws that still read from it
+		glBufferData ( GL_ARRAY_BUFFER, ringSize, 0, GL_DYNAMIC_DRAW );
+		this->mVertexBufferSize = ringSize;
+		cursor = 0;
+	}
+	
+	glBufferSubData ( GL_ARRAY_BUFFER, cursor, size, this->mBuffer );
+	this->mVertexBufferCursor = cursor + size;
+	
+	return cursor;
 }
 
 //----------------------------------------------------------------//
@@ -15,6 +15,7 @@ class MOAIGfxResource;
 class MOAIGfxState;
 class MOAIMultiTexture;
 class MOAIShader;
+class MOAITexture;
 class MOAITextureBase;
 class MOAIVertexFormat;
 class MOAIViewport;
@@ -77,9 +78,18 @@ public:
 		TOTAL_EVENTS,
 	};
 	
+	// not a GL prim type; quads are written as four verts and drawn as indexed triangles
+	static const u32 PRIM_QUADS				= 0x10000;
+	
+	static const u32 MAX_QUADS				= 0x4000; // most quads addressable with 16-bit indices
+	
 private:
 	
 	static const u32 DEFAULT_BUFFER_SIZE	= 0x8000;
+	static const u32 MAX_BUFFER_SIZE		= 0x80000;
+	static const u32 VERTEX_RING_SEGMENTS	= 4; // size of the streaming vertex buffer in multiples of mSize
+	static const u32 DEFAULT_UPLOAD_BUDGET	= 0x200000;
+	static const u32 DEFAULT_EVICTION_AGE	= 8; // frames a texture has to go unbound before it can be evicted
 	
 	int				mCullFunc;	
 	int				mDepthFunc;
@@ -105,7 +115,9 @@ private:
 	float			mDeviceScale;
 
 	u32				mDrawCount;
+	u32				mUploadSize; // bytes of vertex data sent to the GPU this frame
 	bool			mHasContext;
+	u32				mContextID; // bumped whenever a new context is detected
 
 	bool			mIsFramebufferSupported;
 	bool			mIsOpenGLES;
@@ -131,6 +143,14 @@ private:
 	
 	typedef USLeanList < MOAIGfxResource* >::Iterator ResourceIt;
 	USLeanList < MOAIGfxResource* > mResources;
+	
+	STLList < MOAITexture* >	mPendingUploads;	// decoded textures waiting to be sent to the GPU
+	size_t						mUploadBudget;		// bytes of pending textures uploaded per frame; 0 for no limit
+	
+	size_t						mTextureBudget;		// evictable texture memory allowed before least recently bound textures are evicted; 0 for no limit
+	u32							mEvictionAge;		// frames a texture has to go unbound before it can be evicted
+	u32							mEvictionCount;
+	USLeanStack < USRadixKey32 < MOAIGfxResource* >, 64 > mEvictionQueue; // candidates keyed by the frame they were last bound
 
 	USRect			mScissorRect;
 	MOAIShader*		mShader;	
@@ -161,10 +181,20 @@ private:
 
 	USFrustum		mViewVolume;
 	
+	// streaming vertex buffer; each flush is appended to it until it fills, then it is orphaned
+	bool			mUseVertexBuffers;
+	GLuint			mVertexBufferID;
+	u32				mVertexBufferSize;
+	u32				mVertexBufferCursor;
+	
+	USLeanArray < u16 >	mQuadIndices;
+	GLuint				mQuadIndexBufferID;
+	
 	USLeanStack < MOAIGfxDeleter, 32 > mDeleterStack;
 
 	//----------------------------------------------------------------//
 	static int				_getMaxTextureUnits		( lua_State* L );
+	static int				_getTextureResidency	( lua_State* L );
 	static int				_getViewSize			( lua_State* L );
 	static int				_isProgrammable			( lua_State* L );
 	static int				_setClearColor			( lua_State* L );
@@ -172,15 +202,20 @@ private:
 	static int				_setPenColor			( lua_State* L );
 	static int				_setPenWidth			( lua_State* L );
 	static int				_setPointSize			( lua_State* L );
+	static int				_setTextureBudget		( lua_State* L );
+	static int				_setTextureUploadBudget	( lua_State* L );
 
 	//----------------------------------------------------------------//
+	void					AffirmQuadIndices		();
 	void					Clear					();
 	void					DrawPrims				();
+	void					GrowBuffer				();
 	void					GpuLoadMatrix			( const USMatrix4x4& mtx ) const;
 	void					GpuMultMatrix			( const USMatrix4x4& mtx ) const;
 	void					InsertGfxResource		( MOAIGfxResource& resource );
 	void					RemoveGfxResource		( MOAIGfxResource& resource );
 	void					TransformAndWriteQuad	( USVec4D* vtx, USVec2D* uv );
+	size_t					UploadPrims				( u32 size );
 	void					UpdateFinalColor		();
 	void					UpdateCpuVertexMtx		();
 	void					UpdateGpuVertexMtx		();
@@ -197,10 +232,12 @@ public:
 	GET ( size_t, TextureMemoryUsage, mTextureMemoryUsage )
 	GET ( u32, MaxTextureSize, mMaxTextureSize )
 	GET ( bool, HasContext, mHasContext )
+	GET ( u32, ContextID, mContextID )
 	
 	GET_BOOL ( IsOpenGLES, mIsOpenGLES )
 	GET_BOOL ( IsProgrammable, mIsProgrammable )
 	GET_BOOL ( IsFramebufferSupported, mIsFramebufferSupported )
+	GET_BOOL ( UsesVertexBuffers, mUseVertexBuffers )
 	
 	GET ( const USFrustum&, ViewVolume, mViewVolume )
 	
@@ -219,13 +256,16 @@ public:
 	
 	void					ClearErrors				();
 	void					DetectContext			();
+	void					DrawQuadBuffer			( const MOAIVertexFormat& format, GLuint bufferID, u32 totalQuads );
 	void					EndPrim					();
+	void					EvictResources			();
 	void					Flush					();
 	
 	const USMatrix4x4&		GetBillboardMtx			() const;
 	
 	float					GetDeviceScale			();
 	u32						GetDrawCount			() const { return mDrawCount; }
+	u32						GetUploadSize			() const { return mUploadSize; }
 	cc8*					GetErrorString			( int error ) const;
 	
 	u32						GetHeight				() const;
@@ -249,7 +289,9 @@ public:
 							~MOAIGfxDevice			();
 	
 	void					ProcessDeleters			();
+	void					ProcessUploads			();
 	void					PushDeleter				( u32 type, GLuint id );
+	void					PushUpload				( MOAITexture& texture );
 
 	void					ReadFrameBuffer			( MOAIImage * img );
 
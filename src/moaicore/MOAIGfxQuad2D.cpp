@@ -179,6 +179,12 @@ int MOAIGfxQuad2D::_transformUV ( lua_State* L ) {
 // MOAIGfxQuad2D
 //================================================================//
 
+//----------------------------------------------------------------//
+bool MOAIGfxQuad2D::CanRemapUVs () {
+
+	return true;
+}
+
 //----------------------------------------------------------------//
 USBox MOAIGfxQuad2D::ComputeMaxBounds () {
 	return this->GetItemBounds ( 0 );
@@ -195,7 +201,13 @@ void MOAIGfxQuad2D::DrawIndex ( u32 idx, float xOff, float yOff, float zOff, flo
 	gfxDevice.SetVertexMtxMode ( MOAIGfxDevice::VTX_STAGE_MODEL, MOAIGfxDevice::VTX_STAGE_PROJ );
 	gfxDevice.SetUVMtxMode ( MOAIGfxDevice::UV_STAGE_MODEL, MOAIGfxDevice::UV_STAGE_TEXTURE );
 	
-	this->mQuad.Draw ( xOff, yOff, zOff, xScl, yScl );
+	float uOff = 0.0f;
+	float vOff = 0.0f;
+	float uScale = 1.0f;
+	float vScale = 1.0f;
+	this->RemapUVs ( uOff, vOff, uScale, vScale );
+	
+	this->mQuad.Draw ( xOff, yOff, zOff, xScl, yScl, uOff, vOff, uScale, vScale );
 }
 
 //----------------------------------------------------------------//
@@ -221,6 +221,12 @@ int MOAIGfxQuadDeck2D::_transformUV ( lua_State* L ) {
 // MOAIGfxQuadDeck2D
 //================================================================//
 
+//----------------------------------------------------------------//
+bool MOAIGfxQuadDeck2D::CanRemapUVs () {
+
+	return true;
+}
+
 //----------------------------------------------------------------//
 USBox MOAIGfxQuadDeck2D::ComputeMaxBounds () {
 
@@ -249,8 +255,15 @@ void MOAIGfxQuadDeck2D::DrawIndex ( u32 idx, float xOff, float yOff, float zOff,
 
 	u32 size = this->mQuads.Size ();
 	if ( size ) {
+	
+		float uOff = 0.0f;
+		float vOff = 0.0f;
+		float uScale = 1.0f;
+		float vScale = 1.0f;
+		this->RemapUVs ( uOff, vOff, uScale, vScale );
+	
 		idx = ( idx - 1 ) % size;
-		this->mQuads [ idx ].Draw ( xOff, yOff, zOff, xScl, yScl );
+		this->mQuads [ idx ].Draw ( xOff, yOff, zOff, xScl, yScl, uOff, vOff, uScale, vScale );
 	}
 }
 
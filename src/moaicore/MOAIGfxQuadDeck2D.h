@@ -40,6 +40,7 @@ public:
 	DECL_LUA_FACTORY ( MOAIGfxQuadDeck2D )
 	
 	//----------------------------------------------------------------//
+	bool		CanRemapUVs				();
 	void		DrawIndex				( u32 idx, float xOff, float yOff, float zOff, float xScl, float yScl, float zScl );
 				MOAIGfxQuadDeck2D		();
 				~MOAIGfxQuadDeck2D		();
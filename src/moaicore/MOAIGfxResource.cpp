@@ -46,6 +46,39 @@ int MOAIGfxResource::_getAge ( lua_State* L ) {
 	return 1;
 }
 
+//----------------------------------------------------------------//
+/**	@name	getEvictionCount
+	@text	Returns the number of times the resource has been evicted
+			to keep MOAIGfxDevice under its texture budget.
+ 
+	@in		MOAIGfxResource self
+	@out	number evictions
+*/
+int MOAIGfxResource::_getEvictionCount ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAIGfxResource, "U" )
+
+	lua_pushnumber ( state, self->mEvictionCount );
+
+	return 1;
+}
+
+//----------------------------------------------------------------//
+/**	@name	isResident
+	@text	Returns true if the resource is on the GPU and ready to use.
+			An evicted resource is not resident until it has been bound
+			again and (for files loaded in the background) reloaded.
+ 
+	@in		MOAIGfxResource self
+	@out	boolean isResident
+*/
+int MOAIGfxResource::_isResident ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAIGfxResource, "U" )
+
+	lua_pushboolean ( state, self->IsResident ());
+
+	return 1;
+}
+
 //----------------------------------------------------------------//
 /**	@name	softRelease
 	@text	Attempt to release the resource. Generally this is used when
@@ -78,9 +111,16 @@ int MOAIGfxResource::_softRelease ( lua_State* L ) {
 //----------------------------------------------------------------//
 bool MOAIGfxResource::Affirm () {
 	
+	if ( this->mState == STATE_EVICTED ) {
+		this->OnReload ();
+	}
+	
 	if ( this->mState == STATE_PRECREATE ) {
 		this->OnCreate ();
 		this->mState = this->IsValid () ? STATE_READY : STATE_ERROR;
+		
+		// a resource created without being bound still counts as fresh for eviction
+		this->mLastRenderCount = MOAIRenderMgr::Get ().GetRenderCounter ();
 	}
 	return this->mState == STATE_READY;
 }
@@ -130,6 +170,21 @@ void MOAIGfxResource::Destroy () {
 	}
 }
 
+//----------------------------------------------------------------//
+bool MOAIGfxResource::Evict () {
+
+	if ( this->mState != STATE_READY ) return false;
+	if ( !( this->GetEvictableSize () && this->IsRenewable ())) return false;
+	
+	this->OnDestroy ();
+	this->OnInvalidate ();
+	
+	this->mState = STATE_EVICTED;
+	this->mEvictionCount++;
+	
+	return true;
+}
+
 //----------------------------------------------------------------//
 void MOAIGfxResource::Invalidate () {
 
@@ -145,6 +200,12 @@ void MOAIGfxResource::Invalidate () {
 	}
 }
 
+//----------------------------------------------------------------//
+bool MOAIGfxResource::IsResident () {
+
+	return this->mState == STATE_READY;
+}
+
 //----------------------------------------------------------------//
 void MOAIGfxResource::Load () {
 
@@ -163,7 +224,8 @@ void MOAIGfxResource::Load () {
 //----------------------------------------------------------------//
 MOAIGfxResource::MOAIGfxResource () :
 	mState ( STATE_PRECREATE ),
-	mLastRenderCount ( 0 ) {
+	mLastRenderCount ( 0 ),
+	mEvictionCount ( 0 ) {
 
 	RTTI_SINGLE ( MOAIGfxState )
 
@@ -180,6 +242,17 @@ MOAIGfxResource::~MOAIGfxResource () {
 	}
 }
 
+//----------------------------------------------------------------//
+void MOAIGfxResource::Refresh () {
+
+	if ( this->mState == STATE_READY ) {
+		this->mState = STATE_PRECREATE;
+	}
+	else {
+		this->Load ();
+	}
+}
+
 //----------------------------------------------------------------//
 void MOAIGfxResource::RegisterLuaClass ( MOAILuaState& state ) {
 	UNUSED ( state );
@@ -190,6 +263,8 @@ void MOAIGfxResource::RegisterLuaFuncs ( MOAILuaState& state ) {
 
 	luaL_Reg regTable [] = {
 		{ "getAge",					_getAge },
+		{ "getEvictionCount",		_getEvictionCount },
+		{ "isResident",				_isResident },
 		{ "softRelease",			_softRelease },
 		{ NULL, NULL }
 	};
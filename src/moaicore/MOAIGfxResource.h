@@ -40,10 +40,12 @@ private:
 		STATE_ERROR,
 		STATE_PRECREATE,
 		STATE_PRELOAD,
+		STATE_EVICTED,		// GPU-side resource dropped by MOAIGfxDevice's texture budget; reloaded when next bound
 	};
 
 	u32				mState;
 	u32				mLastRenderCount;
+	u32				mEvictionCount;
 	
 	MOAILuaLocal	mOnRenew;
 
@@ -51,6 +53,8 @@ private:
 
 	//----------------------------------------------------------------//
 	static int		_getAge						( lua_State* L );
+	static int		_getEvictionCount			( lua_State* L );
+	static int		_isResident					( lua_State* L );
 	static int		_softRelease				( lua_State* L );
 
 protected:
@@ -58,6 +62,7 @@ protected:
 	//----------------------------------------------------------------//
 	bool			Affirm						();
 	bool			Bind						();
+	virtual size_t	GetEvictableSize			() { return 0; } // GPU memory given back by evicting the resource; 0 if it can't be evicted - MAIN THREAD
 	bool			HasLoadScript				();
 	virtual bool	IsRenewable					() = 0; // return 'true' if resource has sufficient information to create GPU-side resource - MAIN THREAD
 	virtual void	OnBind						() = 0; // select GPU-side resource on device for use - GRAPHICS THREAD
@@ -66,6 +71,8 @@ protected:
 	virtual void	OnDestroy					() = 0; // destroy GPU-side resource - MAIN THREAD
 	virtual void	OnInvalidate				() = 0; // clear any handles or references to GPU-side resource - MAIN THREAD
 	virtual void	OnLoad						() = 0; // load or initialize any CPU-side resources required to create device resource - MAIN THREAD
+	virtual void	OnReload					() { this->Load (); } // bring an evicted resource back; may finish on a later frame - MAIN THREAD
+	void			Refresh						(); // call OnCreate again at next bind, keeping the GPU-side resource - MAIN THREAD
 
 public:
 
@@ -74,7 +81,9 @@ public:
 	//----------------------------------------------------------------//
 	void			Clear						();
 	void			Destroy						();
+	bool			Evict						();
 	void			Invalidate					();
+	bool			IsResident					();
 	virtual bool	IsValid						() = 0; // return 'true' if the handle to the GPU-side resource is valid (or initialized) - GRAPHICS THREAD
 	void			Load						();
 					MOAIGfxResource				();
@@ -93,6 +93,7 @@ MOAIGlyph::MOAIGlyph () :
 	mBearingY ( 0.0f ),
 	mSrcX ( 0 ),
 	mSrcY ( 0 ),
+	mReady ( true ),
 	mNext ( 0 ) {
 }
 
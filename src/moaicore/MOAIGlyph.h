@@ -25,8 +25,7 @@ public:
 class MOAIGlyph {
 private:
 	
-	static const u32 MAX_KERN_TABLE_SIZE	= 512;
-	static const u32 NULL_PAGE_ID			= 0xffffffff;
+	static const u32 NULL_PAGE_ID	= 0xffffffff;
 	
 	u32			mCode;
 	u32			mPageID; // ID of texture page in glyph cache
@@ -39,6 +38,7 @@ private:
 	
 	u32			mSrcX; // corresponds to glyph location on page
 	u32			mSrcY; // corresponds to glyph location on page
+	bool		mReady; // false while the glyph is being rendered off the main thread
 	
 	USLeanArray < MOAIKernVec > mKernTable;
 	
@@ -79,6 +79,13 @@ MOAIImage* MOAIGlyphCache::GetImage () {
 	return image;
 }
 
+//----------------------------------------------------------------//
+void MOAIGlyphCache::InvalidateGlyph ( MOAIGlyph& glyph ) {
+
+	assert ( glyph.GetPageID () < this->mPages.Size ());
+	this->mPages [ glyph.GetPageID ()]->InvalidateGlyph ( glyph );
+}
+
 //----------------------------------------------------------------//
 bool MOAIGlyphCache::IsDynamic () {
 
@@ -106,7 +113,6 @@ void MOAIGlyphCache::PlaceGlyph ( MOAIFont& font, MOAIGlyph& glyph ) {
 		MOAIGlyphCachePage* page = this->mPages [ i ];
 		MOAISpan < MOAIGlyph* >* span = page->Alloc ( font, glyph );
 		if ( span ) {
-			this->mPages [ i ]->mImageTexture->Invalidate ();
 			glyph.SetPageID ( i );
 			return;
 		}
@@ -53,6 +53,7 @@ public:
 	MOAIImage*			GetGlyphImage				( MOAIGlyph& glyph );
 	MOAITextureBase*	GetGlyphTexture				( MOAIGlyph& glyph );
 	MOAIImage*			GetImage					();
+	void				InvalidateGlyph				( MOAIGlyph& glyph );
 	bool				IsDynamic					();
 						MOAIGlyphCache				();
 						~MOAIGlyphCache				();
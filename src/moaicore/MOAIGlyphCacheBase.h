@@ -44,6 +44,7 @@ public:
 	virtual MOAIImage*			GetGlyphImage			( MOAIGlyph& glyph ) = 0;
 	virtual MOAITextureBase*	GetGlyphTexture			( MOAIGlyph& glyph ) = 0;
 	virtual MOAIImage*			GetImage				() = 0;
+	virtual void				InvalidateGlyph			( MOAIGlyph& glyph ) = 0; // glyph's pixels have been written to its image
 	virtual bool				IsDynamic				() = 0;
 								MOAIGlyphCacheBase		();
 								~MOAIGlyphCacheBase		();
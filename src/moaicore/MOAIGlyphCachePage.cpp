@@ -141,6 +141,22 @@ void MOAIGlyphCachePage::InitCanvas ( u32 width, u32 height, USColor::Format col
 	this->mImageTexture->Init ( width, height, colorFmt, pixelFmt );
 }
 
+//----------------------------------------------------------------//
+void MOAIGlyphCachePage::InvalidateGlyph ( MOAIGlyph& glyph ) {
+
+	if ( !this->mImageTexture ) return;
+
+	// same footprint Alloc reserved for the glyph
+	USIntRect rect;
+	rect.Init (
+		glyph.mSrcX,
+		glyph.mSrcY,
+		glyph.mSrcX + ( u32 )glyph.mWidth + 2,
+		glyph.mSrcY + ( u32 )glyph.mHeight + 2
+	);
+	this->mImageTexture->Invalidate ( rect );
+}
+
 //----------------------------------------------------------------//
 MOAIGlyphCachePage::MOAIGlyphCachePage () :
 	mImageTexture ( 0 ),
@@ -41,6 +41,7 @@ public:
 	void			Clear						();
 	bool			ExpandToNextPowerofTwo		();
 	void			InitCanvas					( u32 width, u32 height, USColor::Format colorFmt, USPixel::Format pixelFmt );
+	void			InvalidateGlyph				( MOAIGlyph& glyph );
 					MOAIGlyphCachePage			();
 					~MOAIGlyphCachePage			();
 };
@@ -8,40 +8,169 @@
 // MOAIGlyphSet
 //================================================================//
 
+//----------------------------------------------------------------//
+static inline u32 _hashKernPair ( u32 first, u32 second ) {
+
+	return ( first * 0x9e3779b1 ) ^ ( second * 0x85ebca6b );
+}
+
+//================================================================//
+// MOAIGlyphSet
+//================================================================//
+
 //----------------------------------------------------------------//
 const MOAIGlyph& MOAIGlyphSet::AffirmGlyph ( u32 c ) {
 
-	if ( !this->mGlyphMap.contains ( c )) {
+	MOAIGlyph* glyph = this->GetGlyph ( c );
+	if ( glyph ) return *glyph;
+	
+	MOAIGlyph& newGlyph = this->NewGlyph ( c );
+	newGlyph.mNext = this->mPending;
+	this->mPending = &newGlyph;
+	
+	return newGlyph;
+}
+
+//----------------------------------------------------------------//
+void MOAIGlyphSet::BuildKernPairs () {
+
+	this->mKernDirty = false;
+	this->mKernPairs.Clear ();
+
+	u32 totalPairs = 0;
+	
+	GlyphMapIt glyphMapIt = this->mGlyphMap.begin ();
+	for ( ; glyphMapIt != this->mGlyphMap.end (); ++glyphMapIt ) {
+		totalPairs += glyphMapIt->second.mKernTable.Size ();
+	}
+	
+	if ( !totalPairs ) return;
+	
+	u32 size = 16;
+	while ( size < ( totalPairs * 2 )) {
+		size <<= 1;
+	}
 	
-		MOAIGlyph& glyph = this->mGlyphMap [ c ];
-		glyph.mNext = this->mPending;
-		this->mPending = &glyph;
-		glyph.mCode = c;
+	MOAIKernPair empty;
+	empty.mFirst = NULL_CODE;
+	empty.mSecond = NULL_CODE;
+	empty.mKerning.Init ( 0.0f, 0.0f );
+	
+	this->mKernPairs.Init ( size );
+	this->mKernPairs.Fill ( empty );
+	
+	u32 mask = size - 1;
+	
+	glyphMapIt = this->mGlyphMap.begin ();
+	for ( ; glyphMapIt != this->mGlyphMap.end (); ++glyphMapIt ) {
 		
-		return glyph;
+		const MOAIGlyph& glyph = glyphMapIt->second;
+		u32 total = glyph.mKernTable.Size ();
+		
+		for ( u32 i = 0; i < total; ++i ) {
+			
+			const MOAIKernVec& kernVec = glyph.mKernTable [ i ];
+			u32 slot = _hashKernPair ( glyph.mCode, kernVec.mName ) & mask;
+			
+			// keep the first entry for a pair, as the linear scan of the kern table would
+			for ( ; this->mKernPairs [ slot ].mFirst != NULL_CODE; slot = ( slot + 1 ) & mask ) {
+				const MOAIKernPair& pair = this->mKernPairs [ slot ];
+				if (( pair.mFirst == glyph.mCode ) && ( pair.mSecond == kernVec.mName )) break;
+			}
+			
+			MOAIKernPair& pair = this->mKernPairs [ slot ];
+			if ( pair.mFirst == NULL_CODE ) {
+				pair.mFirst = glyph.mCode;
+				pair.mSecond = kernVec.mName;
+				pair.mKerning.Init ( kernVec.mX, kernVec.mY );
+			}
+		}
 	}
-	return this->mGlyphMap [ c ];
 }
 
 //----------------------------------------------------------------//
 MOAIGlyph& MOAIGlyphSet::EditGlyph ( u32 c ) {
 
-	if ( !this->mGlyphMap.contains ( c )) {
+	// the caller may be about to change the glyph's kern table
+	this->mKernDirty = true;
+
+	MOAIGlyph* glyph = this->GetGlyph ( c );
+	if ( glyph ) return *glyph;
 	
-		MOAIGlyph& glyph = this->mGlyphMap [ c ];
-		glyph.mNext = this->mGlyphs;
-		this->mGlyphs = &glyph;
-		glyph.mCode = c;
-		
-		return glyph;
+	MOAIGlyph& newGlyph = this->NewGlyph ( c );
+	newGlyph.mNext = this->mGlyphs;
+	this->mGlyphs = &newGlyph;
+	
+	return newGlyph;
+}
+
+//----------------------------------------------------------------//
+u32 MOAIGlyphSet::FindKernPair ( u32 first, u32 second ) const {
+
+	u32 size = this->mKernPairs.Size ();
+	if ( !size ) return NULL_CODE;
+	
+	u32 mask = size - 1;
+	u32 slot = _hashKernPair ( first, second ) & mask;
+	
+	for ( ; this->mKernPairs [ slot ].mFirst != NULL_CODE; slot = ( slot + 1 ) & mask ) {
+		const MOAIKernPair& pair = this->mKernPairs [ slot ];
+		if (( pair.mFirst == first ) && ( pair.mSecond == second )) return slot;
 	}
-	return this->mGlyphMap [ c ];
+	return NULL_CODE;
 }
 
 //----------------------------------------------------------------//
 MOAIGlyph* MOAIGlyphSet::GetGlyph ( u32 c ) {
 
-	return &this->mGlyphMap [ c ];
+	u32 pageID = c >> PAGE_BITS;
+	if ( pageID < this->mGlyphPages.Size ()) {
+		MOAIGlyph** page = this->mGlyphPages [ pageID ];
+		if ( page ) {
+			return page [ c & ( PAGE_SIZE - 1 )];
+		}
+	}
+	return 0;
+}
+
+//----------------------------------------------------------------//
+USVec2D MOAIGlyphSet::GetKerning ( u32 first, u32 second ) {
+
+	if ( this->mKernDirty ) {
+		this->BuildKernPairs ();
+	}
+	
+	u32 slot = this->FindKernPair ( first, second );
+	if ( slot != NULL_CODE ) {
+		return this->mKernPairs [ slot ].mKerning;
+	}
+	return USVec2D ( 0.0f, 0.0f );
+}
+
+//----------------------------------------------------------------//
+bool MOAIGlyphSet::HasKernPair ( u32 first, u32 second ) {
+
+	if ( this->mKernDirty ) {
+		this->BuildKernPairs ();
+	}
+	return this->FindKernPair ( first, second ) != NULL_CODE;
+}
+
+//----------------------------------------------------------------//
+void MOAIGlyphSet::IndexGlyph ( MOAIGlyph& glyph ) {
+
+	u32 pageID = glyph.mCode >> PAGE_BITS;
+	
+	if ( pageID >= this->mGlyphPages.Size ()) {
+		this->mGlyphPages.Resize ( pageID + 1, 0 );
+	}
+	
+	MOAIGlyph**& page = this->mGlyphPages [ pageID ];
+	if ( !page ) {
+		page = new MOAIGlyph* [ PAGE_SIZE ];
+		memset ( page, 0, PAGE_SIZE * sizeof ( MOAIGlyph* ));
+	}
+	page [ glyph.mCode & ( PAGE_SIZE - 1 )] = &glyph;
 }
 
 //----------------------------------------------------------------//
@@ -49,12 +178,29 @@ MOAIGlyphSet::MOAIGlyphSet () :
 	mSize ( 0.0f ),
 	mHeight ( 0.0f ),
 	mAscent ( 0.0f ),
+	mKernDirty ( false ),
 	mPending ( 0 ),
 	mGlyphs ( 0 ) {
 }
 
 //----------------------------------------------------------------//
 MOAIGlyphSet::~MOAIGlyphSet (){
+
+	for ( u32 i = 0; i < this->mGlyphPages.Size (); ++i ) {
+		if ( this->mGlyphPages [ i ]) {
+			delete [] this->mGlyphPages [ i ];
+		}
+	}
+}
+
+//----------------------------------------------------------------//
+MOAIGlyph& MOAIGlyphSet::NewGlyph ( u32 c ) {
+
+	MOAIGlyph& glyph = this->mGlyphMap [ c ];
+	glyph.mCode = c;
+	
+	this->IndexGlyph ( glyph );
+	return glyph;
 }
 
 //----------------------------------------------------------------//
@@ -72,6 +218,8 @@ void MOAIGlyphSet::SerializeIn ( MOAILuaState& state ) {
 			u32 c = state.GetValue < u32 >( -2, 0 );
 			MOAIGlyph& glyph = this->mGlyphMap [ c ];
 			glyph.SerializeIn ( state );
+			glyph.mCode = c;
+			this->IndexGlyph ( glyph );
 		}
 		state.Pop ( 1 );
 	}
@@ -89,6 +237,7 @@ void MOAIGlyphSet::SerializeIn ( MOAILuaState& state ) {
 			this->mGlyphs = &glyph;
 		}
 	}
+	this->mKernDirty = true;
 }
 
 //----------------------------------------------------------------//
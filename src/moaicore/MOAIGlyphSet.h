@@ -7,30 +7,57 @@
 #include <moaicore/MOAIGlyph.h>
 #include <moaicore/MOAILua.h>
 
+//================================================================//
+// MOAIKernPair
+//================================================================//
+class MOAIKernPair {
+public:
+
+	u32			mFirst;
+	u32			mSecond;
+	USVec2D		mKerning;
+};
+
 //================================================================//
 // MOAIGlyphSet
 //================================================================//
+// Glyphs are owned by mGlyphMap, which keeps their addresses stable for the
+// processing lists. Lookups go through a page table indexed directly by
+// character code instead. Kerning is gathered from the glyphs' kern tables
+// into one open addressed table keyed on the character pair, rebuilt on the
+// first lookup after any kern table changes.
 class MOAIGlyphSet {
 private:
 
 	friend class MOAIFont;
 	friend class MOAITextDesigner;
 	
+	static const u32 PAGE_BITS			= 8;
+	static const u32 PAGE_SIZE			= 1 << PAGE_BITS;
+	static const u32 NULL_CODE			= 0xffffffff;
+	
 	float	mSize;
 	float	mHeight;
 	float	mAscent;
 	
-	// TODO: optimize for printable ASCII characters
-	// TODO: find better container than STLMap
 	typedef STLMap < u32, MOAIGlyph >::iterator GlyphMapIt;
 	STLMap < u32, MOAIGlyph > mGlyphMap;
 	
+	USLeanArray < MOAIGlyph** >		mGlyphPages;	// PAGE_SIZE glyph pointers each; null until a glyph lands on the page
+	
+	USLeanArray < MOAIKernPair >	mKernPairs;		// power of two sized, at most half full
+	bool							mKernDirty;
+	
 	MOAIGlyph* mPending; // queue of glyphs remaining to be processed
 	MOAIGlyph* mGlyphs; // processed glyphs
 	
 	//----------------------------------------------------------------//
 	const MOAIGlyph&	AffirmGlyph			( u32 c );
+	void				BuildKernPairs		();
 	MOAIGlyph&			EditGlyph			( u32 c );
+	u32					FindKernPair		( u32 first, u32 second ) const;
+	void				IndexGlyph			( MOAIGlyph& glyph );
+	MOAIGlyph&			NewGlyph			( u32 c );
 
 public:
 
@@ -40,6 +67,8 @@ public:
 
 	//----------------------------------------------------------------//
 	MOAIGlyph*			GetGlyph			( u32 c );
+	USVec2D				GetKerning			( u32 first, u32 second );
+	bool				HasKernPair			( u32 first, u32 second );
 						MOAIGlyphSet		();
 						~MOAIGlyphSet		();
 	void				SerializeIn			( MOAILuaState& state );
@@ -225,6 +225,37 @@ int MOAIGrid::_toggleTileFlags ( lua_State* L ) {
 // MOAIGrid
 //================================================================//
 
+//----------------------------------------------------------------//
+void MOAIGrid::AddListener ( MOAIGridListener* listener ) {
+
+	if ( listener ) {
+		this->mListeners.insert ( listener );
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAIGrid::CloneFrom ( MOAIGrid& src ) {
+
+	this->mXOff = src.mXOff;
+	this->mYOff = src.mYOff;
+	
+	this->mCellWidth = src.mCellWidth;
+	this->mCellHeight = src.mCellHeight;
+	
+	this->mTileWidth = src.mTileWidth;
+	this->mTileHeight = src.mTileHeight;
+	
+	this->mWidth = src.mWidth;
+	this->mHeight = src.mHeight;
+	
+	this->mShape = src.mShape;
+	this->mRepeat = src.mRepeat;
+	
+	this->mTiles.CloneFrom ( src.mTiles );
+	
+	this->NotifyReset ();
+}
+
 //----------------------------------------------------------------//
 u32 MOAIGrid::GetTile ( int xTile, int yTile ) {
 
@@ -248,11 +279,31 @@ MOAIGrid::MOAIGrid () {
 MOAIGrid::~MOAIGrid () {
 }
 
+//----------------------------------------------------------------//
+void MOAIGrid::NotifyReset () {
+
+	STLSet < MOAIGridListener* >::iterator listenerIt = this->mListeners.begin ();
+	for ( ; listenerIt != this->mListeners.end (); ++listenerIt ) {
+		( *listenerIt )->OnGridReset ( *this );
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAIGrid::NotifyTileChanged ( int xTile, int yTile ) {
+
+	STLSet < MOAIGridListener* >::iterator listenerIt = this->mListeners.begin ();
+	for ( ; listenerIt != this->mListeners.end (); ++listenerIt ) {
+		( *listenerIt )->OnGridTileChanged ( *this, xTile, yTile );
+	}
+}
+
 //----------------------------------------------------------------//
 void MOAIGrid::OnResize () {
 
 	this->mTiles.Init ( this->GetTotalCells ());
 	this->mTiles.Fill ( 0 );
+	
+	this->NotifyReset ();
 }
 
 //----------------------------------------------------------------//
@@ -282,6 +333,12 @@ void MOAIGrid::RegisterLuaFuncs ( MOAILuaState& state ) {
 	luaL_register ( state, 0, regTable );
 }
 
+//----------------------------------------------------------------//
+void MOAIGrid::RemoveListener ( MOAIGridListener* listener ) {
+
+	this->mListeners.erase ( listener );
+}
+
 //----------------------------------------------------------------//
 void MOAIGrid::SerializeIn ( MOAILuaState& state, MOAIDeserializer& serializer ) {
 	UNUSED ( serializer );
@@ -310,6 +367,8 @@ void MOAIGrid::SerializeIn ( MOAILuaState& state, MOAIDeserializer& serializer )
 	}
 	
 	lua_pop ( state, 1 );
+	
+	this->NotifyReset ();
 }
 
 //----------------------------------------------------------------//
@@ -335,7 +394,13 @@ void MOAIGrid::SetTile ( u32 addr, u32 tile ) {
 
 	if ( size ) {
 		addr = addr % this->mTiles.Size ();
-		this->mTiles [ addr ] = tile;
+		
+		if ( this->mTiles [ addr ] != tile ) {
+			this->mTiles [ addr ] = tile;
+			
+			MOAICellCoord coord = this->GetCellCoord ( addr );
+			this->NotifyTileChanged ( coord.mX, coord.mY );
+		}
 	}
 }
 
@@ -346,8 +411,9 @@ void MOAIGrid::SetTile ( int xTile, int yTile, u32 tile ) {
 	if ( this->IsValidCoord ( coord )) {
 	
 		u32 addr = this->GetCellAddr ( coord );
-		if ( addr < this->mTiles.Size ()) {
+		if (( addr < this->mTiles.Size ()) && ( this->mTiles [ addr ] != tile )) {
 			this->mTiles [ addr ] = tile;
+			this->NotifyTileChanged ( xTile, yTile );
 		}
 	}
 }
@@ -358,7 +424,10 @@ size_t MOAIGrid::StreamTilesIn ( USStream* stream ) {
 	if ( !stream ) return 0;
 	
 	size_t size = this->mTiles.Size () * sizeof ( u32 );
-	return stream->ReadBytes ( this->mTiles, size );
+	size = stream->ReadBytes ( this->mTiles, size );
+	
+	this->NotifyReset ();
+	return size;
 }
 
 //----------------------------------------------------------------//
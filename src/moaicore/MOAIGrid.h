@@ -7,6 +7,21 @@
 #include <moaicore/MOAIGridSpace.h>
 #include <moaicore/MOAILua.h>
 
+class MOAIGrid;
+
+//================================================================//
+// MOAIGridListener
+//================================================================//
+// notified when tiles change so derived data (i.e. path graphs, cached tile meshes) can be updated incrementally
+class MOAIGridListener {
+public:
+
+	//----------------------------------------------------------------//
+	virtual void	OnGridReset			( MOAIGrid& grid ) = 0;
+	virtual void	OnGridTileChanged	( MOAIGrid& grid, int xTile, int yTile ) = 0;
+	virtual			~MOAIGridListener	() {}
+};
+
 //================================================================//
 // MOAIGrid
 //================================================================//
@@ -19,6 +34,8 @@ class MOAIGrid :
 private:
 
 	USLeanArray < u32 > mTiles;
+	
+	STLSet < MOAIGridListener* > mListeners;
 
 	//----------------------------------------------------------------//
 	static int		_clearTileFlags		( lua_State* L );
@@ -32,6 +49,8 @@ private:
 	static int		_toggleTileFlags	( lua_State* L );
 
 	//----------------------------------------------------------------//
+	void			NotifyReset			();
+	void			NotifyTileChanged	( int xTile, int yTile );
 	void			OnResize			();
 
 public:
@@ -39,11 +58,14 @@ public:
 	DECL_LUA_FACTORY ( MOAIGrid )
 	
 	//----------------------------------------------------------------//
+	void			AddListener			( MOAIGridListener* listener );
+	void			CloneFrom			( MOAIGrid& src );
 	u32				GetTile				( int xTile, int yTile );
 					MOAIGrid			();
 					~MOAIGrid			();
 	void			RegisterLuaClass	( MOAILuaState& state );
 	void			RegisterLuaFuncs	( MOAILuaState& state );
+	void			RemoveListener		( MOAIGridListener* listener );
 	void			RowFromString		( u32 rowID, cc8* str );
 	STLString		RowToString			( u32 rowID );
 	void			SerializeIn			( MOAILuaState& state, MOAIDeserializer& serializer );
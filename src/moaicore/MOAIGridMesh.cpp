@@ -0,0 +1,207 @@
+// Copyright (c) 2010-2011 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#include "pch.h"
+#include <moaicore/MOAIDeck.h>
+#include <moaicore/MOAIGfxDevice.h>
+#include <moaicore/MOAIGrid.h>
+#include <moaicore/MOAIGridMesh.h>
+#include <moaicore/MOAIVertexFormatMgr.h>
+
+//================================================================//
+// MOAIGridMesh
+//================================================================//
+
+//----------------------------------------------------------------//
+void MOAIGridMesh::BuildChunk ( int xChunk, int yChunk ) {
+
+	MOAIGridMeshChunk& chunk = this->mChunks [( yChunk * this->mXChunks ) + xChunk ];
+	chunk.mDirty = false;
+
+	u32 totalQuads = this->WriteChunk ( xChunk, yChunk, this->mScratch.Data ());
+
+	chunk.mTotalQuads = totalQuads;
+	if ( !totalQuads ) return;
+
+	if ( !chunk.mBufferID ) {
+		glGenBuffers ( 1, &chunk.mBufferID );
+		if ( !chunk.mBufferID ) {
+			chunk.mTotalQuads = 0;
+			return;
+		}
+	}
+
+	glBindBuffer ( GL_ARRAY_BUFFER, chunk.mBufferID );
+	glBufferData ( GL_ARRAY_BUFFER, totalQuads * 4 * sizeof ( MOAIQuadVertex ), this->mScratch.Data (), GL_STATIC_DRAW );
+	glBindBuffer ( GL_ARRAY_BUFFER, 0 );
+}
+
+//----------------------------------------------------------------//
+bool MOAIGridMesh::CanDraw ( MOAIGrid& grid, MOAIDeck& deck ) {
+
+	// blocks are drawn one at a time, so tiles in neighboring blocks only layer the
+	// same as the per tile path if no two quads overlap: staggered and oblique grids
+	// interleave their rows and a deck item larger than the cell spills into its neighbors
+	if ( grid.GetShape () != MOAIGridSpace::RECT_SHAPE ) return false;
+
+	USBox bounds = deck.GetBounds ();
+
+	float tileWidth = grid.GetTileWidth ();
+	float tileHeight = grid.GetTileHeight ();
+	float cellWidth = grid.GetCellWidth ();
+	float cellHeight = grid.GetCellHeight ();
+
+	float width = ( bounds.mMax.mX - bounds.mMin.mX ) * ABS ( tileWidth );
+	float height = ( bounds.mMax.mY - bounds.mMin.mY ) * ABS ( tileHeight );
+
+	return ( width <= ABS ( cellWidth )) && ( height <= ABS ( cellHeight ));
+}
+
+//----------------------------------------------------------------//
+void MOAIGridMesh::Clear () {
+
+	// buffers from a lost context are already gone
+	bool release = MOAIGfxDevice::IsValid () && ( MOAIGfxDevice::Get ().GetContextID () == this->mContextID );
+
+	for ( u32 i = 0; i < this->mChunks.Size (); ++i ) {
+		if ( release && this->mChunks [ i ].mBufferID ) {
+			MOAIGfxDevice::Get ().PushDeleter ( MOAIGfxDeleter::DELETE_BUFFER, this->mChunks [ i ].mBufferID );
+		}
+	}
+	this->mChunks.Clear ();
+
+	this->mXChunks = 0;
+	this->mYChunks = 0;
+}
+
+//----------------------------------------------------------------//
+void MOAIGridMesh::Draw ( MOAICellCoord c0, MOAICellCoord c1 ) {
+
+	MOAIGfxDevice& gfxDevice = MOAIGfxDevice::Get ();
+	MOAIGrid& grid = *this->mGrid;
+
+	if ( this->mContextID != gfxDevice.GetContextID ()) {
+		this->mChunks.Clear ();
+		this->mContextID = gfxDevice.GetContextID ();
+		this->Reset ();
+	}
+	else if ( !this->mChunks.Size () || ( this->mShape != grid.GetShape ())) {
+		this->Reset ();
+	}
+	else if ( this->mDeckVersion != this->mDeck->GetContentVersion ()) {
+		this->Invalidate ();
+	}
+
+	if ( !this->mChunks.Size ()) return;
+
+	c0 = grid.Clamp ( c0 );
+	c1 = grid.Clamp ( c1 );
+
+	const MOAIVertexFormat& format = MOAIVertexFormatMgr::Get ().GetPreset ( MOAIVertexFormatMgr::XYZWUVC );
+
+	for ( int y = c0.mY / CHUNK_SIZE; y <= ( c1.mY / CHUNK_SIZE ); ++y ) {
+		for ( int x = c0.mX / CHUNK_SIZE; x <= ( c1.mX / CHUNK_SIZE ); ++x ) {
+
+			MOAIGridMeshChunk& chunk = this->mChunks [( y * this->mXChunks ) + x ];
+
+			if ( chunk.mDirty ) {
+				this->BuildChunk ( x, y );
+			}
+			gfxDevice.DrawQuadBuffer ( format, chunk.mBufferID, chunk.mTotalQuads );
+		}
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAIGridMesh::Invalidate () {
+
+	for ( u32 i = 0; i < this->mChunks.Size (); ++i ) {
+		this->mChunks [ i ].mDirty = true;
+	}
+	this->mDeckVersion = this->mDeck->GetContentVersion ();
+}
+
+//----------------------------------------------------------------//
+MOAIGridMesh::MOAIGridMesh ( MOAIGrid& grid, MOAIDeck& deck ) :
+	mGrid ( &grid ),
+	mDeck ( &deck ),
+	mDeckVersion ( 0 ),
+	mContextID ( MOAIGfxDevice::Get ().GetContextID ()),
+	mShape ( 0 ),
+	mXChunks ( 0 ),
+	mYChunks ( 0 ) {
+
+	this->mScratch.Init ( CHUNK_SIZE * CHUNK_SIZE * 4 );
+	grid.AddListener ( this );
+}
+
+//----------------------------------------------------------------//
+MOAIGridMesh::~MOAIGridMesh () {
+
+	this->mGrid->RemoveListener ( this );
+	this->Clear ();
+}
+
+//----------------------------------------------------------------//
+void MOAIGridMesh::OnGridReset ( MOAIGrid& grid ) {
+	UNUSED ( grid );
+
+	// the grid may have been resized; lay the chunks out again on the next draw
+	this->Clear ();
+}
+
+//----------------------------------------------------------------//
+void MOAIGridMesh::OnGridTileChanged ( MOAIGrid& grid, int xTile, int yTile ) {
+	UNUSED ( grid );
+
+	int xChunk = xTile / CHUNK_SIZE;
+	int yChunk = yTile / CHUNK_SIZE;
+
+	if (( xChunk < this->mXChunks ) && ( yChunk < this->mYChunks )) {
+		this->mChunks [( yChunk * this->mXChunks ) + xChunk ].mDirty = true;
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAIGridMesh::Reset () {
+
+	this->Clear ();
+
+	MOAIGrid& grid = *this->mGrid;
+
+	this->mXChunks = ( grid.GetWidth () + CHUNK_SIZE - 1 ) / CHUNK_SIZE;
+	this->mYChunks = ( grid.GetHeight () + CHUNK_SIZE - 1 ) / CHUNK_SIZE;
+	this->mChunks.Init ( this->mXChunks * this->mYChunks );
+
+	this->mShape = grid.GetShape ();
+	this->mDeckVersion = this->mDeck->GetContentVersion ();
+}
+
+//----------------------------------------------------------------//
+u32 MOAIGridMesh::WriteChunk ( int xChunk, int yChunk, MOAIQuadVertex* vtx ) {
+
+	MOAIGrid& grid = *this->mGrid;
+
+	float tileWidth = grid.GetTileWidth ();
+	float tileHeight = grid.GetTileHeight ();
+
+	int x0 = xChunk * CHUNK_SIZE;
+	int y0 = yChunk * CHUNK_SIZE;
+	int x1 = MIN ( x0 + CHUNK_SIZE, grid.GetWidth ());
+	int y1 = MIN ( y0 + CHUNK_SIZE, grid.GetHeight ());
+
+	// same row major order the per tile path draws in
+	u32 totalQuads = 0;
+	for ( int y = y0; y < y1; ++y ) {
+		for ( int x = x0; x < x1; ++x ) {
+
+			MOAICellCoord coord ( x, y );
+			USVec2D loc = grid.GetTilePoint ( coord, MOAIGridSpace::TILE_CENTER );
+
+			if ( this->mDeck->WriteQuad ( grid.GetTile ( x, y ), &vtx [ totalQuads * 4 ], loc.mX, loc.mY, 0.0f, tileWidth, tileHeight )) {
+				totalQuads++;
+			}
+		}
+	}
+	return totalQuads;
+}
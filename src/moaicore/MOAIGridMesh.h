@@ -0,0 +1,80 @@
+// Copyright (c) 2010-2011 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#ifndef	MOAIGRIDMESH_H
+#define	MOAIGRIDMESH_H
+
+#include <moaicore/MOAIGrid.h>
+#include <moaicore/MOAIQuadBrush.h>
+
+class MOAIDeck;
+
+//================================================================//
+// MOAIGridMeshChunk
+//================================================================//
+class MOAIGridMeshChunk {
+private:
+
+	friend class MOAIGridMesh;
+
+	GLuint		mBufferID;
+	u32			mTotalQuads;
+	bool		mDirty;
+
+public:
+
+	//----------------------------------------------------------------//
+	MOAIGridMeshChunk () :
+		mBufferID ( 0 ),
+		mTotalQuads ( 0 ),
+		mDirty ( true ) {
+	}
+};
+
+//================================================================//
+// MOAIGridMesh
+//================================================================//
+// Keeps the quads for a grid's tiles in static vertex buffers, one per block
+// of CHUNK_SIZE x CHUNK_SIZE tiles, so drawing a tile map costs one draw call
+// per visible block instead of a deck draw per tile. Blocks are rebuilt when
+// the grid reports a tile change or the deck's content version moves. Blocks
+// are drawn one after another rather than in the grid's row order, so only
+// grids whose tiles can't overlap (see CanDraw) may be drawn this way.
+class MOAIGridMesh :
+	public MOAIGridListener {
+private:
+
+	MOAIGrid*	mGrid;
+	MOAIDeck*	mDeck;
+
+	u32			mDeckVersion;
+	u32			mContextID;
+	u32			mShape;
+
+	int			mXChunks;
+	int			mYChunks;
+
+	USLeanArray < MOAIGridMeshChunk >	mChunks;
+	USLeanArray < MOAIQuadVertex >		mScratch;
+
+	//----------------------------------------------------------------//
+	void			BuildChunk				( int xChunk, int yChunk );
+	void			Clear					();
+	void			Invalidate				();
+	void			OnGridReset				( MOAIGrid& grid );
+	void			OnGridTileChanged		( MOAIGrid& grid, int xTile, int yTile );
+	void			Reset					();
+
+public:
+
+	static const int CHUNK_SIZE = 32;
+
+	//----------------------------------------------------------------//
+	static bool		CanDraw					( MOAIGrid& grid, MOAIDeck& deck );
+	void			Draw					( MOAICellCoord c0, MOAICellCoord c1 );
+					MOAIGridMesh			( MOAIGrid& grid, MOAIDeck& deck );
+					~MOAIGridMesh			();
+	u32				WriteChunk				( int xChunk, int yChunk, MOAIQuadVertex* vtx );
+};
+
+#endif
@@ -22,10 +22,87 @@ public:
 	u32 mHeuristic;
 };
 
+//================================================================//
+// MOAIGridPathSearchEntry
+//================================================================//
+
+static const int sDirections [ 8 ][ 2 ] = {
+	{ -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 }, // orthogonal first
+	{ -1, -1 }, { -1, 1 }, { 1, -1 }, { 1, 1 },
+};
+
+//----------------------------------------------------------------//
+static MOAIGridPathSearchEntry _popSearchEntry ( USLeanStack < MOAIGridPathSearchEntry, 256 >& heap ) {
+
+	MOAIGridPathSearchEntry* entries = heap;
+	MOAIGridPathSearchEntry best = entries [ 0 ];
+	
+	heap.Pop ();
+	u32 size = heap.GetTop ();
+	
+	if ( size ) {
+	
+		MOAIGridPathSearchEntry entry = entries [ size ];
+		u32 i = 0;
+		
+		for ( u32 child = 1; child < size; child = ( i * 2 ) + 1 ) {
+		
+			if ((( child + 1 ) < size ) && ( entries [ child + 1 ].mCost < entries [ child ].mCost )) {
+				++child;
+			}
+			if ( entry.mCost <= entries [ child ].mCost ) break;
+			
+			entries [ i ] = entries [ child ];
+			i = child;
+		}
+		entries [ i ] = entry;
+	}
+	return best;
+}
+
+//----------------------------------------------------------------//
+static void _pushSearchEntry ( USLeanStack < MOAIGridPathSearchEntry, 256 >& heap, u32 cell, float cost ) {
+
+	MOAIGridPathSearchEntry entry;
+	entry.mCell = cell;
+	entry.mCost = cost;
+
+	u32 i = heap.GetTop ();
+	heap.Push ( entry );
+	MOAIGridPathSearchEntry* entries = heap;
+	
+	while ( i ) {
+		u32 parent = ( i - 1 ) >> 1;
+		if ( entries [ parent ].mCost <= cost ) break;
+		entries [ i ] = entries [ parent ];
+		i = parent;
+	}
+	entries [ i ] = entry;
+}
+
 //================================================================//
 // local
 //================================================================//
 
+//----------------------------------------------------------------//
+/**	@name	setClusterSize
+	@text	Set the size (in cells) of the square clusters used by
+			HIERARCHICAL searches. Discards the current abstraction.
+
+	@in		MOAIGridPathGraph self
+	@opt	number size						Default value is 16.
+	@out	nil
+*/
+int MOAIGridPathGraph::_setClusterSize ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAIGridPathGraph, "U" )
+
+	u32 size = state.GetValue < u32 >( 2, DEFAULT_CLUSTER_SIZE );
+	self->mClusterSize = size < 2 ? 2 : size;
+	self->ClearClusters ();
+	
+	return 0;
+}
+
 //----------------------------------------------------------------//
 /**	@name	setGrid
 	@text	Set graph data to use for pathfinding. 
@@ -47,6 +124,50 @@ int MOAIGridPathGraph::_setGrid ( lua_State* L ) {
 // MOAIGridPathGraph
 //================================================================//
 
+//----------------------------------------------------------------//
+void MOAIGridPathGraph::AddClusterNode ( u32 clusterID, int xTile, int yTile ) {
+
+	u32 addr = ( u32 )this->mGrid->GetCellAddr ( xTile, yTile );
+	
+	// corner cells may be found by two borders
+	if ( this->mClusterNodeIndex [ addr ] != NO_NODE ) return;
+	
+	MOAIGridPathCluster& cluster = this->mClusters [ clusterID ];
+	u32 index = cluster.mNodes.Size ();
+	
+	cluster.mNodes.Resize ( index + 1 );
+	cluster.mNodes [ index ] = addr;
+	this->mClusterNodeIndex [ addr ] = index;
+}
+
+//----------------------------------------------------------------//
+void MOAIGridPathGraph::ClearClusters () {
+
+	this->mClusters.Clear ();
+	this->mClusterNodeIndex.Clear ();
+	this->mDirtyClusters.Reset ();
+	
+	this->mClusterWidth = 0;
+	this->mClusterHeight = 0;
+	
+	this->mTargetCacheID = -1;
+}
+
+//----------------------------------------------------------------//
+void MOAIGridPathGraph::CopyClusters ( MOAIGridPathGraph& src ) {
+
+	// src must be up to date and built from a grid identical to this one's
+	this->ClearClusters ();
+	
+	this->mClusterSize = src.mClusterSize;
+	this->mClusterWidth = src.mClusterWidth;
+	this->mClusterHeight = src.mClusterHeight;
+	this->mClusterDiagonals = src.mClusterDiagonals;
+	
+	this->mClusters.CloneFrom ( src.mClusters );
+	this->mClusterNodeIndex.CloneFrom ( src.mClusterNodeIndex );
+}
+
 //----------------------------------------------------------------//
 float MOAIGridPathGraph::ComputeHeuristic ( MOAIGridPathGraphParams& params, const MOAICellCoord& c0, const MOAICellCoord& c1 ) {
 
@@ -78,7 +199,89 @@ float MOAIGridPathGraph::ComputeHeuristic ( MOAIGridPathGraphParams& params, con
 }
 
 //----------------------------------------------------------------//
-MOAIGridPathGraph::MOAIGridPathGraph () {
+u32 MOAIGridPathGraph::GetClusterID ( int xTile, int yTile ) {
+
+	return ( u32 )(( xTile / ( int )this->mClusterSize ) + (( yTile / ( int )this->mClusterSize ) * ( int )this->mClusterWidth ));
+}
+
+//----------------------------------------------------------------//
+void MOAIGridPathGraph::GetClusterRect ( u32 clusterID, int& x0, int& y0, int& x1, int& y1 ) {
+
+	int size = ( int )this->mClusterSize;
+
+	x0 = ( int )( clusterID % this->mClusterWidth ) * size;
+	y0 = ( int )( clusterID / this->mClusterWidth ) * size;
+	
+	x1 = MIN ( x0 + size, this->mGrid->GetWidth ());
+	y1 = MIN ( y0 + size, this->mGrid->GetHeight ());
+}
+
+//----------------------------------------------------------------//
+bool MOAIGridPathGraph::IsPassable ( int xTile, int yTile ) {
+
+	u32 tile = this->mGrid->GetTile ( xTile, yTile );
+	return ( tile && !( tile & MOAITileFlags::HIDDEN ));
+}
+
+//----------------------------------------------------------------//
+bool MOAIGridPathGraph::Jump ( int& xTile, int& yTile, int dx, int dy, const MOAICellCoord& target, u32& steps ) {
+
+	for ( ;; ) {
+	
+		xTile += dx;
+		yTile += dy;
+		++steps;
+		
+		if ( !this->IsPassable ( xTile, yTile )) return false;
+		if (( xTile == target.mX ) && ( yTile == target.mY )) return true;
+		
+		if ( dx && dy ) {
+			
+			if ( !this->IsPassable ( xTile - dx, yTile ) && this->IsPassable ( xTile - dx, yTile + dy )) return true;
+			if ( !this->IsPassable ( xTile, yTile - dy ) && this->IsPassable ( xTile + dx, yTile - dy )) return true;
+			
+			// a diagonal step is also a jump point if either straight run from it finds one
+			u32 straightSteps = 0;
+			
+			int x = xTile;
+			int y = yTile;
+			if ( this->Jump ( x, y, dx, 0, target, straightSteps )) return true;
+			
+			x = xTile;
+			y = yTile;
+			if ( this->Jump ( x, y, 0, dy, target, straightSteps )) return true;
+		}
+		else if ( dx ) {
+		
+			if ( !this->IsPassable ( xTile, yTile + 1 ) && this->IsPassable ( xTile + dx, yTile + 1 )) return true;
+			if ( !this->IsPassable ( xTile, yTile - 1 ) && this->IsPassable ( xTile + dx, yTile - 1 )) return true;
+		}
+		else {
+		
+			if ( !this->IsPassable ( xTile + 1, yTile ) && this->IsPassable ( xTile + 1, yTile + dy )) return true;
+			if ( !this->IsPassable ( xTile - 1, yTile ) && this->IsPassable ( xTile - 1, yTile + dy )) return true;
+		}
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAIGridPathGraph::MarkClusterDirty ( u32 clusterID ) {
+
+	MOAIGridPathCluster& cluster = this->mClusters [ clusterID ];
+	
+	if ( !cluster.mDirty ) {
+		cluster.mDirty = true;
+		this->mDirtyClusters.Push ( clusterID );
+	}
+}
+
+//----------------------------------------------------------------//
+MOAIGridPathGraph::MOAIGridPathGraph () :
+	mClusterSize ( DEFAULT_CLUSTER_SIZE ),
+	mClusterWidth ( 0 ),
+	mClusterHeight ( 0 ),
+	mClusterDiagonals ( true ),
+	mTargetCacheID ( -1 ) {
 	
 	RTTI_SINGLE ( MOAIGridPathGraph )
 }
@@ -89,6 +292,201 @@ MOAIGridPathGraph::~MOAIGridPathGraph () {
 	this->SetGrid ( 0 );
 }
 
+//----------------------------------------------------------------//
+void MOAIGridPathGraph::OnGridReset ( MOAIGrid& grid ) {
+	UNUSED ( grid );
+
+	this->ClearClusters ();
+}
+
+//----------------------------------------------------------------//
+void MOAIGridPathGraph::OnGridTileChanged ( MOAIGrid& grid, int xTile, int yTile ) {
+	UNUSED ( grid );
+
+	this->mTargetCacheID = -1;
+
+	if ( !this->mClusters.Size ()) return;
+	
+	int size = ( int )this->mClusterSize;
+	int xCluster = xTile / size;
+	int yCluster = yTile / size;
+	
+	u32 clusterID = this->GetClusterID ( xTile, yTile );
+	this->MarkClusterDirty ( clusterID );
+	
+	// a tile on a cluster border also moves the entrances of the cluster across from it
+	if (( xTile % size ) == 0 && ( xCluster > 0 )) {
+		this->MarkClusterDirty ( clusterID - 1 );
+	}
+	
+	if ((( xTile % size ) == ( size - 1 )) && (( u32 )( xCluster + 1 ) < this->mClusterWidth )) {
+		this->MarkClusterDirty ( clusterID + 1 );
+	}
+	
+	if (( yTile % size ) == 0 && ( yCluster > 0 )) {
+		this->MarkClusterDirty ( clusterID - this->mClusterWidth );
+	}
+	
+	if ((( yTile % size ) == ( size - 1 )) && (( u32 )( yCluster + 1 ) < this->mClusterHeight )) {
+		this->MarkClusterDirty ( clusterID + this->mClusterWidth );
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAIGridPathGraph::PushClusterNeighbors ( MOAIPathFinder& pathFinder, MOAIGridPathGraphParams& params, int nodeID ) {
+
+	this->UpdateClusters (( pathFinder.GetFlags () & NO_DIAGONALS ) == 0 );
+	
+	if (( u32 )nodeID >= this->mClusterNodeIndex.Size ()) return;
+	
+	MOAIGrid& grid = *this->mGrid;
+	
+	MOAICellCoord coord = grid.GetCellCoord ( nodeID );
+	u32 clusterID = this->GetClusterID ( coord.mX, coord.mY );
+	MOAIGridPathCluster& cluster = this->mClusters [ clusterID ];
+	
+	int x0, y0, x1, y1;
+	this->GetClusterRect ( clusterID, x0, y0, x1, y1 );
+	int width = x1 - x0;
+	
+	// connect to the target if it can be reached without leaving its cluster
+	int targetID = pathFinder.GetTargetNodeID ();
+	MOAICellCoord targetCoord = grid.GetCellCoord ( targetID );
+	
+	if ( this->GetClusterID ( targetCoord.mX, targetCoord.mY ) == clusterID ) {
+	
+		if ( this->mTargetCacheID != targetID ) {
+			this->SearchCluster ( clusterID, targetID, this->mTargetCosts );
+			this->mTargetCacheID = targetID;
+		}
+		
+		float cost = this->mTargetCosts [( coord.mX - x0 ) + (( coord.mY - y0 ) * width )];
+		if ( cost >= 0.0f ) {
+			this->PushNode ( pathFinder, params, targetID, cost );
+		}
+	}
+	
+	u32 total = cluster.mNodes.Size ();
+	u32 index = this->mClusterNodeIndex [ nodeID ];
+	
+	if ( index == NO_NODE ) {
+	
+		// not an entrance (i.e. the start node); search the cluster to connect it to the abstract graph
+		this->SearchCluster ( clusterID, nodeID, this->mSearchCosts );
+		
+		for ( u32 i = 0; i < total; ++i ) {
+		
+			MOAICellCoord nodeCoord = grid.GetCellCoord ( cluster.mNodes [ i ]);
+			float cost = this->mSearchCosts [( nodeCoord.mX - x0 ) + (( nodeCoord.mY - y0 ) * width )];
+			
+			if ( cost >= 0.0f ) {
+				this->PushNode ( pathFinder, params, cluster.mNodes [ i ], cost );
+			}
+		}
+		return;
+	}
+	
+	float* costs = &cluster.mCosts [ index * total ];
+	for ( u32 i = 0; i < total; ++i ) {
+		if (( i != index ) && ( costs [ i ] >= 0.0f )) {
+			this->PushNode ( pathFinder, params, cluster.mNodes [ i ], costs [ i ]);
+		}
+	}
+	
+	// each entrance pairs up with the entrance directly across the cluster border
+	for ( u32 i = 0; i < 4; ++i ) {
+	
+		int dx = sDirections [ i ][ 0 ];
+		int dy = sDirections [ i ][ 1 ];
+		
+		int xTile = coord.mX + dx;
+		int yTile = coord.mY + dy;
+		
+		if ( !grid.IsValidCoord ( grid.GetCellCoord ( xTile, yTile ))) continue;
+		if ( this->GetClusterID ( xTile, yTile ) == clusterID ) continue;
+		
+		u32 addr = ( u32 )grid.GetCellAddr ( xTile, yTile );
+		if (( this->mClusterNodeIndex [ addr ] != NO_NODE ) && this->IsPassable ( xTile, yTile )) {
+			this->PushNode ( pathFinder, params, addr, dx ? params.mHCost : params.mVCost );
+		}
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAIGridPathGraph::PushJump ( MOAIPathFinder& pathFinder, MOAIGridPathGraphParams& params, int xTile, int yTile, int dx, int dy ) {
+
+	MOAICellCoord target = this->mGrid->GetCellCoord ( pathFinder.GetTargetNodeID ());
+	
+	u32 steps = 0;
+	if ( this->Jump ( xTile, yTile, dx, dy, target, steps )) {
+	
+		float moveCost = ( dx && dy ) ? params.mDCost : ( dx ? params.mHCost : params.mVCost );
+		this->PushNode ( pathFinder, params, this->mGrid->GetCellAddr ( xTile, yTile ), moveCost * ( float )steps );
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAIGridPathGraph::PushJumpPoints ( MOAIPathFinder& pathFinder, MOAIGridPathGraphParams& params, int nodeID ) {
+
+	MOAICellCoord coord = this->mGrid->GetCellCoord ( nodeID );
+	int x = coord.mX;
+	int y = coord.mY;
+	
+	int parentID = pathFinder.GetParentNodeID ();
+	
+	if ( parentID < 0 ) {
+		for ( u32 i = 0; i < 8; ++i ) {
+			this->PushJump ( pathFinder, params, x, y, sDirections [ i ][ 0 ], sDirections [ i ][ 1 ]);
+		}
+		return;
+	}
+	
+	// prune to the natural and forced neighbors for the direction of travel
+	MOAICellCoord parent = this->mGrid->GetCellCoord ( parentID );
+	
+	int dx = ( x > parent.mX ) ? 1 : (( x < parent.mX ) ? -1 : 0 );
+	int dy = ( y > parent.mY ) ? 1 : (( y < parent.mY ) ? -1 : 0 );
+	
+	if ( dx && dy ) {
+		
+		this->PushJump ( pathFinder, params, x, y, dx, 0 );
+		this->PushJump ( pathFinder, params, x, y, 0, dy );
+		this->PushJump ( pathFinder, params, x, y, dx, dy );
+		
+		if ( !this->IsPassable ( x - dx, y ) && this->IsPassable ( x - dx, y + dy )) {
+			this->PushJump ( pathFinder, params, x, y, -dx, dy );
+		}
+		
+		if ( !this->IsPassable ( x, y - dy ) && this->IsPassable ( x + dx, y - dy )) {
+			this->PushJump ( pathFinder, params, x, y, dx, -dy );
+		}
+	}
+	else if ( dx ) {
+	
+		this->PushJump ( pathFinder, params, x, y, dx, 0 );
+		
+		if ( !this->IsPassable ( x, y + 1 ) && this->IsPassable ( x + dx, y + 1 )) {
+			this->PushJump ( pathFinder, params, x, y, dx, 1 );
+		}
+		
+		if ( !this->IsPassable ( x, y - 1 ) && this->IsPassable ( x + dx, y - 1 )) {
+			this->PushJump ( pathFinder, params, x, y, dx, -1 );
+		}
+	}
+	else {
+	
+		this->PushJump ( pathFinder, params, x, y, 0, dy );
+		
+		if ( !this->IsPassable ( x + 1, y ) && this->IsPassable ( x + 1, y + dy )) {
+			this->PushJump ( pathFinder, params, x, y, 1, dy );
+		}
+		
+		if ( !this->IsPassable ( x - 1, y ) && this->IsPassable ( x - 1, y + dy )) {
+			this->PushJump ( pathFinder, params, x, y, -1, dy );
+		}
+	}
+}
+
 //----------------------------------------------------------------//
 void MOAIGridPathGraph::PushNeighbor ( MOAIPathFinder& pathFinder, MOAIGridPathGraphParams& params, u32 tile0, int xTile, int yTile, float moveCost ) {
 
@@ -147,6 +545,20 @@ void MOAIGridPathGraph::PushNeighbors ( MOAIPathFinder& pathFinder, int nodeID )
 			params.mDCost = sqrtf (( params.mHCost * params.mHCost ) + ( params.mVCost * params.mVCost ));
 			params.mZCost = 0.0f;
 			
+			// the faster search modes assume uniform costs
+			if ( !pathFinder.HasTerrainDeck ()) {
+			
+				if ( flags & HIERARCHICAL ) {
+					this->PushClusterNeighbors ( pathFinder, params, nodeID );
+					break;
+				}
+				
+				if (( flags & ( JUMP_POINT_SEARCH | NO_DIAGONALS )) == JUMP_POINT_SEARCH ) {
+					this->PushJumpPoints ( pathFinder, params, nodeID );
+					break;
+				}
+			}
+			
 			this->PushNeighbor ( pathFinder, params, tile0, xTile - 1, yTile, params.mHCost );
 			this->PushNeighbor ( pathFinder, params, tile0, xTile + 1, yTile, params.mHCost );
 			this->PushNeighbor ( pathFinder, params, tile0, xTile, yTile + 1, params.mVCost );
@@ -241,6 +653,57 @@ void MOAIGridPathGraph::PushNeighbors ( MOAIPathFinder& pathFinder, int nodeID )
 	}
 }
 
+//----------------------------------------------------------------//
+void MOAIGridPathGraph::PushNode ( MOAIPathFinder& pathFinder, MOAIGridPathGraphParams& params, int nodeID, float moveCost ) {
+
+	if ( pathFinder.IsVisited ( nodeID )) return;
+
+	MOAICellCoord coord = this->mGrid->GetCellCoord ( nodeID );
+	MOAICellCoord targetCoord = this->mGrid->GetCellCoord ( pathFinder.GetTargetNodeID ());
+	
+	float g = moveCost * params.mGWeight;
+	float h = this->ComputeHeuristic ( params, coord, targetCoord ) * params.mHWeight;
+	
+	pathFinder.PushState ( nodeID, g + h );
+}
+
+//----------------------------------------------------------------//
+void MOAIGridPathGraph::RebuildCluster ( u32 clusterID ) {
+
+	MOAIGridPathCluster& cluster = this->mClusters [ clusterID ];
+	
+	u32 total = cluster.mNodes.Size ();
+	for ( u32 i = 0; i < total; ++i ) {
+		this->mClusterNodeIndex [ cluster.mNodes [ i ]] = NO_NODE;
+	}
+	cluster.mNodes.Clear ();
+	
+	int x0, y0, x1, y1;
+	this->GetClusterRect ( clusterID, x0, y0, x1, y1 );
+	
+	int width = x1 - x0;
+	int height = y1 - y0;
+	
+	this->ScanClusterBorder ( clusterID, x0, y0, 0, 1, -1, 0, height );
+	this->ScanClusterBorder ( clusterID, x1 - 1, y0, 0, 1, 1, 0, height );
+	this->ScanClusterBorder ( clusterID, x0, y0, 1, 0, 0, -1, width );
+	this->ScanClusterBorder ( clusterID, x0, y1 - 1, 1, 0, 0, 1, width );
+	
+	total = cluster.mNodes.Size ();
+	cluster.mCosts.Init ( total * total );
+	
+	for ( u32 i = 0; i < total; ++i ) {
+	
+		this->SearchCluster ( clusterID, cluster.mNodes [ i ], this->mSearchCosts );
+		
+		for ( u32 j = 0; j < total; ++j ) {
+			MOAICellCoord coord = this->mGrid->GetCellCoord ( cluster.mNodes [ j ]);
+			cluster.mCosts [( i * total ) + j ] = this->mSearchCosts [( coord.mX - x0 ) + (( coord.mY - y0 ) * width )];
+		}
+	}
+	cluster.mDirty = false;
+}
+
 //----------------------------------------------------------------//
 void MOAIGridPathGraph::RegisterLuaClass ( MOAILuaState& state ) {
 
@@ -249,6 +712,8 @@ void MOAIGridPathGraph::RegisterLuaClass ( MOAILuaState& state ) {
 	state.SetField ( -1, "EUCLIDEAN_DISTANCE", ( u32 )EUCLIDEAN_DISTANCE );
 	
 	state.SetField ( -1, "NO_DIAGONALS", ( u32 )NO_DIAGONALS );
+	state.SetField ( -1, "JUMP_POINT_SEARCH", ( u32 )JUMP_POINT_SEARCH );
+	state.SetField ( -1, "HIERARCHICAL", ( u32 )HIERARCHICAL );
 }
 
 //----------------------------------------------------------------//
@@ -256,6 +721,7 @@ void MOAIGridPathGraph::RegisterLuaFuncs ( MOAILuaState& state ) {
 	MOAIPathGraph::RegisterLuaFuncs ( state );
 	
 	luaL_Reg regTable [] = {
+		{ "setClusterSize",		_setClusterSize },
 		{ "setGrid",			_setGrid },
 		{ NULL, NULL }
 	};
@@ -263,8 +729,150 @@ void MOAIGridPathGraph::RegisterLuaFuncs ( MOAILuaState& state ) {
 	luaL_register ( state, 0, regTable );
 }
 
+//----------------------------------------------------------------//
+void MOAIGridPathGraph::ScanClusterBorder ( u32 clusterID, int xTile, int yTile, int xStep, int yStep, int xOut, int yOut, int length ) {
+
+	// entrances go on each run of cells open on both sides of the border: one in the middle
+	// of a short run, or one at each end of a long run. both clusters scan the same run the
+	// same way, so their entrances always pair up.
+	int runStart = -1;
+	
+	for ( int i = 0; i <= length; ++i ) {
+	
+		int x = xTile + ( i * xStep );
+		int y = yTile + ( i * yStep );
+		
+		if (( i < length ) && this->IsPassable ( x, y ) && this->IsPassable ( x + xOut, y + yOut )) {
+			if ( runStart < 0 ) {
+				runStart = i;
+			}
+			continue;
+		}
+		
+		if ( runStart >= 0 ) {
+		
+			int runEnd = i - 1;
+			
+			if ((( runEnd - runStart ) + 1 ) >= LONG_ENTRANCE_SIZE ) {
+				this->AddClusterNode ( clusterID, xTile + ( runStart * xStep ), yTile + ( runStart * yStep ));
+				this->AddClusterNode ( clusterID, xTile + ( runEnd * xStep ), yTile + ( runEnd * yStep ));
+			}
+			else {
+				int mid = ( runStart + runEnd ) >> 1;
+				this->AddClusterNode ( clusterID, xTile + ( mid * xStep ), yTile + ( mid * yStep ));
+			}
+			runStart = -1;
+		}
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAIGridPathGraph::SearchCluster ( u32 clusterID, int nodeID, USLeanArray < float >& costs ) {
+
+	MOAIGrid& grid = *this->mGrid;
+
+	int x0, y0, x1, y1;
+	this->GetClusterRect ( clusterID, x0, y0, x1, y1 );
+	
+	int width = x1 - x0;
+	int height = y1 - y0;
+	
+	u32 total = ( u32 )( width * height );
+	if ( costs.Size () < total ) {
+		costs.Init ( total );
+	}
+	costs.Fill ( -1.0f );
+	
+	float hCost = grid.GetCellWidth ();
+	float vCost = grid.GetCellHeight ();
+	float dCost = sqrtf (( hCost * hCost ) + ( vCost * vCost ));
+	
+	u32 directions = this->mClusterDiagonals ? 8 : 4;
+	
+	MOAICellCoord coord = grid.GetCellCoord ( nodeID );
+	u32 start = ( u32 )(( coord.mX - x0 ) + (( coord.mY - y0 ) * width ));
+	
+	costs [ start ] = 0.0f;
+	
+	this->mSearchHeap.Reset ();
+	_pushSearchEntry ( this->mSearchHeap, start, 0.0f );
+	
+	while ( this->mSearchHeap.GetTop ()) {
+	
+		MOAIGridPathSearchEntry entry = _popSearchEntry ( this->mSearchHeap );
+		if ( entry.mCost > costs [ entry.mCell ]) continue; // stale
+		
+		int x = ( int )( entry.mCell % width );
+		int y = ( int )( entry.mCell / width );
+		
+		for ( u32 i = 0; i < directions; ++i ) {
+		
+			int dx = sDirections [ i ][ 0 ];
+			int dy = sDirections [ i ][ 1 ];
+		
+			int nx = x + dx;
+			int ny = y + dy;
+			
+			if (( nx < 0 ) || ( ny < 0 ) || ( nx >= width ) || ( ny >= height )) continue;
+			if ( !this->IsPassable ( x0 + nx, y0 + ny )) continue;
+			
+			float cost = entry.mCost + (( dx && dy ) ? dCost : ( dx ? hCost : vCost ));
+			u32 cell = ( u32 )( nx + ( ny * width ));
+			
+			if (( costs [ cell ] < 0.0f ) || ( cost < costs [ cell ])) {
+				costs [ cell ] = cost;
+				_pushSearchEntry ( this->mSearchHeap, cell, cost );
+			}
+		}
+	}
+}
+
 //----------------------------------------------------------------//
 void MOAIGridPathGraph::SetGrid ( MOAIGrid* grid ) {
 
+	if ( this->mGrid ) {
+		this->mGrid->RemoveListener ( this );
+	}
+
 	this->mGrid.Set ( *this, grid );
+	
+	if ( grid ) {
+		grid->AddListener ( this );
+	}
+	this->ClearClusters ();
+}
+
+//----------------------------------------------------------------//
+void MOAIGridPathGraph::UpdateClusters ( bool diagonals ) {
+
+	MOAIGrid& grid = *this->mGrid;
+
+	if (( this->mClusters.Size () == 0 ) || ( this->mClusterDiagonals != diagonals )) {
+	
+		this->ClearClusters ();
+		
+		u32 size = this->mClusterSize;
+		this->mClusterWidth = (( u32 )grid.GetWidth () + size - 1 ) / size;
+		this->mClusterHeight = (( u32 )grid.GetHeight () + size - 1 ) / size;
+		this->mClusterDiagonals = diagonals;
+		
+		u32 total = this->mClusterWidth * this->mClusterHeight;
+		if ( !total ) return;
+		
+		this->mClusters.Init ( total );
+		
+		this->mClusterNodeIndex.Init (( u32 )grid.GetTotalCells ());
+		this->mClusterNodeIndex.Fill ( NO_NODE );
+		
+		for ( u32 i = 0; i < total; ++i ) {
+			this->mDirtyClusters.Push ( i );
+		}
+	}
+	
+	while ( this->mDirtyClusters.GetTop ()) {
+	
+		u32 clusterID = this->mDirtyClusters [ this->mDirtyClusters.GetTop () - 1 ];
+		this->mDirtyClusters.Pop ();
+		this->RebuildCluster ( clusterID );
+	}
 }
@@ -10,16 +10,69 @@
 class MOAIGridPathGraphParams;
 class MOAIPathFinder;
 
+//================================================================//
+// MOAIGridPathCluster
+//================================================================//
+class MOAIGridPathCluster {
+private:
+
+	friend class MOAIGridPathGraph;
+
+	USLeanArray < int >		mNodes; // entrance cells on the cluster border
+	USLeanArray < float >	mCosts; // mNodes.Size () squared; negative if unreachable
+	bool					mDirty;
+	
+public:
+
+	//----------------------------------------------------------------//
+	MOAIGridPathCluster () :
+		mDirty ( true ) {
+	}
+};
+
+//================================================================//
+// MOAIGridPathSearchEntry
+//================================================================//
+class MOAIGridPathSearchEntry {
+public:
+
+	u32			mCell;
+	float		mCost;
+};
+
 //================================================================//
 // MOAIGridPathGraph
 //================================================================//
 /**	@name	MOAIGridPathGraph
 	@text	Pathfinder graph adapter for MOAIGrid.
+	
+			For uniform cost rect grids (no terrain deck), two faster
+			search modes may be selected with MOAIPathFinder's setFlags.
+			Both return a path of waypoints instead of every cell.
+			
+			JUMP_POINT_SEARCH expands only jump points. Consecutive
+			waypoints are joined by a straight or diagonal run of cells.
+			It requires diagonals.
+			
+			HIERARCHICAL searches an abstract graph of entrances between
+			square clusters of cells. Consecutive waypoints lie in the same
+			cluster (or are adjacent across a border). The abstraction is
+			built lazily and rebuilt per cluster as the grid's tiles change.
+			Share a single graph between path finders to share the abstraction.
+	
+	@const	MANHATTAN_DISTANCE
+	@const	DIAGONAL_DISTANCE
+	@const	EUCLIDEAN_DISTANCE
+	@const	NO_DIAGONALS
+	@const	JUMP_POINT_SEARCH
+	@const	HIERARCHICAL
 */
 class MOAIGridPathGraph :
-	public MOAIPathGraph {
+	public MOAIPathGraph,
+	public MOAIGridListener {
 private:
 
+	friend class MOAIPathBatch;
 	friend class MOAIPathFinder;
 
 	enum {
@@ -28,15 +81,54 @@ private:
 		D_MOVE_COST,
 	};
 
+	static const u32 DEFAULT_CLUSTER_SIZE	= 16;
+	static const int LONG_ENTRANCE_SIZE		= 6; // runs this long get an entrance at each end
+	static const u32 NO_NODE				= 0xffffffff;
+
 	MOAILuaSharedPtr < MOAIGrid > mGrid;
 
+	// hierarchical abstraction
+	u32										mClusterSize;
+	u32										mClusterWidth;
+	u32										mClusterHeight;
+	bool									mClusterDiagonals;
+	USLeanArray < MOAIGridPathCluster >		mClusters;
+	USLeanArray < u32 >						mClusterNodeIndex; // per cell; index into its cluster's nodes
+	USLeanStack < u32, 64 >					mDirtyClusters;
+	
+	// cached search from the target node across its cluster
+	int										mTargetCacheID;
+	USLeanArray < float >					mTargetCosts;
+	
+	USLeanArray < float >					mSearchCosts;
+	USLeanStack < MOAIGridPathSearchEntry, 256 > mSearchHeap;
+
 	//----------------------------------------------------------------//
+	static int		_setClusterSize				( lua_State* L );
 	static int		_setGrid					( lua_State* L );
 
 	//----------------------------------------------------------------//
+	void			AddClusterNode				( u32 clusterID, int xTile, int yTile );
+	void			ClearClusters				();
+	void			CopyClusters				( MOAIGridPathGraph& src );
 	float			ComputeHeuristic			( MOAIGridPathGraphParams& params, const MOAICellCoord& c0, const MOAICellCoord& c1 );
+	u32				GetClusterID				( int xTile, int yTile );
+	void			GetClusterRect				( u32 clusterID, int& x0, int& y0, int& x1, int& y1 );
+	bool			IsPassable					( int xTile, int yTile );
+	bool			Jump						( int& xTile, int& yTile, int dx, int dy, const MOAICellCoord& target, u32& steps );
+	void			MarkClusterDirty			( u32 clusterID );
+	void			OnGridReset					( MOAIGrid& grid );
+	void			OnGridTileChanged			( MOAIGrid& grid, int xTile, int yTile );
+	void			PushClusterNeighbors		( MOAIPathFinder& pathFinder, MOAIGridPathGraphParams& params, int nodeID );
+	void			PushJump					( MOAIPathFinder& pathFinder, MOAIGridPathGraphParams& params, int xTile, int yTile, int dx, int dy );
+	void			PushJumpPoints				( MOAIPathFinder& pathFinder, MOAIGridPathGraphParams& params, int nodeID );
 	void			PushNeighbor				( MOAIPathFinder& pathFinder, MOAIGridPathGraphParams& params, u32 tile0, int xTile, int yTile, float moveCost );
 	void			PushNeighbors				( MOAIPathFinder& pathFinder, int nodeID );
+	void			PushNode					( MOAIPathFinder& pathFinder, MOAIGridPathGraphParams& params, int nodeID, float moveCost );
+	void			RebuildCluster				( u32 clusterID );
+	void			ScanClusterBorder			( u32 clusterID, int xTile, int yTile, int xStep, int yStep, int xOut, int yOut, int length );
+	void			SearchCluster				( u32 clusterID, int nodeID, USLeanArray < float >& costs );
+	void			UpdateClusters				( bool diagonals );
 
 public:
 	
@@ -46,10 +138,14 @@ public:
 		EUCLIDEAN_DISTANCE,
 	};
 	
-	static const u32 NO_DIAGONALS = 0x00000001;
+	static const u32 NO_DIAGONALS		= 0x00000001;
+	static const u32 JUMP_POINT_SEARCH	= 0x00000002;
+	static const u32 HIERARCHICAL		= 0x00000004;
 	
 	DECL_LUA_FACTORY ( MOAIGridPathGraph )
 	
+	GET ( MOAIGrid*, Grid, mGrid )
+	
 	//----------------------------------------------------------------//
 					MOAIGridPathGraph			();
 					~MOAIGridPathGraph			();
@@ -6,6 +6,7 @@
 #include <moaicore/MOAILogMessages.h>
 #include <moaicore/MOAIImage.h>
 #include <moaicore/MOAIDataBuffer.h>
+#include <moaicore/MOAIKtxHeader.h>
 
 //================================================================//
 // local
@@ -537,6 +538,37 @@ int MOAIImage::_writePNG ( lua_State* L ) {
 	return 0;
 }
 
+//----------------------------------------------------------------//
+/**	@name	writeKTX
+	@text	Write image to a KTX file, with a full chain of mipmaps
+			unless told otherwise. The file keeps the image's color
+			format, so convert to RGB_565 or RGBA_4444 first for a
+			smaller texture. Palettized images and RGBA_5551 are not
+			supported. Compressed formats (ETC1, DXT, PVRTC) have to
+			come from an external tool.
+
+	@in		MOAIImage self
+	@in		string filename
+	@opt	boolean mipmaps			Default value is true.
+	@out	boolean success
+*/
+int MOAIImage::_writeKTX ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAIImage, "US" )
+	
+	cc8* filename	= state.GetValue < cc8* >( 2, "" );
+	bool mipmaps	= state.GetValue < bool >( 3, true );
+	
+	bool result = false;
+	
+	USFileStream stream;
+	if ( stream.OpenWrite ( filename )) {
+		result = self->WriteKTX ( stream, mipmaps );
+	}
+	
+	lua_pushboolean ( state, result );
+	return 1;
+}
+
 //================================================================//
 // MOAIImage
 //================================================================//
@@ -561,7 +593,7 @@ void MOAIImage::Alloc () {
 	
 	u32 paletteSize = this->GetPaletteSize ();
 	if ( paletteSize ) {
-		this->mData = malloc ( paletteSize );
+		this->mPalette = malloc ( paletteSize );
 		memset ( this->mPalette, 0, paletteSize );
 	}
 }
@@ -725,6 +757,13 @@ void MOAIImage::ConvertColors ( const MOAIImage& image, USColor::Format colorFmt
 			this->Copy ( image );
 		}
 	}
+	else if ( this == &image ) {
+	
+		// Init would free the colors before they're read
+		MOAIImage converted;
+		converted.ConvertColors ( image, colorFmt );
+		this->Take ( converted );
+	}
 	else {
 	
 		this->Init ( image.mWidth, image.mHeight, colorFmt, image.mPixelFormat );
@@ -800,7 +839,11 @@ void MOAIImage::Copy ( const MOAIImage& image ) {
 
 	this->Init ( image.mWidth, image.mHeight, image.mColorFormat, image.mPixelFormat );
 	
-	memcpy ( this->mData, image.mData, this->GetBitmapSize () + this->GetPaletteSize ());
+	memcpy ( this->mBitmap, image.mBitmap, this->GetBitmapSize ());
+	
+	if ( this->mPalette ) {
+		memcpy ( this->mPalette, image.mPalette, this->GetPaletteSize ());
+	}
 }
 
 //----------------------------------------------------------------//
@@ -1023,6 +1066,11 @@ void MOAIImage::CopyRect ( const MOAIImage& image, USIntRect srcRect, USIntRect
 		ySrcStep = -ySrcStep;
 	}
 	
+	if (( this->mPixelFormat == USPixel::TRUECOLOR ) && ( image.mPixelFormat == USPixel::TRUECOLOR )) {
+		this->CopyRectRows ( image, srcRect, destRect, xSrcOrigin, ySrcOrigin, xSrcStep, ySrcStep, filter );
+		return;
+	}
+	
 	int yDest = destRect.mYMin;
 	float ySample = ySrcOrigin;
 	for ( int i = 0; i < destHeight; ++i, ySample += ySrcStep, yDest++ ) {
@@ -1031,27 +1079,23 @@ void MOAIImage::CopyRect ( const MOAIImage& image, USIntRect srcRect, USIntRect
 		float xSample = xSrcOrigin;
 		for ( int j = 0; j < destWidth; ++j, xSample += xSrcStep, xDest++ ) {
 			
-			u32 x0 = ( u32 )floorf ( xSample );
-			u32 y0 = ( u32 )floorf ( ySample );
+			int x0 = ( int )floorf ( xSample );
+			int y0 = ( int )floorf ( ySample );
 			
-			u32 x1 = x0 + 1;
-			u32 y1 = y0 + 1;
+			u8 xt = ( u8 )(( xSample - ( float )x0 ) * 255.0f );
+			u8 yt = ( u8 )(( ySample - ( float )y0 ) * 255.0f );
 			
-			if ( x1 >= this->mWidth ) {
-				x1 = this->mWidth - 1;
-			}
+			// as in CopyRectRows; a flipped rect starts sampling on the source's far edge
+			x0 = MIN ( MAX ( x0, 0 ), ( int )image.mWidth - 1 );
+			y0 = MIN ( MAX ( y0, 0 ), ( int )image.mHeight - 1 );
 			
-			if ( y1 >= this->mHeight ) {
-				y1 = this->mHeight - 1;
-			}
+			int x1 = MIN ( x0 + 1, ( int )image.mWidth - 1 );
+			int y1 = MIN ( y0 + 1, ( int )image.mHeight - 1 );
 			
 			u32 c0 = image.GetColor ( x0, y0 );
 			u32 c1 = image.GetColor ( x1, y0 );
 			u32 c2 = image.GetColor ( x0, y1 );
 			u32 c3 = image.GetColor ( x1, y1 );
-
-			u8 xt = ( u8 )(( xSample - ( float )x0 ) * 255.0f );
-			u8 yt = ( u8 )(( ySample - ( float )y0 ) * 255.0f );
 			
 			u32 result;
 			
@@ -1067,6 +1111,107 @@ void MOAIImage::CopyRect ( const MOAIImage& image, USIntRect srcRect, USIntRect
 	}
 }
 
+//----------------------------------------------------------------//
+void MOAIImage::CopyRectRows ( const MOAIImage& image, USIntRect srcRect, USIntRect destRect, float xSrcOrigin, float ySrcOrigin, float xSrcStep, float ySrcStep, u32 filter ) {
+
+	// Resamples a row at a time: the source rows a dest row reads from are
+	// unpacked to RGBA once (and kept while the next dest row shares them),
+	// filtered into a scratch row and packed back with one USColor::Convert.
+	int destWidth = destRect.Width ();
+	int destHeight = destRect.Height ();
+	
+	if (( destWidth <= 0 ) || ( destHeight <= 0 )) return;
+
+	// samples land anywhere from the rect's min to its max edge; clamp to the pixels that exist
+	int xSpanMin = srcRect.mXMin;
+	int xSpanMax = MIN ( srcRect.mXMax, ( int )image.mWidth - 1 );
+	int ySpanMin = srcRect.mYMin;
+	int ySpanMax = MIN ( srcRect.mYMax, ( int )image.mHeight - 1 );
+	
+	u32 spanWidth = ( u32 )( xSpanMax - xSpanMin + 1 );
+
+	// per column: left and right span offsets, then the blend
+	USLeanArray < u32 > columns;
+	columns.Init ( destWidth * 3 );
+	
+	float xSample = xSrcOrigin;
+	for ( int j = 0; j < destWidth; ++j, xSample += xSrcStep ) {
+		
+		int x0 = ( int )floorf ( xSample );
+		u8 xt = ( u8 )(( xSample - ( float )x0 ) * 255.0f );
+		
+		x0 = MIN ( MAX ( x0, xSpanMin ), xSpanMax );
+		int x1 = MIN ( x0 + 1, xSpanMax );
+		
+		columns [ j * 3 ] = ( u32 )( x0 - xSpanMin );
+		columns [ ( j * 3 ) + 1 ] = ( u32 )( x1 - xSpanMin );
+		columns [ ( j * 3 ) + 2 ] = xt;
+	}
+	
+	USLeanArray < u32 > buffer;
+	buffer.Init (( spanWidth * 2 ) + destWidth );
+	
+	u32* row0 = buffer.Data ();
+	u32* row1 = row0 + spanWidth;
+	u32* result = row1 + spanWidth;
+	
+	int row0Y = -1;
+	int row1Y = -1;
+	
+	u32 srcOffset = xSpanMin * USColor::GetSize ( image.mColorFormat );
+	u32 destOffset = destRect.mXMin * USColor::GetSize ( this->mColorFormat );
+	
+	int yDest = destRect.mYMin;
+	float ySample = ySrcOrigin;
+	for ( int i = 0; i < destHeight; ++i, ySample += ySrcStep, yDest++ ) {
+		
+		int y0 = ( int )floorf ( ySample );
+		u8 yt = ( u8 )(( ySample - ( float )y0 ) * 255.0f );
+		
+		y0 = MIN ( MAX ( y0, ySpanMin ), ySpanMax );
+		int y1 = MIN ( y0 + 1, ySpanMax );
+		
+		if ( y0 != row0Y ) {
+			if ( y0 == row1Y ) {
+				u32* swap = row0;
+				row0 = row1;
+				row1 = swap;
+				row1Y = row0Y;
+			}
+			else {
+				USColor::Convert ( row0, USColor::RGBA_8888, ( const u8* )image.GetRowAddr ( y0 ) + srcOffset, image.mColorFormat, spanWidth );
+			}
+			row0Y = y0;
+		}
+		
+		if ( y1 != row1Y ) {
+			USColor::Convert ( row1, USColor::RGBA_8888, ( const u8* )image.GetRowAddr ( y1 ) + srcOffset, image.mColorFormat, spanWidth );
+			row1Y = y1;
+		}
+		
+		for ( int j = 0; j < destWidth; ++j ) {
+			
+			const u32* column = &columns [ j * 3 ];
+			
+			u32 c0 = row0 [ column [ 0 ]];
+			u32 c1 = row0 [ column [ 1 ]];
+			u32 c2 = row1 [ column [ 0 ]];
+			u32 c3 = row1 [ column [ 1 ]];
+			
+			u8 xt = ( u8 )column [ 2 ];
+			
+			if ( filter == FILTER_LINEAR ) {
+				result [ j ] = USColor::BilerpFixed ( c0, c1, c2, c3, xt, yt );
+			}
+			else {
+				result [ j ] = USColor::NearestNeighbor ( c0, c1, c2, c3, xt, yt );
+			}
+		}
+		
+		USColor::Convert (( u8* )this->GetRowAddr ( yDest ) + destOffset, this->mColorFormat, result, USColor::RGBA_8888, destWidth );
+	}
+}
+
 //----------------------------------------------------------------//
 void MOAIImage::FillRect ( USIntRect rect, u32 color ) {
 
@@ -1405,6 +1550,14 @@ bool MOAIImage::MipReduce () {
 			nextMip.SetColor ( x >> 1, 0, result );
 		}
 	}
+	else if ( this->mPixelFormat == USPixel::TRUECOLOR ) {
+	
+		nextMip.Init ( width >> 1, height >> 1, this->mColorFormat, this->mPixelFormat );
+		
+		for ( u32 y = 0; y < ( height >> 1 ); ++y ) {
+			USColor::MipReduceRow ( nextMip.GetRowAddr ( y ), this->GetRowAddr ( y << 1 ), this->GetRowAddr (( y << 1 ) + 1 ), this->mColorFormat, width >> 1 );
+		}
+	}
 	else {
 		
 		nextMip.Init ( width >> 1, height >> 1, this->mColorFormat, this->mPixelFormat );
@@ -1524,6 +1677,7 @@ void MOAIImage::RegisterLuaFuncs ( MOAILuaState& state ) {
 		{ "resizeCanvas",		_resizeCanvas },
 		{ "setColor32",			_setColor32 },
 		{ "setRGBA",			_setRGBA },
+		{ "writeKTX",			_writeKTX },
 		{ "writePNG",			_writePNG },
 		{ NULL, NULL }
 	};
@@ -1694,6 +1848,7 @@ void MOAIImage::Take ( MOAIImage& image ) {
 
 	// kill the data before clear
 	image.mData = 0;
+	image.mPalette = 0;
 	image.Clear ();
 }
 
@@ -1756,3 +1911,46 @@ void MOAIImage::Transform ( u32 transform ) {
 		this->PadToPow2 ( *this );
 	}
 }
+
+//----------------------------------------------------------------//
+bool MOAIImage::WriteKTX ( USStream& stream, bool mipmaps ) {
+
+	if ( !this->IsOK ()) return false;
+	if ( this->mPixelFormat != USPixel::TRUECOLOR ) return false;
+
+	u32 levels = 1;
+	if ( mipmaps ) {
+		for ( u32 w = this->mWidth, h = this->mHeight; ( w > 1 ) || ( h > 1 ); w >>= 1, h >>= 1 ) {
+			levels++;
+		}
+	}
+
+	MOAIKtxHeader header;
+	if ( !header.Init ( this->mColorFormat, this->mWidth, this->mHeight, levels )) return false;
+	
+	stream.WriteBytes ( &header, MOAIKtxHeader::HEADER_SIZE );
+	
+	static const u8 zeros [ 4 ] = { 0, 0, 0, 0 };
+	
+	MOAIImage mip;
+	mip.Copy ( *this );
+	
+	for ( u32 level = 0; level < levels; ++level ) {
+	
+		if ( level ) {
+			mip.MipReduce ();
+		}
+		
+		// rows are padded to four bytes; so then is the level
+		u32 rowSize = mip.GetRowSize ();
+		u32 paddedRowSize = MOAIKtxHeader::GetPaddedSize ( rowSize );
+		
+		stream.Write < u32 >( paddedRowSize * mip.mHeight );
+		
+		for ( u32 y = 0; y < mip.mHeight; ++y ) {
+			stream.WriteBytes ( mip.GetRowAddr ( y ), rowSize );
+			stream.WriteBytes ( zeros, paddedRowSize - rowSize );
+		}
+	}
+	return true;
+}
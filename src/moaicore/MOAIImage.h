@@ -77,10 +77,12 @@ private:
 	static int		_resizeCanvas		( lua_State* L );
 	static int		_setColor32			( lua_State* L );
 	static int		_setRGBA			( lua_State* L );
+	static int		_writeKTX			( lua_State* L );
 	static int		_writePNG			( lua_State* L );
 
 	//----------------------------------------------------------------//
 	void			Alloc				();
+	void			CopyRectRows		( const MOAIImage& image, USIntRect srcRect, USIntRect destRect, float xSrcOrigin, float ySrcOrigin, float xSrcStep, float ySrcStep, u32 filter );
 	static u32		GetMinPowerOfTwo	( u32 size ); // gets the smallest power of two greater than size
 	void			Init				( void* bitmap, u32 width, u32 height, USColor::Format colorFmt, bool copy );
 	static bool		IsJpg				( USStream& stream );
@@ -158,6 +160,7 @@ public:
 	void				Take					( MOAIImage& image );
 	void				ToTrueColor				( const MOAIImage& image );
 	void				Transform				( u32 transform );
+	bool				WriteKTX				( USStream& stream, bool mipmaps );
 	bool				WritePNG				( USStream& stream );
 };
 
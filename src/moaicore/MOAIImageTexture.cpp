@@ -46,8 +46,9 @@ void MOAIImageTexture::Invalidate () {
 
 	this->mStatus = INVALID;
 	
-	this->MOAIGfxResource::Invalidate ();
-	this->MOAIGfxResource::Load ();
+	// keep the texture handle; OnCreate reloads the whole image into it,
+	// or replaces it if the image has changed size
+	this->MOAIGfxResource::Refresh ();
 }
 
 //----------------------------------------------------------------//
@@ -66,8 +67,8 @@ void MOAIImageTexture::Invalidate ( USIntRect rect ) {
 	}
 	this->mStatus = INVALID_REGION;
 	
-	this->MOAIGfxResource::Invalidate ();
-	this->MOAIGfxResource::Load ();
+	// regions invalidated before the next bind are merged into a single sub-image upload
+	this->MOAIGfxResource::Refresh ();
 }
 
 //----------------------------------------------------------------//
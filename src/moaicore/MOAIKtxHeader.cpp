@@ -0,0 +1,182 @@
+// Copyright (c) 2010-2011 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#include "pch.h"
+#include <moaicore/MOAIKtxHeader.h>
+
+static const u8 KTX_IDENTIFIER [ 12 ] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x31, 0x31, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+
+//================================================================//
+// MOAIKtxHeader
+//================================================================//
+
+//----------------------------------------------------------------//
+u32 MOAIKtxHeader::GetLevelCount () {
+
+	return this->mNumberOfMipmapLevels ? this->mNumberOfMipmapLevels : 1;
+}
+
+//----------------------------------------------------------------//
+MOAIKtxHeader* MOAIKtxHeader::GetHeader ( const void* data, size_t size ) {
+
+	if ( data && ( size >= HEADER_SIZE )) {
+		MOAIKtxHeader* header = ( MOAIKtxHeader* )data;
+		if ( header->IsValid ()) {
+			return header;
+		}
+	}
+	return 0;
+}
+
+//----------------------------------------------------------------//
+const void* MOAIKtxHeader::GetLevelData ( const void* data, size_t size ) {
+
+	MOAIKtxHeader* header = MOAIKtxHeader::GetHeader ( data, size );
+	if ( header && (( HEADER_SIZE + header->mBytesOfKeyValueData ) <= size )) {
+		return ( const void* )(( uintptr )data + HEADER_SIZE + header->mBytesOfKeyValueData );
+	}
+	return 0;
+}
+
+//----------------------------------------------------------------//
+u32 MOAIKtxHeader::GetPaddedSize ( u32 size ) {
+
+	return ( size + 3 ) & ~3;
+}
+
+//----------------------------------------------------------------//
+bool MOAIKtxHeader::Init ( USColor::Format colorFormat, u32 width, u32 height, u32 levels ) {
+
+	switch ( colorFormat ) {
+	
+		case USColor::A_8:
+			this->mGLType = GL_UNSIGNED_BYTE;
+			this->mGLTypeSize = 1;
+			this->mGLFormat = GL_ALPHA;
+			break;
+		
+		case USColor::RGB_888:
+			this->mGLType = GL_UNSIGNED_BYTE;
+			this->mGLTypeSize = 1;
+			this->mGLFormat = GL_RGB;
+			break;
+		
+		case USColor::RGB_565:
+			this->mGLType = GL_UNSIGNED_SHORT_5_6_5;
+			this->mGLTypeSize = 2;
+			this->mGLFormat = GL_RGB;
+			break;
+		
+		case USColor::RGBA_4444:
+			this->mGLType = GL_UNSIGNED_SHORT_4_4_4_4;
+			this->mGLTypeSize = 2;
+			this->mGLFormat = GL_RGBA;
+			break;
+		
+		case USColor::RGBA_8888:
+			this->mGLType = GL_UNSIGNED_BYTE;
+			this->mGLTypeSize = 1;
+			this->mGLFormat = GL_RGBA;
+			break;
+		
+		// RGBA_5551 keeps red in the low bits; GL wants it in the high ones
+		default:
+			return false;
+	}
+	
+	memcpy ( this->mIdentifier, KTX_IDENTIFIER, sizeof ( KTX_IDENTIFIER ));
+	this->mEndianness = ENDIANNESS;
+	
+	this->mGLInternalFormat = this->mGLFormat;
+	this->mGLBaseInternalFormat = this->mGLFormat;
+	
+	this->mPixelWidth = width;
+	this->mPixelHeight = height;
+	this->mPixelDepth = 0;
+	this->mNumberOfArrayElements = 0;
+	this->mNumberOfFaces = 1;
+	this->mNumberOfMipmapLevels = levels;
+	this->mBytesOfKeyValueData = 0;
+	
+	return true;
+}
+
+//----------------------------------------------------------------//
+bool MOAIKtxHeader::IsValid () {
+
+	if ( memcmp ( this->mIdentifier, KTX_IDENTIFIER, sizeof ( KTX_IDENTIFIER ))) return false;
+	if ( this->mEndianness != ENDIANNESS ) return false;
+	
+	if ( !( this->mPixelWidth && this->mPixelHeight )) return false;
+	if ( this->mPixelDepth || this->mNumberOfArrayElements || ( this->mNumberOfFaces != 1 )) return false;
+	
+	return true;
+}
+
+//----------------------------------------------------------------//
+void MOAIKtxHeader::Load ( USStream& stream ) {
+
+	assert ( HEADER_SIZE <= sizeof ( MOAIKtxHeader ));
+
+	this->mEndianness = 0;
+	stream.PeekBytes ( this, HEADER_SIZE );
+}
+
+//----------------------------------------------------------------//
+MOAIKtxHeader::MOAIKtxHeader () {
+
+	memset ( this, 0, sizeof ( MOAIKtxHeader ));
+}
+
+//----------------------------------------------------------------//
+void* MOAIKtxHeader::ReadLevels ( USStream& stream, u32 baseLevel, size_t& size ) {
+
+	// Reads the header and the levels from baseLevel down, skipping the key/value
+	// data and the larger levels without loading them. Level records in the
+	// result start at baseLevel.
+	size = 0;
+
+	MOAIKtxHeader header;
+	if ( stream.ReadBytes ( &header, HEADER_SIZE ) != HEADER_SIZE ) return 0;
+	if ( !header.IsValid ()) return 0;
+	
+	u32 totalLevels = header.GetLevelCount ();
+	if ( baseLevel >= totalLevels ) return 0;
+	
+	stream.Seek ( header.mBytesOfKeyValueData, SEEK_CUR );
+	header.mBytesOfKeyValueData = 0;
+	
+	for ( u32 i = 0; i < baseLevel; ++i ) {
+	
+		u32 imageSize = 0;
+		if ( stream.ReadBytes ( &imageSize, sizeof ( u32 )) != sizeof ( u32 )) return 0;
+		stream.Seek ( MOAIKtxHeader::GetPaddedSize ( imageSize ), SEEK_CUR );
+	}
+	
+	// walk the remaining records for their size, then come back for them;
+	// the last level may be missing its padding
+	size_t start = stream.GetCursor ();
+	size_t total = 0;
+	
+	for ( u32 i = baseLevel; i < totalLevels; ++i ) {
+	
+		u32 imageSize = 0;
+		if ( stream.ReadBytes ( &imageSize, sizeof ( u32 )) != sizeof ( u32 )) return 0;
+		
+		u32 paddedSize = MOAIKtxHeader::GetPaddedSize ( imageSize );
+		total += sizeof ( u32 ) + ((( i + 1 ) < totalLevels ) ? paddedSize : imageSize );
+		stream.Seek ( paddedSize, SEEK_CUR );
+	}
+	stream.SetCursor (( long )start );
+	
+	void* data = malloc ( HEADER_SIZE + total );
+	memcpy ( data, &header, HEADER_SIZE );
+	
+	if ( stream.ReadBytes (( void* )(( uintptr )data + HEADER_SIZE ), total ) != total ) {
+		free ( data );
+		return 0;
+	}
+	
+	size = HEADER_SIZE + total;
+	return data;
+}
@@ -0,0 +1,48 @@
+// Copyright (c) 2010-2011 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#ifndef MOAIKTXHEADER_H
+#define MOAIKTXHEADER_H
+
+//================================================================//
+// MOAIKtxHeader
+//================================================================//
+// Header of a KTX (Khronos texture) file: pre-built mip levels stored in
+// the pixel formats GL takes as is, compressed (ETC1, DXT, PVRTC) or not.
+// Level records follow the key/value data, largest first: a u32 byte count,
+// then the level (rows padded to four bytes), padded to four bytes. Only
+// plain 2D textures in the reader's byte order are accepted.
+class MOAIKtxHeader {
+public:
+	
+	static const u32 HEADER_SIZE		= 64;
+	static const u32 ENDIANNESS			= 0x04030201;
+	
+	u8	mIdentifier [ 12 ];			// '«' 'K' 'T' 'X' ' ' '1' '1' '»' '\r' '\n' '\x1A' '\n'
+	u32 mEndianness;				// ENDIANNESS as written by the file's author
+	u32 mGLType;					// 0 for compressed formats
+	u32 mGLTypeSize;
+	u32 mGLFormat;					// 0 for compressed formats
+	u32 mGLInternalFormat;
+	u32 mGLBaseInternalFormat;
+	u32 mPixelWidth;
+	u32 mPixelHeight;
+	u32 mPixelDepth;
+	u32 mNumberOfArrayElements;
+	u32 mNumberOfFaces;
+	u32 mNumberOfMipmapLevels;		// 0 asks for the levels to be generated; treated as 1
+	u32 mBytesOfKeyValueData;
+
+	//----------------------------------------------------------------//
+	u32						GetLevelCount		();
+	static MOAIKtxHeader*	GetHeader			( const void* data, size_t size );
+	static const void*		GetLevelData		( const void* data, size_t size );
+	static u32				GetPaddedSize		( u32 size );
+	bool					Init				( USColor::Format colorFormat, u32 width, u32 height, u32 levels );
+	bool					IsValid				();
+	void					Load				( USStream& stream );
+							MOAIKtxHeader		();
+	static void*			ReadLevels			( USStream& stream, u32 baseLevel, size_t& size );
+};
+
+#endif
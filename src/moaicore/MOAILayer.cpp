@@ -12,7 +12,6 @@
 #include <moaicore/MOAILayer.h>
 #include <moaicore/MOAILogMessages.h>
 #include <moaicore/MOAIPartitionResultBuffer.h>
-#include <moaicore/MOAIPartitionResultMgr.h>
 #include <moaicore/MOAIProp.h>
 #include <moaicore/MOAITextureBase.h>
 #include <moaicore/MOAITransform.h>
@@ -318,7 +317,10 @@ int	MOAILayer::_setPartitionCull2D ( lua_State* L ) {
 								MOAILayer.SORT_PRIORITY_DESCENDING, MOAILayer.SORT_X_ASCENDING,
 								MOAILayer.SORT_X_DESCENDING, MOAILayer.SORT_Y_ASCENDING,
 								MOAILayer.SORT_Y_DESCENDING, MOAILayer.SORT_Z_ASCENDING,
-								MOAILayer.SORT_Z_DESCENDING
+								MOAILayer.SORT_Z_DESCENDING, MOAILayer.SORT_ISO,
+								MOAILayer.SORT_ISO_GRAPH. SORT_ISO_GRAPH produces the same
+								front to back ordering as SORT_ISO, but only compares props
+								whose on screen footprints overlap. Use it for large scenes.
 	@out	nil
 */
 int MOAILayer::_setSortMode ( lua_State* L ) {
@@ -351,6 +353,27 @@ int	MOAILayer::_setSortScale ( lua_State* L ) {
 	return 0;
 }
 
+//----------------------------------------------------------------//
+/**	@name	setStateSort
+	@text	After sorting, reorder props so those drawn with the same
+			texture, shader and blend mode are drawn together. A prop is
+			only moved past props whose on screen footprints it does not
+			overlap, so the result looks the same as the plain sort.
+			Props in the partition's global or empty cells are never moved.
+			Cuts down on batch flushes in scenes with many small props.
+	
+	@in		MOAILayer self
+	@opt	boolean enable		Default value is false.
+	@out	nil
+*/
+int MOAILayer::_setStateSort ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAILayer, "U" )
+
+	self->mStateSort = state.GetValue < bool >( 2, false );
+
+	return 0;
+}
+
 //----------------------------------------------------------------//
 /**	@name	setViewport
 	@text	Set the layer's viewport.
@@ -485,6 +508,59 @@ void MOAILayer::AffirmPartition () {
 	}
 }
 
+//----------------------------------------------------------------//
+// Gathers and sorts the layer's props into its result buffer. Touches neither
+// the gfx device nor Lua, so MOAIRenderMgr may call it from a worker thread
+// (after PrepareCull on the main thread).
+void MOAILayer::CullAndSort () {
+
+	this->mTotalResults = 0;
+	this->mIsCulled = true;
+
+	if ( !( this->mViewport && this->mPartition )) return;
+
+	USMatrix4x4 view;
+	this->GetViewMtx ( view );
+	
+	USMatrix4x4 proj;
+	this->GetProjectionMtx ( proj );
+	
+	USMatrix4x4 viewProj = view;
+	viewProj.Append ( proj );
+	
+	USMatrix4x4 invViewProj;
+	invViewProj.Inverse ( viewProj );
+	this->mViewVolume.Init ( invViewProj );
+	
+	MOAIPartitionResultBuffer& buffer = this->mResults;
+	buffer.SetViewVolume ( &this->mViewVolume );
+	
+	u32 totalResults = 0;
+	
+	if ( this->mPartitionCull2D ) {
+		totalResults = this->mPartition->GatherProps ( buffer, 0, this->mViewVolume.mAABB, MOAIProp::CAN_DRAW | MOAIProp::CAN_DRAW_DEBUG );
+	}
+	else {
+		totalResults = this->mPartition->GatherProps ( buffer, 0, this->mViewVolume, MOAIProp::CAN_DRAW | MOAIProp::CAN_DRAW_DEBUG );
+	}
+	
+	if ( !totalResults ) return;
+	
+	buffer.GenerateKeys (
+		this->mSortMode,
+		this->mSortScale [ 0 ],
+		this->mSortScale [ 1 ],
+		this->mSortScale [ 2 ],
+		this->mSortScale [ 3 ]
+	);
+	
+	this->mTotalResults = buffer.Sort ( this->mSortMode, &viewProj );
+	
+	if ( this->mStateSort ) {
+		buffer.SortByState ( &viewProj );
+	}
+}
+
 //----------------------------------------------------------------//
 void MOAILayer::Draw ( int subPrimID ) {
 	UNUSED ( subPrimID );
@@ -550,29 +626,17 @@ void MOAILayer::Draw ( int subPrimID ) {
 	
 	if ( this->mPartition ) {
 		
-		MOAIPartitionResultBuffer& buffer = MOAIPartitionResultMgr::Get ().GetBuffer ();
-		const USFrustum& viewVolume = gfxDevice.GetViewVolume ();
-		
-		u32 totalResults = 0;
-		
-		if ( this->mPartitionCull2D ) {
-			totalResults = this->mPartition->GatherProps ( buffer, 0, viewVolume.mAABB, MOAIProp::CAN_DRAW | MOAIProp::CAN_DRAW_DEBUG );
-		}
-		else {
-			totalResults = this->mPartition->GatherProps ( buffer, 0, viewVolume, MOAIProp::CAN_DRAW | MOAIProp::CAN_DRAW_DEBUG );
+		// use the results from MOAIRenderMgr's cull pass if there are any; otherwise cull now
+		if ( !this->mIsCulled ) {
+			this->mPartition->FlushUpdates ();
+			this->CullAndSort ();
 		}
+		this->mIsCulled = false;
 		
-		if ( !totalResults ) return;
+		MOAIPartitionResultBuffer& buffer = this->mResults;
+		u32 totalResults = this->mTotalResults;
 		
-		buffer.GenerateKeys (
-			this->mSortMode,
-			this->mSortScale [ 0 ],
-			this->mSortScale [ 1 ],
-			this->mSortScale [ 2 ],
-			this->mSortScale [ 3 ]
-		);
-		
-		totalResults = buffer.Sort ( this->mSortMode );
+		if ( !totalResults ) return;
 		
 		// set up the ambient color
 		gfxDevice.SetAmbientColor ( this->mColor );
@@ -708,7 +772,11 @@ MOAILayer::MOAILayer () :
 	mParallax ( 1.0f, 1.0f, 1.0f ),
 	mShowDebugLines ( true ),
 	mSortMode ( MOAIPartitionResultBuffer::SORT_PRIORITY_ASCENDING ),
-	mPartitionCull2D ( true ) {
+	mPartitionCull2D ( true ),
+	mStateSort ( false ),
+	mTotalResults ( 0 ),
+	mCullFrame ( 0 ),
+	mIsCulled ( false ) {
 	
 	RTTI_BEGIN
 		RTTI_EXTEND ( MOAIProp )
@@ -734,6 +802,29 @@ MOAILayer::~MOAILayer () {
 	#endif
 }
 
+//----------------------------------------------------------------//
+// Called on the main thread before CullAndSort is handed to a worker. Returns
+// false if the layer has nothing to cull or was already prepared this frame.
+bool MOAILayer::PrepareCull ( u32 frame ) {
+
+	this->mIsCulled = false;
+
+	if ( this->mCullFrame == frame ) return false;
+	this->mCullFrame = frame;
+
+	if ( !( this->mFlags & FLAGS_VISIBLE )) return false;
+	if ( !( this->mViewport && this->mPartition )) return false;
+	
+	// apply queued prop moves now; gathers on the workers only read the partition
+	this->mPartition->FlushUpdates ();
+	
+	// the camera's inverse is built lazily; build it here, not on a worker
+	if ( this->mCamera ) {
+		this->mCamera->GetWorldToLocalMtx ();
+	}
+	return true;
+}
+
 //----------------------------------------------------------------//
 void MOAILayer::RegisterLuaClass ( MOAILuaState& state ) {
 
@@ -741,6 +832,7 @@ void MOAILayer::RegisterLuaClass ( MOAILuaState& state ) {
 	
 	state.SetField ( -1, "SORT_NONE",					( u32 )MOAIPartitionResultBuffer::SORT_NONE );
 	state.SetField ( -1, "SORT_ISO",					( u32 )MOAIPartitionResultBuffer::SORT_ISO );
+	state.SetField ( -1, "SORT_ISO_GRAPH",				( u32 )MOAIPartitionResultBuffer::SORT_ISO_GRAPH );
 	state.SetField ( -1, "SORT_PRIORITY_ASCENDING",		( u32 )MOAIPartitionResultBuffer::SORT_PRIORITY_ASCENDING );
 	state.SetField ( -1, "SORT_PRIORITY_DESCENDING",	( u32 )MOAIPartitionResultBuffer::SORT_PRIORITY_DESCENDING );
 	state.SetField ( -1, "SORT_X_ASCENDING",			( u32 )MOAIPartitionResultBuffer::SORT_X_ASCENDING );
@@ -775,6 +867,7 @@ void MOAILayer::RegisterLuaFuncs ( MOAILuaState& state ) {
 		{ "setPartitionCull2D",		_setPartitionCull2D },
 		{ "setSortMode",			_setSortMode },
 		{ "setSortScale",			_setSortScale },
+		{ "setStateSort",			_setStateSort },
 		{ "setViewport",			_setViewport },
 		{ "showDebugLines",			_showDebugLines },
 		{ "wndToWorld",				_wndToWorld },
@@ -6,6 +6,7 @@
 
 #include <moaicore/MOAILua.h>
 #include <moaicore/MOAIPartition.h>
+#include <moaicore/MOAIPartitionResultBuffer.h>
 #include <moaicore/MOAIProp.h>
 #include <moaicore/MOAIViewport.h>
 
@@ -22,6 +23,7 @@ class MOAIFrameBuffer;
 	
 	@const	SORT_NONE
 	@const	SORT_ISO
+	@const	SORT_ISO_GRAPH
 	@const	SORT_PRIORITY_ASCENDING
 	@const	SORT_PRIORITY_DESCENDING
 	@const	SORT_X_ASCENDING
@@ -57,6 +59,14 @@ private:
 	float		mSortScale [ 4 ];
 
 	bool		mPartitionCull2D;
+	bool		mStateSort;
+
+	// cull and sort output; each layer has its own so layers may be culled in parallel
+	MOAIPartitionResultBuffer	mResults;
+	USFrustum					mViewVolume;
+	u32							mTotalResults;
+	u32							mCullFrame;
+	bool						mIsCulled;
 
 	//----------------------------------------------------------------//
 	static int	_clear				( lua_State* L );
@@ -75,6 +85,7 @@ private:
 	static int	_setPartitionCull2D	( lua_State* L );
 	static int	_setSortMode		( lua_State* L );
 	static int	_setSortScale		( lua_State* L );
+	static int	_setStateSort		( lua_State* L );
 	static int	_setViewport		( lua_State* L );
 	static int	_showDebugLines		( lua_State* L );
 	static int	_wndToWorld			( lua_State* L );
@@ -92,6 +103,7 @@ public:
 	DECL_LUA_FACTORY ( MOAILayer )
 	
 	//----------------------------------------------------------------//
+	void			CullAndSort				();
 	void			Draw					( int subPrimID );
 	float			GetFitting				( USRect& worldRect, float hPad, float vPad );
 	u32				GetPropBounds			( USBox& bounds );
@@ -99,6 +111,7 @@ public:
 	void			GetWorldToWndMtx		( USMatrix4x4& worldToWnd );
 					MOAILayer				();
 					~MOAILayer				();
+	bool			PrepareCull				( u32 frame );
 	void			RegisterLuaClass		( MOAILuaState& state );
 	void			RegisterLuaFuncs		( MOAILuaState& state );
 	void			Render					();
@@ -34,6 +34,7 @@ public:
 		MOAIBox2DFixture_MissingInstance,
 		MOAIBox2DJoint_MissingInstance,
 		MOAIBox2DWorld_IsLocked,
+		MOAIDeck_NoAtlasRegions_S,
 		MOAIGfxDevice_OpenGLError_S,
 		MOAIGfxResource_MissingDevice,
 		MOAINode_AttributeNotFound,
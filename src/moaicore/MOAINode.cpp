@@ -400,6 +400,14 @@ bool MOAINode::ApplyAttrOp ( u32 attrID, MOAIAttrOp& attrOp, u32 op ) {
 	return false;
 }
 
+//----------------------------------------------------------------//
+bool MOAINode::CanUpdateInParallel () {
+
+	// nodes must opt in; only those whose update reads their sources and
+	// writes nothing but their own members may be evaluated on a worker
+	return false;
+}
+
 //----------------------------------------------------------------//
 bool MOAINode::CheckAttrExists ( u32 attrID ) {
 
@@ -453,6 +461,32 @@ void MOAINode::ClearNodeLink ( MOAINode& srcNode ) {
 	}
 }
 
+//----------------------------------------------------------------//
+u32 MOAINode::ComputeUpdateLevel ( u32 minLevel ) {
+
+	// one deeper than the deepest source; sources whose level is stale or not yet known are ignored
+	u32 level = minLevel;
+
+	MOAIDepLink* link = this->mPullLinks;
+	for ( ; link ; link = link->mNextInDest ) {
+		u32 sourceLevel = link->mSourceNode->mUpdateLevel;
+		if ( sourceLevel >= level ) {
+			level = sourceLevel + 1;
+		}
+	}
+	return level;
+}
+
+//----------------------------------------------------------------//
+void MOAINode::DepNodeEvaluate () {
+
+	// the first half of DepNodeUpdate; MOAINodeMgr extends the update
+	// on the main thread once every worker is done
+	this->mState = STATE_UPDATING;
+	this->PullAttributes ();
+	this->OnDepNodeUpdate ();
+}
+
 //----------------------------------------------------------------//
 void MOAINode::DepNodeUpdate () {
 	
@@ -502,6 +536,7 @@ void MOAINode::ForceUpdate () {
 
 	this->ScheduleUpdate ();
 	this->DepNodeUpdate ();
+	this->OnDepNodeFinish ();
 }
 
 //----------------------------------------------------------------//
@@ -512,6 +547,24 @@ u32 MOAINode::GetAttrFlags ( u32 attrID ) {
 	return attrOp.GetFlags ();
 }
 
+//----------------------------------------------------------------//
+bool MOAINode::GetDirectAttr ( u32 attrID, MOAIDirectAttr& attr ) {
+	UNUSED ( attrID );
+	UNUSED ( attr );
+
+	return false;
+}
+
+//----------------------------------------------------------------//
+bool MOAINode::HasScheduledSources () {
+
+	MOAIDepLink* link = this->mPullLinks;
+	for ( ; link ; link = link->mNextInDest ) {
+		if ( link->mSourceNode->mState == STATE_SCHEDULED ) return true;
+	}
+	return false;
+}
+
 //----------------------------------------------------------------//
 bool MOAINode::IsNodeUpstream ( MOAINode* node ) {
 
@@ -528,7 +581,8 @@ MOAINode::MOAINode () :
 	mPushLinks ( 0 ),
 	mState ( STATE_IDLE ),
 	mPrev ( 0 ),
-	mNext ( 0 ) {
+	mNext ( 0 ),
+	mUpdateLevel ( 0 ) {
 	
 	RTTI_SINGLE ( MOAILuaObject )
 }
@@ -551,6 +605,12 @@ MOAINode::~MOAINode () {
 	}
 }
 
+//----------------------------------------------------------------//
+// Called on the main thread once the pass that updated the node is over, and
+// so before any layer is culled; resolve here anything a cull worker reads.
+void MOAINode::OnDepNodeFinish () {
+}
+
 //----------------------------------------------------------------//
 void MOAINode::OnDepNodeUpdate () {
 }
@@ -25,6 +25,25 @@
 class MOAINode;
 class MOAIDepLink;
 
+//================================================================//
+// MOAIDirectAttr
+//================================================================//
+// A float attribute a node lets MOAIAnim write to in place instead of going
+// through ApplyAttrOp. Only attributes whose SET and ADD have no side effects
+// beyond the optional clamp may be handed out.
+class MOAIDirectAttr {
+public:
+
+	float*		mValue;
+	bool		mClamp;		// keep the value within [ 0, 1 ]
+
+	//----------------------------------------------------------------//
+	MOAIDirectAttr () :
+		mValue ( 0 ),
+		mClamp ( false ) {
+	}
+};
+
 //================================================================//
 // MOAINode
 //================================================================//
@@ -49,6 +68,7 @@ private:
 	u32				mState;
 	MOAINode*		mPrev;
 	MOAINode*		mNext;
+	u32				mUpdateLevel;	// dependency depth; only valid while MOAINodeMgr is updating
 
 	//----------------------------------------------------------------//
 	static int		_clearAttrLink		( lua_State* L );
@@ -65,10 +85,13 @@ private:
 	
 	//----------------------------------------------------------------//
 	void			ActivateOnLink		( MOAINode& srcNode );
+	u32				ComputeUpdateLevel	( u32 minLevel );
+	void			DepNodeEvaluate		();
 	void			DepNodeUpdate		();
 	void			ExtendUpdate		();
 	MOAIDepLink*	FindAttrLink		( int attrID );
 	MOAIDepLink*	FindNodeLink		( MOAINode& srcNode );
+	bool			HasScheduledSources	();
 	bool			IsNodeUpstream		( MOAINode* node );
 	void			PullAttributes		();
 	void			RemoveDepLink		( MOAIDepLink& link );
@@ -76,6 +99,8 @@ private:
 protected:
 
 	//----------------------------------------------------------------//
+	virtual bool	CanUpdateInParallel	();
+	virtual void	OnDepNodeFinish		();
 	virtual void	OnDepNodeUpdate		();
 	bool			PullLinkedAttr		( u32 attrID, MOAIAttrOp& attrOp );
 
@@ -150,6 +175,7 @@ protected:
 public:
 	
 	friend class MOAINodeMgr;
+	friend class MOAINodeUpdateTask;
 	
 	DECL_LUA_FACTORY ( MOAINode )
 	
@@ -161,6 +187,7 @@ public:
 	void			ClearNodeLink			( MOAINode& srcNode );
 	void			ForceUpdate				();
 	u32				GetAttrFlags			( u32 attrID );
+	virtual bool	GetDirectAttr			( u32 attrID, MOAIDirectAttr& attr );
 					MOAINode				();
 					~MOAINode				();
 	void			RegisterLuaClass		( MOAILuaState& state );
@@ -6,6 +6,56 @@
 #include <moaicore/MOAILogMessages.h>
 #include <moaicore/MOAINode.h>
 #include <moaicore/MOAINodeMgr.h>
+#include <moaicore/MOAITransform.h>
+
+//================================================================//
+// MOAINodeUpdateTask
+//================================================================//
+
+//----------------------------------------------------------------//
+// DepNodeEvaluate for a run of plain transforms, with the builds batched
+void MOAINodeUpdateTask::EvaluateTransforms ( MOAITransform** transforms, u32 total ) {
+
+	for ( u32 i = 0; i < total; ++i ) {
+		transforms [ i ]->mState = MOAINode::STATE_UPDATING;
+		transforms [ i ]->PullAttributes ();
+	}
+	MOAITransform::BuildBatch ( transforms, total );
+}
+
+//----------------------------------------------------------------//
+void MOAINodeUpdateTask::Execute () {
+
+	for ( u32 i = 0; i < this->mTotal; i += this->mStride ) {
+		this->mNodes [ i ]->DepNodeEvaluate ();
+	}
+	MOAINodeUpdateTask::EvaluateTransforms ( this->mTransforms, this->mTotalTransforms );
+}
+
+//----------------------------------------------------------------//
+MOAINodeUpdateTask::MOAINodeUpdateTask () :
+	mNodes ( 0 ),
+	mTotal ( 0 ),
+	mStride ( 1 ),
+	mTransforms ( 0 ),
+	mTotalTransforms ( 0 ) {
+}
+
+//----------------------------------------------------------------//
+MOAINodeUpdateTask::~MOAINodeUpdateTask () {
+}
+
+//----------------------------------------------------------------//
+void MOAINodeUpdateTask::Update ( MOAINode** nodes, u32 total, u32 stride, MOAITransform** transforms, u32 totalTransforms ) {
+
+	this->mNodes = nodes;
+	this->mTotal = total;
+	this->mStride = stride;
+	this->mTransforms = transforms;
+	this->mTotalTransforms = totalTransforms;
+	
+	this->Start ();
+}
 
 //================================================================//
 // MOAINodeMgr
@@ -104,22 +154,72 @@ void MOAINodeMgr::Remove ( MOAINode& node ) {
 	node.Release ();
 }
 
+//----------------------------------------------------------------//
+u32 MOAINodeMgr::SortBatch ( u32 base ) {
+
+	u32 total = this->mBatch.GetTop ();
+	u32 top = base;
+	
+	// the list keeps sources ahead of the nodes they feed, so one pass sees every
+	// source's level before it is needed. sources outside the batch (or behind the
+	// node in the list) don't count; UpdateLevel keeps those nodes off the workers.
+	for ( u32 i = 0; i < total; ++i ) {
+	
+		MOAINode* node = this->mBatch [ i ];
+		u32 level = node->ComputeUpdateLevel ( base + 1 );
+		node->mUpdateLevel = level;
+		top = MAX ( top, level );
+	}
+	
+	// counting sort; nodes keep their list order within a level
+	u32 levels = top - base;
+	this->mLevelCounts.Grow ( levels + 1 );
+	memset ( this->mLevelCounts.Data (), 0, ( levels + 1 ) * sizeof ( u32 ));
+	
+	for ( u32 i = 0; i < total; ++i ) {
+		this->mLevelCounts [ this->mBatch [ i ]->mUpdateLevel - base ]++;
+	}
+	
+	u32 offset = 0;
+	for ( u32 i = 1; i <= levels; ++i ) {
+		u32 count = this->mLevelCounts [ i ];
+		this->mLevelCounts [ i ] = offset;
+		offset += count;
+	}
+	
+	this->mSorted.SetTop ( total );
+	for ( u32 i = 0; i < total; ++i ) {
+		MOAINode* node = this->mBatch [ i ];
+		this->mSorted [ this->mLevelCounts [ node->mUpdateLevel - base ]++ ] = node;
+	}
+	
+	// mLevelCounts [ i ] is now the end of level i in mSorted
+	return top;
+}
+
 //----------------------------------------------------------------//
 void MOAINodeMgr::Update () {
 
-	MOAINode* node = this->mUpdateListHead;
-	for ( ; node ; node = node->mNext ) {
-		node->DepNodeUpdate ();
+	if ( this->mParallelUpdate ) {
+		this->UpdateParallel ();
+	}
+	else {
+		MOAINode* node = this->mUpdateListHead;
+		for ( ; node ; node = node->mNext ) {
+			node->DepNodeUpdate ();
+		}
 	}
 	
 	// TODO: fix this up later
-	node = this->mUpdateListHead;
+	MOAINode* node = this->mUpdateListHead;
 	while ( node ) {
 		
 		MOAINode* temp = node;
 		node = node->mNext;
 		
+		temp->OnDepNodeFinish ();
 		temp->mState = MOAINode::STATE_IDLE;
+		temp->mUpdateLevel = 0;
 		temp->Release ();
 	}
 	
@@ -127,15 +227,125 @@ void MOAINodeMgr::Update () {
 	this->mUpdateListTail = 0;
 }
 
+//----------------------------------------------------------------//
+void MOAINodeMgr::UpdateLevel ( MOAINode** nodes, u32 total ) {
+
+	// a worker may only take a node that opted in and has no scheduled sources;
+	// pulling from a scheduled source would update the source as well
+	this->mParallel.Reset ();
+	this->mTransforms.Reset ();
+	
+	for ( u32 i = 0; i < total; ++i ) {
+	
+		MOAINode* node = nodes [ i ];
+		if (( node->mState == MOAINode::STATE_SCHEDULED ) && node->CanUpdateInParallel () && !node->HasScheduledSources ()) {
+		
+			MOAITransform* transform = MOAITransform::AsBatchable ( *node );
+			if ( transform ) {
+				this->mTransforms.Push ( transform );
+			}
+			else {
+				this->mParallel.Push ( node );
+			}
+		}
+	}
+	
+	u32 parallel = this->mParallel.GetTop ();
+	u32 transforms = this->mTransforms.GetTop ();
+	
+	if (( parallel + transforms ) >= MIN_PARALLEL_NODES ) {
+	
+		MOAINode** parallelNodes = this->mParallel.Data ();
+		MOAITransform** transformNodes = this->mTransforms.Data ();
+		u32 slots = UPDATE_THREAD_COUNT + 1;
+		
+		// the main thread takes every (UPDATE_THREAD_COUNT + 1)th node and the first run of
+		// transforms; the rest go to the workers. transforms are split into contiguous runs
+		// so each thread builds whole blocks of them.
+		u32 run = ( transforms + slots - 1 ) / slots;
+		
+		for ( u32 i = 0; i < UPDATE_THREAD_COUNT; ++i ) {
+		
+			u32 slot = i + 1;
+			u32 first = slot * run;
+			u32 count = ( first < transforms ) ? transforms - first : 0;
+			count = ( count < run ) ? count : run;
+			
+			MOAINodeUpdateTask* task = this->mUpdateThreads [ i ].NewTask < MOAINodeUpdateTask >();
+			task->Update ( &parallelNodes [ slot ], ( slot < parallel ) ? parallel - slot : 0, slots, &transformNodes [ first ], count );
+		}
+		
+		for ( u32 i = 0; i < parallel; i += slots ) {
+			parallelNodes [ i ]->DepNodeEvaluate ();
+		}
+		MOAINodeUpdateTask::EvaluateTransforms ( transformNodes, ( run < transforms ) ? run : transforms );
+		
+		for ( u32 i = 0; i < UPDATE_THREAD_COUNT; ++i ) {
+			this->mUpdateThreads [ i ].Drain ();
+		}
+		
+		// scheduling touches the update list, so finish the updates here and in list order
+		for ( u32 i = 0; i < total; ++i ) {
+		
+			MOAINode* node = nodes [ i ];
+			if ( node->mState == MOAINode::STATE_UPDATING ) {
+				node->ExtendUpdate ();
+				node->mState = MOAINode::STATE_ACTIVE;
+			}
+		}
+	}
+	
+	// everything else (including the nodes above, if there were too few of them) updates here
+	for ( u32 i = 0; i < total; ++i ) {
+		nodes [ i ]->DepNodeUpdate ();
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAINodeMgr::UpdateParallel () {
+
+	MOAINode* cursor = this->mUpdateListHead;
+	u32 base = 0;
+	
+	// nodes scheduled while a batch updates are pushed after it; they make the next batch
+	while ( cursor ) {
+	
+		MOAINode* last = this->mUpdateListTail;
+		
+		this->mBatch.Reset ();
+		for ( MOAINode* node = cursor; node; node = node->mNext ) {
+			this->mBatch.Push ( node );
+			if ( node == last ) break;
+		}
+		
+		u32 top = this->SortBatch ( base );
+		
+		u32 start = 0;
+		for ( u32 i = 1; i <= ( top - base ); ++i ) {
+			u32 end = this->mLevelCounts [ i ];
+			this->UpdateLevel ( &this->mSorted [ start ], end - start );
+			start = end;
+		}
+		
+		base = top;
+		cursor = last->mNext;
+	}
+}
+
 //----------------------------------------------------------------//
 MOAINodeMgr::MOAINodeMgr () :
 	mUpdateListHead ( 0 ),
-	mUpdateListTail ( 0 ) {
+	mUpdateListTail ( 0 ),
+	mParallelUpdate ( false ) {
 }
 
 //----------------------------------------------------------------//
 MOAINodeMgr::~MOAINodeMgr () {
 
+	for ( u32 i = 0; i < UPDATE_THREAD_COUNT; ++i ) {
+		this->mUpdateThreads [ i ].Stop ();
+	}
+
 	MOAINode* cursor = this->mUpdateListHead;
 	while ( cursor ) {
 		MOAINode* node = cursor;
@@ -5,28 +5,77 @@
 #define MOAINODEMGR_H
 
 class MOAINode;
+class MOAITransform;
+
+//================================================================//
+// MOAINodeUpdateTask
+//================================================================//
+class MOAINodeUpdateTask :
+	public USTask < MOAINodeUpdateTask > {
+private:
+
+	MOAINode**			mNodes;
+	u32					mTotal;
+	u32					mStride;
+	MOAITransform**		mTransforms;
+	u32					mTotalTransforms;
+
+	//----------------------------------------------------------------//
+	void			Execute					();
+
+public:
+
+	//----------------------------------------------------------------//
+	static void		EvaluateTransforms		( MOAITransform** transforms, u32 total );
+					MOAINodeUpdateTask		();
+					~MOAINodeUpdateTask		();
+	void			Update					( MOAINode** nodes, u32 total, u32 stride, MOAITransform** transforms, u32 totalTransforms );
+};
 
 //================================================================//
 // MOAINodeMgr
 //================================================================//
+// Nodes in the update list are grouped into dependency levels: a node's
+// level is one more than the deepest of its sources updated in the same
+// pass. Nodes on one level never depend on each other, so when parallel
+// updates are turned on those that can update in parallel are spread
+// across a small pool of worker threads. Plain transforms are handed out
+// in contiguous runs and built a block at a time (MOAITransform::BuildBatch).
 class MOAINodeMgr :
 	public MOAIGlobalClass < MOAINodeMgr > {
 private:
 
+	static const u32 UPDATE_THREAD_COUNT = 3;
+	static const u32 MIN_PARALLEL_NODES = 64; // smaller levels aren't worth waking the workers for
+
 	MOAINode* mUpdateListHead;
 	MOAINode* mUpdateListTail;
 
+	USTaskThread	mUpdateThreads [ UPDATE_THREAD_COUNT ]; // the main thread updates alongside these
+
+	USLeanStack < MOAINode*, 256 >		mBatch;		// the stretch of the update list being updated, in list order
+	USLeanStack < MOAINode*, 256 >		mSorted;	// the same nodes sorted by level
+	USLeanStack < MOAINode*, 256 >		mParallel;	// scratch for the nodes of one level handed to the workers
+	USLeanStack < MOAITransform*, 256 >	mTransforms;	// scratch for the plain transforms of that level
+	USLeanArray < u32 >					mLevelCounts;
+	bool								mParallelUpdate;
+
 	//----------------------------------------------------------------//
 	void			InsertAfter			( MOAINode& cursor, MOAINode& node );
 	void			InsertBefore		( MOAINode& cursor, MOAINode& node );
 	void			PushBack			( MOAINode& node );
 	void			PushFront			( MOAINode& node );
 	void			Remove				( MOAINode& node );
+	u32				SortBatch			( u32 base );
+	void			UpdateLevel			( MOAINode** nodes, u32 total );
+	void			UpdateParallel		();
 
 public:
 
 	friend class MOAINode;
 
+	GET_SET ( bool, ParallelUpdate, mParallelUpdate )
+
 	//----------------------------------------------------------------//
 	void			Update				();
 					MOAINodeMgr			();
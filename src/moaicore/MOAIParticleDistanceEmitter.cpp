@@ -48,6 +48,13 @@ int MOAIParticleDistanceEmitter::_setDistance ( lua_State* L ) {
 // MOAIParticleDistanceEmitter
 //================================================================//
 
+//----------------------------------------------------------------//
+bool MOAIParticleDistanceEmitter::CanUpdateInParallel () {
+
+	// emits particles into the system while updating
+	return false;
+}
+
 //----------------------------------------------------------------//
 float MOAIParticleDistanceEmitter::GetRandomDistance () {
 
@@ -31,6 +31,7 @@ private:
 	static int		_setDistance			( lua_State* L );
 	
 	//----------------------------------------------------------------//
+	bool			CanUpdateInParallel		();
 	float			GetRandomDistance		();
 	void			OnDepNodeUpdate			();
 	void			OnUpdate				( float step );
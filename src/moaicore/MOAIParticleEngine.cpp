@@ -0,0 +1,485 @@
+// Copyright (c) 2010-2011 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#include "pch.h"
+#include <moaicore/MOAIParticle.h>
+#include <moaicore/MOAIParticleEngine.h>
+#include <moaicore/MOAIParticlePlugin.h>
+#include <moaicore/MOAIParticleScript.h>
+#include <moaicore/MOAIParticleState.h>
+#include <moaicore/MOAIParticleSystem.h>
+
+//================================================================//
+// MOAIParticleBatch
+//================================================================//
+
+//----------------------------------------------------------------//
+MOAIParticleBatch::MOAIParticleBatch () :
+	mState ( 0 ),
+	mTotal ( 0 ),
+	mStride ( 0 ),
+	mRegisters ( 0 ),
+	mT0 ( 0 ),
+	mT1 ( 0 ),
+	mConsts ( 0 ),
+	mSprites ( 0 ) {
+}
+
+//----------------------------------------------------------------//
+MOAIParticleBatch::~MOAIParticleBatch () {
+}
+
+//----------------------------------------------------------------//
+void MOAIParticleBatch::Reserve ( u32 total, u32 registers, u32 spriteColumns, bool gather ) {
+
+	u32 columns = 2 + CONST_COLUMNS + spriteColumns + ( gather ? registers : 0 );
+	this->mBuffer.Grow ( columns * total );
+
+	float* cursor = this->mBuffer.Data ();
+
+	this->mT0 = cursor;
+	cursor += total;
+
+	this->mT1 = cursor;
+	cursor += total;
+
+	this->mConsts = cursor;
+	cursor += CONST_COLUMNS * total;
+
+	this->mSprites = cursor;
+	cursor += spriteColumns * total;
+
+	if ( gather ) {
+		this->mRegisters = cursor;
+		this->mStride = total;
+	}
+	this->mTotal = total;
+}
+
+//================================================================//
+// MOAIParticleEngine
+//================================================================//
+
+//----------------------------------------------------------------//
+u32 MOAIParticleEngine::AffirmBatch ( MOAIParticleState& state ) {
+
+	for ( u32 i = 0; i < this->mTotalBatches; ++i ) {
+		if ( this->mBatches [ i ]->mState == &state ) return i;
+	}
+
+	if ( this->mTotalBatches == this->mBatches.GetTop ()) {
+		this->mBatches.Push ( new MOAIParticleBatch ());
+	}
+
+	MOAIParticleBatch& batch = *this->mBatches [ this->mTotalBatches ];
+	batch.mState = &state;
+	batch.mIndices.Reset ();
+
+	return this->mTotalBatches++;
+}
+
+//----------------------------------------------------------------//
+void MOAIParticleEngine::Clear () {
+
+	this->mBase = 0;
+	this->mTotal = 0;
+	this->mRetired = 0;
+}
+
+//----------------------------------------------------------------//
+void MOAIParticleEngine::Compact () {
+
+	// mBatchIDs is done with for this update; reuse it for the survivors' slots
+	u32* keep = this->mBatchIDs.Data ();
+	u32 end = this->mBase + this->mTotal;
+	u32 total = 0;
+
+	for ( u32 i = this->mBase; i < end; ++i ) {
+		if ( this->mStates [ i ]) {
+			keep [ total++ ] = i;
+		}
+	}
+
+	// survivors move down to the start of the columns; keep [ i ] >= i, so copying forward is safe
+	for ( u32 r = 0; r < this->mRegisterCount; ++r ) {
+		float* column = &this->mRegisters [ r * this->mStride ];
+		for ( u32 i = 0; i < total; ++i ) {
+			column [ i ] = column [ keep [ i ]];
+		}
+	}
+
+	float* age = this->mAge.Data ();
+	float* term = this->mTerm.Data ();
+	float* mass = this->mMass.Data ();
+	MOAIParticleState** states = this->mStates.Data ();
+
+	for ( u32 i = 0; i < total; ++i ) {
+		u32 idx = keep [ i ];
+		age [ i ] = age [ idx ];
+		term [ i ] = term [ idx ];
+		mass [ i ] = mass [ idx ];
+		states [ i ] = states [ idx ];
+	}
+
+	this->mBase = 0;
+	this->mTotal = total;
+}
+
+//----------------------------------------------------------------//
+void MOAIParticleEngine::FinishParticle ( MOAIParticleSystem& system, u32 idx ) {
+
+	MOAIParticleState& state = *this->mStates [ idx ];
+	MOAIParticleBatch& batch = *this->mBatches [ this->mBatchIDs [ idx ]];
+	u32 slot = this->mBatchSlots [ idx ];
+
+	MOAIParticleScript* render = state.mRender;
+	if ( render ) {
+		render->PushBatchSprites ( system, batch, slot );
+	}
+
+	MOAIParticlePlugin* plugin = state.mPlugin;
+	if ( plugin ) {
+
+		this->Gather ( idx );
+		this->mCurrent = idx;
+		float* r = this->mScratch.Data ();
+
+		// a particle changing state gets new registers from the next state's init
+		bool writeBack = !(( this->mAge [ idx ] >= this->mTerm [ idx ]) && state.mNext );
+
+		if ( !system.DeferRender ( *plugin, r, batch.mT0 [ slot ], batch.mT1 [ slot ], this->mTerm [ idx ], writeBack )) {
+
+			AKUParticleSprite sprite;
+			plugin->OnRender ( r, &r [ MOAIParticle::TOTAL_PARTICLE_REG ], &sprite, batch.mT0 [ slot ], batch.mT1 [ slot ], this->mTerm [ idx ]);
+			this->Scatter ( idx );
+
+			system.PushSprite ( sprite );
+		}
+	}
+
+	if ( this->mAge [ idx ] >= this->mTerm [ idx ]) {
+
+		MOAIParticleState* next = state.mNext;
+		if ( next ) {
+			this->InitParticle ( system, *next, idx );
+		}
+		else {
+			this->mStates [ idx ] = 0;
+		}
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAIParticleEngine::FinishUpdate () {
+
+	if ( this->mRetired ) {
+		this->Compact ();
+		this->mRetired = 0;
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAIParticleEngine::Gather ( u32 idx ) {
+
+	const float* src = &this->mRegisters [ idx ];
+	float* dst = this->mScratch.Data ();
+
+	for ( u32 r = 0; r < this->mRegisterCount; ++r ) {
+		dst [ r ] = src [ r * this->mStride ];
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAIParticleEngine::InitParticle ( MOAIParticleSystem& system, MOAIParticleState& state, u32 idx ) {
+
+	// init scripts and plugins are rare enough to leave to the interpreter
+	this->Gather ( idx );
+	this->mCurrent = idx;
+
+	MOAIParticle particle;
+	particle.mData = this->mScratch.Data ();
+	particle.mNext = 0;
+
+	state.InitParticle ( system, particle );
+	this->Scatter ( idx );
+
+	this->mAge [ idx ] = particle.mAge;
+	this->mTerm [ idx ] = particle.mTerm;
+	this->mMass [ idx ] = particle.mMass;
+	this->mStates [ idx ] = particle.mState;
+}
+
+//----------------------------------------------------------------//
+MOAIParticleEngine::MOAIParticleEngine () :
+	mCapacity ( 0 ),
+	mStride ( 0 ),
+	mRegisterCount ( 0 ),
+	mBase ( 0 ),
+	mTotal ( 0 ),
+	mRetired ( 0 ),
+	mCurrent ( 0 ),
+	mTotalBatches ( 0 ) {
+}
+
+//----------------------------------------------------------------//
+MOAIParticleEngine::~MOAIParticleEngine () {
+
+	for ( u32 i = 0; i < this->mBatches.GetTop (); ++i ) {
+		delete this->mBatches [ i ];
+	}
+}
+
+//----------------------------------------------------------------//
+bool MOAIParticleEngine::PushParticle ( MOAIParticleSystem& system, MOAIParticleState& state, float x, float y, float dx, float dy, bool cap ) {
+
+	if ( !this->mCapacity ) return false;
+
+	if ( this->mTotal >= this->mCapacity ) {
+
+		if ( cap ) return false;
+
+		// full and wrapping: drop the oldest particle
+		this->mBase++;
+		this->mTotal--;
+	}
+
+	if (( this->mBase + this->mTotal ) >= this->mStride ) {
+		this->Slide ();
+	}
+
+	u32 idx = this->mBase + this->mTotal++;
+
+	float* r = &this->mRegisters [ idx ];
+	u32 stride = this->mStride;
+
+	r [ MOAIParticle::PARTICLE_X * stride ] = x;
+	r [ MOAIParticle::PARTICLE_Y * stride ] = y;
+	r [ MOAIParticle::PARTICLE_DX * stride ] = dx;
+	r [ MOAIParticle::PARTICLE_DY * stride ] = dy;
+
+	for ( u32 i = MOAIParticle::TOTAL_PARTICLE_REG; i < this->mRegisterCount; ++i ) {
+		r [ i * stride ] = 0.0f;
+	}
+
+	this->InitParticle ( system, state, idx );
+	return true;
+}
+
+//----------------------------------------------------------------//
+void MOAIParticleEngine::ProcessParticle ( MOAIParticleSystem& system, u32 idx, float step ) {
+
+	this->Gather ( idx );
+	this->mCurrent = idx;
+
+	MOAIParticle particle;
+	particle.mAge = this->mAge [ idx ];
+	particle.mTerm = this->mTerm [ idx ];
+	particle.mMass = this->mMass [ idx ];
+	particle.mState = this->mStates [ idx ];
+	particle.mData = this->mScratch.Data ();
+	particle.mNext = 0;
+
+	particle.mState->ProcessParticle ( system, particle, step );
+	this->Scatter ( idx );
+
+	this->mAge [ idx ] = particle.mAge;
+	this->mTerm [ idx ] = particle.mTerm;
+	this->mMass [ idx ] = particle.mMass;
+	this->mStates [ idx ] = particle.mState;
+}
+
+//----------------------------------------------------------------//
+void MOAIParticleEngine::Reserve ( u32 maxParticles, u32 particleSize ) {
+
+	this->mCapacity = maxParticles;
+	this->mStride = maxParticles * 2;
+	this->mRegisterCount = particleSize;
+
+	this->mRegisters.Init ( particleSize * this->mStride );
+	this->mAge.Init ( this->mStride );
+	this->mTerm.Init ( this->mStride );
+	this->mMass.Init ( this->mStride );
+	this->mStates.Init ( this->mStride );
+	this->mBatchIDs.Init ( this->mStride );
+	this->mBatchSlots.Init ( this->mStride );
+	this->mScratch.Init ( particleSize ? particleSize : 1 );
+
+	this->Clear ();
+}
+
+//----------------------------------------------------------------//
+void MOAIParticleEngine::RunBatch ( MOAIParticleSystem& system, MOAIParticleBatch& batch, float step ) {
+
+	MOAIParticleState& state = *batch.mState;
+	MOAIParticleScript* render = state.mRender;
+
+	u32 total = batch.mIndices.GetTop ();
+	u32* indices = batch.mIndices.Data ();
+
+	// when every live particle shares the state, run on the engine's own columns
+	bool gather = ( total < this->mTotal );
+	batch.Reserve ( total, this->mRegisterCount, render ? render->GetSpriteColumns () : 0, gather );
+
+	if ( !gather ) {
+		batch.mRegisters = &this->mRegisters [ this->mBase ];
+		batch.mStride = this->mStride;
+	}
+
+	u32 stride = this->mStride;
+
+	float* x = &this->mRegisters [ MOAIParticle::PARTICLE_X * stride ];
+	float* y = &this->mRegisters [ MOAIParticle::PARTICLE_Y * stride ];
+	float* dx = &this->mRegisters [ MOAIParticle::PARTICLE_DX * stride ];
+	float* dy = &this->mRegisters [ MOAIParticle::PARTICLE_DY * stride ];
+
+	// age and forces, exactly as MOAIParticleState::ProcessParticle does them
+	for ( u32 i = 0; i < total; ++i ) {
+
+		u32 idx = indices [ i ];
+
+		float term = this->mTerm [ idx ];
+		float age = this->mAge [ idx ];
+
+		batch.mT0 [ i ] = age / term;
+
+		age += step;
+		if ( age > term ) {
+			age = term;
+		}
+
+		this->mAge [ idx ] = age;
+		batch.mT1 [ i ] = age / term;
+
+		USVec3D loc ( x [ idx ], y [ idx ], 0.0f );
+		USVec3D vel ( dx [ idx ], dy [ idx ], 0.0f );
+
+		state.GatherForces ( loc, vel, this->mMass [ idx ], step );
+
+		x [ idx ] = loc.mX;
+		y [ idx ] = loc.mY;
+		dx [ idx ] = vel.mX;
+		dy [ idx ] = vel.mY;
+	}
+
+	if ( !render ) return;
+
+	if ( gather ) {
+		for ( u32 r = 0; r < this->mRegisterCount; ++r ) {
+			const float* src = &this->mRegisters [ r * stride ];
+			float* dst = &batch.mRegisters [ r * total ];
+			for ( u32 i = 0; i < total; ++i ) {
+				dst [ i ] = src [ indices [ i ]];
+			}
+		}
+	}
+
+	render->RunBatch ( system, batch );
+
+	if ( gather ) {
+		for ( u32 r = 0; r < this->mRegisterCount; ++r ) {
+			const float* src = &batch.mRegisters [ r * total ];
+			float* dst = &this->mRegisters [ r * stride ];
+			for ( u32 i = 0; i < total; ++i ) {
+				dst [ indices [ i ]] = src [ i ];
+			}
+		}
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAIParticleEngine::Scatter ( u32 idx ) {
+
+	this->SetRegisters ( idx, this->mScratch.Data ());
+}
+
+//----------------------------------------------------------------//
+void MOAIParticleEngine::SetRegisters ( u32 idx, const float* registers ) {
+
+	float* dst = &this->mRegisters [ idx ];
+
+	for ( u32 r = 0; r < this->mRegisterCount; ++r ) {
+		dst [ r * this->mStride ] = registers [ r ];
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAIParticleEngine::Slide () {
+
+	if ( !this->mBase ) return;
+
+	u32 size = this->mTotal * sizeof ( float );
+
+	for ( u32 r = 0; r < this->mRegisterCount; ++r ) {
+		float* column = &this->mRegisters [ r * this->mStride ];
+		memmove ( column, &column [ this->mBase ], size );
+	}
+
+	memmove ( this->mAge.Data (), &this->mAge [ this->mBase ], size );
+	memmove ( this->mTerm.Data (), &this->mTerm [ this->mBase ], size );
+	memmove ( this->mMass.Data (), &this->mMass [ this->mBase ], size );
+	memmove ( this->mStates.Data (), &this->mStates [ this->mBase ], this->mTotal * sizeof ( MOAIParticleState* ));
+
+	this->mBase = 0;
+}
+
+//----------------------------------------------------------------//
+void MOAIParticleEngine::Update ( MOAIParticleSystem& system, float step ) {
+
+	this->mRetired = 0;
+	if ( !this->mTotal ) return;
+
+	u32 end = this->mBase + this->mTotal;
+
+	// sort the particles into one batch per state, keeping queue order within each
+	this->mTotalBatches = 0;
+	u32 batchID = 0;
+	MOAIParticleState* prevState = 0;
+	bool drawsRandom = false;
+
+	for ( u32 i = this->mBase; i < end; ++i ) {
+
+		MOAIParticleState* state = this->mStates [ i ];
+		if ( state != prevState ) {
+			batchID = this->AffirmBatch ( *state );
+			prevState = state;
+			drawsRandom = drawsRandom || ( state->mRender && state->mRender->GetDrawsRandom ());
+		}
+
+		MOAIParticleBatch& batch = *this->mBatches [ batchID ];
+
+		this->mBatchIDs [ i ] = batchID;
+		this->mBatchSlots [ i ] = batch.mIndices.GetTop ();
+		batch.mIndices.Push ( i );
+	}
+
+	u32 retired = 0;
+
+	if ( drawsRandom ) {
+	
+		// batches would draw a column at a time; go one particle at a time instead so the draws
+		// (and the init scripts' draws) come out in the same order as from the particle list
+		for ( u32 i = this->mBase; i < end; ++i ) {
+			this->ProcessParticle ( system, i, step );
+			if ( !this->mStates [ i ]) {
+				retired++;
+			}
+		}
+	}
+	else {
+	
+		for ( u32 i = 0; i < this->mTotalBatches; ++i ) {
+			this->RunBatch ( system, *this->mBatches [ i ], step );
+		}
+
+		// sprites, plugins and state changes go in queue order so the output matches the interpreter's
+		for ( u32 i = this->mBase; i < end; ++i ) {
+			this->FinishParticle ( system, i );
+			if ( !this->mStates [ i ]) {
+				retired++;
+			}
+		}
+	}
+
+	// survivors are compacted in FinishUpdate, once any held back plugin calls have written to them
+	this->mRetired = retired;
+}
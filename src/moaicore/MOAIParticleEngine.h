@@ -0,0 +1,109 @@
+// Copyright (c) 2010-2011 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#ifndef	MOAIPARTICLEENGINE_H
+#define	MOAIPARTICLEENGINE_H
+
+class MOAIParticleState;
+class MOAIParticleSystem;
+
+//================================================================//
+// MOAIParticleBatch
+//================================================================//
+// The particles of one state, laid out one column per register so a
+// script instruction can be run across all of them in a single loop.
+class MOAIParticleBatch {
+private:
+
+	friend class MOAIParticleEngine;
+	friend class MOAIParticleScript;
+
+	static const u32 CONST_COLUMNS = 3; // most value operands any instruction reads
+
+	MOAIParticleState*		mState;
+
+	u32						mTotal;
+	u32						mStride;		// distance between particle register columns
+	float*					mRegisters;		// register r of particle i is mRegisters [( r * mStride ) + i ]
+
+	float*					mT0;
+	float*					mT1;
+	float*					mConsts;		// CONST_COLUMNS scratch columns for constant operands
+	float*					mSprites;		// sprite register sets; set 0 soaks up writes made before the first sprite
+
+	USLeanStack < u32, 256 >	mIndices;	// engine slots of the batch's particles, in queue order
+	USLeanArray < float >		mBuffer;	// backing for the columns above (and the registers when gathered)
+
+	//----------------------------------------------------------------//
+	void			Reserve					( u32 total, u32 registers, u32 spriteColumns, bool gather );
+
+public:
+
+	//----------------------------------------------------------------//
+					MOAIParticleBatch		();
+					~MOAIParticleBatch		();
+};
+
+//================================================================//
+// MOAIParticleEngine
+//================================================================//
+// Alternative to the particle list in MOAIParticleSystem. Particles live in
+// columns (one per register) in queue order. Each update groups them by
+// state and runs the state's render script an instruction at a time across
+// the whole group, then pushes sprites and retires particles in queue order.
+// FinishUpdate compacts the survivors in place. Init scripts, plugins and state
+// changes still run through the interpreter one particle at a time, as do render
+// scripts that draw random numbers, so a seed gives the same draws as the list.
+class MOAIParticleEngine {
+private:
+
+	u32							mCapacity;
+	u32							mStride;		// 2 * mCapacity; the live window slides up as the oldest particles are dropped
+	u32							mRegisterCount;
+
+	u32							mBase;
+	u32							mTotal;
+	u32							mRetired;		// particles retired by the last update, still waiting to be compacted out
+	u32							mCurrent;		// slot of the particle whose registers are in mScratch
+
+	USLeanArray < float >				mRegisters;
+	USLeanArray < float >				mAge;
+	USLeanArray < float >				mTerm;
+	USLeanArray < float >				mMass;
+	USLeanArray < MOAIParticleState* >	mStates;
+	USLeanArray < u32 >					mBatchIDs;
+	USLeanArray < u32 >					mBatchSlots;
+	USLeanArray < float >				mScratch;	// one particle's registers, for the interpreter and plugins
+
+	USLeanStack < MOAIParticleBatch*, 8 >	mBatches;
+	u32										mTotalBatches;
+
+	//----------------------------------------------------------------//
+	u32					AffirmBatch			( MOAIParticleState& state );
+	void				Compact				();
+	void				FinishParticle		( MOAIParticleSystem& system, u32 idx );
+	void				Gather				( u32 idx );
+	void				InitParticle		( MOAIParticleSystem& system, MOAIParticleState& state, u32 idx );
+	void				ProcessParticle		( MOAIParticleSystem& system, u32 idx, float step );
+	void				RunBatch			( MOAIParticleSystem& system, MOAIParticleBatch& batch, float step );
+	void				Scatter				( u32 idx );
+	void				Slide				();
+
+public:
+
+	GET ( u32, Capacity, mCapacity )
+	GET ( u32, Current, mCurrent )
+	GET ( u32, Total, mTotal )
+
+	//----------------------------------------------------------------//
+	void			Clear					();
+	void			FinishUpdate			();
+					MOAIParticleEngine		();
+					~MOAIParticleEngine		();
+	bool			PushParticle			( MOAIParticleSystem& system, MOAIParticleState& state, float x, float y, float dx, float dy, bool cap );
+	void			Reserve					( u32 maxParticles, u32 particleSize );
+	void			SetRegisters			( u32 idx, const float* registers );
+	void			Update					( MOAIParticleSystem& system, float step );
+};
+
+#endif
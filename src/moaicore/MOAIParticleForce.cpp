@@ -115,6 +115,13 @@ int MOAIParticleForce::_setType ( lua_State* L ) {
 // MOAIParticleForce
 //================================================================//
 
+//----------------------------------------------------------------//
+bool MOAIParticleForce::CanUpdateInParallel () {
+
+	// the update only caches the force's own world location and vector
+	return true;
+}
+
 //----------------------------------------------------------------//
 void MOAIParticleForce::Eval ( const USVec3D& loc, float mass, USVec3D& acceleration, USVec3D& offset ) {
 
@@ -45,6 +45,7 @@ private:
 	static int		_setType				( lua_State* L );
 	
 	//----------------------------------------------------------------//
+	bool			CanUpdateInParallel		();
 
 public:
 	
@@ -0,0 +1,132 @@
+// Copyright (c) 2010-2011 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#include "pch.h"
+#include <moaicore/MOAIParticleMgr.h>
+#include <moaicore/MOAIParticleSystem.h>
+
+//================================================================//
+// MOAIParticleUpdateTask
+//================================================================//
+
+//----------------------------------------------------------------//
+void MOAIParticleUpdateTask::Execute () {
+
+	for ( u32 i = 0; i < this->mTotal; i += this->mStride ) {
+		MOAIParticleSystem* system = this->mSystems [ i ];
+		system->UpdateParticles ( system->mPendingStep );
+	}
+}
+
+//----------------------------------------------------------------//
+MOAIParticleUpdateTask::MOAIParticleUpdateTask () :
+	mSystems ( 0 ),
+	mTotal ( 0 ),
+	mStride ( 1 ) {
+}
+
+//----------------------------------------------------------------//
+MOAIParticleUpdateTask::~MOAIParticleUpdateTask () {
+}
+
+//----------------------------------------------------------------//
+void MOAIParticleUpdateTask::Update ( MOAIParticleSystem** systems, u32 total, u32 stride ) {
+
+	this->mSystems = systems;
+	this->mTotal = total;
+	this->mStride = stride;
+	
+	this->Start ();
+}
+
+//================================================================//
+// MOAIParticleMgr
+//================================================================//
+
+//----------------------------------------------------------------//
+MOAIParticleMgr::MOAIParticleMgr () :
+	mParallelUpdate ( false ) {
+}
+
+//----------------------------------------------------------------//
+MOAIParticleMgr::~MOAIParticleMgr () {
+
+	for ( u32 i = 0; i < UPDATE_THREAD_COUNT; ++i ) {
+		this->mUpdateThreads [ i ].Stop ();
+	}
+	
+	for ( u32 i = 0; i < this->mPending.GetTop (); ++i ) {
+		this->mPending [ i ]->Release ();
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAIParticleMgr::PushSystem ( MOAIParticleSystem& system, float step ) {
+
+	if ( !system.mUpdateQueued ) {
+		system.Retain ();
+		system.mUpdateQueued = true;
+		this->mPending.Push ( &system );
+	}
+	system.mUpdatePending = true;
+	system.mPendingStep = step;
+}
+
+//----------------------------------------------------------------//
+void MOAIParticleMgr::Update () {
+
+	u32 queued = this->mPending.GetTop ();
+	if ( !queued ) return;
+	
+	// systems that already caught up (see MOAIParticleSystem::FinishPendingUpdate) are only released.
+	// the rest are no longer pending once picked, so sprites pushed as they update don't catch them up again.
+	this->mUpdates.Reset ();
+	for ( u32 i = 0; i < queued; ++i ) {
+	
+		MOAIParticleSystem* system = this->mPending [ i ];
+		if ( system->mUpdatePending ) {
+			system->mUpdatePending = false;
+			system->mDeferCallbacks = true;
+			system->mRandSeed = ( u32 )rand ();
+			this->mUpdates.Push ( system );
+		}
+	}
+	
+	u32 total = this->mUpdates.GetTop ();
+	if ( total ) {
+	
+		MOAIParticleSystem** systems = this->mUpdates.Data ();
+		
+		// the main thread takes every (workers + 1)th system; the rest go to the workers
+		u32 workers = MIN ( UPDATE_THREAD_COUNT, total - 1 );
+		u32 slots = workers + 1;
+		
+		for ( u32 i = 0; i < workers; ++i ) {
+			MOAIParticleUpdateTask* task = this->mUpdateThreads [ i ].NewTask < MOAIParticleUpdateTask >();
+			task->Update ( &systems [ i + 1 ], total - ( i + 1 ), slots );
+		}
+		
+		for ( u32 i = 0; i < total; i += slots ) {
+			systems [ i ]->UpdateParticles ( systems [ i ]->mPendingStep );
+		}
+		
+		for ( u32 i = 0; i < workers; ++i ) {
+			this->mUpdateThreads [ i ].Drain ();
+		}
+		
+		// held back plugin calls and node scheduling happen here, in the order the systems were queued
+		for ( u32 i = 0; i < total; ++i ) {
+		
+			MOAIParticleSystem* system = systems [ i ];
+			
+			system->mDeferCallbacks = false;
+			system->PublishUpdate ();
+		}
+	}
+	
+	for ( u32 i = 0; i < queued; ++i ) {
+		this->mPending [ i ]->mUpdateQueued = false;
+		this->mPending [ i ]->Release ();
+	}
+	this->mPending.Reset ();
+}
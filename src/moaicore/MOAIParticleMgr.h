@@ -0,0 +1,67 @@
+// Copyright (c) 2010-2011 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#ifndef	MOAIPARTICLEMGR_H
+#define	MOAIPARTICLEMGR_H
+
+#include <moaicore/MOAIGlobals.h>
+
+class MOAIParticleSystem;
+
+//================================================================//
+// MOAIParticleUpdateTask
+//================================================================//
+class MOAIParticleUpdateTask :
+	public USTask < MOAIParticleUpdateTask > {
+private:
+
+	MOAIParticleSystem**	mSystems;
+	u32						mTotal;
+	u32						mStride;
+
+	//----------------------------------------------------------------//
+	void			Execute						();
+
+public:
+
+	//----------------------------------------------------------------//
+					MOAIParticleUpdateTask		();
+					~MOAIParticleUpdateTask		();
+	void			Update						( MOAIParticleSystem** systems, u32 total, u32 stride );
+};
+
+//================================================================//
+// MOAIParticleMgr
+//================================================================//
+// When parallel update is on, particle systems don't simulate as the action
+// tree reaches them; they queue up here instead. Once every action has
+// updated, the queued systems simulate across a small pool of worker
+// threads, each into its own sprite buffer. Plugin calls that have to stay
+// on the main thread are held back and made, in order, as each system's
+// update is published. A queued system that is given particles or sprites
+// before then takes its step on the spot, so the output matches a serial
+// update.
+class MOAIParticleMgr :
+	public MOAIGlobalClass < MOAIParticleMgr > {
+private:
+
+	static const u32 UPDATE_THREAD_COUNT = 3;
+
+	USTaskThread	mUpdateThreads [ UPDATE_THREAD_COUNT ]; // the main thread updates alongside these
+
+	USLeanStack < MOAIParticleSystem*, 32 >		mPending;
+	USLeanStack < MOAIParticleSystem*, 32 >		mUpdates;	// the queued systems still waiting for their step
+	bool										mParallelUpdate;
+
+public:
+
+	GET_SET ( bool, ParallelUpdate, mParallelUpdate )
+
+	//----------------------------------------------------------------//
+					MOAIParticleMgr			();
+					~MOAIParticleMgr		();
+	void			PushSystem				( MOAIParticleSystem& system, float step );
+	void			Update					();
+};
+
+#endif
@@ -744,6 +744,19 @@ void MOAIParticlePexPlugin::_renderRadialScript( float* particle, float* registe
 
 }
 
+//----------------------------------------------------------------//
+bool MOAIParticlePexPlugin::CanInitInParallel () {
+
+	// the init scripts draw from rand (), which the worker threads can't share
+	return false;
+}
+
+//----------------------------------------------------------------//
+bool MOAIParticlePexPlugin::CanRunInParallel () {
+
+	return true;
+}
+
 void  MOAIParticlePexPlugin::OnInit ( float* particle, float* registers)
 {
 	if(mEmitterType == EMITTER_GRAVITY)
@@ -136,6 +136,8 @@ public:
 	DECL_LUA_FACTORY ( MOAIParticlePexPlugin )
 	
 	//----------------------------------------------------------------//
+	bool			CanInitInParallel			();
+	bool			CanRunInParallel			();
 					MOAIParticlePexPlugin		();
 					~MOAIParticlePexPlugin		();
 	void			OnInit						( float* particle, float* registers );
@@ -28,6 +28,19 @@ int MOAIParticlePlugin::_getSize ( lua_State* L ) {
 // MOAIParticlePlugin
 //================================================================//
 
+//----------------------------------------------------------------//
+bool MOAIParticlePlugin::CanInitInParallel () {
+
+	return this->CanRunInParallel ();
+}
+
+//----------------------------------------------------------------//
+bool MOAIParticlePlugin::CanRunInParallel () {
+
+	// plugins may call back into the host; only run them on the main thread unless they say otherwise
+	return false;
+}
+
 //----------------------------------------------------------------//
 MOAIParticlePlugin::MOAIParticlePlugin () :
 	mSize ( 0 ) {
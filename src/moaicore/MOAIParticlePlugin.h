@@ -27,6 +27,8 @@ public:
 	//----------------------------------------------------------------//
 					MOAIParticlePlugin			();
 					~MOAIParticlePlugin			();	
+	virtual bool	CanInitInParallel			();
+	virtual bool	CanRunInParallel			();
 	virtual void	OnInit						( float* particle, float* registers ) = 0;
 	virtual void	OnRender					( float* particle, float* registers, AKUParticleSprite* sprite, float t0, float t1, float term ) = 0;
 	void			RegisterLuaClass			( MOAILuaState& state );
@@ -4,6 +4,7 @@
 #include "pch.h"
 #include <moaicore/MOAILogMessages.h>
 #include <moaicore/MOAIParticle.h>
+#include <moaicore/MOAIParticleEngine.h>
 #include <moaicore/MOAIParticleState.h>
 #include <moaicore/MOAIParticleScript.h>
 #include <moaicore/MOAIParticleSystem.h>
@@ -51,6 +52,52 @@
 		}														\
 	}
 
+// column versions of the above for RunBatch; constants are spread across a scratch column
+#define READ_COLUMN(col,bytecode)								\
+	type = *( bytecode++ );										\
+	regIdx = *( bytecode++ );									\
+	col = 0;													\
+																\
+	if ( type & PARAM_TYPE_REG_MASK ) {							\
+		if ( type == PARAM_TYPE_SPRITE_REG ) {					\
+			col = &spriteRegisters [ regIdx * total ];			\
+		}														\
+		else {													\
+			col = &particleRegisters [ regIdx * stride ];		\
+		}														\
+	}
+
+#define READ_VALUE_COLUMN(col,slot,bytecode)					\
+	type = *( bytecode++ );										\
+	col = 0;													\
+	if ( type == PARAM_TYPE_CONST ) {							\
+		dst = ( u8* )&value;										\
+		*( dst++ ) = *( bytecode++ );							\
+		*( dst++ ) = *( bytecode++ );							\
+		*( dst++ ) = *( bytecode++ );							\
+		*( dst++ ) = *( bytecode++ );							\
+	}															\
+	else {														\
+		regIdx = *( bytecode++ );								\
+		value = 0.0f;												\
+																\
+		if ( type & PARAM_TYPE_REG_MASK ) {						\
+			if ( type == PARAM_TYPE_SPRITE_REG ) {				\
+				col = &spriteRegisters [ regIdx * total ];		\
+			}													\
+			else {												\
+				col = &particleRegisters [ regIdx * stride ];	\
+			}													\
+		}														\
+	}															\
+	if ( !col ) {												\
+		float* fill = &batch.mConsts [ slot * total ];			\
+		for ( u32 i = 0; i < total; ++i ) {						\
+			fill [ i ] = value;									\
+		}														\
+		col = fill;												\
+	}
+
 #define READ_INT(var,bytecode)									\
 		dst = ( u8* )&var;										\
 		*( dst++ ) = *( bytecode++ );							\
@@ -532,9 +579,19 @@ u8* MOAIParticleScript::Compile () {
 	end.Init ( END, "" );
 
 	u32 size = 0;
+	this->mTotalSprites = 0;
+	this->mDrawsRandom = false;
 	FOREACH ( InstructionIt, instructionIt, this->mInstructions ) {
 		Instruction& instruction = *instructionIt;
 		size += instruction.GetSize ();
+		
+		if ( instruction.mOpcode == SPRITE ) {
+			this->mTotalSprites++;
+		}
+		
+		if (( instruction.mOpcode == RAND ) || ( instruction.mOpcode == RAND_VEC )) {
+			this->mDrawsRandom = true;
+		}
 	}
 	size += end.GetSize ();
 	
@@ -558,9 +615,18 @@ u8* MOAIParticleScript::Compile () {
 	return this->mBytecode;
 }
 
+//----------------------------------------------------------------//
+u32 MOAIParticleScript::GetSpriteColumns () {
+
+	// one set of sprite registers per sprite instruction, plus one for writes made before the first
+	return ( this->mTotalSprites + 1 ) * TOTAL_SPRITE_REG;
+}
+
 //----------------------------------------------------------------//
 MOAIParticleScript::MOAIParticleScript () :
-	mCompiled ( false ) {
+	mCompiled ( false ),
+	mDrawsRandom ( false ),
+	mTotalSprites ( 0 ) {
 	
 	RTTI_BEGIN
 		RTTI_EXTEND ( MOAILuaObject )
@@ -595,6 +661,22 @@ u64 MOAIParticleScript::Pack64 ( u32 low, u32 hi ) {
 	return val64;
 }
 
+//----------------------------------------------------------------//
+void MOAIParticleScript::PushBatchSprites ( MOAIParticleSystem& system, const MOAIParticleBatch& batch, u32 idx ) {
+
+	float registers [ TOTAL_SPRITE_REG ];
+	u32 total = batch.mTotal;
+
+	for ( u32 i = 1; i <= this->mTotalSprites; ++i ) {
+	
+		const float* set = &batch.mSprites [ i * TOTAL_SPRITE_REG * total ];
+		for ( u32 j = 0; j < TOTAL_SPRITE_REG; ++j ) {
+			registers [ j ] = set [( j * total ) + idx ];
+		}
+		this->PushSprite ( system, registers );
+	}
+}
+
 //----------------------------------------------------------------//
 void MOAIParticleScript::PushSprite ( MOAIParticleSystem& system, float* registers ) {
 
@@ -856,7 +938,7 @@ void MOAIParticleScript::Run ( MOAIParticleSystem& system, MOAIParticle& particl
 				READ_VALUE	( v1, bytecode );
 				
 				if ( r0 ) {
-					*r0 = USFloat::Rand ( v0, v1 );
+					*r0 = system.Rand ( v0, v1 );
 				}
 				break;
 				
@@ -867,8 +949,8 @@ void MOAIParticleScript::Run ( MOAIParticleSystem& system, MOAIParticle& particl
 				READ_VALUE	( v0, bytecode );
 				READ_VALUE	( v1, bytecode );
 				
-				v2 = USFloat::Rand ( 360.0f ) * ( float )D2R;
-				v3 = USFloat::Rand ( v0,  v1 );
+				v2 = system.Rand ( 0.0f, 360.0f ) * ( float )D2R;
+				v3 = system.Rand ( v0,  v1 );
 				
 				if ( r0 ) {
 					*r0 = Cos ( v2 ) * v3;
@@ -978,3 +1060,347 @@ void MOAIParticleScript::Run ( MOAIParticleSystem& system, MOAIParticle& particl
 		this->PushSprite ( system, spriteRegisters );
 	}
 }
+
+//----------------------------------------------------------------//
+void MOAIParticleScript::RunBatch ( MOAIParticleSystem& system, MOAIParticleBatch& batch ) {
+
+	// same instructions as Run, but each is decoded once and applied down whole columns.
+	// operands are read into locals before any write so registers may alias as they do in Run.
+	// rand draws come out column by column, so MOAIParticleEngine doesn't batch scripts that draw.
+	u8* dst;
+	u8* bytecode = this->mBytecode;
+	if ( !bytecode ) return;
+	
+	u32 total = batch.mTotal;
+	u32 stride = batch.mStride;
+	
+	float* particleRegisters = batch.mRegisters;
+	float* spriteRegisters = batch.mSprites;
+	const float* t0 = batch.mT0;
+	const float* t1 = batch.mT1;
+	
+	float* r0;
+	float* r1;
+	float* c0;
+	float* c1;
+	float* c2;
+	float value;
+	u32 i0;
+	
+	u8 type;
+	u8 regIdx;
+	
+	u32 spriteSet = 0;
+	
+	for ( u8 opcode = *( bytecode++ ); opcode != END; opcode = *( bytecode++ )) {
+		
+		switch ( opcode ) {
+			
+			case ADD: // RVV
+				
+				READ_COLUMN			( r0, bytecode );
+				READ_VALUE_COLUMN	( c0, 0, bytecode );
+				READ_VALUE_COLUMN	( c1, 1, bytecode );
+				
+				if ( r0 ) {
+					for ( u32 i = 0; i < total; ++i ) {
+						r0 [ i ] = c0 [ i ] + c1 [ i ];
+					}
+				}
+				break;
+			
+			case ANGLE_VEC: // RRV
+				
+				READ_COLUMN			( r0, bytecode );
+				READ_COLUMN			( r1, bytecode );
+				READ_VALUE_COLUMN	( c0, 0, bytecode );
+				
+				if ( r0 && r1 ) {
+					for ( u32 i = 0; i < total; ++i ) {
+						float v0 = c0 [ i ];
+						r0 [ i ] = ( float )( Cos ( v0 * ( float )D2R ));
+						r1 [ i ] = ( float )( Sin ( v0 * ( float )D2R ));
+					}
+				}
+				break;
+			
+			case COS: // RV
+				
+				READ_COLUMN			( r0, bytecode );
+				READ_VALUE_COLUMN	( c0, 0, bytecode );
+				
+				if ( r0 ) {
+					for ( u32 i = 0; i < total; ++i ) {
+						r0 [ i ] = ( float )( cos ( c0 [ i ]));
+					}
+				}
+				break;
+			
+			case CYCLE: // RVVV
+				
+				READ_COLUMN			( r0, bytecode );
+				READ_VALUE_COLUMN	( c0, 0, bytecode );
+				READ_VALUE_COLUMN	( c1, 1, bytecode );
+				READ_VALUE_COLUMN	( c2, 2, bytecode );
+				
+				if ( r0 ) {
+					for ( u32 i = 0; i < total; ++i ) {
+					
+						float v0 = c0 [ i ];
+						float v1 = c1 [ i ];
+						float v3 = c2 [ i ] - v1;
+						v3 = ( v3 < 0.0f ) ? -v3 : v3;
+						
+						float cycle = ( v0 - v1 ) / v3;
+						int cycleIdx = USFloat::ToInt ( USFloat::Floor ( cycle ));
+						float cycleDec = cycle - ( float )cycleIdx;
+						
+						if ( cycleIdx & 0x01 ) {
+							cycleDec = 1.0f - cycleDec;
+						}
+						r0 [ i ] = v1 + ( cycleDec * v3 );
+					}
+				}
+				break;
+			
+			case DIV: // RVV
+				
+				READ_COLUMN			( r0, bytecode );
+				READ_VALUE_COLUMN	( c0, 0, bytecode );
+				READ_VALUE_COLUMN	( c1, 1, bytecode );
+				
+				if ( r0 ) {
+					for ( u32 i = 0; i < total; ++i ) {
+						r0 [ i ] = c0 [ i ] / c1 [ i ];
+					}
+				}
+				break;
+			
+			case EASE: // RVVI
+				
+				READ_COLUMN			( r0, bytecode );
+				READ_VALUE_COLUMN	( c0, 0, bytecode );
+				READ_VALUE_COLUMN	( c1, 1, bytecode );
+				READ_INT			( i0, bytecode );
+				
+				if ( r0 ) {
+					for ( u32 i = 0; i < total; ++i ) {
+						r0 [ i ] = USInterpolate::Interpolate ( i0, c0 [ i ], c1 [ i ], t1 [ i ]);
+					}
+				}
+				break;
+			
+			case EASE_DELTA: // RVVI
+				
+				READ_COLUMN			( r0, bytecode );
+				READ_VALUE_COLUMN	( c0, 0, bytecode );
+				READ_VALUE_COLUMN	( c1, 1, bytecode );
+				READ_INT			( i0, bytecode );
+				
+				if ( r0 ) {
+					for ( u32 i = 0; i < total; ++i ) {
+						float v2 = USInterpolate::Interpolate ( i0, c0 [ i ], c1 [ i ], t0 [ i ]);
+						float v3 = USInterpolate::Interpolate ( i0, c0 [ i ], c1 [ i ], t1 [ i ]);
+						r0 [ i ] += ( v3 - v2 );
+					}
+				}
+				break;
+			
+			case MUL: // RVV
+				
+				READ_COLUMN			( r0, bytecode );
+				READ_VALUE_COLUMN	( c0, 0, bytecode );
+				READ_VALUE_COLUMN	( c1, 1, bytecode );
+				
+				if ( r0 ) {
+					for ( u32 i = 0; i < total; ++i ) {
+						r0 [ i ] = c0 [ i ] * c1 [ i ];
+					}
+				}
+				break;
+			
+			case NORM: // RRVV
+				
+				READ_COLUMN			( r0, bytecode );
+				READ_COLUMN			( r1, bytecode );
+				READ_VALUE_COLUMN	( c0, 0, bytecode );
+				READ_VALUE_COLUMN	( c1, 1, bytecode );
+				
+				if ( r0 && r1 ) {
+					for ( u32 i = 0; i < total; ++i ) {
+					
+						float v0 = c0 [ i ];
+						float v1 = c1 [ i ];
+						float v3 = Sqrt (( v0 * v0 ) + ( v1 * v1 ));
+						
+						if ( v3 ) {
+							r0 [ i ] = ( float )( v0 / v3 );
+							r1 [ i ] = ( float )( v1 / v3 );
+						}
+						else {
+							r0 [ i ] = 0;
+							r1 [ i ] = 0;
+						}
+					}
+				}
+				break;
+			
+			case RAND: // RVV
+				
+				READ_COLUMN			( r0, bytecode );
+				READ_VALUE_COLUMN	( c0, 0, bytecode );
+				READ_VALUE_COLUMN	( c1, 1, bytecode );
+				
+				if ( r0 ) {
+					for ( u32 i = 0; i < total; ++i ) {
+						r0 [ i ] = system.Rand ( c0 [ i ], c1 [ i ]);
+					}
+				}
+				break;
+			
+			case RAND_VEC: // RRVV
+				
+				READ_COLUMN			( r0, bytecode );
+				READ_COLUMN			( r1, bytecode );
+				READ_VALUE_COLUMN	( c0, 0, bytecode );
+				READ_VALUE_COLUMN	( c1, 1, bytecode );
+				
+				// draws even with no destination, as Run does
+				for ( u32 i = 0; i < total; ++i ) {
+				
+					float v2 = system.Rand ( 0.0f, 360.0f ) * ( float )D2R;
+					float v3 = system.Rand ( c0 [ i ], c1 [ i ]);
+					
+					if ( r0 ) {
+						r0 [ i ] = Cos ( v2 ) * v3;
+					}
+					
+					if ( r1 ) {
+						r1 [ i ] = -Sin ( v2 ) * v3;
+					}
+				}
+				break;
+			
+			case SET: // RV
+				
+				READ_COLUMN			( r0, bytecode );
+				READ_VALUE_COLUMN	( c0, 0, bytecode );
+				
+				if ( r0 && ( r0 != c0 )) {
+					memcpy ( r0, c0, total * sizeof ( float ));
+				}
+				break;
+			
+			case SIN: // RV
+				
+				READ_COLUMN			( r0, bytecode );
+				READ_VALUE_COLUMN	( c0, 0, bytecode );
+				
+				if ( r0 ) {
+					for ( u32 i = 0; i < total; ++i ) {
+						r0 [ i ] = ( float )( sin ( c0 [ i ]));
+					}
+				}
+				break;
+			
+			case SPRITE: { //
+				
+				// each sprite instruction gets a fresh set of registers; MOAIParticleScript::PushBatchSprites pushes them later
+				spriteRegisters = &batch.mSprites [ ++spriteSet * TOTAL_SPRITE_REG * total ];
+				
+				memcpy ( &spriteRegisters [ SPRITE_X_LOC * total ], &particleRegisters [ MOAIParticle::PARTICLE_X * stride ], total * sizeof ( float ));
+				memcpy ( &spriteRegisters [ SPRITE_Y_LOC * total ], &particleRegisters [ MOAIParticle::PARTICLE_Y * stride ], total * sizeof ( float ));
+				
+				static const float defaults [ TOTAL_SPRITE_REG ] = {
+					0.0f, 0.0f,				// SPRITE_X_LOC, SPRITE_Y_LOC (copied above)
+					0.0f,					// SPRITE_ROT
+					1.0f, 1.0f,				// SPRITE_X_SCL, SPRITE_Y_SCL
+					1.0f, 1.0f, 1.0f, 1.0f,	// SPRITE_RED, SPRITE_GREEN, SPRITE_BLUE, SPRITE_OPACITY
+					0.0f,					// SPRITE_GLOW
+					1.0f,					// SPRITE_IDX
+				};
+				
+				for ( u32 reg = SPRITE_ROT; reg < TOTAL_SPRITE_REG; ++reg ) {
+					float* column = &spriteRegisters [ reg * total ];
+					for ( u32 i = 0; i < total; ++i ) {
+						column [ i ] = defaults [ reg ];
+					}
+				}
+				break;
+			}
+			case SUB: // RVV
+				
+				READ_COLUMN			( r0, bytecode );
+				READ_VALUE_COLUMN	( c0, 0, bytecode );
+				READ_VALUE_COLUMN	( c1, 1, bytecode );
+				
+				if ( r0 ) {
+					for ( u32 i = 0; i < total; ++i ) {
+						r0 [ i ] = c0 [ i ] - c1 [ i ];
+					}
+				}
+				break;
+			
+			case TAN: // RV
+				
+				READ_COLUMN			( r0, bytecode );
+				READ_VALUE_COLUMN	( c0, 0, bytecode );
+				
+				if ( r0 ) {
+					for ( u32 i = 0; i < total; ++i ) {
+						r0 [ i ] = ( float )( tan ( c0 [ i ]));
+					}
+				}
+				break;
+			
+			case TIME: // R
+				
+				READ_COLUMN			( r0, bytecode );
+				
+				if ( r0 ) {
+					memcpy ( r0, t1, total * sizeof ( float ));
+				}
+				break;
+			
+			case VEC_ANGLE: // RVV
+				
+				READ_COLUMN			( r0, bytecode );
+				READ_VALUE_COLUMN	( c0, 0, bytecode );
+				READ_VALUE_COLUMN	( c1, 1, bytecode );
+				
+				if ( r0 ) {
+					for ( u32 i = 0; i < total; ++i ) {
+						r0 [ i ] = ( float )( atan2 ( c0 [ i ], c1 [ i ]) * R2D );
+					}
+				}
+				break;
+			
+			case WRAP: // RVVV
+				
+				READ_COLUMN			( r0, bytecode );
+				READ_VALUE_COLUMN	( c0, 0, bytecode );
+				READ_VALUE_COLUMN	( c1, 1, bytecode );
+				READ_VALUE_COLUMN	( c2, 2, bytecode );
+				
+				if ( r0 ) {
+					for ( u32 i = 0; i < total; ++i ) {
+					
+						float v0 = c0 [ i ];
+						float v1 = c1 [ i ];
+						float v2 = c2 [ i ];
+						float v3 = v2 - v1;
+						
+						while ( v0 < v1 ) {
+							v0 += v3;
+						}
+						
+						while ( v0 >= v2 ) {
+							v0 -= v3;
+						}
+						r0 [ i ] = v0;
+					}
+				}
+				break;
+		}
+	}
+}
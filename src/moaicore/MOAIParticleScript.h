@@ -7,6 +7,7 @@
 #include <moaicore/MOAILua.h>
 
 class MOAIParticle;
+class MOAIParticleBatch;
 class MOAIParticleState;
 class MOAIParticleSystem;
 
@@ -105,6 +106,8 @@ private:
 	
 	USLeanArray < u8 > mBytecode;
 	bool mCompiled;
+	bool mDrawsRandom; // compiled script has rand or randVec instructions
+	u32 mTotalSprites; // number of sprite instructions in the compiled script
 
 	//----------------------------------------------------------------//
 	static int		_add				( lua_State* L );
@@ -139,6 +142,8 @@ public:
 	
 	DECL_LUA_FACTORY ( MOAIParticleScript )
 	
+	GET ( bool, DrawsRandom, mDrawsRandom )
+	
 	enum {
 		PARAM_TYPE_FLAG				= 0x00,
 		PARAM_TYPE_CONST			= 0x01,
@@ -151,11 +156,14 @@ public:
 	
 	//----------------------------------------------------------------//
 	u8*				Compile					();
+	u32				GetSpriteColumns		();
 					MOAIParticleScript		();
 					~MOAIParticleScript		();
+	void			PushBatchSprites		( MOAIParticleSystem& system, const MOAIParticleBatch& batch, u32 idx );
 	void			RegisterLuaClass		( MOAILuaState& state );
 	void			RegisterLuaFuncs		( MOAILuaState& state );
 	void			Run						( MOAIParticleSystem& system, MOAIParticle& particle, float t0, float t1 );
+	void			RunBatch				( MOAIParticleSystem& system, MOAIParticleBatch& batch );
 };
 
 #endif
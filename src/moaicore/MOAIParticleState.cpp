@@ -231,13 +231,13 @@ void MOAIParticleState::InitParticle ( MOAIParticleSystem& system, MOAIParticle&
 	}
 	
 	MOAIParticlePlugin* plugin = this->mPlugin;
-	if ( plugin ) {
+	if ( plugin && !system.DeferInit ( *plugin, particle.mData )) {
 		plugin->OnInit ( particle.mData, &particle.mData [ MOAIParticle::TOTAL_PARTICLE_REG ]);
 	}
 	
 	particle.mAge = 0.0f;
-	particle.mTerm = USFloat::Rand ( this->mTermRange [ 0 ], this->mTermRange [ 1 ]);
-	particle.mMass = USFloat::Rand ( this->mMassRange [ 0 ], this->mMassRange [ 1 ]);
+	particle.mTerm = system.Rand ( this->mTermRange [ 0 ], this->mTermRange [ 1 ]);
+	particle.mMass = system.Rand ( this->mMassRange [ 0 ], this->mMassRange [ 1 ]);
 	particle.mState = this;
 }
 
@@ -340,9 +340,15 @@ void MOAIParticleState::ProcessParticle ( MOAIParticleSystem& system, MOAIPartic
 	MOAIParticlePlugin* plugin = this->mPlugin;
 	if ( plugin ) {
 		
-		AKUParticleSprite sprite;
-		plugin->OnRender ( particle.mData, &particle.mData [ MOAIParticle::TOTAL_PARTICLE_REG ], &sprite, t0, t1, particle.mTerm );
-		system.PushSprite ( sprite );
+		// a particle changing state gets new registers from the next state's init
+		bool writeBack = !(( particle.mAge >= particle.mTerm ) && this->mNext );
+		
+		if ( !system.DeferRender ( *plugin, particle.mData, t0, t1, particle.mTerm, writeBack )) {
+		
+			AKUParticleSprite sprite;
+			plugin->OnRender ( particle.mData, &particle.mData [ MOAIParticle::TOTAL_PARTICLE_REG ], &sprite, t0, t1, particle.mTerm );
+			system.PushSprite ( sprite );
+		}
 	}
 
 	if ( particle.mAge >= particle.mTerm ) {
@@ -22,6 +22,7 @@ class MOAIParticleSystem;
 class MOAIParticleState :
 	public virtual MOAILuaObject {
 private:
+	friend class MOAIParticleEngine;
 	friend class MOAIParticleScript;
 	friend class MOAIParticleSystem;
 
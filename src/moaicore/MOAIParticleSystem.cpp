@@ -4,11 +4,18 @@
 #include "pch.h"
 #include <float.h>
 #include <moaicore/MOAIDeck.h>
+#include <moaicore/MOAIDeckRemapper.h>
 #include <moaicore/MOAIGfxDevice.h>
 #include <moaicore/MOAILogMessages.h>
+#include <moaicore/MOAIParticleEngine.h>
+#include <moaicore/MOAIParticleMgr.h>
+#include <moaicore/MOAIParticlePlugin.h>
 #include <moaicore/MOAIParticleState.h>
 #include <moaicore/MOAIParticleSystem.h>
+#include <moaicore/MOAIQuadBrush.h>
+#include <moaicore/MOAIShaderMgr.h>
 #include <moaicore/MOAITextureBase.h>
+#include <moaicore/MOAIVertexFormatMgr.h>
 
 class MOAIDataBuffer;
 
@@ -58,7 +65,9 @@ int MOAIParticleSystem::_capSprites ( lua_State* L ) {
 int MOAIParticleSystem::_clearSprites ( lua_State* L ) {
 	MOAI_LUA_SETUP ( MOAIParticleSystem, "U" )
 
+	self->FinishPendingUpdate ();
 	self->mSpriteTop = 0;
+	self->mHasBounds = false;
 	return 0;
 }
 
@@ -94,7 +103,7 @@ int  MOAIParticleSystem::_isIdle( lua_State* L ) {
 	
 	MOAI_LUA_SETUP ( MOAIParticleSystem, "U" )
 
-	bool result = !self->mHead;
+	bool result = self->mEngine ? ( self->mEngine->GetTotal () == 0 ) : !self->mHead;
 
 	lua_pushboolean ( state, result );
 	return 1;
@@ -302,6 +311,42 @@ int MOAIParticleSystem::_setState ( lua_State* L ) {
 	return 0;
 }
 
+//----------------------------------------------------------------//
+/**	@name	setVectorized
+	@text	Switches the system to an engine that keeps particle registers
+			in columns and runs each render script instruction across every
+			particle in a state at once. Sprites, particle registers,
+			random draws and state changes come out the same as with the
+			default engine. Init scripts, plugins and render scripts that
+			call rand or randVec still run one particle at a time, so only
+			render scripts without them gain from the switch. Switching
+			engines discards any live particles.
+	
+	@in		MOAIParticleSystem self
+	@opt	boolean vectorized		Default value is true.
+	@out	nil
+*/
+int MOAIParticleSystem::_setVectorized ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAIParticleSystem, "U" )
+
+	bool vectorized = state.GetValue < bool >( 2, true );
+	if ( vectorized == ( self->mEngine != 0 )) return 0;
+	
+	u32 maxParticles = self->mEngine ? self->mEngine->GetCapacity () : self->mParticles.Size ();
+	u32 particleSize = ( self->mParticleSize > MOAIParticle::TOTAL_PARTICLE_REG ) ? self->mParticleSize - MOAIParticle::TOTAL_PARTICLE_REG : 0;
+	
+	if ( vectorized ) {
+		self->mEngine = new MOAIParticleEngine ();
+	}
+	else {
+		delete self->mEngine;
+		self->mEngine = 0;
+	}
+	
+	self->ReserveParticles ( maxParticles, particleSize );
+	return 0;
+}
+
 //----------------------------------------------------------------//
 /**	@name	surge
 	@text	Release a batch emission or particles into the system.
@@ -334,6 +379,17 @@ int MOAIParticleSystem::_surge ( lua_State* L ) {
 // MOAIParticleSystem
 //================================================================//
 
+//----------------------------------------------------------------//
+bool MOAIParticleSystem::CanDrawBatched () {
+
+	// the shader takes the sprites in model space, so nothing may need CPU transformed vertices
+	if ( this->mUVTransform || this->mShader ) return false;
+	if ( this->mDeck->GetShader () || !this->mDeck->CanWriteQuads ()) return false;
+
+	MOAIGfxDevice& gfxDevice = MOAIGfxDevice::Get ();
+	return gfxDevice.IsProgrammable () && gfxDevice.UsesVertexBuffers ();
+}
+
 //----------------------------------------------------------------//
 void MOAIParticleSystem::ClearStates () {
 
@@ -350,6 +406,70 @@ void MOAIParticleSystem::ClearQueue () {
 	this->mTail = 0;
 }
 
+//----------------------------------------------------------------//
+MOAIParticleCallback* MOAIParticleSystem::DeferCallback ( MOAIParticlePlugin& plugin, float* particle ) {
+
+	// the call gets a copy of the registers as they are now
+	u32 data = this->mCallbackData.GetTop ();
+	this->mCallbackData.SetTop ( data + this->mParticleSize );
+	memcpy ( &this->mCallbackData [ data ], particle, this->mParticleSize * sizeof ( float ));
+	
+	u32 top = this->mCallbacks.GetTop ();
+	this->mCallbacks.SetTop ( top + 1 );
+	
+	MOAIParticleCallback& callback = this->mCallbacks [ top ];
+	
+	callback.mPlugin		= &plugin;
+	callback.mRender		= false;
+	callback.mWriteBack		= true;
+	callback.mTarget		= 0;
+	callback.mEngineIdx		= 0;
+	callback.mData			= data;
+	callback.mSprite		= MOAIParticleCallback::NO_SPRITE;
+	callback.mT0			= 0.0f;
+	callback.mT1			= 0.0f;
+	callback.mTerm			= 0.0f;
+	
+	// the engine hands plugins a scratch copy of the particle; write back to its slot instead
+	if ( this->mEngine ) {
+		callback.mEngineIdx = this->mEngine->GetCurrent ();
+	}
+	else {
+		callback.mTarget = particle;
+	}
+	return &callback;
+}
+
+//----------------------------------------------------------------//
+bool MOAIParticleSystem::DeferInit ( MOAIParticlePlugin& plugin, float* particle ) {
+
+	if (( !this->mDeferCallbacks ) || plugin.CanInitInParallel ()) return false;
+	
+	this->DeferCallback ( plugin, particle );
+	return true;
+}
+
+//----------------------------------------------------------------//
+bool MOAIParticleSystem::DeferRender ( MOAIParticlePlugin& plugin, float* particle, float t0, float t1, float term, bool writeBack ) {
+
+	if (( !this->mDeferCallbacks ) || plugin.CanRunInParallel ()) return false;
+
+	MOAIParticleCallback* callback = this->DeferCallback ( plugin, particle );
+	
+	callback->mRender		= true;
+	callback->mWriteBack	= writeBack;
+	callback->mT0			= t0;
+	callback->mT1			= t1;
+	callback->mTerm			= term;
+	
+	// hold the sprite's place so the output keeps the same order
+	u32 spriteID;
+	if ( this->ReserveSprite ( spriteID )) {
+		callback->mSprite = spriteID;
+	}
+	return true;
+}
+
 //----------------------------------------------------------------//
 void MOAIParticleSystem::Draw ( int subPrimID ) {
 	UNUSED ( subPrimID );
@@ -368,6 +488,11 @@ void MOAIParticleSystem::Draw ( int subPrimID ) {
 	}
 	
 	this->LoadGfxState ();
+	
+	if ( this->CanDrawBatched ()) {
+		this->DrawBatched ();
+		return;
+	}
 
 	USAffine3D drawingMtx;
 	USAffine3D spriteMtx;
@@ -398,6 +523,56 @@ void MOAIParticleSystem::Draw ( int subPrimID ) {
 	}
 }
 
+//----------------------------------------------------------------//
+void MOAIParticleSystem::DrawBatched () {
+
+	MOAIGfxDevice& gfxDevice = MOAIGfxDevice::Get ();
+	
+	u32 maxSprites = this->mSprites.Size ();
+	u32 total = MIN ( this->mSpriteTop, maxSprites );
+	if ( !total ) return;
+	
+	// buffers from a lost context are already gone
+	if ( this->mContextID != gfxDevice.GetContextID ()) {
+		this->mVertexBufferID = 0;
+	}
+	
+	if ( !this->mVertexBufferID ) {
+		glGenBuffers ( 1, &this->mVertexBufferID );
+		if ( !this->mVertexBufferID ) return;
+		this->mContextID = gfxDevice.GetContextID ();
+	}
+	
+	// the shader has to be in place before the world transform is set for it to pick up the matrix
+	gfxDevice.SetShaderPreset ( MOAIShaderMgr::PARTICLE_SHADER );
+	gfxDevice.SetPenColor ( 1.0f, 1.0f, 1.0f, 1.0f );
+	gfxDevice.SetVertexMtxMode ( MOAIGfxDevice::VTX_STAGE_MODEL, MOAIGfxDevice::VTX_STAGE_MODEL );
+	gfxDevice.SetUVMtxMode ( MOAIGfxDevice::UV_STAGE_MODEL, MOAIGfxDevice::UV_STAGE_TEXTURE );
+	gfxDevice.SetVertexTransform ( MOAIGfxDevice::VTX_WORLD_TRANSFORM, this->GetLocalToWorldMtx ());
+	
+	const MOAIVertexFormat& format = MOAIVertexFormatMgr::Get ().GetPreset ( MOAIVertexFormatMgr::PARTICLE );
+	
+	u32 maxQuads = MIN ( maxSprites, MOAIGfxDevice::MAX_QUADS );
+	if ( this->mVertices.Size () < ( maxQuads * 4 )) {
+		this->mVertices.Init ( maxQuads * 4 );
+	}
+	
+	u32 cursor = 0;
+	while ( cursor < total ) {
+	
+		u32 totalQuads = this->WriteSprites ( this->mVertices.Data (), cursor, maxQuads );
+		
+		if ( totalQuads ) {
+		
+			glBindBuffer ( GL_ARRAY_BUFFER, this->mVertexBufferID );
+			glBufferData ( GL_ARRAY_BUFFER, totalQuads * 4 * sizeof ( MOAIParticleVertex ), this->mVertices.Data (), GL_STREAM_DRAW );
+			glBindBuffer ( GL_ARRAY_BUFFER, 0 );
+			
+			gfxDevice.DrawQuadBuffer ( format, this->mVertexBufferID, totalQuads );
+		}
+	}
+}
+
 //----------------------------------------------------------------//
 void MOAIParticleSystem::EnqueueParticle ( MOAIParticle& particle ) {
 
@@ -412,6 +587,22 @@ void MOAIParticleSystem::EnqueueParticle ( MOAIParticle& particle ) {
 	this->mTail = &particle;
 }
 
+//----------------------------------------------------------------//
+void MOAIParticleSystem::FinishPendingUpdate () {
+
+	// a queued system that gets new particles or sprites before MOAIParticleMgr runs
+	// takes its step right away instead, so anything added after the action tree
+	// reached it waits for the next step, just as when updating serially
+	if ( !this->mUpdatePending ) return;
+
+	// cleared before UpdateParticles so sprites pushed during the update don't
+	// run FinishPendingUpdate again
+	this->mUpdatePending = false;
+
+	this->UpdateParticles ( this->mPendingStep );
+	this->PublishUpdate ();
+}
+
 //----------------------------------------------------------------//
 u32 MOAIParticleSystem::GetPropBounds ( USBox& bounds ) {
 
@@ -441,6 +632,32 @@ AKUParticleSprite* MOAIParticleSystem::GetTopSprite () {
 	return 0;
 }
 
+//----------------------------------------------------------------//
+void MOAIParticleSystem::GrowBounds ( const AKUParticleSprite& sprite ) {
+
+	// TODO: need to take rotation into account
+	USBox bounds = this->mDeck->GetBounds ( sprite.mGfxID, this->mRemapper );
+	
+	USVec3D offset ( sprite.mXLoc, sprite.mYLoc, 0.0f );
+	USVec3D scale ( sprite.mXScl, sprite.mYScl, 0.0f );
+	
+	bounds.Scale ( scale );
+	
+	float radius = bounds.GetMaxExtent () * 1.4f;
+	bounds.mMin.Init ( -radius, -radius, -radius );
+	bounds.mMax.Init ( radius, radius, radius );
+	
+	bounds.Offset ( offset );
+	
+	if ( !this->mHasBounds ) {
+		this->mParticleBounds = bounds;
+		this->mHasBounds = true;
+	}
+	else {
+		this->mParticleBounds.Grow ( bounds );
+	}
+}
+
 //----------------------------------------------------------------//
 bool MOAIParticleSystem::IsDone () {
 
@@ -456,7 +673,16 @@ MOAIParticleSystem::MOAIParticleSystem () :
 	mTail ( 0 ),
 	mFree ( 0 ),
 	mSpriteTop ( 0 ),
-	mComputeBounds ( false ) {
+	mComputeBounds ( false ),
+	mEngine ( 0 ),
+	mHasBounds ( false ),
+	mDeferCallbacks ( false ),
+	mUpdateQueued ( false ),
+	mUpdatePending ( false ),
+	mPendingStep ( 0.0f ),
+	mRandSeed ( 0 ),
+	mVertexBufferID ( 0 ),
+	mContextID ( 0 ) {
 	
 	RTTI_BEGIN
 		RTTI_EXTEND ( MOAIProp )
@@ -472,44 +698,77 @@ MOAIParticleSystem::MOAIParticleSystem () :
 MOAIParticleSystem::~MOAIParticleSystem () {
 
 	this->ClearStates ();
+	
+	if ( this->mEngine ) {
+		delete this->mEngine;
+	}
+	
+	// buffers from a lost context are already gone
+	if ( this->mVertexBufferID && MOAIGfxDevice::IsValid () && ( MOAIGfxDevice::Get ().GetContextID () == this->mContextID )) {
+		MOAIGfxDevice::Get ().PushDeleter ( MOAIGfxDeleter::DELETE_BUFFER, this->mVertexBufferID );
+	}
 }
 
 //----------------------------------------------------------------//
 void MOAIParticleSystem::OnUpdate ( float step ) {
 
-	// clear out the sprites
-	this->mSpriteTop = 0;
+	MOAIParticleMgr& particleMgr = MOAIParticleMgr::Get ();
+	
+	if ( particleMgr.GetParallelUpdate ()) {
+	
+		// updated twice in one frame; catch up on the first update before queuing the second
+		this->FinishPendingUpdate ();
+		particleMgr.PushSystem ( *this, step );
+		return;
+	}
 
-	this->mParticleBounds.Init ( 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f );
+	this->UpdateParticles ( step );
+	this->PublishUpdate ();
+}
 
-	// bail if no particles
-	if ( !this->mHead ) return;
+//----------------------------------------------------------------//
+void MOAIParticleSystem::PublishUpdate () {
 
-	// grab the head then clear out the queue
-	MOAIParticle* cursor = this->mHead;
-	this->ClearQueue ();
+	u32 maxSprites = this->mSprites.Size ();
+	u32 totalCallbacks = this->mCallbacks.GetTop ();
 	
-	// update the particles and rebuild the queue
-	while ( cursor ) {
-		MOAIParticle* particle = cursor;
-		cursor = cursor->mNext;
+	for ( u32 i = 0; i < totalCallbacks; ++i ) {
+	
+		MOAIParticleCallback& callback = this->mCallbacks [ i ];
+		float* r = &this->mCallbackData [ callback.mData ];
 		
-		// update the particle
-		if ( particle->mState ) {
-			particle->mState->ProcessParticle ( *this, *particle, step );
-		}
+		if ( callback.mRender ) {
 		
-		// if is still to be killed, move it to the free list, else put it back in the queue
-		if ( !particle->mState ) {
-			particle->mNext = this->mFree;
-			this->mFree = particle;
+			AKUParticleSprite sprite;
+			callback.mPlugin->OnRender ( r, &r [ MOAIParticle::TOTAL_PARTICLE_REG ], &sprite, callback.mT0, callback.mT1, callback.mTerm );
+			
+			// skip the sprite if later ones have wrapped around over it
+			if (( callback.mSprite != MOAIParticleCallback::NO_SPRITE ) && (( this->mSpriteTop - callback.mSprite ) <= maxSprites )) {
+				this->mSprites [ callback.mSprite % maxSprites ] = sprite;
+				this->GrowBounds ( sprite );
+			}
 		}
 		else {
-			// and put it back in the queue
-			this->EnqueueParticle ( *particle );
+			callback.mPlugin->OnInit ( r, &r [ MOAIParticle::TOTAL_PARTICLE_REG ]);
+		}
+		
+		if ( callback.mWriteBack ) {
+			if ( callback.mTarget ) {
+				memcpy ( callback.mTarget, r, this->mParticleSize * sizeof ( float ));
+			}
+			else if ( this->mEngine ) {
+				this->mEngine->SetRegisters ( callback.mEngineIdx, r );
+			}
 		}
 	}
 	
+	this->mCallbacks.Reset ();
+	this->mCallbackData.Reset ();
+	
+	if ( this->mEngine ) {
+		this->mEngine->FinishUpdate ();
+	}
+	
 	if ( this->mComputeBounds && this->mSpriteTop ) {
 		this->ScheduleUpdate ();
 	}
@@ -524,13 +783,19 @@ bool MOAIParticleSystem::PushParticle ( float x, float y ) {
 //----------------------------------------------------------------//
 bool MOAIParticleSystem::PushParticle ( float x, float y, float dx, float dy ) {
 	
-	if (( !this->mFree ) && this->mCapParticles ) {
+	this->FinishPendingUpdate ();
+	
+	if (( !this->mEngine ) && ( !this->mFree ) && this->mCapParticles ) {
 		return false;
 	}
 	
 	MOAIParticleState* state = this->GetState ( 0 );
 	if ( !state ) return false;
 	
+	if ( this->mEngine ) {
+		return this->mEngine->PushParticle ( *this, *state, x, y, dx, dy, this->mCapParticles );
+	}
+	
 	MOAIParticle* particle = 0;
 	
 	if ( this->mFree ) {
@@ -566,42 +831,36 @@ bool MOAIParticleSystem::PushParticle ( float x, float y, float dx, float dy ) {
 //----------------------------------------------------------------//
 bool MOAIParticleSystem::PushSprite ( const AKUParticleSprite& sprite ) {
 
-	u32 size = this->mSprites.Size ();
-	
-	if ( size && this->mDeck ) {
+	this->FinishPendingUpdate ();
+
+	u32 spriteID;
+	if ( this->ReserveSprite ( spriteID )) {
 	
-		if (( this->mSpriteTop >= size ) && this->mCapSprites ) {
-			return false;
-		}
-		
-		u32 idx = ( this->mSpriteTop++ ) % size;
-		this->mSprites [ idx ] = sprite;
-		
-		// TODO: need to take rotation into account
-		USBox bounds = this->mDeck->GetBounds ( sprite.mGfxID, this->mRemapper );
-		
-		USVec3D offset ( sprite.mXLoc, sprite.mYLoc, 0.0f );
-		USVec3D scale ( sprite.mXScl, sprite.mYScl, 0.0f );
-		
-		bounds.Scale ( scale );
-		
-		float radius = bounds.GetMaxExtent () * 1.4f;
-		bounds.mMin.Init ( -radius, -radius, -radius );
-		bounds.mMax.Init ( radius, radius, radius );
-		
-		bounds.Offset ( offset );
-		
-		if ( this->mSpriteTop == 1 ) {
-			this->mParticleBounds = bounds;
-		}
-		else {
-			this->mParticleBounds.Grow ( bounds );
-		}
+		this->mSprites [ spriteID % this->mSprites.Size ()] = sprite;
+		this->GrowBounds ( sprite );
 		return true;
 	}
 	return false;
 }
 
+//----------------------------------------------------------------//
+float MOAIParticleSystem::Rand ( float lower, float upper ) {
+
+	// rand ()'s state can't be shared with the worker threads, so while queued for a parallel
+	// update the system draws from its own generator. MOAIParticleMgr seeds it from rand ()
+	// on the main thread, so math.randomseed still makes a run repeatable.
+	if ( !this->mDeferCallbacks ) {
+		return USFloat::Rand ( lower, upper );
+	}
+	
+	if ( lower == upper ) return lower;
+	
+	this->mRandSeed = ( this->mRandSeed * 1103515245 ) + 12345;
+	float r = ( float )(( this->mRandSeed >> 16 ) & 0x7fff ) / 32767.0f;
+	
+	return lower + ( r * ( upper - lower ));
+}
+
 //----------------------------------------------------------------//
 void MOAIParticleSystem::RegisterLuaClass ( MOAILuaState& state ) {
 
@@ -630,6 +889,7 @@ void MOAIParticleSystem::RegisterLuaFuncs ( MOAILuaState& state ) {
 		{ "setSpriteColor",		_setSpriteColor },
 		{ "setSpriteDeckIdx",	_setSpriteDeckIdx },
 		{ "setState",			_setState },
+		{ "setVectorized",		_setVectorized },
 		{ "surge",				_surge },
 		{ NULL, NULL }
 	};
@@ -648,6 +908,15 @@ void MOAIParticleSystem::ReserveParticles ( u32 maxParticles, u32 particleSize )
 	
 	this->mParticleSize = particleSize;
 	
+	if ( this->mEngine ) {
+	
+		// the engine keeps its own columns
+		this->mParticles.Clear ();
+		this->mParticleData.Clear ();
+		this->mEngine->Reserve ( maxParticles, particleSize );
+		return;
+	}
+	
 	this->mParticles.Init ( maxParticles );
 	this->mParticleData.Init ( maxParticles * particleSize );
 	this->mParticleData.Fill ( 0.0f );
@@ -672,6 +941,22 @@ void MOAIParticleSystem::ReserveSprites ( u32 maxSprites ) {
 	this->mSprites.Init ( maxSprites );
 }
 
+//----------------------------------------------------------------//
+bool MOAIParticleSystem::ReserveSprite ( u32& spriteID ) {
+
+	u32 size = this->mSprites.Size ();
+	
+	if ( size && this->mDeck ) {
+	
+		if (( this->mSpriteTop >= size ) && this->mCapSprites ) {
+			return false;
+		}
+		spriteID = this->mSpriteTop++;
+		return true;
+	}
+	return false;
+}
+
 //----------------------------------------------------------------//
 void MOAIParticleSystem::ReserveStates ( u32 total ) {
 
@@ -692,3 +977,112 @@ void MOAIParticleSystem::SerializeOut ( MOAILuaState& state, MOAISerializer& ser
 	MOAIProp::SerializeOut ( state, serializer );
 	MOAIAction::SerializeOut ( state, serializer );
 }
+
+//----------------------------------------------------------------//
+void MOAIParticleSystem::UpdateParticles ( float step ) {
+
+	// clear out the sprites
+	this->mSpriteTop = 0;
+
+	this->mParticleBounds.Init ( 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f );
+	this->mHasBounds = false;
+
+	if ( this->mEngine ) {
+		this->mEngine->Update ( *this, step );
+		return;
+	}
+
+	// bail if no particles
+	if ( !this->mHead ) return;
+
+	// grab the head then clear out the queue
+	MOAIParticle* cursor = this->mHead;
+	this->ClearQueue ();
+	
+	// update the particles and rebuild the queue
+	while ( cursor ) {
+		MOAIParticle* particle = cursor;
+		cursor = cursor->mNext;
+		
+		// update the particle
+		if ( particle->mState ) {
+			particle->mState->ProcessParticle ( *this, *particle, step );
+		}
+		
+		// if is still to be killed, move it to the free list, else put it back in the queue
+		if ( !particle->mState ) {
+			particle->mNext = this->mFree;
+			this->mFree = particle;
+		}
+		else {
+			// and put it back in the queue
+			this->EnqueueParticle ( *particle );
+		}
+	}
+}
+
+//----------------------------------------------------------------//
+// Writes sprites, oldest first from the cursor'th, into vtx as four MOAIParticleVertex
+// each, for the particle shader. Stops after maxQuads quads or when out of sprites and
+// advances the cursor past every sprite looked at, including any the deck has no quad
+// for. Returns the number of quads written.
+u32 MOAIParticleSystem::WriteSprites ( MOAIParticleVertex* vtx, u32& cursor, u32 maxQuads ) {
+
+	u32 maxSprites = this->mSprites.Size ();
+	u32 total = this->mSpriteTop;
+	u32 base = 0;
+	if ( total > maxSprites ) {
+		base = total % maxSprites;
+		total = maxSprites;
+	}
+	
+	if ( !this->mDeck ) {
+		cursor = total;
+		return 0;
+	}
+	
+	// neighboring sprites mostly share a deck item, so only fetch the quad when it changes
+	MOAIQuadVertex quad [ 4 ];
+	u32 quadID = 0;
+	bool hasQuad = false;
+	
+	u32 first = cursor;
+	u32 totalQuads = 0;
+	
+	for ( ; ( cursor < total ) && ( totalQuads < maxQuads ); ++cursor ) {
+	
+		AKUParticleSprite& sprite = this->mSprites [( base + cursor ) % maxSprites ];
+		
+		u32 spriteQuadID = this->mIndex + ( u32 )sprite.mGfxID;
+		if (( cursor == first ) || ( spriteQuadID != quadID )) {
+			quadID = spriteQuadID;
+			u32 idx = this->mRemapper ? this->mRemapper->Remap ( quadID ) : quadID;
+			hasQuad = this->mDeck->WriteQuad ( idx, quad, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f );
+		}
+		if ( !hasQuad ) continue;
+		
+		USColorVec color;
+		color.Set ( sprite.mRed, sprite.mGreen, sprite.mBlue, sprite.mAlpha );
+		u32 color32 = color.PackRGBA ();
+		
+		float zRot = sprite.mZRot * ( float )D2R;
+		
+		for ( u32 j = 0; j < 4; ++j ) {
+		
+			vtx [ j ].mCornerX	= quad [ j ].mX;
+			vtx [ j ].mCornerY	= quad [ j ].mY;
+			vtx [ j ].mU		= quad [ j ].mU;
+			vtx [ j ].mV		= quad [ j ].mV;
+			
+			vtx [ j ].mXLoc		= sprite.mXLoc;
+			vtx [ j ].mYLoc		= sprite.mYLoc;
+			vtx [ j ].mXScl		= sprite.mXScl;
+			vtx [ j ].mYScl		= sprite.mYScl;
+			vtx [ j ].mZRot		= zRot;
+			vtx [ j ].mColor	= color32;
+		}
+		vtx += 4;
+		totalQuads++;
+	}
+	return totalQuads;
+}
@@ -11,9 +11,60 @@
 #include <moaicore/MOAIProp.h>
 
 class MOAIDeck;
+class MOAIParticleEngine;
+class MOAIParticlePlugin;
 class MOAIParticleScript;
 class MOAIParticleState;
 
+//================================================================//
+// MOAIParticleVertex
+//================================================================//
+// matches the layout of MOAIVertexFormatMgr::PARTICLE; all four corners of
+// a sprite carry the same sprite fields and the shader places the corner
+class MOAIParticleVertex {
+public:
+
+	float	mCornerX;
+	float	mCornerY;
+	float	mU;
+	float	mV;
+	
+	float	mXLoc;
+	float	mYLoc;
+	float	mXScl;
+	float	mYScl;
+	
+	float	mZRot;
+	
+	u32		mColor;
+};
+
+//================================================================//
+// MOAIParticleCallback
+//================================================================//
+// A plugin call held back from a worker thread, to be made on the main
+// thread once the system's update is published.
+class MOAIParticleCallback {
+private:
+
+	friend class MOAIParticleSystem;
+
+	static const u32 NO_SPRITE = 0xffffffff;
+
+	MOAIParticlePlugin*		mPlugin;
+	bool					mRender;		// OnRender if true, else OnInit
+	bool					mWriteBack;		// false if the particle changed again after the call was made
+	
+	float*					mTarget;		// the particle's registers, or 0 if it lives in the engine
+	u32						mEngineIdx;
+	u32						mData;			// offset of the copy of the registers the call sees
+	u32						mSprite;		// sprite reserved for OnRender's output
+	
+	float					mT0;
+	float					mT1;
+	float					mTerm;
+};
+
 //================================================================//
 // MOAIParticleSystem
 //================================================================//
@@ -43,6 +94,21 @@ private:
 	bool								mComputeBounds;
 	USBox								mParticleBounds;
 	
+	MOAIParticleEngine*					mEngine; // replaces the particle list when set; see setVectorized ()
+	
+	bool											mHasBounds;
+	bool											mDeferCallbacks;	// set while updating on a worker thread
+	bool											mUpdateQueued;		// in MOAIParticleMgr's queue
+	bool											mUpdatePending;		// mPendingStep hasn't been simulated yet
+	float											mPendingStep;
+	u32												mRandSeed;			// see Rand ()
+	USLeanStack < MOAIParticleCallback, 32 >		mCallbacks;
+	USLeanStack < float, 256 >						mCallbackData;
+	
+	GLuint								mVertexBufferID;	// sprites streamed for the shader; see DrawBatched ()
+	u32									mContextID;
+	USLeanArray < MOAIParticleVertex >	mVertices;
+	
 	//----------------------------------------------------------------//
 	static int		_capParticles			( lua_State* L );
 	static int		_capSprites				( lua_State* L );
@@ -59,21 +125,35 @@ private:
 	static int		_setSpriteColor			( lua_State* L );
 	static int		_setSpriteDeckIdx		( lua_State* L );
 	static int		_setState				( lua_State* L );
+	static int		_setVectorized			( lua_State* L );
 	static int		_surge					( lua_State* L );
 	
 	//----------------------------------------------------------------//
+	bool					CanDrawBatched			();
 	void					ClearStates				();
 	void					ClearQueue				();
+	MOAIParticleCallback*	DeferCallback			( MOAIParticlePlugin& plugin, float* particle );
+	bool					DeferInit				( MOAIParticlePlugin& plugin, float* particle );
+	bool					DeferRender				( MOAIParticlePlugin& plugin, float* particle, float t0, float t1, float term, bool writeBack );
+	void					DrawBatched				();
 	void					EnqueueParticle			( MOAIParticle& particle );
+	void					FinishPendingUpdate		();
 	AKUParticleSprite*		GetTopSprite			();
 	MOAIParticleState*		GetState				( u32 id );
+	void					GrowBounds				( const AKUParticleSprite& sprite );
 	void					OnUpdate				( float step );
+	void					PublishUpdate			();
+	float					Rand					( float lower, float upper );
+	bool					ReserveSprite			( u32& spriteID );
+	void					UpdateParticles			( float step );
 
 public:
 	
 	friend class MOAIParticleEngine;
+	friend class MOAIParticleMgr;
 	friend class MOAIParticleScript;
 	friend class MOAIParticleState;
+	friend class MOAIParticleUpdateTask;
 	
 	DECL_LUA_FACTORY ( MOAIParticleSystem )
 
@@ -96,6 +176,7 @@ public:
 	void			SerializeOut			( MOAILuaState& state, MOAISerializer& serializer );
 	void			SetConstant				( u32 idx, float value );
 	void			SetRect					( u32 idx, USRect& rect );
+	u32				WriteSprites			( MOAIParticleVertex* vtx, u32& cursor, u32 maxQuads );
 };
 
 #endif
@@ -383,6 +383,8 @@ void MOAIPartition::AffirmPriority ( MOAIProp& prop ) {
 //----------------------------------------------------------------//
 void MOAIPartition::Clear () {
 
+	this->FlushUpdates ();
+
 	u32 totalLayers = this->mLevels.Size ();
 	for ( u32 i = 0; i < totalLayers; ++i ) {
 		this->mLevels [ i ].Clear ();
@@ -392,9 +394,28 @@ void MOAIPartition::Clear () {
 	this->mEmpties.Clear ();
 }
 
+//----------------------------------------------------------------//
+void MOAIPartition::FlushUpdates () {
+
+	// leave the stack untouched when there's nothing to do; layers may gather on several threads at once
+	u32 total = this->mPendingProps.GetTop ();
+	if ( !total ) return;
+	
+	for ( u32 i = 0; i < total; ++i ) {
+		
+		MOAIProp* prop = this->mPendingProps [ i ];
+		MOAIPartitionCell* cell = prop->mPendingCell;
+		
+		prop->mPendingCell = 0;
+		cell->InsertProp ( *prop );
+	}
+	this->mPendingProps.Reset ();
+}
+
 //----------------------------------------------------------------//
 u32 MOAIPartition::GatherProps ( MOAIPartitionResultBuffer& results, MOAIProp* ignore, u32 mask ) {
 	
+	this->FlushUpdates ();
 	results.Reset ();
 	
 	u32 totalLayers = this->mLevels.Size ();
@@ -411,6 +432,7 @@ u32 MOAIPartition::GatherProps ( MOAIPartitionResultBuffer& results, MOAIProp* i
 //----------------------------------------------------------------//
 u32 MOAIPartition::GatherProps ( MOAIPartitionResultBuffer& results, MOAIProp* ignore, const USVec3D& point, const USVec3D& orientation, u32 mask ) {
 	
+	this->FlushUpdates ();
 	results.Reset ();
 	
 	u32 totalLayers = this->mLevels.Size ();
@@ -426,6 +448,7 @@ u32 MOAIPartition::GatherProps ( MOAIPartitionResultBuffer& results, MOAIProp* i
 //----------------------------------------------------------------//
 u32 MOAIPartition::GatherProps ( MOAIPartitionResultBuffer& results, MOAIProp* ignore, const USVec3D& point, u32 mask ) {
 	
+	this->FlushUpdates ();
 	results.Reset ();
 	
 	u32 totalLayers = this->mLevels.Size ();
@@ -441,6 +464,7 @@ u32 MOAIPartition::GatherProps ( MOAIPartitionResultBuffer& results, MOAIProp* i
 //----------------------------------------------------------------//
 u32 MOAIPartition::GatherProps ( MOAIPartitionResultBuffer& results, MOAIProp* ignore, USBox box, u32 mask ) {
 	
+	this->FlushUpdates ();
 	results.Reset ();
 	box.Bless ();
 	
@@ -457,6 +481,7 @@ u32 MOAIPartition::GatherProps ( MOAIPartitionResultBuffer& results, MOAIProp* i
 //----------------------------------------------------------------//
 u32 MOAIPartition::GatherProps ( MOAIPartitionResultBuffer& results, MOAIProp* ignore, const USFrustum& frustum, u32 mask ) {
 	
+	this->FlushUpdates ();
 	results.Reset ();
 	
 	u32 totalLayers = this->mLevels.Size ();
@@ -494,12 +519,14 @@ void MOAIPartition::InsertProp ( MOAIProp& prop ) {
 
 //----------------------------------------------------------------//
 bool MOAIPartition::IsEmpty ( MOAIProp& prop ) {
-	return prop.mCell == &this->mEmpties;
+	MOAIPartitionCell* cell = prop.mPendingCell ? prop.mPendingCell : prop.mCell;
+	return cell == &this->mEmpties;
 }
 
 //----------------------------------------------------------------//
 bool MOAIPartition::IsGlobal ( MOAIProp& prop ) {
-	return prop.mCell == &this->mGlobals;
+	MOAIPartitionCell* cell = prop.mPendingCell ? prop.mPendingCell : prop.mCell;
+	return cell == &this->mGlobals;
 }
 
 //----------------------------------------------------------------//
@@ -517,10 +544,30 @@ MOAIPartition::~MOAIPartition () {
 	this->Clear ();
 }
 
+//----------------------------------------------------------------//
+// Queues a prop for a move to another cell; the move is applied by the next
+// call to FlushUpdates (). Props that stay in the same cell only refresh their
+// bounds.
+void MOAIPartition::MoveProp ( MOAIProp& prop, MOAIPartitionCell& cell ) {
+
+	if ( prop.mPendingCell ) {
+		prop.mPendingCell = &cell;
+	}
+	else if ( prop.mCell == &cell ) {
+		cell.SetBounds ( prop.mCellIdx, prop.mBounds );
+	}
+	else {
+		prop.mPendingCell = &cell;
+		this->mPendingProps.Push ( &prop );
+	}
+}
+
 //----------------------------------------------------------------//
 // This moves all props to the 'empties' cell
 void MOAIPartition::PrepareRebuild () {
 
+	this->FlushUpdates ();
+
 	u32 totalLayers = this->mLevels.Size ();
 	for ( u32 i = 0; i < totalLayers; ++i ) {
 		this->mLevels [ i ].ExtractProps ( this->mEmpties, 0 );
@@ -570,6 +617,9 @@ void MOAIPartition::RemoveProp ( MOAIProp& prop ) {
 
 	if ( prop.mPartition != this ) return;
 	
+	// the prop may be released below; don't leave it in the pending list
+	this->FlushUpdates ();
+	
 	if ( prop.mCell ) {
 		prop.mCell->RemoveProp ( prop );
 	}
@@ -605,10 +655,10 @@ void MOAIPartition::UpdateProp ( MOAIProp& prop, u32 status ) {
 	if ( status != MOAIProp::BOUNDS_OK ) {
 		
 		if ( status == MOAIProp::BOUNDS_GLOBAL ) {
-			this->mGlobals.InsertProp ( prop );
+			this->MoveProp ( prop, this->mGlobals );
 		}
 		else {
-			this->mEmpties.InsertProp ( prop );
+			this->MoveProp ( prop, this->mEmpties );
 		}
 		return;
 	}
@@ -639,17 +689,17 @@ void MOAIPartition::UpdateProp ( MOAIProp& prop, u32 status ) {
 		
 		if ( layer ) {
 			// layer prop
-			layer->PlaceProp ( prop );
+			this->MoveProp ( prop, *layer->GetCell ( prop ));
 			prop.mLayer = layer;
 		}
 		else {
 			// biggie prop - has dimension but too big to fit in any layer
-			this->mBiggies.InsertProp ( prop );
+			this->MoveProp ( prop, this->mBiggies );
 		}
 	}
 	else {
 		// empty prop
-		this->mEmpties.InsertProp ( prop );
+		this->MoveProp ( prop, this->mEmpties );
 	}
 }
 
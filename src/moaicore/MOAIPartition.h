@@ -14,6 +14,8 @@
 /**	@name	MOAIPartition
 	@text	Class for optimizing spatial queries against sets of primitives.
 			Configure for performance; default behavior is a simple list.
+			Props that move to a new cell are queued and relinked in a
+			single pass before the next query.
 	
 	@const PLANE_XY
 	@const PLANE_XZ
@@ -32,6 +34,9 @@ private:
 	MOAIPartitionCell					mGlobals;
 	MOAIPartitionCell					mBiggies;
 
+	// props whose cell changed since the last flush
+	USLeanStack < MOAIProp*, 256 >		mPendingProps;
+
 	s32					mPriorityCounter;
 	static const s32	PRIORITY_MASK = 0x7fffffff;
 
@@ -52,6 +57,7 @@ private:
 
 	//----------------------------------------------------------------//
 	void			AffirmPriority			( MOAIProp& prop );
+	void			MoveProp				( MOAIProp& prop, MOAIPartitionCell& cell );
 	void			PrepareRebuild			();
 	void			Rebuild					();
 	void			UpdateProp				( MOAIProp& prop, u32 status );
@@ -62,6 +68,7 @@ public:
 	
 	//----------------------------------------------------------------//
 	void			Clear					();
+	void			FlushUpdates			();
 	u32				GatherProps				( MOAIPartitionResultBuffer& results, MOAIProp* ignore, const USVec3D& point, const USVec3D& orientation, u32 mask = 0xffffffff );
 	u32				GatherProps				( MOAIPartitionResultBuffer& results, MOAIProp* ignore, u32 mask = 0xffffffff );
 	u32				GatherProps				( MOAIPartitionResultBuffer& results, MOAIProp* ignore, const USVec3D& point, u32 mask = 0xffffffff );
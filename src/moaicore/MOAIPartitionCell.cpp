@@ -13,14 +13,39 @@
 // MOAIPartitionCell
 //================================================================//
 
+//----------------------------------------------------------------//
+void MOAIPartitionCell::AppendProp ( MOAIProp& prop ) {
+
+	u32 idx = this->mTotalProps++;
+
+	if ( this->mTotalProps > this->mProps.Size ()) {
+		
+		this->mProps.Grow ( this->mTotalProps, CHUNK_SIZE );
+		
+		u32 size = this->mProps.Size ();
+		this->mXMin.Resize ( size );
+		this->mYMin.Resize ( size );
+		this->mZMin.Resize ( size );
+		this->mXMax.Resize ( size );
+		this->mYMax.Resize ( size );
+		this->mZMax.Resize ( size );
+	}
+	
+	this->mProps [ idx ] = &prop;
+	this->SetBounds ( idx, prop.mBounds );
+	
+	prop.mCell = this;
+	prop.mCellIdx = idx;
+}
+
 //----------------------------------------------------------------//
 void MOAIPartitionCell::Clear () {
 
-	PropIt propIt = this->mProps.Head ();
-	while ( propIt ) {
-		MOAIProp* prop = propIt->Data ();
-		propIt = propIt->Next ();
-		prop->SetPartition ( 0 );
+	// removing a prop swaps the last prop into its slot, so walk backward
+	for ( u32 i = this->mTotalProps; i--; ) {
+		if ( i < this->mTotalProps ) {
+			this->mProps [ i ]->SetPartition ( 0 );
+		}
 	}
 }
 
@@ -29,28 +54,29 @@ void MOAIPartitionCell::ExtractProps ( MOAIPartitionCell& cell, MOAIPartitionLev
 
 	if ( &cell != this ) {
 	
-		PropIt propIt = this->mProps.Head ();
-		for ( ; propIt; propIt = propIt->Next ()) {
-			MOAIProp* prop = propIt->Data ();
-			prop->mCell = &cell;
+		for ( u32 i = 0; i < this->mTotalProps; ++i ) {
+			MOAIProp* prop = this->mProps [ i ];
+			cell.AppendProp ( *prop );
 			prop->mLayer = layer;
 		}
-	
-		cell.mProps.Join ( cell.mProps, this->mProps );
+		this->mTotalProps = 0;
 	}
 }
 
 //----------------------------------------------------------------//
 void MOAIPartitionCell::GatherProps ( MOAIPartitionResultBuffer& results, const MOAIProp* ignore, const USVec3D& point, const USVec3D& orientation, u32 mask ) {
-	PropIt propIt = this->mProps.Head ();
-	for ( ; propIt; propIt = propIt->Next ()) {
-		MOAIProp* prop = propIt->Data ();
+	
+	USBox bounds;
+	
+	for ( u32 i = 0; i < this->mTotalProps; ++i ) {
+		MOAIProp* prop = this->mProps [ i ];
 		
 		if ( prop == ignore ) continue;
 		
 		float t;
 		if (( mask == 0 ) || ( prop->mMask & mask )) {
-			if ( !USSect::RayToBox( prop->mBounds, point, orientation, t )) {
+			this->GetBounds ( i, bounds );
+			if ( !USSect::RayToBox( bounds, point, orientation, t )) {
 				prop->AddToSortBuffer ( results,  -1 * USFloat::FloatToIntKey ( t ));
 			}
 		}
@@ -60,9 +86,8 @@ void MOAIPartitionCell::GatherProps ( MOAIPartitionResultBuffer& results, const
 //----------------------------------------------------------------//
 void MOAIPartitionCell::GatherProps ( MOAIPartitionResultBuffer& results, const MOAIProp* ignore, u32 mask ) {
 	
-	PropIt propIt = this->mProps.Head ();
-	for ( ; propIt; propIt = propIt->Next ()) {
-		MOAIProp* prop = propIt->Data ();
+	for ( u32 i = 0; i < this->mTotalProps; ++i ) {
+		MOAIProp* prop = this->mProps [ i ];
 		
 		if ( prop == ignore ) continue;
 		
@@ -75,14 +100,25 @@ void MOAIPartitionCell::GatherProps ( MOAIPartitionResultBuffer& results, const
 //----------------------------------------------------------------//
 void MOAIPartitionCell::GatherProps ( MOAIPartitionResultBuffer& results, const MOAIProp* ignore, const USVec3D& point, u32 mask ) {
 
-	PropIt propIt = this->mProps.Head ();
-	for ( ; propIt; propIt = propIt->Next ()) {
-		MOAIProp* prop = propIt->Data ();
-		
-		if ( prop == ignore ) continue;
+	USBox box;
+	box.Init ( point );
+	
+	USCullBoxes boxes;
+	this->GetBoxes ( boxes );
+	
+	u32 visible [ CULL_BLOCK_SIZE ];
+	
+	for ( u32 base = 0; base < this->mTotalProps; base += CULL_BLOCK_SIZE ) {
+	
+		u32 total = MIN ( CULL_BLOCK_SIZE, this->mTotalProps - base );
+		total = USCull::Box ( boxes, base, total, box, visible );
 		
-		if (( mask == 0 ) || ( prop->mMask & mask )) {
-			if ( prop->mBounds.Contains ( point )) {
+		for ( u32 i = 0; i < total; ++i ) {
+			MOAIProp* prop = this->mProps [ visible [ i ]];
+			
+			if ( prop == ignore ) continue;
+			
+			if (( mask == 0 ) || ( prop->mMask & mask )) {
 				if ( prop->Inside ( point, 0.0f )) {
 					prop->AddToSortBuffer ( results );
 				}
@@ -94,14 +130,22 @@ void MOAIPartitionCell::GatherProps ( MOAIPartitionResultBuffer& results, const
 //----------------------------------------------------------------//
 void MOAIPartitionCell::GatherProps ( MOAIPartitionResultBuffer& results, const MOAIProp* ignore, const USBox& box, u32 mask ) {
 
-	PropIt propIt = this->mProps.Head ();
-	for ( ; propIt; propIt = propIt->Next ()) {
-		MOAIProp* prop = propIt->Data ();
-		
-		if ( prop == ignore ) continue;
+	USCullBoxes boxes;
+	this->GetBoxes ( boxes );
+	
+	u32 visible [ CULL_BLOCK_SIZE ];
+	
+	for ( u32 base = 0; base < this->mTotalProps; base += CULL_BLOCK_SIZE ) {
+	
+		u32 total = MIN ( CULL_BLOCK_SIZE, this->mTotalProps - base );
+		total = USCull::Box ( boxes, base, total, box, visible );
 		
-		if (( mask == 0 ) || ( prop->mMask & mask )) {	
-			if ( prop->mBounds.Overlap ( box )) {
+		for ( u32 i = 0; i < total; ++i ) {
+			MOAIProp* prop = this->mProps [ visible [ i ]];
+			
+			if ( prop == ignore ) continue;
+			
+			if (( mask == 0 ) || ( prop->mMask & mask )) {
 				prop->AddToSortBuffer ( results );
 			}
 		}
@@ -111,34 +155,69 @@ void MOAIPartitionCell::GatherProps ( MOAIPartitionResultBuffer& results, const
 //----------------------------------------------------------------//
 void MOAIPartitionCell::GatherProps ( MOAIPartitionResultBuffer& results, const MOAIProp* ignore, const USFrustum& frustum, u32 mask ) {
 
-	PropIt propIt = this->mProps.Head ();
-	for ( ; propIt; propIt = propIt->Next ()) {
-		MOAIProp* prop = propIt->Data ();
-		
-		if ( prop == ignore ) continue;
+	USCullBoxes boxes;
+	this->GetBoxes ( boxes );
+	
+	u32 visible [ CULL_BLOCK_SIZE ];
+	
+	for ( u32 base = 0; base < this->mTotalProps; base += CULL_BLOCK_SIZE ) {
+	
+		u32 total = MIN ( CULL_BLOCK_SIZE, this->mTotalProps - base );
+		total = USCull::Frustum ( boxes, base, total, frustum, visible );
 		
-		if (( mask == 0 ) || ( prop->mMask & mask )) {	
-			if ( !frustum.Cull ( prop->mBounds )) {
+		for ( u32 i = 0; i < total; ++i ) {
+			MOAIProp* prop = this->mProps [ visible [ i ]];
+			
+			if ( prop == ignore ) continue;
+			
+			if (( mask == 0 ) || ( prop->mMask & mask )) {
 				prop->AddToSortBuffer ( results );
 			}
 		}
 	}
 }
 
+//----------------------------------------------------------------//
+void MOAIPartitionCell::GetBounds ( u32 idx, USBox& bounds ) const {
+
+	bounds.mMin.mX = this->mXMin [ idx ];
+	bounds.mMin.mY = this->mYMin [ idx ];
+	bounds.mMin.mZ = this->mZMin [ idx ];
+	
+	bounds.mMax.mX = this->mXMax [ idx ];
+	bounds.mMax.mY = this->mYMax [ idx ];
+	bounds.mMax.mZ = this->mZMax [ idx ];
+}
+
+//----------------------------------------------------------------//
+void MOAIPartitionCell::GetBoxes ( USCullBoxes& boxes ) const {
+
+	boxes.mXMin = this->mXMin;
+	boxes.mYMin = this->mYMin;
+	boxes.mZMin = this->mZMin;
+	boxes.mXMax = this->mXMax;
+	boxes.mYMax = this->mYMax;
+	boxes.mZMax = this->mZMax;
+}
+
 //----------------------------------------------------------------//
 void MOAIPartitionCell::InsertProp ( MOAIProp& prop ) {
 
-	if ( prop.mCell == this ) return;
+	if ( prop.mCell == this ) {
+		// same cell; only the bounds need refreshing
+		this->SetBounds ( prop.mCellIdx, prop.mBounds );
+		return;
+	}
 
 	if ( prop.mCell ) {
 		prop.mCell->RemoveProp ( prop );
 	}
-	this->mProps.PushBack ( prop.mLinkInCell );
-	prop.mCell = this;
+	this->AppendProp ( prop );
 }
 
 //----------------------------------------------------------------//
-MOAIPartitionCell::MOAIPartitionCell () {
+MOAIPartitionCell::MOAIPartitionCell () :
+	mTotalProps ( 0 ) {
 }
 
 //----------------------------------------------------------------//
@@ -151,16 +230,43 @@ void MOAIPartitionCell::RemoveProp ( MOAIProp& prop ) {
 
 	if ( prop.mCell != this ) return;
 	
-	this->mProps.Remove ( prop.mLinkInCell );
+	u32 idx = prop.mCellIdx;
+	u32 last = --this->mTotalProps;
+	
+	if ( idx != last ) {
+	
+		MOAIProp* moved = this->mProps [ last ];
+		
+		this->mProps [ idx ] = moved;
+		this->mXMin [ idx ] = this->mXMin [ last ];
+		this->mYMin [ idx ] = this->mYMin [ last ];
+		this->mZMin [ idx ] = this->mZMin [ last ];
+		this->mXMax [ idx ] = this->mXMax [ last ];
+		this->mYMax [ idx ] = this->mYMax [ last ];
+		this->mZMax [ idx ] = this->mZMax [ last ];
+		
+		moved->mCellIdx = idx;
+	}
+	
 	prop.mCell = 0;
 }
 
 //----------------------------------------------------------------//
 void MOAIPartitionCell::ScheduleProps () {
 
-	PropIt propIt = this->mProps.Head ();
-	for ( ; propIt; propIt = propIt->Next ()) {
-		MOAIProp* prop = propIt->Data ();
-		prop->ScheduleUpdate ();
+	for ( u32 i = 0; i < this->mTotalProps; ++i ) {
+		this->mProps [ i ]->ScheduleUpdate ();
 	}
-}
\ No newline at end of file
+}
+
+//----------------------------------------------------------------//
+void MOAIPartitionCell::SetBounds ( u32 idx, const USBox& bounds ) {
+
+	this->mXMin [ idx ] = bounds.mMin.mX;
+	this->mYMin [ idx ] = bounds.mMin.mY;
+	this->mZMin [ idx ] = bounds.mMin.mZ;
+	
+	this->mXMax [ idx ] = bounds.mMax.mX;
+	this->mYMax [ idx ] = bounds.mMax.mY;
+	this->mZMax [ idx ] = bounds.mMax.mZ;
+}
@@ -12,6 +12,9 @@ class MOAIProp;
 //================================================================//
 // MOAIPartitionCell
 //================================================================//
+// Props are kept in contiguous arrays; prop bounds are mirrored as
+// structure-of-arrays so queries can test bounds without touching
+// the props themselves. Removal swaps the last prop into the hole.
 class MOAIPartitionCell {
 private:
 	
@@ -19,10 +22,21 @@ private:
 	friend class MOAIPartitionLevel;
 	friend class MOAIProp;
 	
-	typedef USLeanList < MOAIProp* >::Iterator PropIt;
-	USLeanList < MOAIProp* > mProps;
+	static const u32 CHUNK_SIZE = 16;
+	static const u32 CULL_BLOCK_SIZE = 64; // props culled per call into USCull
+	
+	u32							mTotalProps;
+	USLeanArray < MOAIProp* >	mProps;
+	
+	USLeanArray < float >		mXMin;
+	USLeanArray < float >		mYMin;
+	USLeanArray < float >		mZMin;
+	USLeanArray < float >		mXMax;
+	USLeanArray < float >		mYMax;
+	USLeanArray < float >		mZMax;
 
 	//----------------------------------------------------------------//
+	void			AppendProp				( MOAIProp& prop );
 	void			Clear					();
 	void			ExtractProps			( MOAIPartitionCell& cell, MOAIPartitionLevel* layer );
 	void			GatherProps				( MOAIPartitionResultBuffer& results, const MOAIProp* ignore, const USVec3D& point, const USVec3D& orientation, u32 mask );
@@ -30,12 +44,17 @@ private:
 	void			GatherProps				( MOAIPartitionResultBuffer& results, const MOAIProp* ignore, const USVec3D& point, u32 mask );
 	void			GatherProps				( MOAIPartitionResultBuffer& results, const MOAIProp* ignore, const USBox& box, u32 mask );
 	void			GatherProps				( MOAIPartitionResultBuffer& results, const MOAIProp* ignore, const USFrustum& frustum, u32 mask );
+	void			GetBounds				( u32 idx, USBox& bounds ) const;
+	void			GetBoxes				( USCullBoxes& boxes ) const;
 	void			InsertProp				( MOAIProp& prop );
 	void			RemoveProp				( MOAIProp& prop );
 	void			ScheduleProps			(); // schedule all props in cell for update
+	void			SetBounds				( u32 idx, const USBox& bounds );
 					
 public:
 
+	GET ( u32, TotalProps, mTotalProps )
+
 	//----------------------------------------------------------------//
 					MOAIPartitionCell		();
 					~MOAIPartitionCell		();
@@ -175,15 +175,3 @@ MOAIPartitionLevel::MOAIPartitionLevel () :
 MOAIPartitionLevel::~MOAIPartitionLevel () {
 	this->Clear ();
 }
-
-//----------------------------------------------------------------//
-void MOAIPartitionLevel::PlaceProp ( MOAIProp& prop ) {
-
-	//USVec3D loc;
-	//prop.mBounds.GetCenter ( loc );
-	//MOAICellCoord coord = this->mGridSpace.GetCellCoord ( loc.mX, loc.mY );
-	//printf ( "cell %d ( %d, %d )\n", this->mGridSpace.GetCellAddr ( coord ), coord.mX, coord.mY );
-
-	MOAIPartitionCell* cell = this->GetCell ( prop );
-	cell->InsertProp ( prop );
-}
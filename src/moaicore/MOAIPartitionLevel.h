@@ -27,7 +27,6 @@ private:
 	void					GatherProps			( MOAIPartitionResultBuffer& results, MOAIProp* ignore, const USFrustum& frustum, u32 planeID, u32 mask );
 	MOAIPartitionCell*		GetCell				( MOAIProp& prop );
 	void					Init				( float cellSize, u32 width, u32 height );
-	void					PlaceProp			( MOAIProp& prop );
 
 public:
 
@@ -5,15 +5,6 @@
 #include <moaicore/MOAIPartitionResultBuffer.h>
 #include <moaicore/MOAIProp.h>
 
-//================================================================//
-// IsoSortItem
-//================================================================//
-class IsoSortItem {
-public:
-	MOAIPartitionResult*	mResult;
-	IsoSortItem*			mNext;
-};
-
 //================================================================//
 // IsoSortList
 //================================================================//
@@ -83,16 +74,69 @@ public:
 	}
 };
 
+//================================================================//
+// local
+//================================================================//
+
+static const u32 ISO_NODE_DRAWN = 0xffffffff;
+
+//----------------------------------------------------------------//
+static inline void _pushStateQueue ( u32 idx, u32 state, u32* heads, u32* tails, u32* next ) {
+
+	next [ idx ] = ISO_NODE_DRAWN;
+
+	if ( heads [ state ] == ISO_NODE_DRAWN ) {
+		heads [ state ] = idx;
+	}
+	else {
+		next [ tails [ state ]] = idx;
+	}
+	tails [ state ] = idx;
+}
+
+//----------------------------------------------------------------//
+static inline u32 _isoCellCoord ( float coord, float origin, float cellSize, u32 totalCells ) {
+
+	float cell = ( coord - origin ) / cellSize;
+	if ( cell <= 0.0f ) return 0;
+	
+	u32 cellCoord = ( u32 )cell;
+	return cellCoord < totalCells ? cellCoord : totalCells - 1;
+}
+
 //================================================================//
 // MOAIPartitionResultBuffer
 //================================================================//
 
+//----------------------------------------------------------------//
+void MOAIPartitionResultBuffer::AffirmSwapBuffer () {
+
+	if ( this->mSwapBuffer.Size () < this->mMainBuffer.Size ()) {
+		this->mSwapBuffer.Init ( this->mMainBuffer.Size ());
+	}
+}
+
 //----------------------------------------------------------------//
 void MOAIPartitionResultBuffer::Clear () {
 
 	this->mMainBuffer.Clear ();
 	this->mSwapBuffer.Clear ();
 	
+	this->mIsoItems.Clear ();
+	this->mIsoNodes.Clear ();
+	this->mIsoEdges.Clear ();
+	this->mIsoAdjacency.Clear ();
+	this->mIsoCells.Clear ();
+	this->mIsoCellItems.Clear ();
+	this->mIsoQueue.Clear ();
+	
+	this->mStateKeys.Clear ();
+	this->mStateTable.Clear ();
+	this->mStateIDs.Clear ();
+	this->mStateHeads.Clear ();
+	this->mStateTails.Clear ();
+	this->mStateNext.Clear ();
+	
 	this->mResults = 0;
 	this->mTotalResults = 0;
 }
@@ -118,6 +162,173 @@ MOAIProp* MOAIPartitionResultBuffer::FindBest () {
 	return best->mProp;
 }
 
+//----------------------------------------------------------------//
+// Projects the bounds of each result to get its screen space footprint, then finds every
+// pair of overlapping footprints. Footprints are binned into a uniform grid sized to the
+// average footprint and each overlapping pair is visited exactly once (in the cell holding
+// the min corner of the pair's intersection). The pairs are written to mIsoEdges with the
+// earlier result as mBack. Returns the number of pairs.
+u32 MOAIPartitionResultBuffer::GatherOverlaps ( const MOAIPartitionResult* results, u32 total, const USMatrix4x4* viewProj ) {
+
+	this->mIsoNodes.Grow ( total, BLOCK_SIZE );
+	MOAIIsoSortNode* nodes = this->mIsoNodes;
+	
+	// project the bounds of each prop to get its footprint
+	USRect frame;
+	float widthSum = 0.0f;
+	float heightSum = 0.0f;
+	
+	for ( u32 i = 0; i < total; ++i ) {
+	
+		MOAIIsoSortNode& node = nodes [ i ];
+		const USBox& bounds = results [ i ].mBounds;
+		
+		if ( viewProj ) {
+			for ( u32 j = 0; j < 8; ++j ) {
+				
+				USVec3D corner (
+					( j & 0x01 ) ? bounds.mMax.mX : bounds.mMin.mX,
+					( j & 0x02 ) ? bounds.mMax.mY : bounds.mMin.mY,
+					( j & 0x04 ) ? bounds.mMax.mZ : bounds.mMin.mZ
+				);
+				viewProj->Project ( corner );
+				
+				if ( j ) {
+					node.mRect.Grow ( corner );
+				}
+				else {
+					node.mRect.Init ( corner );
+				}
+			}
+		}
+		else {
+			node.mRect = bounds.GetRect ( USBox::PLANE_XY );
+		}
+		
+		node.mInDegree = 0;
+		node.mEdgeBase = 0;
+		node.mTotalEdges = 0;
+		
+		widthSum += node.mRect.Width ();
+		heightSum += node.mRect.Height ();
+		
+		if ( i ) {
+			frame.Grow ( node.mRect );
+		}
+		else {
+			frame = node.mRect;
+		}
+	}
+	
+	// size the grid to the average footprint, but keep the cell count proportional to the prop count
+	u32 maxCells = ( u32 )sqrtf (( float )total ) * 2 + 1;
+	
+	float frameWidth = frame.Width ();
+	float frameHeight = frame.Height ();
+	
+	float avgWidth = widthSum / ( float )total;
+	float avgHeight = heightSum / ( float )total;
+	
+	u32 xCells = (( avgWidth > 0.0f ) && ( frameWidth > 0.0f )) ? ( u32 )( frameWidth / avgWidth ) + 1 : 1;
+	u32 yCells = (( avgHeight > 0.0f ) && ( frameHeight > 0.0f )) ? ( u32 )( frameHeight / avgHeight ) + 1 : 1;
+	
+	xCells = xCells < maxCells ? xCells : maxCells;
+	yCells = yCells < maxCells ? yCells : maxCells;
+	
+	float cellWidth = frameWidth > 0.0f ? frameWidth / ( float )xCells : 1.0f;
+	float cellHeight = frameHeight > 0.0f ? frameHeight / ( float )yCells : 1.0f;
+	
+	u32 totalCells = xCells * yCells;
+	
+	// count the footprints touching each cell
+	this->mIsoCells.Grow ( totalCells + 1, BLOCK_SIZE );
+	u32* cells = this->mIsoCells;
+	memset ( cells, 0, ( totalCells + 1 ) * sizeof ( u32 ));
+	
+	u32 totalCellItems = 0;
+	for ( u32 i = 0; i < total; ++i ) {
+		
+		const USRect& rect = nodes [ i ].mRect;
+		
+		u32 x0 = _isoCellCoord ( rect.mXMin, frame.mXMin, cellWidth, xCells );
+		u32 x1 = _isoCellCoord ( rect.mXMax, frame.mXMin, cellWidth, xCells );
+		u32 y0 = _isoCellCoord ( rect.mYMin, frame.mYMin, cellHeight, yCells );
+		u32 y1 = _isoCellCoord ( rect.mYMax, frame.mYMin, cellHeight, yCells );
+		
+		for ( u32 y = y0; y <= y1; ++y ) {
+			for ( u32 x = x0; x <= x1; ++x ) {
+				cells [( y * xCells ) + x ]++;
+			}
+		}
+		totalCellItems += (( x1 - x0 ) + 1 ) * (( y1 - y0 ) + 1 );
+	}
+	
+	// convert counts to cell end offsets, then fill back to front so each cell ends up at its start offset
+	for ( u32 i = 1; i <= totalCells; ++i ) {
+		cells [ i ] += cells [ i - 1 ];
+	}
+	
+	this->mIsoCellItems.Grow ( totalCellItems, BLOCK_SIZE );
+	u32* cellItems = this->mIsoCellItems;
+	
+	for ( u32 i = total; i--; ) {
+		
+		const USRect& rect = nodes [ i ].mRect;
+		
+		u32 x0 = _isoCellCoord ( rect.mXMin, frame.mXMin, cellWidth, xCells );
+		u32 x1 = _isoCellCoord ( rect.mXMax, frame.mXMin, cellWidth, xCells );
+		u32 y0 = _isoCellCoord ( rect.mYMin, frame.mYMin, cellHeight, yCells );
+		u32 y1 = _isoCellCoord ( rect.mYMax, frame.mYMin, cellHeight, yCells );
+		
+		for ( u32 y = y0; y <= y1; ++y ) {
+			for ( u32 x = x0; x <= x1; ++x ) {
+				cellItems [ --cells [( y * xCells ) + x ]] = i;
+			}
+		}
+	}
+	
+	// find each pair of overlapping footprints
+	u32 totalPairs = 0;
+	
+	for ( u32 cellID = 0; cellID < totalCells; ++cellID ) {
+		
+		u32 end = cells [ cellID + 1 ];
+		
+		for ( u32 a = cells [ cellID ]; a < end; ++a ) {
+		
+			u32 idx1 = cellItems [ a ];
+			MOAIIsoSortNode& node1 = nodes [ idx1 ];
+			
+			for ( u32 b = a + 1; b < end; ++b ) {
+				
+				u32 idx0 = cellItems [ b ];
+				MOAIIsoSortNode& node0 = nodes [ idx0 ];
+				
+				if ( !node1.mRect.OverlapWithoutEdges ( node0.mRect )) continue;
+				
+				// only visit the pair in the cell holding the min corner of the intersection
+				float xMin = node0.mRect.mXMin > node1.mRect.mXMin ? node0.mRect.mXMin : node1.mRect.mXMin;
+				float yMin = node0.mRect.mYMin > node1.mRect.mYMin ? node0.mRect.mYMin : node1.mRect.mYMin;
+				
+				u32 x = _isoCellCoord ( xMin, frame.mXMin, cellWidth, xCells );
+				u32 y = _isoCellCoord ( yMin, frame.mYMin, cellHeight, yCells );
+				
+				if ((( y * xCells ) + x ) != cellID ) continue;
+				
+				if ( totalPairs >= this->mIsoEdges.Size ()) {
+					this->mIsoEdges.Grow ( totalPairs * 2, BLOCK_SIZE );
+				}
+				
+				MOAIIsoSortEdge& pair = this->mIsoEdges [ totalPairs++ ];
+				
+				pair.mBack = idx0 < idx1 ? idx0 : idx1;
+				pair.mFront = idx0 < idx1 ? idx1 : idx0;
+			}
+		}
+	}
+	return totalPairs;
+}
+
 //----------------------------------------------------------------//
 void MOAIPartitionResultBuffer::GenerateKeys ( u32 mode, float xScale, float yScale, float zScale, float priority ) {
 
@@ -168,16 +379,82 @@ void MOAIPartitionResultBuffer::GenerateKeys ( u32 mode, float xScale, float ySc
 	}
 }
 
+//----------------------------------------------------------------//
+// Assigns an ID to each distinct draw state among the results (in mStateIDs). Returns
+// the number of distinct states.
+u32 MOAIPartitionResultBuffer::MapDrawStates ( const MOAIPartitionResult* results, u32 total ) {
+
+	u32 tableSize = 1;
+	while ( tableSize < ( total << 1 )) {
+		tableSize <<= 1;
+	}
+	u32 mask = tableSize - 1;
+	
+	this->mStateTable.Grow ( tableSize, BLOCK_SIZE );
+	this->mStateKeys.Grow ( total, BLOCK_SIZE );
+	this->mStateIDs.Grow ( total, BLOCK_SIZE );
+	
+	// slots hold state ID + 1; zero is empty
+	u32* table = this->mStateTable;
+	memset ( table, 0, tableSize * sizeof ( u32 ));
+	
+	u32 totalStates = 0;
+	
+	for ( u32 i = 0; i < total; ++i ) {
+	
+		MOAIDrawStateKey key;
+		results [ i ].mProp->GetDrawStateKey ( key );
+		
+		u32 slot = key.Hash () & mask;
+		
+		while ( table [ slot ] && !this->mStateKeys [ table [ slot ] - 1 ].IsSame ( key )) {
+			slot = ( slot + 1 ) & mask;
+		}
+		
+		if ( !table [ slot ]) {
+			this->mStateKeys [ totalStates ] = key;
+			table [ slot ] = ++totalStates;
+		}
+		this->mStateIDs [ i ] = table [ slot ] - 1;
+	}
+	return totalStates;
+}
+
 //----------------------------------------------------------------//
 MOAIPartitionResultBuffer::MOAIPartitionResultBuffer () :
 	mResults ( 0 ),
-	mTotalResults ( 0 ) {
+	mTotalResults ( 0 ),
+	mViewVolume ( 0 ) {
 }
 
 //----------------------------------------------------------------//
 MOAIPartitionResultBuffer::~MOAIPartitionResultBuffer () {
 }
 
+//----------------------------------------------------------------//
+// Packs the edges in mIsoEdges by back node. Expects each node's mTotalEdges to hold its
+// outgoing edge count.
+void MOAIPartitionResultBuffer::PackIsoEdges ( u32 total, u32 totalEdges ) {
+
+	MOAIIsoSortNode* nodes = this->mIsoNodes;
+
+	this->mIsoAdjacency.Grow ( totalEdges, BLOCK_SIZE );
+	u32* adjacency = this->mIsoAdjacency;
+	
+	u32 edgeBase = 0;
+	for ( u32 i = 0; i < total; ++i ) {
+		nodes [ i ].mEdgeBase = edgeBase;
+		edgeBase += nodes [ i ].mTotalEdges;
+		nodes [ i ].mTotalEdges = 0;
+	}
+	
+	for ( u32 i = 0; i < totalEdges; ++i ) {
+		MOAIIsoSortEdge& edge = this->mIsoEdges [ i ];
+		MOAIIsoSortNode& back = nodes [ edge.mBack ];
+		adjacency [ back.mEdgeBase + back.mTotalEdges++ ] = edge.mFront;
+	}
+}
+
 //----------------------------------------------------------------//
 MOAIPartitionResult* MOAIPartitionResultBuffer::PopResult () {
 
@@ -227,7 +504,7 @@ void MOAIPartitionResultBuffer::Reset () {
 }
 
 //----------------------------------------------------------------//
-u32 MOAIPartitionResultBuffer::Sort ( u32 mode ) {
+u32 MOAIPartitionResultBuffer::Sort ( u32 mode, const USMatrix4x4* viewProj ) {
 
 	this->mResults = this->mMainBuffer;
 
@@ -237,15 +514,58 @@ u32 MOAIPartitionResultBuffer::Sort ( u32 mode ) {
 	else if ( mode == SORT_ISO ) {
 		return this->SortResultsIso ();
 	}
+	else if ( mode == SORT_ISO_GRAPH ) {
+		return this->SortResultsIsoGraph ( viewProj );
+	}
 	return this->SortResultsLinear ();
 }
 
+//----------------------------------------------------------------//
+// Reorders the (already sorted) results so runs of props sharing the same draw state are
+// drawn together. A prop may only move ahead of earlier props whose screen footprints it
+// doesn't overlap, so the final image is unchanged. Props without bounds (global or
+// empty) can't be placed and stay where they are, splitting the results into runs that
+// are reordered independently.
+u32 MOAIPartitionResultBuffer::SortByState ( const USMatrix4x4* viewProj ) {
+
+	u32 total = this->mTotalResults;
+	if (( total < 2 ) || !this->mResults ) return total;
+	
+	this->AffirmSwapBuffer ();
+	
+	MOAIPartitionResult* src = this->mResults;
+	MOAIPartitionResult* dst = ( src == this->mSwapBuffer ) ? this->mMainBuffer : this->mSwapBuffer;
+	
+	u32 base = 0;
+	for ( u32 i = 0; i <= total; ++i ) {
+	
+		if (( i < total ) && src [ i ].mProp->HasBounds ()) continue;
+		
+		if ( i > base ) {
+			this->SortRunByState ( &src [ base ], &dst [ base ], i - base, viewProj );
+		}
+		
+		if ( i < total ) {
+			dst [ i ] = src [ i ];
+		}
+		base = i + 1;
+	}
+	
+	for ( u32 i = 0; i < total; ++i ) {
+		dst [ i ].mKey = i;
+	}
+	
+	this->mResults = dst;
+	return total;
+}
+
 //----------------------------------------------------------------//
 u32 MOAIPartitionResultBuffer::SortResultsIso () {
 
 	this->mTotalResults = this->mTotalResults;
 
-	IsoSortItem* sortBuffer = ( IsoSortItem* )alloca ( this->mTotalResults * sizeof ( IsoSortItem ));
+	this->mIsoItems.Grow ( this->mTotalResults, BLOCK_SIZE );
+	IsoSortItem* sortBuffer = this->mIsoItems;
 	
 	IsoSortList frontList;
 	IsoSortList backList;
@@ -301,10 +621,7 @@ u32 MOAIPartitionResultBuffer::SortResultsIso () {
 		list.PushBack ( dontCareList );
 	}
 	
-	// affirm the swap buffer
-	if ( this->mSwapBuffer.Size () < this->mMainBuffer.Size ()) {
-		this->mSwapBuffer.Init ( this->mMainBuffer.Size ());
-	}
+	this->AffirmSwapBuffer ();
 	
 	IsoSortItem* cursor = list.mHead;
 	for ( u32 i = 0; cursor; cursor = cursor->mNext, ++i ) {
@@ -319,18 +636,191 @@ u32 MOAIPartitionResultBuffer::SortResultsIso () {
 	return this->mTotalResults;
 }
 
+//----------------------------------------------------------------//
+// Gives the same front/back ordering as SortResultsIso, but props are only compared
+// if their screen space footprints overlap (see GatherOverlaps). Each definite
+// front/back relationship becomes an edge in a dependency graph which is then
+// topologically sorted. Cycles are broken by drawing the earliest remaining prop.
+u32 MOAIPartitionResultBuffer::SortResultsIsoGraph ( const USMatrix4x4* viewProj ) {
+
+	u32 total = this->mTotalResults;
+	if ( !total ) return 0;
+
+	this->mIsoQueue.Grow ( total, BLOCK_SIZE );
+	
+	u32 totalPairs = this->GatherOverlaps ( this->mMainBuffer, total, viewProj );
+	MOAIIsoSortNode* nodes = this->mIsoNodes;
+	
+	// keep the pairs with a definite front/back relationship as edges
+	u32 totalEdges = 0;
+	
+	for ( u32 i = 0; i < totalPairs; ++i ) {
+		
+		u32 idx0 = this->mIsoEdges [ i ].mFront;
+		u32 idx1 = this->mIsoEdges [ i ].mBack;
+		
+		const USBox& bounds0 = this->mMainBuffer [ idx0 ].mBounds;
+		const USBox& bounds1 = this->mMainBuffer [ idx1 ].mBounds;
+		
+		// front flags
+		bool f0 =(( bounds1.mMax.mX < bounds0.mMin.mX ) || ( bounds1.mMax.mY < bounds0.mMin.mY ) || ( bounds1.mMax.mZ < bounds0.mMin.mZ ));
+		bool f1 =(( bounds0.mMax.mX < bounds1.mMin.mX ) || ( bounds0.mMax.mY < bounds1.mMin.mY ) || ( bounds0.mMax.mZ < bounds1.mMin.mZ ));
+		
+		// ambiguous; either order will do
+		if ( f0 == f1 ) continue;
+		
+		MOAIIsoSortEdge& edge = this->mIsoEdges [ totalEdges++ ];
+		
+		// prop0 is *clearly* in front of prop1 or the other way around
+		edge.mBack = f0 ? idx1 : idx0;
+		edge.mFront = f0 ? idx0 : idx1;
+		
+		nodes [ edge.mBack ].mTotalEdges++;
+		nodes [ edge.mFront ].mInDegree++;
+	}
+	
+	this->PackIsoEdges ( total, totalEdges );
+	u32* adjacency = this->mIsoAdjacency;
+	
+	// topological sort
+	this->AffirmSwapBuffer ();
+	
+	u32* queue = this->mIsoQueue;
+	u32 head = 0;
+	u32 tail = 0;
+	
+	for ( u32 i = 0; i < total; ++i ) {
+		if ( !nodes [ i ].mInDegree ) {
+			queue [ tail++ ] = i;
+		}
+	}
+	
+	u32 cursor = 0;
+	for ( u32 i = 0; i < total; ++i ) {
+		
+		u32 idx;
+		
+		if ( head < tail ) {
+			idx = queue [ head++ ];
+		}
+		else {
+			// everything left is part of (or behind) a cycle; draw the earliest remaining prop
+			while ( nodes [ cursor ].mInDegree == ISO_NODE_DRAWN ) ++cursor;
+			idx = cursor;
+		}
+		
+		MOAIIsoSortNode& node = nodes [ idx ];
+		node.mInDegree = ISO_NODE_DRAWN;
+		
+		this->mSwapBuffer [ i ] = this->mMainBuffer [ idx ];
+		this->mSwapBuffer [ i ].mKey = i;
+		
+		u32 edgeEnd = node.mEdgeBase + node.mTotalEdges;
+		for ( u32 j = node.mEdgeBase; j < edgeEnd; ++j ) {
+			
+			u32 frontIdx = adjacency [ j ];
+			MOAIIsoSortNode& front = nodes [ frontIdx ];
+			
+			if (( front.mInDegree != ISO_NODE_DRAWN ) && ( --front.mInDegree == 0 )) {
+				queue [ tail++ ] = frontIdx;
+			}
+		}
+	}
+	
+	this->mResults = this->mSwapBuffer;
+	return total;
+}
+
 //----------------------------------------------------------------//
 u32 MOAIPartitionResultBuffer::SortResultsLinear () {
 
 	this->mResults = this->mMainBuffer;
 
-	// affirm the swap buffer
-	if ( this->mSwapBuffer.Size () < this->mMainBuffer.Size ()) {
-		this->mSwapBuffer.Init ( this->mMainBuffer.Size ());
-	}
+	this->AffirmSwapBuffer ();
 	
 	// sort
 	this->mResults = RadixSort32 < MOAIPartitionResult >( this->mMainBuffer, this->mSwapBuffer, this->mTotalResults );
 	
 	return this->mTotalResults;
 }
+
+//----------------------------------------------------------------//
+// Topological sort over the overlap graph that keeps drawing with the current state
+// for as long as any result using it is free to draw. When none is, it switches to the
+// state of the earliest result that became free.
+void MOAIPartitionResultBuffer::SortRunByState ( const MOAIPartitionResult* src, MOAIPartitionResult* dst, u32 total, const USMatrix4x4* viewProj ) {
+
+	u32 totalEdges = this->GatherOverlaps ( src, total, viewProj );
+	MOAIIsoSortNode* nodes = this->mIsoNodes;
+	
+	// every overlap orders the pair; the earlier result still has to be drawn first
+	for ( u32 i = 0; i < totalEdges; ++i ) {
+	
+		MOAIIsoSortEdge& edge = this->mIsoEdges [ i ];
+		
+		nodes [ edge.mBack ].mTotalEdges++;
+		nodes [ edge.mFront ].mInDegree++;
+	}
+	
+	this->PackIsoEdges ( total, totalEdges );
+	u32* adjacency = this->mIsoAdjacency;
+	
+	u32 totalStates = this->MapDrawStates ( src, total );
+	u32* stateIDs = this->mStateIDs;
+	
+	// results that are free to draw are queued per state and in one queue across all states
+	this->mStateHeads.Grow ( totalStates, BLOCK_SIZE );
+	this->mStateTails.Grow ( totalStates, BLOCK_SIZE );
+	this->mStateNext.Grow ( total, BLOCK_SIZE );
+	this->mIsoQueue.Grow ( total, BLOCK_SIZE );
+	
+	u32* heads = this->mStateHeads;
+	u32* tails = this->mStateTails;
+	u32* next = this->mStateNext;
+	u32* queue = this->mIsoQueue;
+	
+	for ( u32 i = 0; i < totalStates; ++i ) {
+		heads [ i ] = ISO_NODE_DRAWN;
+	}
+	
+	u32 head = 0;
+	u32 tail = 0;
+	
+	for ( u32 i = 0; i < total; ++i ) {
+		if ( !nodes [ i ].mInDegree ) {
+			_pushStateQueue ( i, stateIDs [ i ], heads, tails, next );
+			queue [ tail++ ] = i;
+		}
+	}
+	
+	u32 state = stateIDs [ queue [ 0 ]];
+	
+	for ( u32 i = 0; i < total; ++i ) {
+		
+		if ( heads [ state ] == ISO_NODE_DRAWN ) {
+			
+			// nothing else can draw with this state yet
+			while ( nodes [ queue [ head ]].mInDegree == ISO_NODE_DRAWN ) ++head;
+			state = stateIDs [ queue [ head ]];
+		}
+		
+		u32 idx = heads [ state ];
+		heads [ state ] = next [ idx ];
+		
+		MOAIIsoSortNode& node = nodes [ idx ];
+		node.mInDegree = ISO_NODE_DRAWN;
+		
+		dst [ i ] = src [ idx ];
+		
+		u32 edgeEnd = node.mEdgeBase + node.mTotalEdges;
+		for ( u32 j = node.mEdgeBase; j < edgeEnd; ++j ) {
+			
+			u32 frontIdx = adjacency [ j ];
+			
+			if ( --nodes [ frontIdx ].mInDegree == 0 ) {
+				_pushStateQueue ( frontIdx, stateIDs [ frontIdx ], heads, tails, next );
+				queue [ tail++ ] = frontIdx;
+			}
+		}
+	}
+}
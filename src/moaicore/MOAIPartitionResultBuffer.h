@@ -6,6 +6,50 @@
 
 class MOAIProp;
 
+//================================================================//
+// MOAIDrawStateKey
+//================================================================//
+// Gfx state a prop draws with. Props with the same key can share a batch.
+class MOAIDrawStateKey {
+public:
+
+	const void*		mShader;
+	u32				mShaderID;		// deck's default shader; used if there's no shader object
+	const void*		mTexture;
+	const void*		mScissorRect;
+	int				mSrcFactor;
+	int				mDstFactor;
+	int				mCullMode;
+	int				mDepthTest;
+	bool			mDepthMask;
+	
+	//----------------------------------------------------------------//
+	inline u32 Hash () const {
+	
+		u32 hash = ( u32 )(( size_t )this->mShader >> 4 ) + this->mShaderID;
+		hash = ( hash * 31 ) + ( u32 )(( size_t )this->mTexture >> 4 );
+		hash = ( hash * 31 ) + ( u32 )(( size_t )this->mScissorRect >> 4 );
+		hash = ( hash * 31 ) + ( u32 )( this->mSrcFactor ^ ( this->mDstFactor << 16 ));
+		hash ^= hash >> 16;
+		return hash * 0x45d9f3b;
+	}
+	
+	//----------------------------------------------------------------//
+	inline bool IsSame ( const MOAIDrawStateKey& key ) const {
+		return (
+			( this->mShader == key.mShader ) &&
+			( this->mShaderID == key.mShaderID ) &&
+			( this->mTexture == key.mTexture ) &&
+			( this->mScissorRect == key.mScissorRect ) &&
+			( this->mSrcFactor == key.mSrcFactor ) &&
+			( this->mDstFactor == key.mDstFactor ) &&
+			( this->mCullMode == key.mCullMode ) &&
+			( this->mDepthTest == key.mDepthTest ) &&
+			( this->mDepthMask == key.mDepthMask )
+		);
+	}
+};
+
 //================================================================//
 // MOAIPartitionResult
 //================================================================//
@@ -21,6 +65,37 @@ public:
 	USBox		mBounds;
 };
 
+//================================================================//
+// IsoSortItem
+//================================================================//
+class IsoSortItem {
+public:
+	MOAIPartitionResult*	mResult;
+	IsoSortItem*			mNext;
+};
+
+//================================================================//
+// MOAIIsoSortNode
+//================================================================//
+class MOAIIsoSortNode {
+public:
+
+	USRect		mRect;			// screen space footprint
+	u32			mInDegree;		// props that must be drawn first
+	u32			mEdgeBase;		// first outgoing edge in the adjacency buffer
+	u32			mTotalEdges;
+};
+
+//================================================================//
+// MOAIIsoSortEdge
+//================================================================//
+class MOAIIsoSortEdge {
+public:
+
+	u32			mBack;
+	u32			mFront;
+};
+
 //================================================================//
 // MOAIPartitionResultBuffer
 //================================================================//
@@ -41,9 +116,35 @@ private:
 	MOAIPartitionResult*					mResults;
 	u32										mTotalResults;
 
+	// frustum for props that expand into sub-prims; if not set the gfx device's view volume is used
+	const USFrustum*						mViewVolume;
+
+	// scratch buffers for the iso sorts; kept around to avoid per frame allocations
+	USLeanArray < IsoSortItem >				mIsoItems;
+	USLeanArray < MOAIIsoSortNode >			mIsoNodes;
+	USLeanArray < MOAIIsoSortEdge >			mIsoEdges;
+	USLeanArray < u32 >						mIsoAdjacency;
+	USLeanArray < u32 >						mIsoCells;
+	USLeanArray < u32 >						mIsoCellItems;
+	USLeanArray < u32 >						mIsoQueue;
+
+	// scratch buffers for the state sort
+	USLeanArray < MOAIDrawStateKey >		mStateKeys;
+	USLeanArray < u32 >						mStateTable;
+	USLeanArray < u32 >						mStateIDs;
+	USLeanArray < u32 >						mStateHeads;
+	USLeanArray < u32 >						mStateTails;
+	USLeanArray < u32 >						mStateNext;
+
 	//----------------------------------------------------------------//
+	void					AffirmSwapBuffer				();
+	u32						GatherOverlaps					( const MOAIPartitionResult* results, u32 total, const USMatrix4x4* viewProj );
+	u32						MapDrawStates					( const MOAIPartitionResult* results, u32 total );
+	void					PackIsoEdges					( u32 total, u32 totalEdges );
 	u32						SortResultsIso					();
+	u32						SortResultsIsoGraph				( const USMatrix4x4* viewProj );
 	u32						SortResultsLinear				();
+	void					SortRunByState					( const MOAIPartitionResult* src, MOAIPartitionResult* dst, u32 total, const USMatrix4x4* viewProj );
 	
 public:
 
@@ -61,6 +162,8 @@ public:
 		SORT_Z_ASCENDING,
 		SORT_VECTOR_ASCENDING,
 		
+		SORT_ISO_GRAPH,
+		
 		SORT_PRIORITY_DESCENDING	= SORT_PRIORITY_ASCENDING | SORT_FLAG_DESCENDING,
 		SORT_X_DESCENDING			= SORT_X_ASCENDING | SORT_FLAG_DESCENDING,
 		SORT_Y_DESCENDING			= SORT_Y_ASCENDING | SORT_FLAG_DESCENDING,
@@ -69,6 +172,7 @@ public:
 	};
 
 	GET ( u32, TotalResults, mTotalResults )
+	GET_SET ( const USFrustum*, ViewVolume, mViewVolume )
 	
 	//----------------------------------------------------------------//
 	void					Clear							();
@@ -80,7 +184,8 @@ public:
 	void					PushProps						( lua_State* L );
 	void					PushResult						( MOAIProp& prop, u32 key, int subPrimID, s32 priority, const USVec3D& loc, const USBox& bounds );
 	void					Reset							();
-	u32						Sort							( u32 mode );
+	u32						Sort							( u32 mode, const USMatrix4x4* viewProj = 0 );
+	u32						SortByState						( const USMatrix4x4* viewProj = 0 );
 	
 	//----------------------------------------------------------------//
 	inline MOAIPartitionResult* GetResult ( u32 idx ) {
@@ -0,0 +1,315 @@
+// Copyright (c) 2010-2011 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#include "pch.h"
+#include <moaicore/MOAIGrid.h>
+#include <moaicore/MOAIGridPathGraph.h>
+#include <moaicore/MOAIPathBatch.h>
+#include <moaicore/MOAIPathFinder.h>
+#include <moaicore/MOAISim.h>
+
+//================================================================//
+// MOAIPathBatchTask
+//================================================================//
+
+//----------------------------------------------------------------//
+void MOAIPathBatchTask::Execute () {
+
+	for ( u32 i = 0; i < this->mTotal; ++i ) {
+
+		this->mPathFinder->Init ( this->mQueries [ i * 2 ], this->mQueries [( i * 2 ) + 1 ]);
+		this->mPathFinder->FindPath ( 0 );
+		this->mPaths [ i ].CloneFrom ( this->mPathFinder->GetPath ());
+	}
+}
+
+//----------------------------------------------------------------//
+MOAIPathBatchTask::MOAIPathBatchTask () :
+	mPathFinder ( 0 ),
+	mQueries ( 0 ),
+	mPaths ( 0 ),
+	mTotal ( 0 ) {
+}
+
+//----------------------------------------------------------------//
+MOAIPathBatchTask::~MOAIPathBatchTask () {
+}
+
+//----------------------------------------------------------------//
+void MOAIPathBatchTask::Solve ( MOAIPathFinder& pathFinder, const int* queries, USLeanArray < int >* paths, u32 total ) {
+
+	this->mPathFinder = &pathFinder;
+	this->mQueries = queries;
+	this->mPaths = paths;
+	this->mTotal = total;
+
+	this->Start ();
+}
+
+//================================================================//
+// local
+//================================================================//
+
+//----------------------------------------------------------------//
+/**	@name	addQuery
+	@text	Adds a query to the batch. Adding a query to a batch that
+			has finished discards its results and begins a new batch.
+			Queries may not be added while the batch is running.
+
+	@in		MOAIPathBatch self
+	@in		number startNodeID
+	@in		number targetNodeID
+	@out	number index			Index of the query, or nil if the batch is running.
+*/
+int MOAIPathBatch::_addQuery ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAIPathBatch, "UNN" )
+
+	if ( self->mState == BUSY ) return 0;
+
+	if ( self->mState == DONE ) {
+		self->mQueries.Reset ();
+		self->mPaths.Clear ();
+		self->mState = IDLE;
+	}
+
+	self->mQueries.Push ( state.GetValue < int >( 2, 1 ) - 1 );
+	self->mQueries.Push ( state.GetValue < int >( 3, 1 ) - 1 );
+
+	state.Push ( self->mQueries.GetTop () >> 1 );
+	return 1;
+}
+
+//----------------------------------------------------------------//
+/**	@name	getPathEntry
+	@text	Returns a path entry for a query. Results are only available
+			once the batch is done.
+
+	@in		MOAIPathBatch self
+	@in		number query
+	@in		number index
+	@out	number entry
+*/
+int MOAIPathBatch::_getPathEntry ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAIPathBatch, "UNN" )
+
+	if ( self->mState != DONE ) return 0;
+
+	u32 query = state.GetValue < u32 >( 2, 1 ) - 1;
+	u32 index = state.GetValue < u32 >( 3, 1 ) - 1;
+
+	if (( query < self->mPaths.Size ()) && ( index < self->mPaths [ query ].Size ())) {
+
+		state.Push ( self->mPaths [ query ][ index ] + 1 );
+		return 1;
+	}
+	return 0;
+}
+
+//----------------------------------------------------------------//
+/**	@name	getPathSize
+	@text	Returns the size of the path found for a query (zero if none
+			was found). Results are only available once the batch is done.
+
+	@in		MOAIPathBatch self
+	@in		number query
+	@out	number size
+*/
+int MOAIPathBatch::_getPathSize ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAIPathBatch, "UN" )
+
+	if ( self->mState != DONE ) return 0;
+
+	u32 query = state.GetValue < u32 >( 2, 1 ) - 1;
+
+	if ( query < self->mPaths.Size ()) {
+		state.Push ( self->mPaths [ query ].Size ());
+		return 1;
+	}
+	return 0;
+}
+
+//----------------------------------------------------------------//
+/**	@name	init
+	@text	Sets the path finder whose settings are used to solve the
+			queries. The path finder's graph must be a grid path graph.
+
+	@in		MOAIPathBatch self
+	@in		MOAIPathFinder pathFinder
+	@out	nil
+*/
+int MOAIPathBatch::_init ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAIPathBatch, "UU" )
+
+	if ( self->mState == BUSY ) return 0;
+
+	self->mPathFinder.Set ( *self, state.GetLuaObject < MOAIPathFinder >( 2, true ));
+	return 0;
+}
+
+//----------------------------------------------------------------//
+/**	@name	setCallback
+	@text	Sets the function to call when every query in the batch
+			has been solved.
+
+	@in		MOAIPathBatch self
+	@in		function callback		Called with the batch as its only parameter.
+	@out	nil
+*/
+int MOAIPathBatch::_setCallback ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAIPathBatch, "UF" )
+
+	self->SetLocal ( state, 2, self->mOnFinish );
+	return 0;
+}
+
+//================================================================//
+// MOAIPathBatch
+//================================================================//
+
+//----------------------------------------------------------------//
+void MOAIPathBatch::Dispatch () {
+
+	u32 total = this->mQueries.GetTop () >> 1;
+	this->mPaths.Init ( total );
+
+	MOAIPathFinder* pathFinder = this->mPathFinder;
+	MOAIPathGraph* graph = pathFinder ? pathFinder->GetGraph () : 0;
+	MOAIGridPathGraph* gridPathGraph = graph ? graph->AsType < MOAIGridPathGraph >() : 0;
+	MOAIGrid* grid = gridPathGraph ? gridPathGraph->GetGrid () : 0;
+
+	if ( !( total && grid )) {
+		this->Finish ();
+		return;
+	}
+
+	// workers search a copy of the grid so the sim may keep changing the original
+	MOAIGrid* snapshot = new MOAIGrid ();
+	snapshot->CloneFrom ( *grid );
+
+	u32 flags = pathFinder->GetFlags ();
+	bool hierarchical = (( flags & MOAIGridPathGraph::HIERARCHICAL ) != 0 ) && !pathFinder->HasTerrainDeck ();
+
+	// bring the abstraction up to date once here instead of once per worker
+	if ( hierarchical ) {
+		gridPathGraph->UpdateClusters (( flags & MOAIGridPathGraph::NO_DIAGONALS ) == 0 );
+	}
+
+	MOAISim& sim = MOAISim::Get ();
+	u32 threads = MIN ( total, sim.GetPathThreadCount ());
+	u32 base = 0;
+
+	for ( u32 i = 0; i < threads; ++i ) {
+
+		u32 count = ( total - base ) / ( threads - i );
+
+		// every worker gets its own graph and path finder; they share the snapshot
+		MOAIGridPathGraph* workerGraph = new MOAIGridPathGraph ();
+		workerGraph->SetGrid ( snapshot );
+
+		if ( hierarchical ) {
+			workerGraph->CopyClusters ( *gridPathGraph );
+		}
+
+		MOAIPathFinder* worker = new MOAIPathFinder ();
+		worker->Retain ();
+		worker->CopySettings ( *pathFinder );
+		worker->SetGraph ( workerGraph );
+
+		MOAIPathBatchTask* task = sim.GetPathThread ( i ).NewTask < MOAIPathBatchTask >();
+		task->SetDelegate ( this, &MOAIPathBatch::Finished );
+		task->Solve ( *worker, &this->mQueries [ base * 2 ], &this->mPaths [ base ], count );
+
+		base += count;
+	}
+
+	// hold on to the batch until every task has been published
+	this->Retain ();
+	this->mPendingTasks = threads;
+	this->mState = BUSY;
+}
+
+//----------------------------------------------------------------//
+void MOAIPathBatch::Finish () {
+
+	this->mState = DONE;
+
+	if ( this->mOnFinish ) {
+
+		MOAILuaStateHandle state = MOAILuaRuntime::Get ().State ();
+		this->PushLocal ( state, this->mOnFinish );
+		this->PushLuaUserdata ( state );
+		state.DebugCall ( 1, 0 );
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAIPathBatch::Finished ( MOAIPathBatchTask* task ) {
+
+	// releasing the worker also releases its graph and (with the last worker) the snapshot
+	task->mPathFinder->Release ();
+
+	if ( --this->mPendingTasks ) return;
+
+	this->Finish ();
+	this->Release ();
+}
+
+//----------------------------------------------------------------//
+bool MOAIPathBatch::IsDone () {
+
+	return ( this->mState == DONE );
+}
+
+//----------------------------------------------------------------//
+MOAIPathBatch::MOAIPathBatch () :
+	mState ( IDLE ),
+	mPendingTasks ( 0 ) {
+
+	RTTI_SINGLE ( MOAIAction )
+}
+
+//----------------------------------------------------------------//
+MOAIPathBatch::~MOAIPathBatch () {
+
+	this->mPathFinder.Set ( *this, 0 );
+}
+
+//----------------------------------------------------------------//
+void MOAIPathBatch::OnStart () {
+
+	if ( this->mState == IDLE ) {
+		this->Dispatch ();
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAIPathBatch::OnUpdate ( float step ) {
+	UNUSED ( step );
+
+	if ( this->mState == DONE ) {
+		this->Stop ();
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAIPathBatch::RegisterLuaClass ( MOAILuaState& state ) {
+
+	MOAIAction::RegisterLuaClass ( state );
+}
+
+//----------------------------------------------------------------//
+void MOAIPathBatch::RegisterLuaFuncs ( MOAILuaState& state ) {
+
+	MOAIAction::RegisterLuaFuncs ( state );
+
+	luaL_Reg regTable [] = {
+		{ "addQuery",			_addQuery },
+		{ "getPathEntry",		_getPathEntry },
+		{ "getPathSize",		_getPathSize },
+		{ "init",				_init },
+		{ "setCallback",		_setCallback },
+		{ NULL, NULL }
+	};
+
+	luaL_register ( state, 0, regTable );
+}
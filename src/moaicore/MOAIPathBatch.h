@@ -0,0 +1,94 @@
+// Copyright (c) 2010-2011 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#ifndef	MOAIPATHBATCH_H
+#define	MOAIPATHBATCH_H
+
+#include <moaicore/MOAIAction.h>
+#include <moaicore/MOAILua.h>
+
+class MOAIPathFinder;
+
+//================================================================//
+// MOAIPathBatchTask
+//================================================================//
+class MOAIPathBatchTask :
+	public USTask < MOAIPathBatchTask > {
+private:
+
+	friend class MOAIPathBatch;
+
+	MOAIPathFinder*			mPathFinder;
+	const int*				mQueries; // start and target node ID pairs
+	USLeanArray < int >*	mPaths;
+	u32						mTotal;
+
+	//----------------------------------------------------------------//
+	void			Execute					();
+
+public:
+
+	//----------------------------------------------------------------//
+					MOAIPathBatchTask		();
+					~MOAIPathBatchTask		();
+	void			Solve					( MOAIPathFinder& pathFinder, const int* queries, USLeanArray < int >* paths, u32 total );
+};
+
+//================================================================//
+// MOAIPathBatch
+//================================================================//
+/**	@name	MOAIPathBatch
+	@text	Action for solving many path queries on worker threads.
+			Queries are solved with the settings (graph, flags, heuristic,
+			weights and terrain deck) of a template MOAIPathFinder. When the
+			action starts, the graph's grid is copied and the queries are
+			split across MOAISim's pool of path threads, so the grid may
+			be changed freely while the batch runs. The terrain deck is
+			shared and must not be changed while the batch runs. Results
+			are published back on the main thread.
+*/
+class MOAIPathBatch :
+	public MOAIAction {
+private:
+
+	enum {
+		IDLE,
+		BUSY,
+		DONE,
+	};
+
+	MOAILuaSharedPtr < MOAIPathFinder >		mPathFinder;
+	USLeanStack < int, 64 >					mQueries;
+	USLeanArray < USLeanArray < int > >		mPaths;
+	
+	MOAILuaLocal							mOnFinish;
+	u32										mState;
+	u32										mPendingTasks;
+
+	//----------------------------------------------------------------//
+	static int		_addQuery				( lua_State* L );
+	static int		_getPathEntry			( lua_State* L );
+	static int		_getPathSize			( lua_State* L );
+	static int		_init					( lua_State* L );
+	static int		_setCallback			( lua_State* L );
+
+	//----------------------------------------------------------------//
+	void			Dispatch				();
+	void			Finish					();
+	void			Finished				( MOAIPathBatchTask* task );
+
+public:
+
+	DECL_LUA_FACTORY ( MOAIPathBatch )
+
+	//----------------------------------------------------------------//
+	bool			IsDone					();
+					MOAIPathBatch			();
+					~MOAIPathBatch			();
+	void			OnStart					();
+	void			OnUpdate				( float step );
+	void			RegisterLuaClass		( MOAILuaState& state );
+	void			RegisterLuaFuncs		( MOAILuaState& state );
+};
+
+#endif
@@ -95,10 +95,10 @@ int MOAIPathFinder::_getPathSize ( lua_State* L ) {
 int MOAIPathFinder::_init ( lua_State* L ) {
 	MOAI_LUA_SETUP ( MOAIPathFinder, "UNN" )
 	
-	self->mStartNodeID = state.GetValue < int >( 2, 1 ) - 1;
-	self->mTargetNodeID = state.GetValue < int >( 3, 1 ) - 1;
+	int startNodeID = state.GetValue < int >( 2, 1 ) - 1;
+	int targetNodeID = state.GetValue < int >( 3, 1 ) - 1;
 	
-	self->Reset ();
+	self->Init ( startNodeID, targetNodeID );
 	
 	return 0;
 }
@@ -256,14 +256,14 @@ int MOAIPathFinder::_setWeight ( lua_State* L ) {
 //================================================================//
 
 //----------------------------------------------------------------//
-void MOAIPathFinder::BuildPath ( MOAIPathState* state ) {
+void MOAIPathFinder::BuildPath ( u32 stateID ) {
 
 	u32 size = 0;
-	for ( MOAIPathState* cursor = state; cursor; cursor = cursor->mParent, ++size );
+	for ( u32 cursor = stateID; cursor != NO_STATE; cursor = this->mStates [ cursor ].mParent, ++size );
 	
 	this->mPath.Init ( size );
-	for ( MOAIPathState* cursor = state; cursor; cursor = cursor->mParent ) {
-		this->mPath [ --size ] = cursor->mNodeID;
+	for ( u32 cursor = stateID; cursor != NO_STATE; cursor = this->mStates [ cursor ].mParent ) {
+		this->mPath [ --size ] = this->mStates [ cursor ].mNodeID;
 	}
 	
 	this->ClearVisitation ();
@@ -272,37 +272,13 @@ void MOAIPathFinder::BuildPath ( MOAIPathState* state ) {
 //----------------------------------------------------------------//
 void MOAIPathFinder::ClearVisitation () {
 
-	while ( this->mOpen ) {
-		MOAIPathState* state = this->mOpen;
-		this->mOpen = this->mOpen->mNext;
-		delete state;
-	}
-	
-	while ( this->mClosed ) {
-		MOAIPathState* state = this->mClosed;
-		this->mClosed = this->mClosed->mNext;
-		delete state;
-	}
-}
-
-//----------------------------------------------------------------//
-void MOAIPathFinder::CloseState ( MOAIPathState* stateToClose ) {
-	
-	MOAIPathState* cursor = this->mOpen;
-	this->mOpen = 0;
+	this->mStates.Reset ();
+	this->mOpen.Reset ();
 	
-	while ( cursor ) {
-		MOAIPathState* state = cursor;
-		cursor = cursor->mNext;
-		
-		if ( state == stateToClose ) {
-			state->mNext = this->mClosed;
-			this->mClosed = state;
-		}
-		else {
-			state->mNext = this->mOpen;
-			this->mOpen = state;
-		}
+	// bump the stamp instead of clearing the visitation array
+	if ( ++this->mVisitStamp == 0 ) {
+		this->mVisitation.Fill ( 0 );
+		this->mVisitStamp = 1;
 	}
 }
 
@@ -346,50 +322,99 @@ float MOAIPathFinder::ComputeTerrainCost ( float moveCost, u32 terrain0, u32 ter
 	return terrainCost;
 }
 
+//----------------------------------------------------------------//
+void MOAIPathFinder::CopySettings ( MOAIPathFinder& src ) {
+
+	this->mTerrainDeck.Set ( *this, src.mTerrainDeck );
+	this->mWeights.CloneFrom ( src.mWeights );
+	
+	this->mMask = src.mMask;
+	this->mHeuristic = src.mHeuristic;
+	this->mFlags = src.mFlags;
+	this->mGWeight = src.mGWeight;
+	this->mHWeight = src.mHWeight;
+}
+
 //----------------------------------------------------------------//
 bool MOAIPathFinder::FindPath ( int iterations ) {
 	
-	if ( !this->mState ) {
+	if ( this->mState == NO_STATE ) {
 		this->PushState ( this->mStartNodeID, 0.0f );
 	}
 	
 	bool noIterations = iterations <= 0;
 	
-	for ( ; this->mOpen && (( iterations > 0 ) || noIterations ); iterations-- ) {
+	for ( ; this->mOpen.GetTop () && (( iterations > 0 ) || noIterations ); iterations-- ) {
 		
 		this->mState = this->NextState ();
-		this->CloseState ( this->mState );
+		int nodeID = this->mStates [ this->mState ].mNodeID;
 		
-		if ( this->mState->mNodeID == this->mTargetNodeID ) {
+		if ( nodeID == this->mTargetNodeID ) {
 			this->BuildPath ( this->mState );
 			return false;
 		}
-		this->mGraph->PushNeighbors ( *this, this->mState->mNodeID );
+		this->mGraph->PushNeighbors ( *this, nodeID );
 	}
-	return this->mOpen ? true : false;
+	return this->mOpen.GetTop () ? true : false;
 }
 
 //----------------------------------------------------------------//
-bool MOAIPathFinder::IsVisited ( int nodeID ) {
+MOAIPathGraph* MOAIPathFinder::GetGraph () {
 
-	for ( MOAIPathState* state = this->mOpen; state; state = state->mNext ) {
-		if ( state->mNodeID == nodeID ) return true;
-	}
-	
-	for ( MOAIPathState* state = this->mClosed; state; state = state->mNext ) {
-		if ( state->mNodeID == nodeID ) return true;
+	return this->mGraph;
+}
+
+//----------------------------------------------------------------//
+int MOAIPathFinder::GetParentNodeID () {
+
+	// node ID of the parent of the state currently being expanded (or -1 if none)
+	if ( this->mState != NO_STATE ) {
+		u32 parent = this->mStates [ this->mState ].mParent;
+		if ( parent != NO_STATE ) {
+			return this->mStates [ parent ].mNodeID;
+		}
 	}
+	return -1;
+}
+
+//----------------------------------------------------------------//
+bool MOAIPathFinder::HasTerrainDeck () {
+
+	return this->mTerrainDeck ? true : false;
+}
+
+//----------------------------------------------------------------//
+void MOAIPathFinder::Init ( int startNodeID, int targetNodeID ) {
+
+	this->mStartNodeID = startNodeID;
+	this->mTargetNodeID = targetNodeID;
 	
-	return false;
+	this->Reset ();
+}
+
+//----------------------------------------------------------------//
+bool MOAIPathFinder::IsBetter ( u32 stateID0, u32 stateID1 ) {
+
+	float score0 = this->mStates [ stateID0 ].mScore;
+	float score1 = this->mStates [ stateID1 ].mScore;
+
+	// break ties in favor of the most recently pushed state
+	return ( score0 < score1 ) || (( score0 == score1 ) && ( stateID0 > stateID1 ));
+}
+
+//----------------------------------------------------------------//
+bool MOAIPathFinder::IsVisited ( int nodeID ) {
+
+	u32 id = ( u32 )nodeID;
+	return ( id < this->mVisitation.Size ()) && ( this->mVisitation [ id ] == this->mVisitStamp );
 }
 
 //----------------------------------------------------------------//
 MOAIPathFinder::MOAIPathFinder () :
-	mOpen ( 0 ),
-	mClosed ( 0 ),
+	mVisitStamp ( 1 ),
 	mStartNodeID ( 0 ),
 	mTargetNodeID ( 0 ),
-	mState ( 0 ),
+	mState ( NO_STATE ),
 	mMask ( 0xffffffff ),
 	mHeuristic ( 0 ),
 	mFlags ( 0 ),
@@ -409,16 +434,32 @@ MOAIPathFinder::~MOAIPathFinder () {
 }
 
 //----------------------------------------------------------------//
-MOAIPathState* MOAIPathFinder::NextState () {
+u32 MOAIPathFinder::NextState () {
 
-	MOAIPathState* state = this->mOpen;
-	MOAIPathState* best = state;
-	state = state->mNext;
-
-	for ( ; state; state = state->mNext ) {
-		if ( state->mScore < best->mScore ) {
-			best = state;
+	// pop the root of the heap and sift the last entry down into its place
+	u32* heap = this->mOpen;
+	u32 best = heap [ 0 ];
+	
+	this->mOpen.Pop ();
+	u32 size = this->mOpen.GetTop ();
+	
+	if ( size ) {
+	
+		u32 stateID = heap [ size ];
+		u32 i = 0;
+		
+		for ( u32 child = 1; child < size; child = ( i * 2 ) + 1 ) {
+		
+			if ((( child + 1 ) < size ) && this->IsBetter ( heap [ child + 1 ], heap [ child ])) {
+				++child;
+			}
+			
+			if ( !this->IsBetter ( heap [ child ], stateID )) break;
+			
+			heap [ i ] = heap [ child ];
+			i = child;
 		}
+		heap [ i ] = stateID;
 	}
 	return best;
 }
@@ -426,14 +467,35 @@ MOAIPathState* MOAIPathFinder::NextState () {
 //----------------------------------------------------------------//
 void MOAIPathFinder::PushState ( int nodeID, float score ) {
 	
-	MOAIPathState* state = new MOAIPathState ();
-	state->mNodeID = nodeID;
-	state->mParent = this->mState;
-
-	state->mNext = this->mOpen;
-	this->mOpen = state;
+	u32 id = ( u32 )nodeID;
+	u32 visitationSize = this->mVisitation.Size ();
 	
-	state->mScore = score;
+	if ( id >= visitationSize ) {
+		u32 size = visitationSize * 2;
+		this->mVisitation.Resize ( size > id ? size : id + 1, 0 );
+	}
+	this->mVisitation [ id ] = this->mVisitStamp;
+	
+	u32 stateID = this->mStates.GetTop ();
+	this->mStates.Push ( MOAIPathState ());
+	
+	MOAIPathState& state = this->mStates [ stateID ];
+	state.mNodeID = nodeID;
+	state.mParent = this->mState;
+	state.mScore = score;
+	
+	// sift up
+	u32 i = this->mOpen.GetTop ();
+	this->mOpen.Push ( stateID );
+	u32* heap = this->mOpen;
+	
+	while ( i ) {
+		u32 parent = ( i - 1 ) >> 1;
+		if ( !this->IsBetter ( stateID, heap [ parent ])) break;
+		heap [ i ] = heap [ parent ];
+		i = parent;
+	}
+	heap [ i ] = stateID;
 }
 
 //----------------------------------------------------------------//
@@ -466,8 +528,14 @@ void MOAIPathFinder::RegisterLuaFuncs ( MOAILuaState& state ) {
 //----------------------------------------------------------------//
 void MOAIPathFinder::Reset () {
 
-	this->mState = 0;
+	this->mState = NO_STATE;
 	this->mPath.Clear ();
 
 	this->ClearVisitation ();
 }
+
+//----------------------------------------------------------------//
+void MOAIPathFinder::SetGraph ( MOAIPathGraph* graph ) {
+
+	this->mGraph.Set ( *this, graph );
+}
@@ -29,8 +29,7 @@ private:
 	friend class MOAIPathFinder;
 
 	int					mNodeID;
-	MOAIPathState*		mParent;
-	MOAIPathState*		mNext;
+	u32					mParent; // index of the parent in the state pool
 	
 	float				mScore;
 };
@@ -53,16 +52,21 @@ private:
 	USLeanArray < MOAIPathWeight > mWeights;
 	USLeanArray < int >	mPath;
 
-	// TODO: optimize implementation with memory pool of path states
-	// and binary heap of open paths
+	static const u32 NO_STATE			= 0xffffffff;
+	static const u32 STATE_CHUNK_SIZE	= 4096;
 
-	MOAIPathState*		mOpen;
-	MOAIPathState*		mClosed;
+	// states are pooled; the pool is reset (but not freed) when visitation is cleared
+	USLeanStack < MOAIPathState, STATE_CHUNK_SIZE >		mStates;
+	USLeanStack < u32, STATE_CHUNK_SIZE >				mOpen; // binary heap of indices into mStates
+	
+	// a node has been visited if its entry matches the current stamp
+	USLeanArray < u32 >		mVisitation;
+	u32						mVisitStamp;
 	
 	int					mStartNodeID;
 	int					mTargetNodeID;
 
-	MOAIPathState*		mState; // used while expanding open set
+	u32					mState; // used while expanding open set
 
 	u32					mMask;
 
@@ -87,10 +91,10 @@ private:
 	static int			_setWeight					( lua_State* L );
 
 	//----------------------------------------------------------------//
-	void				BuildPath			( MOAIPathState* state );
+	void				BuildPath			( u32 stateID );
 	void				ClearVisitation		();
-	void				CloseState			( MOAIPathState* stateToClose );
-	MOAIPathState*		NextState			();
+	bool				IsBetter			( u32 stateID0, u32 stateID1 );
+	u32					NextState			();
 	void				Reset				();
 
 public:
@@ -98,6 +102,8 @@ public:
 	DECL_LUA_FACTORY ( MOAIPathFinder )
 	
 	GET ( const USLeanArray < MOAIPathWeight >&, Weights, mWeights );
+	GET ( const USLeanArray < int >&, Path, mPath );
+	GET ( int, StartNodeID, mStartNodeID );
 	GET ( int, TargetNodeID, mTargetNodeID );
 	GET ( u32, Mask, mMask );
 	GET ( u32, Heuristic, mHeuristic )
@@ -108,13 +114,19 @@ public:
 	//----------------------------------------------------------------//
 	bool		CheckMask				( u32 terrain );
 	float		ComputeTerrainCost		( float moveCost, u32 terrain0, u32 terrain1 );
+	void		CopySettings			( MOAIPathFinder& src );
 	bool		FindPath				( int iterations );
+	MOAIPathGraph*	GetGraph			();
+	int			GetParentNodeID			();
+	bool		HasTerrainDeck			();
+	void		Init					( int startNodeID, int targetNodeID );
 	bool		IsVisited				( int nodeID );
 				MOAIPathFinder			();
 				~MOAIPathFinder			();
 	void		PushState				( int nodeID, float score );
 	void		RegisterLuaClass		( MOAILuaState& state );
 	void		RegisterLuaFuncs		( MOAILuaState& state );
+	void		SetGraph				( MOAIPathGraph* graph );
 };
 
 #endif
@@ -8,6 +8,7 @@
 #include <moaicore/MOAIDebugLines.h>
 #include <moaicore/MOAIGfxDevice.h>
 #include <moaicore/MOAIGrid.h>
+#include <moaicore/MOAIGridMesh.h>
 #include <moaicore/MOAILayoutFrame.h>
 #include <moaicore/MOAILogMessages.h>
 #include <moaicore/MOAIPartition.h>
@@ -324,6 +325,7 @@ int MOAIProp::_setCullMode ( lua_State* L ) {
 int MOAIProp::_setDeck ( lua_State* L ) {
 	MOAI_LUA_SETUP ( MOAIProp, "U" )
 
+	self->ClearGridMesh ();
 	self->mDeck.Set ( *self, state.GetLuaObject < MOAIDeck >( 2, true ));
 
 	if ( self->mDeck ) {
@@ -394,6 +396,7 @@ int MOAIProp::_setExpandForSort ( lua_State* L ) {
 	else {
 		self->mFlags &= ~FLAGS_EXPAND_FOR_SORT;
 	}
+	self->OnDepNodeFinish ();
 
 	return 0;
 }
@@ -413,7 +416,9 @@ int MOAIProp::_setGrid ( lua_State* L ) {
 	MOAIGrid* grid = state.GetLuaObject < MOAIGrid >( 2, true );
 	if ( !grid ) return 0;
 	
+	self->ClearGridMesh ();
 	self->mGrid.Set ( *self, grid );
+	self->OnDepNodeFinish ();
 	
 	return 0;
 }
@@ -627,7 +632,9 @@ void MOAIProp::AddToSortBuffer ( MOAIPartitionResultBuffer& buffer, u32 key ) {
 		MOAICellCoord c0;
 		MOAICellCoord c1;
 		
-		this->GetGridBoundsInView ( c0, c1 );
+		// layers may cull on a worker thread, so prefer the buffer's view volume over the device's
+		const USFrustum* viewVolume = buffer.GetViewVolume ();
+		this->GetGridBoundsInView ( viewVolume ? *viewVolume : MOAIGfxDevice::Get ().GetViewVolume (), c0, c1 );
 
 		for ( int y = c0.mY; y <= c1.mY; ++y ) {
 			for ( int x = c0.mX; x <= c1.mX; ++x ) {
@@ -688,6 +695,36 @@ bool MOAIProp::ApplyAttrOp ( u32 attrID, MOAIAttrOp& attrOp, u32 op ) {
 	return MOAITransform::ApplyAttrOp ( attrID, attrOp, op );
 }
 
+//----------------------------------------------------------------//
+bool MOAIProp::CanDrawGridMesh () {
+
+	// anything that changes tiles per frame or expects CPU transformed
+	// vertices has to go through the deck one tile at a time
+	if ( this->mRemapper || this->mUVTransform || this->mShader ) return false;
+	if ( this->mGrid->GetRepeat ()) return false;
+	if ( this->mDeck->GetShader () || !this->mDeck->CanWriteQuads ()) return false;
+	if ( !MOAIGridMesh::CanDraw ( *this->mGrid, *this->mDeck )) return false;
+
+	MOAIGfxDevice& gfxDevice = MOAIGfxDevice::Get ();
+	return gfxDevice.IsProgrammable () && gfxDevice.UsesVertexBuffers ();
+}
+
+//----------------------------------------------------------------//
+bool MOAIProp::CanUpdateInParallel () {
+
+	// updating the bounds moves the prop in its partition, which is shared
+	return false;
+}
+
+//----------------------------------------------------------------//
+void MOAIProp::ClearGridMesh () {
+
+	if ( this->mGridMesh ) {
+		delete this->mGridMesh;
+		this->mGridMesh = 0;
+	}
+}
+
 //----------------------------------------------------------------//
 void MOAIProp::Draw ( int subPrimID ) {
 	UNUSED ( subPrimID );
@@ -777,6 +814,17 @@ void MOAIProp::DrawGrid ( int subPrimID ) {
 
 	MOAIGfxDevice& gfxDevice = MOAIGfxDevice::Get ();
 	
+	// cached quads are in model space and transformed on the GPU, so the shader has to be
+	// in place before the world transform is set for it to pick up the matrix
+	bool drawMesh = ( subPrimID == MOAIProp::NO_SUBPRIM_ID ) && this->CanDrawGridMesh ();
+	
+	if ( drawMesh ) {
+		gfxDevice.SetShaderPreset ( MOAIShaderMgr::MESH_SHADER );
+		gfxDevice.SetPenColor ( this->mColor );
+		gfxDevice.SetVertexMtxMode ( MOAIGfxDevice::VTX_STAGE_MODEL, MOAIGfxDevice::VTX_STAGE_MODEL );
+		gfxDevice.SetUVMtxMode ( MOAIGfxDevice::UV_STAGE_MODEL, MOAIGfxDevice::UV_STAGE_TEXTURE );
+	}
+	
 	if ( this->mFlags & FLAGS_BILLBOARD ) {
 		USAffine3D billboardMtx;	
 		billboardMtx.Init ( gfxDevice.GetBillboardMtx ());
@@ -797,7 +845,16 @@ void MOAIProp::DrawGrid ( int subPrimID ) {
 		MOAICellCoord c0;
 		MOAICellCoord c1;
 		
-		this->GetGridBoundsInView ( c0, c1 );
+		this->GetGridBoundsInView ( gfxDevice.GetViewVolume (), c0, c1 );
+		
+		if ( drawMesh ) {
+		
+			if ( !this->mGridMesh ) {
+				this->mGridMesh = new MOAIGridMesh ( grid, *this->mDeck );
+			}
+			this->mGridMesh->Draw ( c0, c1 );
+			return;
+		}
 		
 		for ( int y = c0.mY; y <= c1.mY; ++y ) {
 			for ( int x = c0.mX; x <= c1.mX; ++x ) {
@@ -906,10 +963,33 @@ void MOAIProp::GetCollisionShape ( MOAICollisionShape& shape ) {
 }
 
 //----------------------------------------------------------------//
-void MOAIProp::GetGridBoundsInView ( MOAICellCoord& c0, MOAICellCoord& c1 ) {
+bool MOAIProp::GetDirectAttr ( u32 attrID, MOAIDirectAttr& attr ) {
+
+	if ( MOAIColor::GetDirectAttr ( attrID, attr )) return true;
+	return MOAITransform::GetDirectAttr ( attrID, attr );
+}
+
+//----------------------------------------------------------------//
+// Same state LoadGfxState binds, except the deck's default shader is identified by ID
+// rather than resolved (which may create it). Safe to call while culling on a worker.
+void MOAIProp::GetDrawStateKey ( MOAIDrawStateKey& key ) {
+
+	MOAIDeck* deck = this->mDeck;
+	
+	key.mShader = this->mShader ? ( MOAIGfxState* )this->mShader : ( deck ? deck->GetShader () : 0 );
+	key.mShaderID = ( deck && !key.mShader ) ? deck->GetDefaultShaderID () : 0;
+	key.mTexture = this->mTexture ? ( MOAIGfxState* )this->mTexture : ( deck ? deck->GetTexture () : 0 );
+	key.mScissorRect = this->mScissorRect;
+	key.mSrcFactor = this->mBlendMode.mSourceFactor;
+	key.mDstFactor = this->mBlendMode.mDestFactor;
+	key.mCullMode = this->mCullMode;
+	key.mDepthTest = this->mDepthTest;
+	key.mDepthMask = this->mDepthMask;
+}
+
+//----------------------------------------------------------------//
+void MOAIProp::GetGridBoundsInView ( const USFrustum& frustum, MOAICellCoord& c0, MOAICellCoord& c1 ) {
 
-	const USFrustum& frustum = MOAIGfxDevice::Get ().GetViewVolume ();
-	
 	USRect viewRect;
 	if ( frustum.GetXYSectRect ( this->GetWorldToLocalMtx (), viewRect )) {
 	
@@ -955,6 +1035,14 @@ MOAIPartition* MOAIProp::GetPartitionTrait () {
 	return this->mPartition;
 }
 
+//----------------------------------------------------------------//
+// False for props in the partition's global or empty cells; their bounds say nothing about where they draw.
+bool MOAIProp::HasBounds () {
+
+	if ( !this->mPartition ) return false;
+	return !( this->mPartition->IsGlobal ( *this ) || this->mPartition->IsEmpty ( *this ));
+}
+
 //----------------------------------------------------------------//
 bool MOAIProp::Inside ( USVec3D vec, float pad ) {
 
@@ -1009,6 +1097,8 @@ void MOAIProp::LoadGfxState () {
 MOAIProp::MOAIProp () :
 	mPartition ( 0 ),
 	mCell ( 0 ),
+	mCellIdx ( 0 ),
+	mPendingCell ( 0 ),
 	mLayer ( 0 ),
 	mNextResult ( 0 ),
 	mMask ( 0xffffffff ),
@@ -1016,6 +1106,7 @@ MOAIProp::MOAIProp () :
 	mFlags ( DEFAULT_FLAGS ),
 	mIndex( 1 ),
 	mGridScale ( 1.0f, 1.0f ),
+	mGridMesh ( 0 ),
 	mCullMode ( 0 ),
 	mDepthTest ( 0 ),
 	mDepthMask ( true ) {
@@ -1026,7 +1117,6 @@ MOAIProp::MOAIProp () :
 		RTTI_EXTEND ( MOAIRenderable )
 	RTTI_END
 	
-	this->mLinkInCell.Data ( this );
 	this->mBounds.Init ( 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f );
 }
 
@@ -1037,6 +1127,8 @@ MOAIProp::~MOAIProp () {
 		this->mCell->RemoveProp ( *this );
 	}
 	
+	this->ClearGridMesh ();
+	
 	this->mDeck.Set ( *this, 0 );
 	this->mRemapper.Set ( *this, 0 );
 	this->mGrid.Set ( *this, 0 );
@@ -1046,6 +1138,15 @@ MOAIProp::~MOAIProp () {
 	this->mScissorRect.Set ( *this, 0 );
 }
 
+//----------------------------------------------------------------//
+void MOAIProp::OnDepNodeFinish () {
+
+	// AddToSortBuffer reads the inverse of a grid expanded for sort on the cull workers
+	if ( this->mGrid && ( this->mFlags & FLAGS_EXPAND_FOR_SORT )) {
+		this->GetWorldToLocalMtx ();
+	}
+}
+
 //----------------------------------------------------------------//
 void MOAIProp::OnDepNodeUpdate () {
 	
@@ -1155,6 +1256,8 @@ void MOAIProp::Render () {
 //----------------------------------------------------------------//
 void MOAIProp::SerializeIn ( MOAILuaState& state, MOAIDeserializer& serializer ) {
 	
+	this->ClearGridMesh ();
+	
 	this->mDeck.Set ( *this, serializer.MemberIDToObject < MOAIDeck >( state.GetField < uintptr >( -1, "mDeck", 0 )));
 	this->mGrid.Set ( *this, serializer.MemberIDToObject < MOAIGrid >( state.GetField < uintptr >( -1, "mGrid", 0 )));
 }
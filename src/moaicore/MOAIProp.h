@@ -15,8 +15,10 @@ class MOAICellCoord;
 class MOAICollisionShape;
 class MOAIDeck;
 class MOAIDeckRemapper;
+class MOAIDrawStateKey;
 class MOAIGfxState;
 class MOAIGrid;
+class MOAIGridMesh;
 class MOAILayoutFrame;
 class MOAIOverlapPrim2D;
 class MOAIPartition;
@@ -83,11 +85,12 @@ private:
 
 	MOAIPartition*				mPartition;
 	MOAIPartitionCell*			mCell;
+	u32							mCellIdx;
+	MOAIPartitionCell*			mPendingCell; // cell the prop moves to on the partition's next flush
 	
 	// this is only for debug draw
 	MOAIPartitionLevel*			mLayer;
 	
-	USLeanLink < MOAIProp* >	mLinkInCell;
 	MOAIProp*					mNextResult;
 
 	u32				mMask;
@@ -123,6 +126,8 @@ private:
 	static int		_setVisible			( lua_State* L );
 
 	//----------------------------------------------------------------//
+	bool			CanDrawGridMesh		();
+	void			ClearGridMesh		();
 	void			DrawGrid			( int subPrimID );
 	void			DrawItem			();
 
@@ -136,6 +141,7 @@ protected:
 	
 	MOAILuaSharedPtr < MOAIGrid >			mGrid;
 	USVec2D									mGridScale;
+	MOAIGridMesh*							mGridMesh; // cached tile quads; built on demand
 	
 	// TODO: these should all be attributes
 	MOAILuaSharedPtr < MOAIShader >			mShader;
@@ -152,8 +158,9 @@ protected:
 
 	//----------------------------------------------------------------//
 	u32				GetFrameFitting			( USBox& bounds, USVec3D& offset, USVec3D& scale );
-	void			GetGridBoundsInView		( MOAICellCoord& c0, MOAICellCoord& c1 );
+	void			GetGridBoundsInView		( const USFrustum& frustum, MOAICellCoord& c0, MOAICellCoord& c1 );
 	virtual u32		GetPropBounds			( USBox& bounds ); // get the prop bounds in model space
+	bool			CanUpdateInParallel		();
 	void			LoadGfxState			();
 	void			UpdateBounds			( u32 status );
 	void			UpdateBounds			( const USBox& bounds, u32 status );
@@ -220,9 +227,13 @@ public:
 	MOAIPartition*		GetPartitionTrait		();
 	bool				GetCellRect				( USRect* cellRect, USRect* paddedRect = 0 );
 	virtual void		GetCollisionShape		( MOAICollisionShape& shape );
+	bool				GetDirectAttr			( u32 attrID, MOAIDirectAttr& attr );
+	void				GetDrawStateKey			( MOAIDrawStateKey& key );
+	bool				HasBounds				();
 	virtual bool		Inside					( USVec3D vec, float pad );
 						MOAIProp				();
 	virtual				~MOAIProp				();
+	void				OnDepNodeFinish			();
 	void				OnDepNodeUpdate			();
 	void				RegisterLuaClass		( MOAILuaState& state );
 	void				RegisterLuaFuncs		( MOAILuaState& state );
@@ -13,7 +13,7 @@
 void MOAIQuadBrush::BindVertexFormat ( MOAIGfxDevice& gfxDevice ) {
 	
 	gfxDevice.SetVertexPreset ( MOAIVertexFormatMgr::XYZWUVC );
-	gfxDevice.SetPrimType ( GL_TRIANGLES );
+	gfxDevice.SetPrimType ( MOAIGfxDevice::PRIM_QUADS );
 }
 
 //----------------------------------------------------------------//
@@ -308,3 +308,22 @@ void MOAIQuadBrush::TransformUVs ( const USAffine3D& mtx ) {
 	mtx.Transform ( this->mUV [ 2 ]);
 	mtx.Transform ( this->mUV [ 3 ]);
 }
+
+//----------------------------------------------------------------//
+void MOAIQuadBrush::WriteQuad ( MOAIQuadVertex* vtx, float xOff, float yOff, float zOff, float xScale, float yScale, float uOff, float vOff, float uScale, float vScale ) const {
+
+	// same corners and order as MOAIGfxDevice::WriteQuad, but untransformed and
+	// white; the pen color is left to the shader
+	for ( u32 i = 0; i < 4; ++i ) {
+	
+		vtx [ i ].mX = ( this->mVtx [ i ].mX * xScale ) + xOff;
+		vtx [ i ].mY = ( this->mVtx [ i ].mY * yScale ) + yOff;
+		vtx [ i ].mZ = zOff;
+		vtx [ i ].mW = 1.0f;
+		
+		vtx [ i ].mU = ( this->mUV [ i ].mX * uScale ) + uOff;
+		vtx [ i ].mV = ( this->mUV [ i ].mY * vScale ) + vOff;
+		
+		vtx [ i ].mColor = 0xffffffff;
+	}
+}
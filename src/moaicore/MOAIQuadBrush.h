@@ -5,6 +5,24 @@
 
 #include <moaicore/MOAIGfxDevice.h>
 
+//================================================================//
+// MOAIQuadVertex
+//================================================================//
+// matches the layout of MOAIVertexFormatMgr::XYZWUVC
+class MOAIQuadVertex {
+public:
+
+	float	mX;
+	float	mY;
+	float	mZ;
+	float	mW;
+	
+	float	mU;
+	float	mV;
+	
+	u32		mColor;
+};
+
 //================================================================//
 // MOAIQuadBrush
 //================================================================//
@@ -47,6 +65,7 @@ public:
 	void				SetVerts			( const USVec2D& v0, float radius );
 	void				TransformUVs		( const USAffine3D& mtx );
 	void				TransformVerts		( const USAffine3D& mtx );
+	void				WriteQuad			( MOAIQuadVertex* vtx, float xOff, float yOff, float zOff, float xScale, float yScale, float uOff, float vOff, float uScale, float vScale ) const;
 };
 
 #endif
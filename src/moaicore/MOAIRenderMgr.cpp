@@ -2,11 +2,39 @@
 // http://getmoai.com
 
 #include "pch.h"
+#include <moaicore/MOAIDeck.h>
 #include <moaicore/MOAIGfxDevice.h>
+#include <moaicore/MOAILayer.h>
 #include <moaicore/MOAIProp.h>
 #include <moaicore/MOAIRenderable.h>
 #include <moaicore/MOAIRenderMgr.h>
 
+//================================================================//
+// MOAILayerCullTask
+//================================================================//
+
+//----------------------------------------------------------------//
+void MOAILayerCullTask::Cull ( MOAILayer& layer ) {
+
+	this->mLayer = &layer;
+	this->Start ();
+}
+
+//----------------------------------------------------------------//
+void MOAILayerCullTask::Execute () {
+
+	this->mLayer->CullAndSort ();
+}
+
+//----------------------------------------------------------------//
+MOAILayerCullTask::MOAILayerCullTask () :
+	mLayer ( 0 ) {
+}
+
+//----------------------------------------------------------------//
+MOAILayerCullTask::~MOAILayerCullTask () {
+}
+
 //================================================================//
 // local
 //================================================================//
@@ -25,6 +53,21 @@ int MOAIRenderMgr::_getPerformanceDrawCount ( lua_State* L ) {
 	return 1;
 }
 
+//----------------------------------------------------------------//
+/**	@name	getPerformanceUploadSize
+	@text	Returns the number of bytes of vertex data sent to the
+			GPU last frame.
+
+	@out	number size
+*/
+int MOAIRenderMgr::_getPerformanceUploadSize ( lua_State* L ) {
+
+	MOAIRenderMgr& device = MOAIRenderMgr::Get ();
+	lua_pushnumber ( L, device.mLastUploadSize );
+
+	return 1;
+}
+
 //----------------------------------------------------------------//
 /**	@name	getRenderTable
 	@text	Returns the table currently being used for rendering.
@@ -61,6 +104,23 @@ int MOAIRenderMgr::_grabNextFrame ( lua_State* L ) {
 	return 0;
 }
 
+//----------------------------------------------------------------//
+/**	@name	setParallelCull
+	@text	Enables or disables culling and sorting layers on worker
+			threads. Has no effect if the render table holds fewer
+			than two layers. Disabled by default. Don't enable it if
+			a layer draws a MOAIScriptDeck with a rect callback; the
+			callback would be called from a worker thread.
+	
+	@opt	boolean enable		Default value is true.
+	@out	nil
+*/
+int MOAIRenderMgr::_setParallelCull ( lua_State* L ) {
+	MOAILuaState state ( L );
+	MOAIRenderMgr::Get ().mParallelCull = state.GetValue < bool >( 1, true );
+	return 0;
+}
+
 //----------------------------------------------------------------//
 /**	@name	setRenderTable
 	@text	Sets the table to be used for rendering. This should be
@@ -131,17 +191,99 @@ int MOAIRenderMgr::_setRenderTable ( lua_State* L ) {
 // MOAIRenderMgr
 //================================================================//
 
+//----------------------------------------------------------------//
+// Called when a deck's max bounds go stale. They are rebuilt on the main
+// thread before the next parallel cull so the cull workers only read them.
+void MOAIRenderMgr::AffirmDeckBounds ( MOAIDeck& deck ) {
+
+	this->mDirtyDecks.PushBack ( deck.mDirtyBoundsLink );
+}
+
+//----------------------------------------------------------------//
+void MOAIRenderMgr::CullLayers () {
+
+	u32 total = this->mCullLayers.GetTop ();
+	if ( !total ) return;
+
+	// the main thread takes every (CULL_THREAD_COUNT + 1)th layer; the rest go to the workers
+	u32 slots = (( total > 1 ) && this->mParallelCull ) ? CULL_THREAD_COUNT + 1 : 1;
+	
+	if ( slots > 1 ) {
+		this->UpdateDeckBounds ();
+	}
+
+	for ( u32 i = 0; i < total; ++i ) {
+	
+		u32 slot = i % slots;
+		if ( !slot ) continue;
+		
+		MOAILayerCullTask* task = this->mCullThreads [ slot - 1 ].NewTask < MOAILayerCullTask >();
+		task->Cull ( *this->mCullLayers [ i ]);
+	}
+	
+	for ( u32 i = 0; i < total; i += slots ) {
+		this->mCullLayers [ i ]->CullAndSort ();
+	}
+	
+	// drawing needs every layer, so wait for the workers before going on
+	if ( slots > 1 ) {
+		for ( u32 i = 0; i < CULL_THREAD_COUNT; ++i ) {
+			this->mCullThreads [ i ].Drain ();
+		}
+	}
+	
+	this->mCullLayers.Reset ();
+}
+
+//----------------------------------------------------------------//
+void MOAIRenderMgr::GatherLayers ( MOAILuaState& state, int idx ) {
+
+	idx = state.AbsIndex ( idx );
+
+	int n = 1;
+	while ( n ) {
+		
+		lua_rawgeti ( state, idx, n++ );
+		
+		int valType = lua_type ( state, -1 );
+			
+		if ( valType == LUA_TUSERDATA ) {
+			MOAILayer* layer = state.GetLuaObject < MOAILayer >( -1, false );
+			if ( layer && layer->PrepareCull ( this->mRenderCounter )) {
+				this->mCullLayers.Push ( layer );
+			}
+		}
+		else if ( valType == LUA_TTABLE ) {
+			this->GatherLayers ( state, -1 );
+		}
+		else {
+			n = 0;
+		}
+		
+		lua_pop ( state, 1 );
+	}
+}
+
 //----------------------------------------------------------------//
 MOAIRenderMgr::MOAIRenderMgr () :
 	mGrabNextFrame ( false ),
 	mLastDrawCount( 0 ),
-	mRenderCounter ( 0 ) {
+	mLastUploadSize ( 0 ),
+	mRenderCounter ( 0 ),
+	mParallelCull ( false ) {
 	
 	RTTI_SINGLE ( MOAILuaObject )
 }
 
 //----------------------------------------------------------------//
 MOAIRenderMgr::~MOAIRenderMgr () {
+
+	for ( u32 i = 0; i < CULL_THREAD_COUNT; ++i ) {
+		this->mCullThreads [ i ].Stop ();
+	}
+	
+	// decks may outlive the manager; unhook them from the list
+	this->mDirtyDecks.Clear ();
 }
 
 //----------------------------------------------------------------//
@@ -152,6 +294,8 @@ void MOAIRenderMgr::RegisterLuaClass ( MOAILuaState& state ) {
 		{ "setRenderTable",				_setRenderTable },
 		{ "grabNextFrame",				_grabNextFrame },
 		{ "getPerformanceDrawCount",	_getPerformanceDrawCount },
+		{ "getPerformanceUploadSize",	_getPerformanceUploadSize },
+		{ "setParallelCull",			_setParallelCull },
 		{ NULL, NULL }
 	};
 
@@ -171,15 +315,19 @@ void MOAIRenderMgr::Render () {
 	MOAIGfxDevice& gfxDevice = MOAIGfxDevice::Get ();
 
 	gfxDevice.BeginDrawing ();
+	gfxDevice.ProcessUploads ();
 	
 	if ( this->mRenderTable ) {
 		MOAILuaStateHandle state = MOAILuaRuntime::Get ().State ();
 		state.Push ( this->mRenderTable );
+		this->GatherLayers ( state, -1 );
+		this->CullLayers ();
 		this->RenderTable ( state, -1 );
 		state.Pop ( 1 );
 	}
 
 	gfxDevice.Flush ();
+	gfxDevice.EvictResources ();
 	gfxDevice.ProcessDeleters ();
 
 	if ( mGrabNextFrame ) {
@@ -196,6 +344,7 @@ void MOAIRenderMgr::Render () {
 	}
 
 	this->mLastDrawCount = MOAIGfxDevice::Get().GetDrawCount();
+	this->mLastUploadSize = MOAIGfxDevice::Get ().GetUploadSize ();
 }
 
 //----------------------------------------------------------------//
@@ -225,4 +374,14 @@ void MOAIRenderMgr::RenderTable ( MOAILuaState& state, int idx ) {
 		
 		lua_pop ( state, 1 );
 	}
-}
\ No newline at end of file
+}
+
+//----------------------------------------------------------------//
+void MOAIRenderMgr::UpdateDeckBounds () {
+
+	while ( this->mDirtyDecks.Count ()) {
+		MOAIDeck* deck = this->mDirtyDecks.Front ();
+		this->mDirtyDecks.PopFront ();
+		deck->GetBounds ();
+	}
+}
@@ -8,8 +8,30 @@
 #include <moaicore/MOAILua.h>
 #include <moaicore/MOAIImage.h>
 
+class MOAIDeck;
+class MOAILayer;
 class MOAIProp;
 
+//================================================================//
+// MOAILayerCullTask
+//================================================================//
+class MOAILayerCullTask :
+	public USTask < MOAILayerCullTask > {
+private:
+
+	MOAILayer*		mLayer;
+
+	//----------------------------------------------------------------//
+	void			Execute					();
+
+public:
+
+	//----------------------------------------------------------------//
+	void			Cull					( MOAILayer& layer );
+					MOAILayerCullTask		();
+					~MOAILayerCullTask		();
+};
+
 //================================================================//
 // MOAIRenderMgr
 //================================================================//
@@ -24,6 +46,10 @@ class MOAIProp;
 			counting from the base index until 'nil' is encountered. The render
 			table may include other tables as entries. These must also be arrays
 			indexed from 1.
+			
+			Before drawing, the layers in the render table are culled and
+			sorted. Set setParallelCull () to spread this work across a
+			small pool of worker threads when there is more than one layer.
 */
 class MOAIRenderMgr :
 	public MOAIGlobalClass < MOAIRenderMgr, MOAILuaObject > {
@@ -34,16 +60,27 @@ private:
 	MOAIImage*		mFrameImage;
 
 	u32				mLastDrawCount; // Draw count for last frame.
+	u32				mLastUploadSize; // Bytes of vertex data uploaded last frame.
 
 	MOAILuaLocal	mOnFrameFinish;
 
 	u32				mRenderCounter;	// increments every render
 	MOAILuaRef		mRenderTable;
 	
+	static const u32 CULL_THREAD_COUNT = 3;
+	USTaskThread	mCullThreads [ CULL_THREAD_COUNT ]; // the main thread culls alongside these
+	
+	USLeanStack < MOAILayer*, 16 >	mCullLayers;
+	bool			mParallelCull;
+	
+	USLeanList < MOAIDeck* >		mDirtyDecks; // decks whose max bounds must be rebuilt before the workers read them
+	
 	//----------------------------------------------------------------//
 	static int		_grabNextFrame				( lua_State* L );
 	static int		_getPerformanceDrawCount    ( lua_State* L );
+	static int		_getPerformanceUploadSize	( lua_State* L );
 	static int		_getRenderTable				( lua_State* L );
+	static int		_setParallelCull			( lua_State* L );
 	static int		_setRenderTable				( lua_State* L );
 
 	//----------------------------------------------------------------//
@@ -55,7 +92,10 @@ private:
 	#endif
 
 	//----------------------------------------------------------------//
+	void			CullLayers					();
+	void			GatherLayers				( MOAILuaState& state, int idx );
 	void			RenderTable					( MOAILuaState& state, int idx );
+	void			UpdateDeckBounds			();
 
 public:
 
@@ -64,6 +104,7 @@ public:
 	GET ( u32, RenderCounter, mRenderCounter )
 	
 	//----------------------------------------------------------------//
+	void			AffirmDeckBounds			( MOAIDeck& deck );
 					MOAIRenderMgr				();
 					~MOAIRenderMgr				();
 	void			RegisterLuaClass			( MOAILuaState& state );
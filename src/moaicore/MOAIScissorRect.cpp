@@ -65,6 +65,13 @@ int MOAIScissorRect::_setScissorRect ( lua_State* L ) {
 // MOAIScissorRect
 //================================================================//
 
+//----------------------------------------------------------------//
+bool MOAIScissorRect::CanUpdateInParallel () {
+
+	// the rect and parent rect are only read when drawing; the update only builds the transform
+	return true;
+}
+
 //----------------------------------------------------------------//
 USRect MOAIScissorRect::GetScissorRect ( const USMatrix4x4& worldToWndMtx ) const {
 
@@ -25,6 +25,9 @@ private:
 	static int		_setRect				( lua_State* L );
 	static int		_setScissorRect			( lua_State* L );
 
+	//----------------------------------------------------------------//
+	bool			CanUpdateInParallel		();
+
 public:
 	
 	DECL_LUA_FACTORY ( MOAIScissorRect )
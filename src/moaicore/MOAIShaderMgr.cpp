@@ -17,6 +17,8 @@
 #include <moaicore/shaders/MOAILineShader-vsh.h>
 #include <moaicore/shaders/MOAIMeshShader-fsh.h>
 #include <moaicore/shaders/MOAIMeshShader-vsh.h>
+#include <moaicore/shaders/MOAIParticleShader-fsh.h>
+#include <moaicore/shaders/MOAIParticleShader-vsh.h>
 
 //================================================================//
 // local
@@ -27,7 +29,8 @@
 	@text	Return one of the built-in shaders.
 
 	@in		number shaderID		One of MOAIShaderMgr.DECK2D_SHADER, MOAIShaderMgr.FONT_SHADER,
-								MOAIShaderMgr.LINE_SHADER, MOAIShaderMgr.MESH_SHADER
+								MOAIShaderMgr.LINE_SHADER, MOAIShaderMgr.MESH_SHADER,
+								MOAIShaderMgr.PARTICLE_SHADER
 	@out	nil
 */
 int MOAIShaderMgr::_getShader ( lua_State* L ) {
@@ -115,6 +118,20 @@ MOAIShader& MOAIShaderMgr::GetShader ( u32 shaderID ) {
 				shader->DeclareUniform ( 0, "transform", MOAIShaderUniform::UNIFORM_WORLD_VIEW_PROJ );
 				shader->DeclareUniform ( 1, "ucolor", MOAIShaderUniform::UNIFORM_PEN_COLOR );
 
+				break;
+			
+			case PARTICLE_SHADER:
+			
+				shader->SetSource ( _particleShaderVSH, _particleShaderFSH );
+				shader->SetVertexAttribute ( MOAIVertexFormatMgr::PARTICLE_CORNER, "corner" );
+				shader->SetVertexAttribute ( MOAIVertexFormatMgr::PARTICLE_SPRITE, "sprite" );
+				shader->SetVertexAttribute ( MOAIVertexFormatMgr::PARTICLE_ROTATION, "rotation" );
+				shader->SetVertexAttribute ( MOAIVertexFormatMgr::PARTICLE_COLOR, "color" );
+				
+				shader->ReserveUniforms ( 2 );
+				shader->DeclareUniform ( 0, "transform", MOAIShaderUniform::UNIFORM_WORLD_VIEW_PROJ );
+				shader->DeclareUniform ( 1, "ucolor", MOAIShaderUniform::UNIFORM_PEN_COLOR );
+				
 				break;
 		}
 		
@@ -152,6 +169,7 @@ void MOAIShaderMgr::RegisterLuaClass ( MOAILuaState& state ) {
 	state.SetField ( -1, "FONT_SHADER",				( u32 )FONT_SHADER );
 	state.SetField ( -1, "LINE_SHADER",				( u32 )LINE_SHADER );
 	state.SetField ( -1, "MESH_SHADER",				( u32 )MESH_SHADER );
+	state.SetField ( -1, "PARTICLE_SHADER",			( u32 )PARTICLE_SHADER );
 	
 	luaL_Reg regTable [] = {
 		{ "getShader",				_getShader },
@@ -17,6 +17,7 @@ class MOAIShader;
 	const FONT_SHADER
 	const LINE_SHADER
 	const MESH_SHADER
+	const PARTICLE_SHADER
 */
 class MOAIShaderMgr :
 	public MOAIGlobalClass < MOAIShaderMgr, MOAILuaObject > {
@@ -28,6 +29,7 @@ public:
 		FONT_SHADER,
 		LINE_SHADER,
 		MESH_SHADER,
+		PARTICLE_SHADER,
 		TOTAL_SHADERS,
 	};
 
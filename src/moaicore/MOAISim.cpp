@@ -8,6 +8,7 @@
 #include <moaicore/MOAIInputMgr.h>
 #include <moaicore/MOAILogMessages.h>
 #include <moaicore/MOAINodeMgr.h>
+#include <moaicore/MOAIParticleMgr.h>
 #include <moaicore/MOAIProp.h>
 #include <moaicore/MOAISim.h>
 #include <moaicore/MOAITextureBase.h>
@@ -522,6 +523,51 @@ int MOAISim::_setLuaAllocLogEnabled ( lua_State* L ) {
 	return 0;
 }
 
+//----------------------------------------------------------------//
+/**	@name	setParallelNodeUpdate
+	@text	Enables or disables updating nodes on worker threads. Nodes are
+			grouped by how deep they sit in the dependency graph; nodes
+			that don't depend on each other and can safely update off the
+			main thread (plain transforms, cameras, scissor rects, particle
+			forces, colors and anim curves) are spread across a small pool
+			of workers. Props, script nodes and any other node with side
+			effects always update on the main thread. Disabled by default.
+	
+	@opt	boolean enable			Default value is true.
+	@out	nil
+*/
+int MOAISim::_setParallelNodeUpdate ( lua_State* L ) {
+	MOAILuaState state ( L );
+	MOAINodeMgr::Get ().SetParallelUpdate ( state.GetValue < bool >( 1, true ));
+	return 0;
+}
+
+//----------------------------------------------------------------//
+/**	@name	setParallelParticleUpdate
+	@text	Enables or disables simulating particle systems on worker
+			threads. Systems queue up as the action tree updates them and
+			all simulate together once every action has run, each into its
+			own sprite buffer. Plugins that must stay on the main thread
+			(such as MOAIParticleCallbackPlugin) are called afterward, in
+			order, on a copy of the particle's registers. Changes a render
+			callback makes to the registers of a particle that is changing
+			state are discarded. A system given particles or sprites after
+			the action tree has updated it takes its step right away, so
+			those wait for the next step as they would when updating
+			serially. Random numbers drawn while simulating come from a
+			generator per system seeded from math.random's, so runs repeat
+			with the same seed but differ from a serial run. Disabled by
+			default.
+	
+	@opt	boolean enable			Default value is true.
+	@out	nil
+*/
+int MOAISim::_setParallelParticleUpdate ( lua_State* L ) {
+	MOAILuaState state ( L );
+	MOAIParticleMgr::Get ().SetParallelUpdate ( state.GetValue < bool >( 1, true ));
+	return 0;
+}
+
 //----------------------------------------------------------------//
 /**	@name	setStep
 	@text	Sets the size of each simulation step (in seconds).
@@ -654,6 +700,12 @@ int MOAISim::_timeToFrames ( lua_State* L ) {
 // MOAISim
 //================================================================//
 
+//----------------------------------------------------------------//
+USTaskThread& MOAISim::GetPathThread ( u32 idx ) {
+
+	return this->mPathThreads [ idx % PATH_THREAD_COUNT ];
+}
+
 //----------------------------------------------------------------//
 MOAISim::MOAISim () :
 	mLoopState ( START ),
@@ -779,6 +831,8 @@ void MOAISim::RegisterLuaClass ( MOAILuaState& state ) {
 		{ "setLongDelayThreshold",		_setLongDelayThreshold },
 		{ "setLoopFlags",				_setLoopFlags },
 		{ "setLuaAllocLogEnabled",		_setLuaAllocLogEnabled },
+		{ "setParallelNodeUpdate",		_setParallelNodeUpdate },
+		{ "setParallelParticleUpdate",	_setParallelParticleUpdate },
 		{ "setStep",					_setStep },
 		{ "setStepMultiplier",			_setStepMultiplier },
 		{ "setTimerError",				_setTimerError },
@@ -834,6 +888,7 @@ double MOAISim::StepSim ( double step, u32 multiplier ) {
 			
 		MOAIInputMgr::Get ().Update ();
 		MOAIActionMgr::Get ().Update (( float )step );		
+		MOAIParticleMgr::Get ().Update ();
 		MOAINodeMgr::Get ().Update ();
 		this->mSimTime += step;
 	}
@@ -855,6 +910,11 @@ void MOAISim::Update () {
 	#endif
 	
 	this->mDataIOThread.Publish ();
+	this->mGlyphThread.Publish ();
+	
+	for ( u32 i = 0; i < PATH_THREAD_COUNT; ++i ) {
+		this->mPathThreads [ i ].Publish ();
+	}
 	
 	// try to account for timer error
 	if ( this->mTimerError != 0.0 ) {
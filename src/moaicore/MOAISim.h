@@ -65,6 +65,10 @@ private:
 	u32				mFrameRateIdx;
 	
 	USTaskThread	mDataIOThread;
+	USTaskThread	mGlyphThread; // renders glyphs for fonts using FONT_ASYNC_RENDER
+	
+	static const u32 PATH_THREAD_COUNT = 4;
+	USTaskThread	mPathThreads [ PATH_THREAD_COUNT ]; // worker pool for MOAIPathBatch
 	
 	u32				mLoopFlags;
 	double			mBoostThreshold;
@@ -101,6 +105,8 @@ private:
 	static int		_setLongDelayThreshold		( lua_State* L );
 	static int		_setLoopFlags				( lua_State* L );
 	static int		_setLuaAllocLogEnabled		( lua_State* L );
+	static int		_setParallelNodeUpdate		( lua_State* L );
+	static int		_setParallelParticleUpdate	( lua_State* L );
 	static int		_setStep					( lua_State* L );
 	static int		_setStepMultiplier			( lua_State* L );
 	static int		_setTimerError				( lua_State* L );
@@ -138,6 +144,8 @@ public:
 	DECL_LUA_SINGLETON ( MOAISim )
 	
 	GET ( USTaskThread&, DataIOThread, mDataIOThread )
+	GET ( USTaskThread&, GlyphThread, mGlyphThread )
+	GET ( u32, PathThreadCount, PATH_THREAD_COUNT )
 	GET ( double, Step, mStep )
 	
 	static const u32 LOOP_FLAGS_DEFAULT		= SIM_LOOP_ALLOW_SPIN | SIM_LOOP_LONG_DELAY;
@@ -152,6 +160,7 @@ public:
 	static const u32 DEFAULT_STEP_MULTIPLIER		= 1;
 	
 	//----------------------------------------------------------------//
+	USTaskThread&	GetPathThread				( u32 idx );
 					MOAISim						();
 					~MOAISim					();
 	void			PauseMOAI					();
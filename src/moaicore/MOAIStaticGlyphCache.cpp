@@ -50,6 +50,11 @@ MOAITexture* MOAIStaticGlyphCache::GetTexture ( u32 id ) {
 	return this->mTextures [ id ];
 }
 
+//----------------------------------------------------------------//
+void MOAIStaticGlyphCache::InvalidateGlyph ( MOAIGlyph& glyph ) {
+	UNUSED ( glyph );
+}
+
 //----------------------------------------------------------------//
 bool MOAIStaticGlyphCache::IsDynamic () {
 
@@ -35,6 +35,7 @@ public:
 	MOAITextureBase*	GetGlyphTexture				( MOAIGlyph& glyph );
 	MOAIImage*			GetImage					();
 	MOAITexture*		GetTexture					( u32 id );
+	void				InvalidateGlyph				( MOAIGlyph& glyph );
 	bool				IsDynamic					();
 						MOAIStaticGlyphCache		();
 						~MOAIStaticGlyphCache		();
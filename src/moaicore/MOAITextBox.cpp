@@ -60,6 +60,26 @@ void MOAITextStyleRef::UpdateState () {
 // local
 //================================================================//
 
+//----------------------------------------------------------------//
+/**	@name	appendString
+	@text	Adds text to the end of the text box's string. Unlike setString ()
+			this keeps highlights and the current reveal, and only the text
+			after the last line break before the old end of the string is
+			laid out again.
+
+	@in		MOAITextBox self
+	@in		string str				The text to append.
+	@out	nil
+*/
+int MOAITextBox::_appendString ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAITextBox, "US" )
+
+	cc8* text = state.GetValue < cc8* >( 2, "" );
+	self->AppendText ( text );
+
+	return 0;
+}
+
 //----------------------------------------------------------------//
 /**	@name	clearHighlights
 	@text	Removes all highlights currently associated with the text box.
@@ -202,6 +222,9 @@ int MOAITextBox::_getStyle ( lua_State* L ) {
 int MOAITextBox::_more ( lua_State* L ) {
 	MOAI_LUA_SETUP ( MOAITextBox, "U" )
 	
+	// mMore is only known once any appended text has been laid out
+	self->Layout ();
+	
 	lua_pushboolean ( L, self->mMore );
 	return 1;
 }
@@ -617,6 +640,26 @@ int MOAITextBox::_spool ( lua_State* L ) {
 
 const float MOAITextBox::DEFAULT_SPOOL_SPEED = 24.0f;
 
+//----------------------------------------------------------------//
+void MOAITextBox::AppendText ( cc8* text ) {
+
+	if ( !( text && text [ 0 ])) return;
+
+	int oldLength = ( int )this->mTextLength;
+
+	this->mText.append ( text );
+	this->mTextLength = ( u32 )this->mText.length ();
+	
+	if ( this->mStyledTop == oldLength ) {
+		this->InvalidateLayout ( oldLength );
+	}
+	else {
+		this->ResetStyleMap ();
+		this->InvalidateLayout ( 0 );
+	}
+	this->ScheduleUpdate ();
+}
+
 //----------------------------------------------------------------//
 MOAITextStyle* MOAITextBox::AddAnonymousStyle ( MOAITextStyle* source ) {
 
@@ -766,9 +809,11 @@ void MOAITextBox::ClearHighlights () {
 }
 
 //----------------------------------------------------------------//
-bool MOAITextBox::CheckStylesChanged () {
+int MOAITextBox::CheckStylesChanged () {
 
-	bool status = false;
+	// returns the index of the first character set in a changed style, or -1 if no style changed
+
+	USLeanStack < MOAITextStyle*, 8 > changed;
 
 	// TODO: think about keeping list of currently active styles instead of iterating through everything
 	
@@ -777,7 +822,7 @@ bool MOAITextBox::CheckStylesChanged () {
 		MOAITextStyleRef& styleRef = this->mAnonymousStyles [ i ];
 		if ( styleRef.NeedsLayout ()) {
 			styleRef.UpdateState ();
-			status = true;
+			changed.Push ( styleRef.mStyle );
 		}
 	}
 
@@ -786,11 +831,23 @@ bool MOAITextBox::CheckStylesChanged () {
 		MOAITextStyleRef& styleRef = styleSetIt->second;
 		if ( styleRef.NeedsLayout ()) {
 			styleRef.UpdateState ();
-			status = true;
+			changed.Push ( styleRef.mStyle );
 		}
 	}
 
-	return status;
+	u32 totalChanged = changed.GetTop ();
+	if ( !totalChanged ) return -1;
+
+	u32 totalSpans = this->mStyleMap.GetTop ();
+	for ( u32 i = 0; i < totalSpans; ++i ) {
+		MOAITextStyleSpan& span = this->mStyleMap [ i ];
+		for ( u32 j = 0; j < totalChanged; ++j ) {
+			if ( span.mStyle == changed [ j ]) {
+				return span.mBase;
+			}
+		}
+	}
+	return ( int )this->mTextLength;
 }
 
 //----------------------------------------------------------------//
@@ -884,6 +941,9 @@ void MOAITextBox::Draw ( int subPrimID ) {
 		for ( u32 i = 0; ( i < size ) && ( i < this->mReveal ); ++i ) {
 			const MOAITextSprite& sprite = this->mSprites [ i ];
 			
+			// glyph is still being rendered on the glyph thread
+			if ( !sprite.mGlyph->mReady ) continue;
+			
 			rgba0 = sprite.mMask & MOAITextSprite::MASK_COLOR ? sprite.mRGBA : sprite.mStyle->mColor;
 			
 			if ( rgba0 != rgba1 ) {
@@ -939,6 +999,18 @@ void MOAITextBox::DrawDebug ( int subPrimID ) {
 	}
 }
 
+//----------------------------------------------------------------//
+u32 MOAITextBox::FindBreak ( int idx ) {
+
+	// last break at or before idx; appends usually land after the last one
+	for ( u32 i = this->mBreaks.GetTop (); i-- > 0; ) {
+		if ( this->mBreaks [ i ].mIdx <= idx ) {
+			return i;
+		}
+	}
+	return NO_BREAK;
+}
+
 //----------------------------------------------------------------//
 void MOAITextBox::FindSpriteSpan ( u32 idx, u32 size, u32& spanIdx, u32& spanSize ) {
 
@@ -1030,6 +1102,15 @@ MOAITextStyle* MOAITextBox::GetStyle ( cc8* styleName ) {
 	return this->mStyleSet [ DEFAULT_STYLE_NAME ].mStyle;
 }
 
+//----------------------------------------------------------------//
+void MOAITextBox::InvalidateLayout ( int idx ) {
+
+	this->mNeedsLayout = true;
+	if ( idx < this->mRelayoutIdx ) {
+		this->mRelayoutIdx = idx;
+	}
+}
+
 //----------------------------------------------------------------//
 bool MOAITextBox::IsDone () {
 
@@ -1052,18 +1133,38 @@ void MOAITextBox::Layout () {
 		if ( !this->mStyleMap.GetTop ()) {
 			MOAITextStyler styler;
 			styler.BuildStyleMap ( *this );
+			this->mRelayoutIdx = 0;
+		}
+		else if ( this->mStyledTop < ( int )this->mTextLength ) {
+			MOAITextStyler styler;
+			styler.AppendStyleMap ( *this );
 		}
-		
-		this->ResetLayout ();
 		
 		MOAITextDesigner designer;
-		designer.Init ( *this );
+		
+		// pick up from the last hard line break before the first change, if there is one
+		u32 breakID = this->FindBreak ( this->mRelayoutIdx );
+		if ( breakID != NO_BREAK ) {
+		
+			MOAITextBreak textBreak = this->mBreaks [ breakID ];
+			
+			this->mBreaks.SetTop ( breakID + 1 );
+			this->mLines.SetTop ( textBreak.mLineTop );
+			this->mSprites.SetTop ( textBreak.mSpriteTop );
+			
+			designer.Resume ( *this, textBreak );
+		}
+		else {
+			this->ResetLayout ();
+			designer.Init ( *this );
+		}
 		designer.BuildLayout ();
 	
 		this->ApplyHighlights ();
 	}
 	
 	this->mNeedsLayout = false;
+	this->mRelayoutIdx = ( int )this->mTextLength;
 }
 
 //----------------------------------------------------------------//
@@ -1081,6 +1182,9 @@ MOAITextBox::MOAITextBox () :
 	mCurrentPageIdx ( 0 ),
 	mNextPageIdx ( 0 ),
 	mNeedsLayout ( false ),
+	mRelayoutIdx ( 0 ),
+	mStyledTop ( -1 ),
+	mLayoutYOff ( 0.0f ),
 	mMore ( false ),
 	mHighlights ( 0 ),
 	mWordBreak ( WORD_BREAK_NONE ) {
@@ -1129,6 +1233,9 @@ bool MOAITextBox::More () {
 //----------------------------------------------------------------//
 void MOAITextBox::NextPage ( bool reveal ) {
 	
+	// appended text may not have been laid out yet; the page break has to be current
+	this->Layout ();
+	
 	if ( this->mMore ) {
 		this->mCurrentPageIdx = this->mNextPageIdx;
 	}
@@ -1146,8 +1253,9 @@ void MOAITextBox::OnDepNodeUpdate () {
 
 	MOAIProp::OnDepNodeUpdate ();
 
-	if ( this->CheckStylesChanged ()) {
-		this->mNeedsLayout = true;
+	int styleIdx = this->CheckStylesChanged ();
+	if ( styleIdx >= 0 ) {
+		this->InvalidateLayout ( styleIdx );
 		this->RefreshStyleGlyphs ();
 	}
 	this->Layout ();
@@ -1159,7 +1267,7 @@ void MOAITextBox::OnDepNodeUpdate () {
 		mtx.ScRoTr ( 1.0f, -1.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, ( this->mFrame.mYMin + this->mFrame.mYMax ), 0.0f );
 		this->mLocalToWorldMtx.Prepend ( mtx );
 		
-		this->mWorldToLocalMtx.Inverse ( this->mLocalToWorldMtx );
+		this->SetWorldToLocalDirty ();
 	}
 }
 
@@ -1266,6 +1374,7 @@ void MOAITextBox::RegisterLuaFuncs ( MOAILuaState& state ) {
 	MOAIAction::RegisterLuaFuncs ( state );
 	
 	luaL_Reg regTable [] = {
+		{ "appendString",			_appendString },
 		{ "clearHighlights",		_clearHighlights },
 		{ "getGlyphScale",			_getGlyphScale },
 		{ "getLineSpacing",			_getLineSpacing },
@@ -1337,6 +1446,7 @@ void MOAITextBox::ResetLayout () {
 	this->mMore = false;
 	this->mLines.Reset ();
 	this->mSprites.Reset ();
+	this->mBreaks.Reset ();
 }
 
 //----------------------------------------------------------------//
@@ -1358,6 +1468,8 @@ void MOAITextBox::ResetStyleMap () {
 	}
 	this->mAnonymousStyles.Reset ();
 	this->mStyleMap.Reset ();
+	this->mStyleStack.Reset ();
+	this->mStyledTop = -1;
 }
 
 //----------------------------------------------------------------//
@@ -1382,7 +1494,7 @@ void MOAITextBox::RetainStyle ( MOAITextStyle* style ) {
 //----------------------------------------------------------------//
 void MOAITextBox::ScheduleLayout () {
 
-	this->mNeedsLayout = true;
+	this->InvalidateLayout ( 0 );
 	this->ScheduleUpdate ();
 }
 
@@ -86,6 +86,28 @@ public:
 
 };
 
+//================================================================//
+// MOAITextBreak
+//================================================================//
+// Designer state just after a hard line break. Appending or restyling
+// text only lays the page out again from the last break before the change.
+class MOAITextBreak {
+private:
+
+	friend class MOAITextDesigner;
+	friend class MOAITextBox;
+	
+	int					mIdx;			// index of the first character after the '\n'
+	u32					mLineTop;		// lines laid out before the break
+	u32					mSpriteTop;		// sprites laid out before the break
+	float				mPenY;
+	USRect				mTokenRect;
+	MOAITextStyle*		mStyle;			// style in effect at the break
+
+public:
+
+};
+
 //================================================================//
 // MOAITextHighlight
 //================================================================//
@@ -214,6 +236,7 @@ private:
 	friend class MOAITextStyler;
 
 	static const u32 REVEAL_ALL = 0xffffffff;
+	static const u32 NO_BREAK = 0xffffffff;
 	static const float DEFAULT_SPOOL_SPEED;
 
 	float				mLineSpacing;
@@ -237,6 +260,7 @@ private:
 	int					mCurrentPageIdx;
 	int					mNextPageIdx;
 	bool				mNeedsLayout;
+	int					mRelayoutIdx;	// layout of the text before this index is still good
 	
 	USLeanArray < MOAIAnimCurve* > mCurves;
 	
@@ -253,10 +277,18 @@ private:
 	// actually layout out a page of text. text is laid out based on the style spans.
 	USLeanStack < MOAITextStyleSpan, 64 > mStyleMap; // each span represents a stretch of 'styled' text
 	
+	// where the styler left off, so appended text can be styled without
+	// parsing the whole string again. mStyledTop is -1 if the map can't
+	// be extended (no map yet or an escape was cut off by the end of the text).
+	USLeanStack < MOAITextStyle*, 8 >	mStyleStack;
+	int									mStyledTop;
+	
 	// this is the text page layout. these are the action sprites and lines
 	// that will be rendered for the current page.
 	USLeanStack < MOAITextSprite, 64 >	mSprites;
 	USLeanStack < MOAITextLine, 8 >		mLines;
+	USLeanStack < MOAITextBreak, 16 >	mBreaks;		// hard line breaks in the page, in text order
+	float								mLayoutYOff;	// vertical offset the page was aligned with
 	bool								mMore;
 	
 	// list of highlight spans
@@ -266,6 +298,7 @@ private:
 	u32 mWordBreak;
 	
 	//----------------------------------------------------------------//
+	static int			_appendString			( lua_State* L );
 	static int			_clearHighlights		( lua_State* L );
 	static int			_getGlyphScale			( lua_State* L );
 	static int			_getLineSpacing			( lua_State* L );
@@ -303,9 +336,11 @@ private:
 	void				ApplyHighlights			();
 	void				ClearHighlight			( u32 base, u32 top );
 	void				ClearHighlights			();
-	bool				CheckStylesChanged		();
+	int					CheckStylesChanged		();
 	void				CompactHighlights		();
+	u32					FindBreak				( int idx );
 	void				FindSpriteSpan			( u32 idx, u32 size, u32& spanIdx, u32& spanSize );
+	void				InvalidateLayout		( int idx );
 	void				Layout					();
 	void				OnDepNodeUpdate			();
 	void				PushLine				( u32 start, u32 size, const USRect& rect, float ascent );
@@ -337,6 +372,7 @@ public:
 	DECL_LUA_FACTORY ( MOAITextBox )
 	
 	//----------------------------------------------------------------//
+	void				AppendText				( cc8* text );
 	void				ClearCurves				();
 	void				Draw					( int subPrimID );
 	void				DrawDebug				( int subPrimID );
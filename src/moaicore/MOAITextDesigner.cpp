@@ -88,10 +88,30 @@ void MOAITextDesigner::Align () {
 			yOff = this->mTextBox->mFrame.mYMax - layoutHeight;
 	}
 	
+	// lines kept from the last layout are already aligned; they only need
+	// to move if the height of the layout changed their vertical offset
+	float yShift = yOff - this->mTextBox->mLayoutYOff;
+	this->mTextBox->mLayoutYOff = yOff;
+	
 	u32 totalLines = this->mTextBox->mLines.GetTop ();
 	for ( u32 i = 0; i < totalLines; ++i ) {
 		MOAITextLine& line = this->mTextBox->mLines [ i ];
 		
+		if ( i < this->mFirstLine ) {
+		
+			if ( yShift != 0.0f ) {
+				
+				line.mRect.Offset ( 0.0f, yShift );
+				
+				if ( hasSprites ) {
+					for ( u32 j = 0; j < line.mSize; ++j ) {
+						this->mTextBox->mSprites [ line.mStart + j ].mY += yShift;
+					}
+				}
+			}
+			continue;
+		}
+		
 		float xOff = this->mTextBox->mFrame.mXMin;
 		float lineWidth = line.mRect.Width ();
 		
@@ -156,7 +176,8 @@ void MOAITextDesigner::BuildLayout () {
 					this->mLineRect.mYMax += this->mDeck->mHeight * scale;
 				}
 				
-				this->AcceptLine ();	
+				this->AcceptLine ();
+				this->PushBreak ();
 			}
 			else if ( c == 0 ) {
 			
@@ -170,12 +191,16 @@ void MOAITextDesigner::BuildLayout () {
 		else {
 			
 			MOAIGlyph* glyph = this->mDeck->GetGlyph ( c );
-			if ( !glyph ) continue;
+			if ( !glyph ) {
+				// a glyph not yet in the set has no kerning with its neighbors
+				this->mPrevGlyph = 0;
+				continue;
+			}
 			
 			// apply kerning
 			if ( this->mPrevGlyph ) {
-				MOAIKernVec kernVec = this->mPrevGlyph->GetKerning ( glyph->mCode );
-				this->mPen.mX += kernVec.mX * scale;
+				USVec2D kerning = this->mDeck->GetKerning ( this->mPrevGlyph->mCode, glyph->mCode );
+				this->mPen.mX += kerning.mX * scale;
 			}
 			
 			this->mPrevGlyph = glyph;
@@ -281,6 +306,7 @@ void MOAITextDesigner::Init ( MOAITextBox& textBox ) {
 	
 	this->mPen.Init ( 0.0f, 0.0f );
 	this->mPrevGlyph = 0;
+	this->mFirstLine = 0;
 	this->mTextBox->mMore = true;
 }
 
@@ -342,3 +368,45 @@ u32 MOAITextDesigner::NextChar () {
 	}
 	return 0;
 }
+
+//----------------------------------------------------------------//
+void MOAITextDesigner::PushBreak () {
+
+	MOAITextBreak textBreak;
+	
+	textBreak.mIdx			= this->mIdx;
+	textBreak.mLineTop		= this->mTextBox->mLines.GetTop ();
+	textBreak.mSpriteTop	= this->mTextBox->mSprites.GetTop ();
+	textBreak.mPenY			= this->mPen.mY;
+	textBreak.mTokenRect	= this->mTokenRect;
+	textBreak.mStyle		= this->mStyle;
+	
+	this->mTextBox->mBreaks.Push ( textBreak );
+}
+
+//----------------------------------------------------------------//
+void MOAITextDesigner::Resume ( MOAITextBox& textBox, const MOAITextBreak& textBreak ) {
+
+	this->Init ( textBox );
+	if ( !this->mTextBox ) return;
+	
+	// state as AcceptLine leaves it after the break's '\n'
+	this->mIdx = textBreak.mIdx;
+	this->mPrevIdx = this->mIdx;
+	
+	this->mLineIdx = this->mIdx;
+	this->mLineSpriteID = textBreak.mSpriteTop;
+	this->mLineRect.Init ( 0.0f, textBreak.mPenY, 0.0f, textBreak.mPenY );
+	
+	this->mTokenIdx = this->mIdx;
+	this->mTokenSpriteID = textBreak.mSpriteTop;
+	this->mTokenRect = textBreak.mTokenRect;
+	
+	this->mPen.Init ( 0.0f, textBreak.mPenY );
+	
+	// the style also has to be in place in case the break is the end of the text
+	this->mStyle = textBreak.mStyle;
+	this->mDeck = this->mStyle->mFont->GetGlyphSet ( this->mStyle->mSize );
+	
+	this->mFirstLine = textBreak.mLineTop;
+}
@@ -5,6 +5,7 @@
 #define	MOAITEXTDESIGNER_H
 
 class MOAITextBox;
+class MOAITextBreak;
 class MOAITextStyle;
 class MOAITextStyleSpan;
 
@@ -44,12 +45,14 @@ private:
 	MOAIGlyph* mPrevGlyph;
 	
 	MOAITextBox* mTextBox;
+	u32 mFirstLine; // lines before this were kept from the last layout
 	
 	//----------------------------------------------------------------//
 	void			AcceptLine				();
 	void			AcceptToken				();
 	void			Align					();
 	u32				NextChar				();
+	void			PushBreak				();
 
 public:
 
@@ -58,6 +61,7 @@ public:
 	void			Init					( MOAITextBox& textBox );
 					MOAITextDesigner		();
 	virtual			~MOAITextDesigner		();
+	void			Resume					( MOAITextBox& textBox, const MOAITextBreak& textBreak );
 };
 
 #endif
@@ -22,11 +22,34 @@
 		TRANSITION ( next )					\
 	}
 
+//----------------------------------------------------------------//
+void MOAITextStyler::AppendStyleMap ( MOAITextBox& textBox ) {
+
+	// pick up where the last parse of the text box's string stopped
+	assert ( textBox.mStyledTop >= 0 );
+	
+	this->mIdx = textBox.mStyledTop;
+	this->mPrev = this->mIdx;
+	this->mTextBox = &textBox;
+	this->mStr = textBox.mText;
+	
+	this->mTokenBase = this->mIdx;
+	this->mTokenTop = this->mIdx;
+	
+	u32 totalStyles = textBox.mStyleStack.GetTop ();
+	for ( u32 i = 0; i < totalStyles; ++i ) {
+		this->PushStyle ( textBox.mStyleStack [ i ]);
+	}
+	this->Parse ();
+}
+
 //----------------------------------------------------------------//
 void MOAITextStyler::BuildStyleMap ( MOAITextBox& textBox ) {
 
 	// throw out any existing style map
 	textBox.mStyleMap.Reset ();
+	textBox.mStyleStack.Reset ();
+	textBox.mStyledTop = -1;
 	
 	MOAITextStyle* defaultStyle = textBox.GetStyle ();
 	if ( !defaultStyle ) return;
@@ -78,7 +101,8 @@ u8 MOAITextStyler::HexToByte ( u32 c ) {
 //----------------------------------------------------------------//
 MOAITextStyler::MOAITextStyler () :
 	mIdx ( 0 ),
-	mStr ( 0 ) {
+	mStr ( 0 ),
+	mOpenEscape ( false ) {
 }
 
 //----------------------------------------------------------------//
@@ -195,6 +219,14 @@ void MOAITextStyler::Parse () {
 		MOAITextStyle* style = this->mActiveStyles [ i ];
 		style->mFont->ProcessGlyphs ();
 	}
+	
+	// save the style stack so appended text can be styled from here
+	this->mTextBox->mStyleStack.Reset ();
+	u32 totalStyles = this->mStyleStack.GetTop ();
+	for ( u32 i = 0; i < totalStyles; ++i ) {
+		this->mTextBox->mStyleStack.Push ( this->mStyleStack [ i ]);
+	}
+	this->mTextBox->mStyledTop = this->mOpenEscape ? -1 : ( int )this->mTextBox->mTextLength;
 }
 
 //----------------------------------------------------------------//
@@ -233,6 +265,10 @@ bool MOAITextStyler::ParseStyle () {
 				
 				c = this->GetChar ();
 
+				if ( c == 0 ) {
+					TRANSITION ( STYLE_ABORT );
+				}
+
 				if ( c == '<' ) {
 					this->mIdx = startIdx + 1;
 					this->FinishToken ();
@@ -249,6 +285,11 @@ bool MOAITextStyler::ParseStyle () {
 			//----------------------------------------------------------------//
 			case STYLE_ABORT: {
 				
+				// appending more text could complete the escape
+				if ( c == 0 ) {
+					this->mOpenEscape = true;
+				}
+				
 				this->mIdx = startIdx;
 				TRANSITION ( DONE );
 			}
@@ -65,6 +65,7 @@ private:
 	USLeanStack < MOAITextStyle*, 8 > mActiveStyles;
 
 	MOAITextStyle* mCurrentStyle;
+	bool mOpenEscape; // a style escape ran into the end of the text
 
 	//----------------------------------------------------------------//
 	u32				AffirmStyle			( MOAITextStyle& style );
@@ -81,6 +82,7 @@ private:
 public:
 
 	//----------------------------------------------------------------//
+	void			AppendStyleMap		( MOAITextBox& textBox );
 	void			BuildStyleMap		( MOAITextBox& textBox );
 					MOAITextStyler		();
 					~MOAITextStyler		();
@@ -5,8 +5,10 @@
 
 #include <moaicore/MOAIDataBuffer.h>
 #include <moaicore/MOAIGfxDevice.h>
+#include <moaicore/MOAIKtxHeader.h>
 #include <moaicore/MOAILogMessages.h>
 #include <moaicore/MOAIPvrHeader.h>
+#include <moaicore/MOAISim.h>
 #include <moaicore/MOAIStream.h>
 #include <moaicore/MOAITexture.h>
 #include <moaicore/MOAIMultiTexture.h>
@@ -18,7 +20,7 @@
 //----------------------------------------------------------------//
 /**	@name	load
 	@text	Loads a texture from a data buffer or a file. Optionally pass
-			in an image transform (not applicable to PVR textures).
+			in an image transform (not applicable to PVR or KTX textures).
 	
 	@overload
 		@in		MOAITexture self
@@ -54,6 +56,53 @@ int MOAITexture::_load ( lua_State* L ) {
 	return 0;
 }
 
+//----------------------------------------------------------------//
+/**	@name	loadAsync
+	@text	Decodes a texture file on the data IO thread instead of
+			blocking the caller. The texture is uploaded during a later
+			render pass, within MOAIGfxDevice's texture upload budget,
+			and is not drawn until then. Use setLoadCallback to find
+			out when it is ready.
+			
+			KTX files with a mip chain are streamed: the smaller levels
+			are read and uploaded first, so a low resolution version
+			can be drawn while the rest of the file is read.
+	
+	@in		MOAITexture self
+	@in		string filename
+	@opt	number transform		Any bitwise combination of MOAIImage.QUANTIZE, MOAIImage.TRUECOLOR, MOAIImage.PREMULTIPLY_ALPHA
+	@opt	string debugname		Name used when reporting texture debug information
+	@out	nil
+*/
+int MOAITexture::_loadAsync ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAITexture, "US" )
+
+	cc8* filename = state.GetValue < cc8* >( 2, "" );
+	u32 transform = state.GetValue < u32 >( 3, MOAITexture::DEFAULT_TRANSFORM );
+	cc8* debugName = state.GetValue < cc8* >( 4, 0 );
+
+	self->LoadAsync ( filename, transform, debugName );
+	return 0;
+}
+
+//----------------------------------------------------------------//
+/**	@name	setLoadCallback
+	@text	Sets the function to be called once a texture started with
+			loadAsync has been uploaded and is ready to draw. Also
+			called when a texture evicted to stay within the device's
+			texture budget has been reloaded.
+	
+	@in		MOAITexture self
+	@opt	function callback		Called with the texture as its only parameter. Pass nil to clear.
+	@out	nil
+*/
+int MOAITexture::_setLoadCallback ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAITexture, "U" )
+
+	self->SetLocal ( state, 2, self->mOnLoad );
+	return 0;
+}
+
 //================================================================//
 // MOAITexture
 //================================================================//
@@ -78,6 +127,21 @@ MOAIGfxState* MOAITexture::AffirmTexture ( MOAILuaState& state, int idx ) {
 	return texture;
 }
 
+//----------------------------------------------------------------//
+size_t MOAITexture::GetEvictableSize () {
+
+	return this->mGLTexID ? this->mTextureSize : 0;
+}
+
+//----------------------------------------------------------------//
+size_t MOAITexture::GetUploadSize () {
+
+	if ( this->mImage.IsOK ()) {
+		return this->mImage.GetBitmapSize ();
+	}
+	return this->mDataSize;
+}
+
 //----------------------------------------------------------------//
 bool MOAITexture::Init ( MOAILuaState& state, int idx ) {
 
@@ -194,6 +258,15 @@ void MOAITexture::Init ( USStream& stream, u32 transform, cc8* debugname ) {
 				this->mDataSize = 0;
 			}
 		}
+		else {
+		
+			MOAIKtxHeader ktxHeader;
+			ktxHeader.Load ( stream );
+			
+			if ( ktxHeader.IsValid ()) {
+				this->mData = MOAIKtxHeader::ReadLevels ( stream, 0, this->mDataSize );
+			}
+		}
 	}
 	
 	// if we're OK, store the debugname and load
@@ -228,11 +301,60 @@ bool MOAITexture::IsRenewable () {
 	return false;
 }
 
+//----------------------------------------------------------------//
+void MOAITexture::LoadAsync ( cc8* filename, u32 transform, cc8* debugname ) {
+
+	this->Clear ();
+	if ( USFileSys::CheckFileExists ( filename )) {
+		
+		this->mFilename = USFileSys::GetAbsoluteFilePath ( filename );
+		if ( debugname ) {
+			this->mDebugName = debugname;
+		}
+		else {
+			this->mDebugName = this->mFilename;
+		}
+		this->mTransform = transform;
+		
+		this->StartLoadTask ( STREAM_BASE_LEVEL );
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAITexture::LoadFile ( cc8* filename, u32 transform, MOAIImage& image, void*& data, size_t& dataSize ) {
+
+	image.Load ( filename, transform );
+	
+	if ( !image.IsOK ()) {
+		
+		// if no image, check to see if the file is a PVR
+		USFileStream stream;
+		stream.OpenRead ( filename );
+		
+		size_t size = stream.GetLength ();
+		void* bytes = malloc ( size );
+		stream.ReadBytes ( bytes, size );
+
+		stream.Close ();
+		
+		if ( MOAIPvrHeader::GetHeader ( bytes, size ) || MOAIKtxHeader::GetHeader ( bytes, size )) {
+			data = bytes;
+			dataSize = size;		
+		}
+		else {
+			free ( bytes );
+		}
+	}
+}
+
 //----------------------------------------------------------------//
 MOAITexture::MOAITexture () :
 	mTransform ( DEFAULT_TRANSFORM ),
 	mData ( 0 ),
-	mDataSize ( 0 ) {
+	mDataSize ( 0 ),
+	mBaseLevel ( 0 ),
+	mLoadTask ( 0 ),
+	mUploadPending ( false ) {
 	
 	RTTI_BEGIN
 		RTTI_EXTEND ( MOAITextureBase )
@@ -257,6 +379,11 @@ void MOAITexture::OnClear () {
 		this->mData = NULL;
 	}
 	this->mDataSize = 0;
+	this->mBaseLevel = 0;
+	
+	// a load still in flight will be ignored when it finishes
+	this->mLoadTask = 0;
+	this->mUploadPending = false;
 }
 
 //----------------------------------------------------------------//
@@ -265,6 +392,9 @@ void MOAITexture::OnCreate () {
 	if ( this->mImage.IsOK ()) {
 		this->CreateTextureFromImage ( this->mImage );
 	}
+	else if ( MOAIKtxHeader::GetHeader ( this->mData, this->mDataSize )) {
+		this->CreateTextureFromKTX ( this->mData, this->mDataSize, this->mBaseLevel );
+	}
 	else if ( this->mData ) {
 		this->CreateTextureFromPVR ( this->mData, this->mDataSize );
 	}
@@ -278,36 +408,22 @@ void MOAITexture::OnCreate () {
 			this->mData = NULL;
 		}
 		this->mDataSize = 0;
+		this->mBaseLevel = 0;
 	}
 }
 
 //----------------------------------------------------------------//
 void MOAITexture::OnLoad () {
 
-	if ( this->mFilename.size ()) {
-	
-		this->mImage.Load ( this->mFilename, this->mTransform );
+	// skip the decode if loadAsync already did it
+	if ( this->mFilename.size () && !( this->mImage.IsOK () || this->mData )) {
 		
-		if ( !this->mImage.IsOK ()) {
-			
-			// if no image, check to see if the file is a PVR
-			USFileStream stream;
-			stream.OpenRead ( this->mFilename );
-			
-			size_t size = stream.GetLength ();
-			void* data = malloc ( size );
-			stream.ReadBytes ( data, size );
-
-			stream.Close ();
-			
-			if ( MOAIPvrHeader::GetHeader ( data, size )) {
-				this->mData = data;
-				this->mDataSize = size;		
-			}
-			else {
-				free ( data );
-			}
-		}
+		// a synchronous load replaces any load still in flight
+		this->mLoadTask = 0;
+		this->mUploadPending = false;
+		this->mBaseLevel = 0;
+		
+		MOAITexture::LoadFile ( this->mFilename, this->mTransform, this->mImage, this->mData, this->mDataSize );
 	}
 	
 	if ( this->mImage.IsOK ()) {
@@ -322,6 +438,66 @@ void MOAITexture::OnLoad () {
 			this->mWidth = header->mWidth;
 			this->mHeight = header->mHeight;
 		}
+		
+		MOAIKtxHeader* ktxHeader = MOAIKtxHeader::GetHeader ( this->mData, this->mDataSize );
+		if ( ktxHeader ) {
+			this->mWidth = ktxHeader->mPixelWidth;
+			this->mHeight = ktxHeader->mPixelHeight;
+		}
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAITexture::OnLoadFinished ( MOAITextureLoadTask* task ) {
+
+	if ( task == this->mLoadTask ) {
+	
+		this->mLoadTask = 0;
+		
+		if ( task->mImage.IsOK () || task->mData ) {
+		
+			// the full chain replaces coarse levels still waiting on the upload
+			this->mImage.Clear ();
+			if ( this->mData ) {
+				free ( this->mData );
+				this->mData = NULL;
+			}
+			
+			if ( task->mImage.IsOK ()) {
+				this->mImage.Take ( task->mImage );
+			}
+			else {
+				this->mData = task->mData;
+				this->mDataSize = task->mDataSize;
+				task->mData = 0;
+			}
+			this->mBaseLevel = task->mBaseLevel;
+			
+			if ( !this->mUploadPending ) {
+				this->mUploadPending = true;
+				MOAIGfxDevice::Get ().PushUpload ( *this );
+			}
+		}
+		
+		// coarse levels are in; go back for the rest
+		if ( task->mBaseLevel ) {
+			this->StartLoadTask ( 0 );
+		}
+	}
+	this->Release ();
+}
+
+//----------------------------------------------------------------//
+void MOAITexture::OnReload () {
+
+	// files come back in the background, the same way loadAsync brings them in
+	if ( this->mFilename.size ()) {
+		if ( !( this->mLoadTask || this->mUploadPending )) {
+			this->StartLoadTask ( STREAM_BASE_LEVEL );
+		}
+	}
+	else {
+		this->Load ();
 	}
 }
 
@@ -338,6 +514,8 @@ void MOAITexture::RegisterLuaFuncs ( MOAILuaState& state ) {
 	
 	luaL_Reg regTable [] = {
 		{ "load",					_load },
+		{ "loadAsync",				_loadAsync },
+		{ "setLoadCallback",		_setLoadCallback },
 		{ NULL, NULL }
 	};
 
@@ -363,3 +541,88 @@ void MOAITexture::SerializeOut ( MOAILuaState& state, MOAISerializer& serializer
 	state.SetField ( -1, "mPath", path.str ());
 }
 
+
+//----------------------------------------------------------------//
+void MOAITexture::StartLoadTask ( u32 baseLevel ) {
+
+	USTaskThread& taskThread = MOAISim::Get ().GetDataIOThread ();
+	MOAITextureLoadTask* task = taskThread.NewTask < MOAITextureLoadTask >();
+	
+	// hold on to the texture until the task reports back
+	this->Retain ();
+	this->mLoadTask = task;
+	
+	task->SetDelegate ( this, &MOAITexture::OnLoadFinished );
+	task->Load ( this->mFilename, this->mTransform, baseLevel );
+}
+
+//----------------------------------------------------------------//
+void MOAITexture::Upload () {
+
+	if ( !this->mUploadPending ) return;
+	this->mUploadPending = false;
+	
+	this->Load ();
+	this->Affirm ();
+	
+	// only report once the last pass is up
+	if ( this->mOnLoad && !this->mLoadTask ) {
+	
+		MOAILuaStateHandle state = MOAILuaRuntime::Get ().State ();
+		this->PushLocal ( state, this->mOnLoad );
+		this->PushLuaUserdata ( state );
+		state.DebugCall ( 1, 0 );
+	}
+}
+
+//================================================================//
+// MOAITextureLoadTask
+//================================================================//
+
+//----------------------------------------------------------------//
+void MOAITextureLoadTask::Execute () {
+
+	// try for just the coarse levels of a KTX file
+	if ( this->mBaseLevel ) {
+	
+		USFileStream stream;
+		if ( stream.OpenRead ( this->mFilename )) {
+		
+			MOAIKtxHeader header;
+			header.Load ( stream );
+			
+			if ( header.IsValid () && ( header.GetLevelCount () > this->mBaseLevel )) {
+				this->mData = MOAIKtxHeader::ReadLevels ( stream, this->mBaseLevel, this->mDataSize );
+				if ( this->mData ) return;
+			}
+		}
+		this->mBaseLevel = 0;
+	}
+	MOAITexture::LoadFile ( this->mFilename, this->mTransform, this->mImage, this->mData, this->mDataSize );
+}
+
+//----------------------------------------------------------------//
+void MOAITextureLoadTask::Load ( cc8* filename, u32 transform, u32 baseLevel ) {
+
+	this->mFilename = filename;
+	this->mTransform = transform;
+	this->mBaseLevel = baseLevel;
+	
+	this->Start ();
+}
+
+//----------------------------------------------------------------//
+MOAITextureLoadTask::MOAITextureLoadTask () :
+	mTransform ( 0 ),
+	mBaseLevel ( 0 ),
+	mData ( 0 ),
+	mDataSize ( 0 ) {
+}
+
+//----------------------------------------------------------------//
+MOAITextureLoadTask::~MOAITextureLoadTask () {
+
+	if ( this->mData ) {
+		free ( this->mData );
+	}
+}
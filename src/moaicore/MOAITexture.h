@@ -9,6 +9,34 @@
 
 class MOAIDataBuffer;
 
+//================================================================//
+// MOAITextureLoadTask
+//================================================================//
+class MOAITextureLoadTask :
+	public USTask < MOAITextureLoadTask > {
+private:
+
+	friend class MOAITexture;
+
+	STLString		mFilename;
+	u32				mTransform;
+	u32				mBaseLevel;			// first KTX level to read; 0 once there's no coarse pass
+	
+	MOAIImage		mImage;
+	void*			mData;
+	size_t			mDataSize;
+
+	//----------------------------------------------------------------//
+	void			Execute					();
+
+public:
+
+	//----------------------------------------------------------------//
+	void			Load					( cc8* filename, u32 transform, u32 baseLevel );
+					MOAITextureLoadTask		();
+					~MOAITextureLoadTask	();
+};
+
 //================================================================//
 // MOAITexture
 //================================================================//
@@ -19,6 +47,10 @@ class MOAITexture :
 	public MOAITextureBase {
 private:
 
+	friend class MOAITextureLoadTask;
+
+	static const u32 STREAM_BASE_LEVEL = 2; // first KTX level of the coarse pass made by LoadAsync
+
 	// for loading from file
 	STLString			mFilename;
 	u32					mTransform;
@@ -29,15 +61,28 @@ private:
 	// for loading compressed data
 	void*				mData;
 	size_t				mDataSize;
+	u32					mBaseLevel;			// KTX level the records in mData start at
+	
+	// for loading in the background
+	MOAITextureLoadTask*	mLoadTask;			// file being decoded on the data IO thread
+	bool					mUploadPending;		// decoded and waiting on MOAIGfxDevice's upload budget
+	MOAILuaLocal			mOnLoad;
 
 	//----------------------------------------------------------------//
 	static int			_load					( lua_State* L );
+	static int			_loadAsync				( lua_State* L );
+	static int			_setLoadCallback		( lua_State* L );
 
 	//----------------------------------------------------------------//
+	size_t				GetEvictableSize		();
 	bool				IsRenewable				();
+	static void			LoadFile				( cc8* filename, u32 transform, MOAIImage& image, void*& data, size_t& dataSize );
 	void				OnClear					();
 	void				OnCreate				();
 	void				OnLoad					();
+	void				OnLoadFinished			( MOAITextureLoadTask* task );
+	void				OnReload				();
+	void				StartLoadTask			( u32 baseLevel );
 
 public:
 	
@@ -48,6 +93,7 @@ public:
 	//----------------------------------------------------------------//
 	static MOAIGfxState*	AffirmTexture			( MOAILuaState& state, int idx );
 	
+	size_t					GetUploadSize			();
 	bool					Init					( MOAILuaState& state, int idx );
 	void					Init					( MOAIImage& image, cc8* debugname );
 	void					Init					( MOAIImage& image, int srcX, int srcY, int width, int height, cc8* debugname );
@@ -55,6 +101,7 @@ public:
 	void					Init					( USStream& stream, u32 transform, cc8* debugname );
 	void					Init					( MOAIDataBuffer& data, u32 transform, cc8* debugname );
 	//void					Init					( const void* data, u32 size, u32 transform, cc8* debugname );
+	void					LoadAsync				( cc8* filename, u32 transform, cc8* debugname = 0 );
 	
 							MOAITexture				();
 							~MOAITexture			();
@@ -62,6 +109,7 @@ public:
 	void					RegisterLuaFuncs		( MOAILuaState& state );
 	void					SerializeIn				( MOAILuaState& state, MOAIDeserializer& serializer );
 	void					SerializeOut			( MOAILuaState& state, MOAISerializer& serializer );
+	void					Upload					();
 };
 
 #endif
@@ -0,0 +1,392 @@
+// Copyright (c) 2010-2011 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#include "pch.h"
+#include <moaicore/MOAIImage.h>
+#include <moaicore/MOAIImageTexture.h>
+#include <moaicore/MOAITextureAtlas.h>
+
+//================================================================//
+// MOAITextureAtlasPage
+//================================================================//
+
+//----------------------------------------------------------------//
+MOAITextureAtlasPage::SlotSpan* MOAITextureAtlasPage::Alloc ( u32 width, u32 height, RowSpan*& row ) {
+
+	RowSpan* rowIt = this->mRows.mHead;
+	RowSpan* bestRowIt = 0;
+
+	// find the very shortest row that can still accomodate the image
+	for ( ; rowIt; rowIt = rowIt->mNext ) {
+		if ( rowIt->mOccupied && ( height <= rowIt->mSize ) && rowIt->mData.HasRoom ( width )) {
+			if ( !bestRowIt || ( rowIt->mSize < bestRowIt->mSize )) {
+				bestRowIt = rowIt;
+			}
+		}
+	}
+
+	// a row that's too loose a fit (as given by mThreshold) wastes the space
+	// under the image; start a new row if the page has room for one
+	if ( !bestRowIt || (( u32 )( bestRowIt->mSize * this->mThreshold ) > height )) {
+
+		RowSpan* newRowIt = this->mRows.Alloc ( height );
+		if ( newRowIt ) {
+			newRowIt->mData.Expand ( this->mTexture->MOAIImage::GetWidth ());
+			bestRowIt = newRowIt;
+		}
+	}
+
+	if ( !bestRowIt ) return 0;
+
+	SlotSpan* slot = bestRowIt->mData.Alloc ( width );
+	if ( slot ) {
+		row = bestRowIt;
+	}
+	return slot;
+}
+
+//----------------------------------------------------------------//
+void MOAITextureAtlasPage::Free ( RowSpan* row, SlotSpan* slot ) {
+
+	row->mData.Free ( slot );
+
+	// give the row back once the last image in it is gone
+	SlotSpan* head = row->mData.mHead;
+	if ( head && !( head->mOccupied || head->mNext )) {
+		this->mRows.Free ( row );
+	}
+}
+
+//----------------------------------------------------------------//
+MOAITextureAtlasPage::MOAITextureAtlasPage () :
+	mTexture ( 0 ),
+	mThreshold ( 0.8f ) {
+}
+
+//----------------------------------------------------------------//
+MOAITextureAtlasPage::~MOAITextureAtlasPage () {
+}
+
+//================================================================//
+// MOAITextureAtlasRegion local
+//================================================================//
+
+//----------------------------------------------------------------//
+/**	@name	getTexture
+	@text	Returns the atlas page the region was packed into.
+
+	@in		MOAITextureAtlasRegion self
+	@out	MOAIImageTexture texture
+*/
+int MOAITextureAtlasRegion::_getTexture ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAITextureAtlasRegion, "U" )
+
+	if ( self->mPage ) {
+		self->mPage->mTexture->PushLuaUserdata ( state );
+		return 1;
+	}
+	return 0;
+}
+
+//----------------------------------------------------------------//
+/**	@name	getUVRect
+	@text	Returns the corners of the region in the page's UV space.
+
+	@in		MOAITextureAtlasRegion self
+	@out	number u0
+	@out	number v0
+	@out	number u1
+	@out	number v1
+*/
+int MOAITextureAtlasRegion::_getUVRect ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAITextureAtlasRegion, "U" )
+
+	state.Push ( self->mUVRect.mXMin );
+	state.Push ( self->mUVRect.mYMin );
+	state.Push ( self->mUVRect.mXMax );
+	state.Push ( self->mUVRect.mYMax );
+
+	return 4;
+}
+
+//================================================================//
+// MOAITextureAtlasRegion
+//================================================================//
+
+//----------------------------------------------------------------//
+MOAITextureBase* MOAITextureAtlasRegion::GetTexture () {
+
+	return this->mPage ? this->mPage->mTexture : 0;
+}
+
+//----------------------------------------------------------------//
+MOAITextureAtlasRegion::MOAITextureAtlasRegion () :
+	mPage ( 0 ),
+	mRow ( 0 ),
+	mSlot ( 0 ) {
+
+	RTTI_SINGLE ( MOAILuaObject )
+
+	this->mUVRect.Init ( 0.0f, 0.0f, 1.0f, 1.0f );
+}
+
+//----------------------------------------------------------------//
+MOAITextureAtlasRegion::~MOAITextureAtlasRegion () {
+
+	if ( this->mAtlas ) {
+		this->mAtlas->Free ( *this );
+	}
+	this->mAtlas.Set ( *this, 0 );
+}
+
+//----------------------------------------------------------------//
+void MOAITextureAtlasRegion::RegisterLuaClass ( MOAILuaState& state ) {
+	UNUSED ( state );
+}
+
+//----------------------------------------------------------------//
+void MOAITextureAtlasRegion::RegisterLuaFuncs ( MOAILuaState& state ) {
+
+	luaL_Reg regTable [] = {
+		{ "getTexture",				_getTexture },
+		{ "getUVRect",				_getUVRect },
+		{ NULL, NULL }
+	};
+
+	luaL_register ( state, 0, regTable );
+}
+
+//----------------------------------------------------------------//
+// Folds the region into a UV offset and scale so a deck's UVs, which
+// span the whole image, land on the region instead.
+void MOAITextureAtlasRegion::RemapUVs ( float& uOff, float& vOff, float& uScale, float& vScale ) const {
+
+	float uSize = this->mUVRect.mXMax - this->mUVRect.mXMin;
+	float vSize = this->mUVRect.mYMax - this->mUVRect.mYMin;
+
+	uOff = this->mUVRect.mXMin + ( uOff * uSize );
+	vOff = this->mUVRect.mYMin + ( vOff * vSize );
+
+	uScale *= uSize;
+	vScale *= vSize;
+}
+
+//================================================================//
+// MOAITextureAtlas local
+//================================================================//
+
+//----------------------------------------------------------------//
+/**	@name	getPageCount
+	@text	Returns the number of pages (textures) in the atlas.
+
+	@in		MOAITextureAtlas self
+	@out	number count
+*/
+int MOAITextureAtlas::_getPageCount ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAITextureAtlas, "U" )
+
+	state.Push ( self->mPages.GetTop ());
+	return 1;
+}
+
+//----------------------------------------------------------------//
+/**	@name	insert
+	@text	Packs an image into the atlas, starting a new page if none
+			of the existing ones has room. Images are copied to the page
+			as RGBA_8888. Images loaded from a file get the same default
+			transform as MOAITexture.
+
+	@in		MOAITextureAtlas self
+	@in		variant image			A MOAIImage or a path to an image file.
+	@opt	number transform		Any bitwise combination of MOAIImage.QUANTIZE, MOAIImage.TRUECOLOR, MOAIImage.PREMULTIPLY_ALPHA. Only used when loading from a file.
+	@out	MOAITextureAtlasRegion region	Or nil if the image is too large for a page or failed to load.
+*/
+int MOAITextureAtlas::_insert ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAITextureAtlas, "U" )
+
+	MOAITextureAtlasRegion* region = 0;
+
+	MOAIImage* image = state.GetLuaObject < MOAIImage >( 2, false );
+	if ( image ) {
+		region = self->Insert ( *image );
+	}
+	else if ( state.IsType ( 2, LUA_TSTRING )) {
+
+		cc8* filename	= state.GetValue < cc8* >( 2, "" );
+		u32 transform	= state.GetValue < u32 >( 3, MOAIImageTexture::DEFAULT_TRANSFORM );
+
+		MOAIImage fileImage;
+		fileImage.Load ( filename, transform );
+		region = self->Insert ( fileImage );
+	}
+
+	if ( region ) {
+		region->PushLuaUserdata ( state );
+		return 1;
+	}
+	return 0;
+}
+
+//----------------------------------------------------------------//
+/**	@name	setPageSize
+	@text	Sets the size of pages created from now on.
+
+	@in		MOAITextureAtlas self
+	@opt	number width			Default value is 1024.
+	@opt	number height			Default value is width.
+	@out	nil
+*/
+int MOAITextureAtlas::_setPageSize ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAITextureAtlas, "U" )
+
+	self->mPageWidth	= state.GetValue < u32 >( 2, DEFAULT_PAGE_SIZE );
+	self->mPageHeight	= state.GetValue < u32 >( 3, self->mPageWidth );
+
+	return 0;
+}
+
+//================================================================//
+// MOAITextureAtlas
+//================================================================//
+
+//----------------------------------------------------------------//
+void MOAITextureAtlas::Free ( MOAITextureAtlasRegion& region ) {
+
+	if ( region.mPage ) {
+		region.mPage->Free ( region.mRow, region.mSlot );
+	}
+
+	region.mPage = 0;
+	region.mRow = 0;
+	region.mSlot = 0;
+}
+
+//----------------------------------------------------------------//
+MOAITextureAtlasRegion* MOAITextureAtlas::Insert ( MOAIImage& image ) {
+
+	if ( !image.IsOK ()) return 0;
+
+	int width = ( int )image.GetWidth ();
+	int height = ( int )image.GetHeight ();
+
+	u32 paddedWidth = ( u32 )width + ( PADDING * 2 );
+	u32 paddedHeight = ( u32 )height + ( PADDING * 2 );
+
+	if (( paddedWidth > this->mPageWidth ) || ( paddedHeight > this->mPageHeight )) return 0;
+
+	MOAIImage converted;
+	MOAIImage* src = &image;
+
+	if (( image.GetPixelFormat () != USPixel::TRUECOLOR ) || ( image.GetColorFormat () != USColor::RGBA_8888 )) {
+		converted.ToTrueColor ( image );
+		converted.ConvertColors ( converted, USColor::RGBA_8888 );
+		src = &converted;
+	}
+
+	MOAITextureAtlasPage* page = 0;
+	MOAITextureAtlasPage::RowSpan* row = 0;
+	MOAITextureAtlasPage::SlotSpan* slot = 0;
+
+	// first fit across the pages; pages made before a setPageSize may be smaller
+	for ( u32 i = 0; ( i < this->mPages.GetTop ()) && !slot; ++i ) {
+		page = this->mPages [ i ];
+		slot = page->Alloc ( paddedWidth, paddedHeight, row );
+	}
+
+	if ( !slot ) {
+		page = this->NewPage ();
+		slot = page->Alloc ( paddedWidth, paddedHeight, row );
+		if ( !slot ) return 0;
+	}
+
+	MOAIImageTexture& texture = *page->mTexture;
+
+	int x = ( int )slot->mBase;
+	int y = ( int )row->mBase;
+	int x0 = x + PADDING;
+	int y0 = y + PADDING;
+
+	texture.CopyBits ( *src, 0, 0, x0, y0, width, height );
+
+	// extrude the edges into the padding (rows first, so the columns pick up the corners)
+	texture.CopyBits ( *src, 0, 0, x0, y, width, 1 );
+	texture.CopyBits ( *src, 0, height - 1, x0, y0 + height, width, 1 );
+	texture.CopyBits ( texture, x0, y, x, y, 1, height + 2 );
+	texture.CopyBits ( texture, x0 + width - 1, y, x0 + width, y, 1, height + 2 );
+
+	USIntRect rect;
+	rect.Init ( x, y, x + ( int )paddedWidth, y + ( int )paddedHeight );
+	texture.Invalidate ( rect );
+
+	MOAITextureAtlasRegion* region = new MOAITextureAtlasRegion ();
+
+	region->mAtlas.Set ( *region, this );
+	region->mPage = page;
+	region->mRow = row;
+	region->mSlot = slot;
+	slot->mData = region;
+
+	float pageWidth = ( float )texture.MOAIImage::GetWidth ();
+	float pageHeight = ( float )texture.MOAIImage::GetHeight ();
+
+	region->mUVRect.Init (
+		( float )x0 / pageWidth,
+		( float )y0 / pageHeight,
+		( float )( x0 + width ) / pageWidth,
+		( float )( y0 + height ) / pageHeight
+	);
+
+	return region;
+}
+
+//----------------------------------------------------------------//
+MOAITextureAtlas::MOAITextureAtlas () :
+	mPageWidth ( DEFAULT_PAGE_SIZE ),
+	mPageHeight ( DEFAULT_PAGE_SIZE ) {
+
+	RTTI_SINGLE ( MOAILuaObject )
+}
+
+//----------------------------------------------------------------//
+MOAITextureAtlas::~MOAITextureAtlas () {
+
+	for ( u32 i = 0; i < this->mPages.GetTop (); ++i ) {
+		MOAITextureAtlasPage* page = this->mPages [ i ];
+		this->LuaRelease ( page->mTexture );
+		delete page;
+	}
+}
+
+//----------------------------------------------------------------//
+MOAITextureAtlasPage* MOAITextureAtlas::NewPage () {
+
+	MOAITextureAtlasPage* page = new MOAITextureAtlasPage ();
+
+	page->mTexture = new MOAIImageTexture ();
+	page->mTexture->Init ( this->mPageWidth, this->mPageHeight, USColor::RGBA_8888, USPixel::TRUECOLOR );
+	page->mTexture->SetDebugName ( "MOAITextureAtlas" );
+	this->LuaRetain ( page->mTexture );
+
+	page->mRows.Expand ( this->mPageHeight );
+
+	this->mPages.Push ( page );
+	return page;
+}
+
+//----------------------------------------------------------------//
+void MOAITextureAtlas::RegisterLuaClass ( MOAILuaState& state ) {
+	UNUSED ( state );
+}
+
+//----------------------------------------------------------------//
+void MOAITextureAtlas::RegisterLuaFuncs ( MOAILuaState& state ) {
+
+	luaL_Reg regTable [] = {
+		{ "getPageCount",			_getPageCount },
+		{ "insert",					_insert },
+		{ "setPageSize",			_setPageSize },
+		{ NULL, NULL }
+	};
+
+	luaL_register ( state, 0, regTable );
+}
@@ -0,0 +1,133 @@
+// Copyright (c) 2010-2011 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#ifndef	MOAITEXTUREATLAS_H
+#define	MOAITEXTUREATLAS_H
+
+#include <moaicore/MOAILua.h>
+#include <moaicore/MOAISpanList.h>
+
+class MOAIImage;
+class MOAIImageTexture;
+class MOAITextureAtlas;
+class MOAITextureAtlasRegion;
+class MOAITextureBase;
+
+//================================================================//
+// MOAITextureAtlasPage
+//================================================================//
+// One shared texture. Rows are cut from a span list as tall as the page
+// and each row is a span list as wide as the page, the same scheme
+// MOAIGlyphCachePage uses to pack glyphs.
+class MOAITextureAtlasPage {
+private:
+
+	friend class MOAITextureAtlas;
+	friend class MOAITextureAtlasRegion;
+
+	typedef MOAISpanList < MOAITextureAtlasRegion* > SlotList;
+	typedef MOAISpanList < MOAITextureAtlasRegion* >::Span SlotSpan;
+
+	typedef MOAISpanList < SlotList > RowList;
+	typedef MOAISpanList < SlotList >::Span RowSpan;
+
+	RowList				mRows;
+	MOAIImageTexture*	mTexture;
+
+	float				mThreshold;
+
+	//----------------------------------------------------------------//
+	SlotSpan*		Alloc						( u32 width, u32 height, RowSpan*& row );
+	void			Free						( RowSpan* row, SlotSpan* slot );
+					MOAITextureAtlasPage		();
+					~MOAITextureAtlasPage		();
+};
+
+//================================================================//
+// MOAITextureAtlasRegion
+//================================================================//
+/**	@name	MOAITextureAtlasRegion
+	@text	An image packed into a page of a MOAITextureAtlas. Pass it
+			to a deck's setTexture in place of a texture: the deck draws
+			from the shared page and maps its UVs into the region. Space
+			on the page is given back when the region is collected.
+*/
+class MOAITextureAtlasRegion :
+	public virtual MOAILuaObject {
+private:
+
+	friend class MOAITextureAtlas;
+
+	MOAILuaSharedPtr < MOAITextureAtlas > mAtlas;
+
+	MOAITextureAtlasPage*				mPage;
+	MOAITextureAtlasPage::RowSpan*		mRow;
+	MOAITextureAtlasPage::SlotSpan*		mSlot;
+
+	USRect		mUVRect;	// the image's corners in page UVs
+
+	//----------------------------------------------------------------//
+	static int		_getTexture				( lua_State* L );
+	static int		_getUVRect				( lua_State* L );
+
+public:
+
+	DECL_LUA_FACTORY ( MOAITextureAtlasRegion )
+
+	GET ( const USRect&, UVRect, mUVRect )
+
+	//----------------------------------------------------------------//
+	MOAITextureBase*	GetTexture				();
+						MOAITextureAtlasRegion	();
+						~MOAITextureAtlasRegion	();
+	void				RegisterLuaClass		( MOAILuaState& state );
+	void				RegisterLuaFuncs		( MOAILuaState& state );
+	void				RemapUVs				( float& uOff, float& vOff, float& uScale, float& vScale ) const;
+};
+
+//================================================================//
+// MOAITextureAtlas
+//================================================================//
+/**	@name	MOAITextureAtlas
+	@text	Packs images into a few large textures at runtime so props
+			drawn from many small images can be batched together instead
+			of switching textures for each one. Each region is padded
+			with a copy of its edge pixels so filtering doesn't pick up
+			its neighbors. Regions can't use GL_REPEAT wrapping.
+*/
+class MOAITextureAtlas :
+	public virtual MOAILuaObject {
+private:
+
+	friend class MOAITextureAtlasRegion;
+
+	static const u32 DEFAULT_PAGE_SIZE	= 1024;
+	static const u32 PADDING			= 1;
+
+	u32		mPageWidth;
+	u32		mPageHeight;
+
+	USLeanStack < MOAITextureAtlasPage*, 4 > mPages;
+
+	//----------------------------------------------------------------//
+	static int		_getPageCount			( lua_State* L );
+	static int		_insert					( lua_State* L );
+	static int		_setPageSize			( lua_State* L );
+
+	//----------------------------------------------------------------//
+	void					Free					( MOAITextureAtlasRegion& region );
+	MOAITextureAtlasPage*	NewPage					();
+
+public:
+
+	DECL_LUA_FACTORY ( MOAITextureAtlas )
+
+	//----------------------------------------------------------------//
+	MOAITextureAtlasRegion*		Insert				( MOAIImage& image );
+								MOAITextureAtlas	();
+								~MOAITextureAtlas	();
+	void						RegisterLuaClass	( MOAILuaState& state );
+	void						RegisterLuaFuncs	( MOAILuaState& state );
+};
+
+#endif
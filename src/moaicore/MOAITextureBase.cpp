@@ -6,6 +6,7 @@
 #include <moaicore/MOAIFrameBuffer.h>
 #include <moaicore/MOAIGfxDevice.h>
 #include <moaicore/MOAIImage.h>
+#include <moaicore/MOAIKtxHeader.h>
 #include <moaicore/MOAILogMessages.h>
 #include <moaicore/MOAIPvrHeader.h>
 #include <moaicore/MOAISim.h>
@@ -231,6 +232,97 @@ void MOAITextureBase::CreateTextureFromImage ( MOAIImage& image ) {
 	}
 }
 
+//----------------------------------------------------------------//
+void MOAITextureBase::CreateTextureFromKTX ( void* data, size_t size, u32 baseLevel ) {
+
+	if ( !MOAIGfxDevice::Get ().GetHasContext ()) return;
+
+	MOAIKtxHeader* header = MOAIKtxHeader::GetHeader ( data, size );
+	if ( !header ) return;
+	
+	u32 totalLevels = header->GetLevelCount ();
+	if ( baseLevel >= totalLevels ) return;
+	
+	const u8* levelData = ( const u8* )MOAIKtxHeader::GetLevelData ( data, size );
+	if ( !levelData ) return;
+	
+	const u8* end = ( const u8* )data + size;
+
+	MOAIGfxDevice::Get ().ClearErrors ();
+
+	// the texture keeps the size of the full image, whatever levels are present
+	this->mWidth = header->mPixelWidth;
+	this->mHeight = header->mPixelHeight;
+
+	bool useMipMaps = (
+		( this->mMinFilter == GL_LINEAR_MIPMAP_LINEAR ) ||
+		( this->mMinFilter == GL_LINEAR_MIPMAP_NEAREST ) ||
+		( this->mMinFilter == GL_NEAREST_MIPMAP_LINEAR ) ||
+		( this->mMinFilter == GL_NEAREST_MIPMAP_NEAREST )
+	);
+	
+	u32 levels = useMipMaps ? totalLevels - baseLevel : 1;
+	
+	// compressed formats leave the type and format empty
+	bool compressed = ( header->mGLType == 0 );
+	this->mGLInternalFormat = compressed ? header->mGLInternalFormat : header->mGLFormat;
+	this->mGLPixelType = header->mGLType;
+
+	glGenTextures ( 1, &this->mGLTexID );
+	if ( !this->mGLTexID ) return;
+
+	glBindTexture ( GL_TEXTURE_2D, this->mGLTexID );
+	
+	this->mTextureSize = 0;
+	bool error = false;
+	
+	for ( u32 i = 0; i < levels; ++i ) {
+		
+		if (( levelData + sizeof ( u32 )) > end ) {
+			error = true;
+			break;
+		}
+		
+		u32 imageSize = *( const u32* )levelData;
+		levelData += sizeof ( u32 );
+		
+		if (( levelData + imageSize ) > end ) {
+			error = true;
+			break;
+		}
+		
+		u32 level = baseLevel + i;
+		GLsizei width = ( GLsizei )MAX ( header->mPixelWidth >> level, 1 );
+		GLsizei height = ( GLsizei )MAX ( header->mPixelHeight >> level, 1 );
+		
+		if ( compressed ) {
+			glCompressedTexImage2D ( GL_TEXTURE_2D, i, this->mGLInternalFormat, width, height, 0, imageSize, levelData );
+		}
+		else {
+			glTexImage2D ( GL_TEXTURE_2D, i, this->mGLInternalFormat, width, height, 0, this->mGLInternalFormat, this->mGLPixelType, levelData );
+		}
+		
+		if ( MOAIGfxDevice::Get ().LogErrors ()) {
+			error = true;
+			break;
+		}
+		
+		this->mTextureSize += imageSize;
+		levelData += MOAIKtxHeader::GetPaddedSize ( imageSize );
+	}
+	
+	if ( error ) {
+		this->mTextureSize = 0;
+		glDeleteTextures ( 1, &this->mGLTexID );
+		this->mGLTexID = 0;
+		this->Clear ();
+		return;
+	}
+	
+	MOAIGfxDevice::Get ().ReportTextureAlloc ( this->mDebugName, this->mTextureSize );
+	this->mIsDirty = true;
+}
+
 //----------------------------------------------------------------//
 void MOAITextureBase::CreateTextureFromPVR ( void* data, size_t size ) {
 	UNUSED ( data );
@@ -581,10 +673,12 @@ void MOAITextureBase::UpdateTextureFromImage ( MOAIImage& image, USIntRect rect
 		
 		void* buffer = image.GetBitmap ();
 		
+		// upload whole rows so the region can be read straight out of the image;
+		// copying it out first needed a scratch buffer as big as the region
 		if (( this->mWidth != ( u32 )rect.Width ()) || ( this->mHeight != ( u32 )rect.Height ())) {
-			u32 size = image.GetSubImageSize ( rect );
-			buffer = alloca ( size );
-			image.GetSubImage ( rect, buffer );
+			rect.mXMin = 0;
+			rect.mXMax = this->mWidth;
+			buffer = ( void* )(( uintptr )buffer + ( image.GetRowSize () * rect.mYMin ));
 		}
 
 		glTexSubImage2D (
@@ -69,6 +69,7 @@ protected:
 
 	//----------------------------------------------------------------//
 	void			CreateTextureFromImage	( MOAIImage& image );
+	void			CreateTextureFromKTX	( void* data, size_t size, u32 baseLevel );
 	void			CreateTextureFromPVR	( void* data, size_t size );
 	bool			IsRenewable				();
 	void			OnBind					();
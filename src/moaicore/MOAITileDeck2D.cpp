@@ -110,6 +110,7 @@ int MOAITileDeck2D::_setUVQuad ( lua_State* L ) {
 	quad.mV [ 3 ].mY = state.GetValue < float >( 9, 0.0f );
 	
 	self->mQuad.SetUVs ( quad.mV [ 0 ], quad.mV [ 1 ], quad.mV [ 2 ], quad.mV [ 3 ]);
+	self->SetContentDirty ();
 	
 	return 0;
 }
@@ -134,6 +135,7 @@ int MOAITileDeck2D::_setUVRect ( lua_State* L ) {
 	float v1	= state.GetValue < float >( 5, 0.0f );
 
 	self->mQuad.SetUVs ( u0, v0, u1, v1 );
+	self->SetContentDirty ();
 
 	return 0;
 }
@@ -186,6 +188,8 @@ int	MOAITileDeck2D::_setSize ( lua_State* L ) {
 	self->SetTileWidth ( tileWidth );
 	self->SetTileHeight ( tileHeight );
 	
+	self->SetContentDirty ();
+	
 	return 0;
 }
 
@@ -232,6 +236,18 @@ int MOAITileDeck2D::_transformUV ( lua_State* L ) {
 // MOAITileDeck2D
 //================================================================//
 
+//----------------------------------------------------------------//
+bool MOAITileDeck2D::CanRemapUVs () {
+
+	return true;
+}
+
+//----------------------------------------------------------------//
+bool MOAITileDeck2D::CanWriteQuads () {
+
+	return true;
+}
+
 //----------------------------------------------------------------//
 USBox MOAITileDeck2D::ComputeMaxBounds () {
 	return this->GetItemBounds ( 0 );
@@ -247,16 +263,8 @@ void MOAITileDeck2D::DrawIndex ( u32 idx, float xOff, float yOff, float zOff, fl
 	gfxDevice.SetVertexMtxMode ( MOAIGfxDevice::VTX_STAGE_MODEL, MOAIGfxDevice::VTX_STAGE_PROJ );
 	gfxDevice.SetUVMtxMode ( MOAIGfxDevice::UV_STAGE_MODEL, MOAIGfxDevice::UV_STAGE_TEXTURE );
 	
-	idx = idx - 1;
-	
-	MOAICellCoord coord = this->GetCellCoord ( idx );
-	USRect uvRect = this->GetTileRect ( coord );
-	
-	float uScale = ( uvRect.mXMax - uvRect.mXMin );
-	float vScale = -( uvRect.mYMax - uvRect.mYMin );
-	
-	float uOff = uvRect.mXMin + ( 0.5f * uScale );
-	float vOff = uvRect.mYMin - ( 0.5f * vScale );
+	float uOff, vOff, uScale, vScale;
+	this->GetTileUVs ( idx, uOff, vOff, uScale, vScale );
 	
 	this->mQuad.Draw ( xOff, yOff, zOff, xScl, yScl, uOff, vOff, uScale, vScale );
 }
@@ -270,6 +278,21 @@ USBox MOAITileDeck2D::GetItemBounds ( u32 idx ) {
 	return bounds;
 }
 
+//----------------------------------------------------------------//
+void MOAITileDeck2D::GetTileUVs ( u32 idx, float& uOff, float& vOff, float& uScale, float& vScale ) {
+
+	MOAICellCoord coord = this->GetCellCoord ( idx - 1 );
+	USRect uvRect = this->GetTileRect ( coord );
+	
+	uScale = ( uvRect.mXMax - uvRect.mXMin );
+	vScale = -( uvRect.mYMax - uvRect.mYMin );
+	
+	uOff = uvRect.mXMin + ( 0.5f * uScale );
+	vOff = uvRect.mYMin - ( 0.5f * vScale );
+	
+	this->RemapUVs ( uOff, vOff, uScale, vScale );
+}
+
 //----------------------------------------------------------------//
 MOAITileDeck2D::MOAITileDeck2D () {
 	
@@ -289,6 +312,12 @@ MOAITileDeck2D::~MOAITileDeck2D () {
 	this->mTexture.Set ( *this, 0 );
 }
 
+//----------------------------------------------------------------//
+void MOAITileDeck2D::OnResize () {
+
+	this->SetContentDirty ();
+}
+
 //----------------------------------------------------------------//
 void MOAITileDeck2D::RegisterLuaClass ( MOAILuaState& state ) {
 
@@ -322,6 +351,7 @@ void MOAITileDeck2D::SerializeIn ( MOAILuaState& state, MOAIDeserializer& serial
 	MOAIGridSpace::SerializeIn ( state, serializer );
 	
 	this->mTexture.Set ( *this, serializer.MemberIDToObject < MOAITextureBase >( state.GetField < uintptr >( -1, "mTexture", 0 )));
+	this->SetContentDirty ();
 }
 
 //----------------------------------------------------------------//
@@ -336,10 +366,22 @@ void MOAITileDeck2D::SerializeOut ( MOAILuaState& state, MOAISerializer& seriali
 void MOAITileDeck2D::Transform ( const USAffine3D& mtx ) {
 
 	this->mQuad.TransformVerts ( mtx );
+	this->SetContentDirty ();
 }
 
 //----------------------------------------------------------------//
 void MOAITileDeck2D::TransformUV ( const USAffine3D& mtx ) {
 
 	this->mQuad.TransformUVs ( mtx );
+	this->SetContentDirty ();
+}
+
+//----------------------------------------------------------------//
+bool MOAITileDeck2D::WriteQuadIndex ( u32 idx, MOAIQuadVertex* vtx, float xOff, float yOff, float zOff, float xScl, float yScl ) {
+
+	float uOff, vOff, uScale, vScale;
+	this->GetTileUVs ( idx, uOff, vOff, uScale, vScale );
+	
+	this->mQuad.WriteQuad ( vtx, xOff, yOff, zOff, xScl, yScl, uOff, vOff, uScale, vScale );
+	return true;
 }
\ No newline at end of file
@@ -35,12 +35,17 @@ private:
 	//----------------------------------------------------------------//
 	USBox			ComputeMaxBounds		();
 	USBox			GetItemBounds			( u32 idx );
+	void			GetTileUVs				( u32 idx, float& uOff, float& vOff, float& uScale, float& vScale );
+	void			OnResize				();
+	bool			WriteQuadIndex			( u32 idx, MOAIQuadVertex* vtx, float xOff, float yOff, float zOff, float xScl, float yScl );
 	
 public:
 	
 	DECL_LUA_FACTORY ( MOAITileDeck2D )
 	
 	//----------------------------------------------------------------//
+	bool			CanRemapUVs				();
+	bool			CanWriteQuads			();
 	void			DrawIndex				( u32 idx, float xOff, float yOff, float zOff, float xScl, float yScl, float zScl );
 					MOAITileDeck2D			();
 					~MOAITileDeck2D			();
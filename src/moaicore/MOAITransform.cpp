@@ -1010,7 +1010,70 @@ bool MOAITransform::ApplyAttrOp ( u32 attrID, MOAIAttrOp& attrOp, u32 op ) {
 }
 
 //----------------------------------------------------------------//
-void MOAITransform::BuildTransforms () {
+// Returns the node as a transform if it's a plain MOAITransform, which
+// BuildBatch can build; subclasses do more in their update.
+MOAITransform* MOAITransform::AsBatchable ( MOAINode& node ) {
+
+	if ( node.GetLuaClass () != &MOAILuaFactoryClass < MOAITransform >::Get ()) return 0;
+	return node.AsType < MOAITransform >();
+}
+
+//----------------------------------------------------------------//
+// Builds a run of transforms that have already pulled their attributes. Each
+// block's local matrices and the matrices they inherit are written into
+// structure-of-arrays scratch and appended in one USAffineBatch pass; only
+// transforms that inherit just a location take the per-node path.
+void MOAITransform::BuildBatch ( MOAITransform** transforms, u32 total ) {
+
+	float localElems [ USAffine3D::SIZE ][ BATCH_SIZE ];
+	float parentElems [ USAffine3D::SIZE ][ BATCH_SIZE ];
+	
+	USAffineArrays local;
+	USAffineArrays parent;
+	
+	for ( u32 e = 0; e < USAffine3D::SIZE; ++e ) {
+		local.m [ e ] = localElems [ e ];
+		parent.m [ e ] = parentElems [ e ];
+	}
+	
+	MOAITransform* batch [ BATCH_SIZE ];
+	
+	for ( u32 i = 0; i < total; ) {
+	
+		u32 count = 0;
+		USAffine3D mtx;
+		
+		for ( ; ( i < total ) && ( count < BATCH_SIZE ); ++i ) {
+		
+			MOAITransform& transform = *transforms [ i ];
+			
+			const USAffine3D* inherit = transform.GetLinkedValue < USAffine3D* >( MOAITransformAttr::Pack ( INHERIT_TRANSFORM ), 0 );
+			if ( inherit ) {
+				transform.BuildLocalTransform ( mtx );
+				local.SetMtx ( count, mtx );
+				parent.SetMtx ( count, *inherit );
+				batch [ count++ ] = &transform;
+			}
+			else if ( transform.GetLinkedValue < USAffine3D* >( MOAITransformAttr::Pack ( INHERIT_LOC ), 0 )) {
+				transform.BuildTransforms ();
+			}
+			else {
+				transform.BuildLocalTransform ( transform.mLocalToWorldMtx );
+				transform.FinishTransforms ();
+			}
+		}
+		
+		USAffineBatch::Append ( local, parent, 0, count );
+		
+		for ( u32 j = 0; j < count; ++j ) {
+			local.GetMtx ( j, batch [ j ]->mLocalToWorldMtx );
+			batch [ j ]->FinishTransforms ();
+		}
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAITransform::BuildLocalTransform ( USAffine3D& mtx ) {
 	
 	if ( this->mRot.mZ >= 360.0f ) {
 		this->mRot.mZ = ( float )fmod ( this->mRot.mZ, 360.0f );
@@ -1019,7 +1082,7 @@ void MOAITransform::BuildTransforms () {
 		this->mRot.mZ = 360.0f + ( float )fmod ( this->mRot.mZ, 360.0f );
 	}
 
-	this->mLocalToWorldMtx.ScRoTr (
+	mtx.ScRoTr (
 		this->mScale.mX,
 		this->mScale.mY,
 		this->mScale.mZ,
@@ -1031,9 +1094,17 @@ void MOAITransform::BuildTransforms () {
 		this->mLoc.mZ
 	);
 	
-	USAffine3D shear;
-	shear.Shear ( this->mShearYX, this->mShearZX, this->mShearXY, this->mShearZY, this->mShearXZ, this->mShearYZ );
-	this->mLocalToWorldMtx.Prepend ( shear );
+	if ( this->HasShear ()) {
+		USAffine3D shear;
+		shear.Shear ( this->mShearYX, this->mShearZX, this->mShearXY, this->mShearZY, this->mShearXZ, this->mShearYZ );
+		mtx.Prepend ( shear );
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAITransform::BuildTransforms () {
+	
+	this->BuildLocalTransform ( this->mLocalToWorldMtx );
 	
 	const USAffine3D* inherit = this->GetLinkedValue < USAffine3D* >( MOAITransformAttr::Pack ( INHERIT_TRANSFORM ), 0 );
 	if ( inherit ) {
@@ -1052,14 +1123,31 @@ void MOAITransform::BuildTransforms () {
 			this->mLocalToWorldMtx.m [ USAffine3D::C3_R2 ] = loc.mZ;
 		}
 	}
-	
+	this->FinishTransforms ();
+}
+
+//----------------------------------------------------------------//
+bool MOAITransform::CanUpdateInParallel () {
+
+	// BuildTransforms reads the sources and writes only this transform's matrices;
+	// subclasses may do more in their update, so each has to opt in itself
+	return this->GetLuaClass () == &MOAILuaFactoryClass < MOAITransform >::Get ();
+}
+
+//----------------------------------------------------------------//
+void MOAITransform::FinishTransforms () {
+
 	if (( this->mPiv.mX != 0.0f ) || ( this->mPiv.mY != 0.0f ) || ( this->mPiv.mZ != 0.0f )) {
 		
-		USAffine3D pivot;
-		pivot.Translate ( -this->mPiv.mX, -this->mPiv.mY, -this->mPiv.mZ );
-		this->mLocalToWorldMtx.Prepend ( pivot );
+		// same as prepending a translation by -pivot, without the full multiply
+		USVec3D pivot ( -this->mPiv.mX, -this->mPiv.mY, -this->mPiv.mZ );
+		this->mLocalToWorldMtx.TransformVec ( pivot );
+		
+		this->mLocalToWorldMtx.m [ USAffine3D::C3_R0 ] += pivot.mX;
+		this->mLocalToWorldMtx.m [ USAffine3D::C3_R1 ] += pivot.mY;
+		this->mLocalToWorldMtx.m [ USAffine3D::C3_R2 ] += pivot.mZ;
 	}
-	this->mWorldToLocalMtx.Inverse ( this->mLocalToWorldMtx );
+	this->SetWorldToLocalDirty ();
 }
 
 //----------------------------------------------------------------//
@@ -1101,16 +1189,49 @@ USAffine3D MOAITransform::GetBillboardMtx ( const USAffine3D& faceCameraMtx ) co
 	return billboardMtx;
 }
 
+//----------------------------------------------------------------//
+bool MOAITransform::GetDirectAttr ( u32 attrID, MOAIDirectAttr& attr ) {
+
+	if ( MOAITransformAttr::Check ( attrID )) {
+
+		attr.mClamp = false;
+
+		switch ( UNPACK_ATTR ( attrID )) {
+			case ATTR_X_PIV:	attr.mValue = &this->mPiv.mX;		return true;
+			case ATTR_Y_PIV:	attr.mValue = &this->mPiv.mY;		return true;
+			case ATTR_Z_PIV:	attr.mValue = &this->mPiv.mZ;		return true;
+			case ATTR_X_LOC:	attr.mValue = &this->mLoc.mX;		return true;
+			case ATTR_Y_LOC:	attr.mValue = &this->mLoc.mY;		return true;
+			case ATTR_Z_LOC:	attr.mValue = &this->mLoc.mZ;		return true;
+			case ATTR_X_ROT:	attr.mValue = &this->mRot.mX;		return true;
+			case ATTR_Y_ROT:	attr.mValue = &this->mRot.mY;		return true;
+			case ATTR_Z_ROT:	attr.mValue = &this->mRot.mZ;		return true;
+			case ATTR_X_SCL:	attr.mValue = &this->mScale.mX;		return true;
+			case ATTR_Y_SCL:	attr.mValue = &this->mScale.mY;		return true;
+			case ATTR_Z_SCL:	attr.mValue = &this->mScale.mZ;		return true;
+		}
+	}
+	return false;
+}
+
 //----------------------------------------------------------------//
 const USAffine3D& MOAITransform::GetLocalToWorldMtx () const {
 
 	return this->mLocalToWorldMtx;
 }
 
-//----------------------------------------------------------------//
-const USAffine3D& MOAITransform::GetWorldToLocalMtx () const {
 
-	return this->mWorldToLocalMtx;
+//----------------------------------------------------------------//
+bool MOAITransform::HasShear () const {
+
+	return (
+		( this->mShearYX != 0.0f ) ||
+		( this->mShearZX != 0.0f ) ||
+		( this->mShearXY != 0.0f ) ||
+		( this->mShearZY != 0.0f ) ||
+		( this->mShearXZ != 0.0f ) ||
+		( this->mShearYZ != 0.0f )
+	);
 }
 
 //----------------------------------------------------------------//
@@ -54,6 +54,8 @@ protected:
 	USVec3D			mScale;
 	USVec3D			mRot;		// Euler angles, in degrees
 
+	static const u32 BATCH_SIZE = 64; // transforms appended to their parents per USAffineBatch pass
+
 	//----------------------------------------------------------------//
 	static int	_addLoc			( lua_State* L );
 	static int	_addPiv			( lua_State* L );
@@ -85,7 +87,11 @@ protected:
 	static int	_worldToModel	( lua_State* L );
 
 	//----------------------------------------------------------------//
+	void	BuildLocalTransform		( USAffine3D& mtx );
 	void	BuildTransforms			();
+	bool	CanUpdateInParallel		();
+	void	FinishTransforms		();
+	bool	HasShear				() const;
 	void	OnDepNodeUpdate			();
 
 public:
@@ -130,9 +136,11 @@ public:
 	
 	//----------------------------------------------------------------//
 	bool					ApplyAttrOp					( u32 attrID, MOAIAttrOp& attrOp, u32 op );
+	static MOAITransform*	AsBatchable					( MOAINode& node );
+	static void				BuildBatch					( MOAITransform** transforms, u32 total );
 	USAffine3D				GetBillboardMtx				( const USAffine3D& faceCameraMtx ) const;
+	bool					GetDirectAttr				( u32 attrID, MOAIDirectAttr& attr );
 	const USAffine3D&		GetLocalToWorldMtx			() const;
-	const USAffine3D&		GetWorldToLocalMtx			() const;
 							MOAITransform				();
 							~MOAITransform				();
 	void					RegisterLuaClass			( MOAILuaState& state );
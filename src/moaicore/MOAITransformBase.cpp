@@ -180,13 +180,18 @@ const USAffine3D* MOAITransformBase::GetTransformTrait () {
 }
 
 //----------------------------------------------------------------//
-const USAffine3D& MOAITransformBase::GetWorldToLocalMtx () {
+const USAffine3D& MOAITransformBase::GetWorldToLocalMtx () const {
 
+	if ( this->mWorldToLocalDirty ) {
+		this->mWorldToLocalMtx.Inverse ( this->mLocalToWorldMtx );
+		this->mWorldToLocalDirty = false;
+	}
 	return this->mWorldToLocalMtx;
 }
 
 //----------------------------------------------------------------//
-MOAITransformBase::MOAITransformBase () {
+MOAITransformBase::MOAITransformBase () :
+	mWorldToLocalDirty ( false ) {
 	
 	RTTI_SINGLE ( MOAINode )
 	
@@ -228,3 +233,9 @@ void MOAITransformBase::RegisterLuaFuncs ( MOAILuaState& state ) {
 	
 	luaL_register ( state, 0, regTable );
 }
+
+//----------------------------------------------------------------//
+void MOAITransformBase::SetWorldToLocalDirty () {
+
+	this->mWorldToLocalDirty = true;
+}
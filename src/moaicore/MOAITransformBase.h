@@ -25,8 +25,12 @@ class MOAITransformBase :
 	public virtual MOAINode {
 protected:
 	
-	USAffine3D		mLocalToWorldMtx;
-	USAffine3D		mWorldToLocalMtx;
+	USAffine3D				mLocalToWorldMtx;
+	
+	// inverted from mLocalToWorldMtx the first time it's asked for after a change. cull
+	// workers may read it, so nodes they read resolve it on the main thread beforehand
+	mutable USAffine3D		mWorldToLocalMtx;
+	mutable bool			mWorldToLocalDirty;
 
 	//----------------------------------------------------------------//
 	static int	_getWorldDir	( lua_State* L );
@@ -34,6 +38,9 @@ protected:
 	static int	_getWorldRot	( lua_State* L );
 	static int	_getWorldScl	( lua_State* L );
 
+	//----------------------------------------------------------------//
+	void		SetWorldToLocalDirty	();
+
 public:
 	
 	DECL_ATTR_HELPER ( MOAITransformBase )
@@ -61,7 +68,7 @@ public:
 	const USAffine3D&		GetLocalToWorldMtx			();
 	const USAffine3D*		GetLocTrait					();
 	const USAffine3D*		GetTransformTrait			();
-	const USAffine3D&		GetWorldToLocalMtx			();
+	const USAffine3D&		GetWorldToLocalMtx			() const;
 							MOAITransformBase			();
 							~MOAITransformBase			();
 	void					RegisterLuaClass			( MOAILuaState& state );
@@ -32,6 +32,14 @@ MOAIVertexFormatMgr::MOAIVertexFormatMgr () {
 	format->DeclareAttribute ( XYZWUVC_POSITION, GL_FLOAT, 4, MOAIVertexFormat::ARRAY_VERTEX, false );
 	format->DeclareAttribute ( XYZWUVC_TEXCOORD, GL_FLOAT, 2, MOAIVertexFormat::ARRAY_TEX_COORD, false );
 	format->DeclareAttribute ( XYZWUVC_COLOR, GL_UNSIGNED_BYTE, 4, MOAIVertexFormat::ARRAY_COLOR, true );
+	
+	// shader only; no fixed function equivalent
+	format = &this->mFormats [ PARTICLE ];
+	
+	format->DeclareAttribute ( PARTICLE_CORNER, GL_FLOAT, 4, MOAIVertexFormat::TOTAL_ARRAY_TYPES, false );
+	format->DeclareAttribute ( PARTICLE_SPRITE, GL_FLOAT, 4, MOAIVertexFormat::TOTAL_ARRAY_TYPES, false );
+	format->DeclareAttribute ( PARTICLE_ROTATION, GL_FLOAT, 1, MOAIVertexFormat::TOTAL_ARRAY_TYPES, false );
+	format->DeclareAttribute ( PARTICLE_COLOR, GL_UNSIGNED_BYTE, 4, MOAIVertexFormat::TOTAL_ARRAY_TYPES, true );
 }
 
 //----------------------------------------------------------------//
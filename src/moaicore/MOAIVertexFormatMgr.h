@@ -16,6 +16,7 @@ public:
 	enum {
 		XYZWC,
 		XYZWUVC,
+		PARTICLE,
 		TOTAL_PRESETS,
 	};
 
@@ -38,6 +39,14 @@ public:
 		XYZWUVC_SIZE,
 	};
 	
+	enum {
+		PARTICLE_CORNER,		// x, y and u, v of the deck quad's corner
+		PARTICLE_SPRITE,		// x, y, x scale and y scale of the sprite
+		PARTICLE_ROTATION,		// sprite rotation in radians
+		PARTICLE_COLOR,
+		PARTICLE_SIZE,
+	};
+	
 	//----------------------------------------------------------------//
 	const MOAIVertexFormat&		GetPreset					( u32 presetID );
 								MOAIVertexFormatMgr			();
@@ -65,6 +65,7 @@
 #include <moaicore/MOAIGlyphSet.h>
 #include <moaicore/MOAIGrid.h>
 #include <moaicore/MOAIGridDeck2D.h>
+#include <moaicore/MOAIGridMesh.h>
 #include <moaicore/MOAIGridPathGraph.h>
 #include <moaicore/MOAIGridSpace.h>
 #include <moaicore/MOAIHashWriter.h>
@@ -76,6 +77,7 @@
 #include <moaicore/MOAIJoystickSensor.h>
 #include <moaicore/MOAIJsonParser.h>
 #include <moaicore/MOAIKeyboardSensor.h>
+#include <moaicore/MOAIKtxHeader.h>
 #include <moaicore/MOAILayer.h>
 #include <moaicore/MOAILayerBridge.h>
 #include <moaicore/MOAILayoutFrame.h>
@@ -94,7 +96,9 @@
 #include <moaicore/MOAIParticleCallbackPlugin.h>
 #include <moaicore/MOAIParticleDistanceEmitter.h>
 #include <moaicore/MOAIParticleEmitter.h>
+#include <moaicore/MOAIParticleEngine.h>
 #include <moaicore/MOAIParticleForce.h>
+#include <moaicore/MOAIParticleMgr.h>
 #include <moaicore/MOAIParticlePexPlugin.h>
 #include <moaicore/MOAIParticlePlugin.h>
 #include <moaicore/MOAIParticleScript.h>
@@ -106,6 +110,7 @@
 #include <moaicore/MOAIPartitionLevel.h>
 #include <moaicore/MOAIPartitionResultBuffer.h>
 #include <moaicore/MOAIPartitionResultMgr.h>
+#include <moaicore/MOAIPathBatch.h>
 #include <moaicore/MOAIPathFinder.h>
 #include <moaicore/MOAIPathTerrainDeck.h>
 #include <moaicore/MOAIPointerSensor.h>
@@ -137,6 +142,7 @@
 #include <moaicore/MOAITextDesigner.h>
 #include <moaicore/MOAITextStyle.h>
 #include <moaicore/MOAITexture.h>
+#include <moaicore/MOAITextureAtlas.h>
 #include <moaicore/MOAITextureBase.h>
 #include <moaicore/MOAITileDeck2D.h>
 #include <moaicore/MOAITileFlags.h>
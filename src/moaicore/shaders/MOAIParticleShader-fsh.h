@@ -0,0 +1,21 @@
+// Copyright (c) 2010-2011 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#ifndef	MOAIPARTICLESHADER_FSH_H
+#define	MOAIPARTICLESHADER_FSH_H
+
+#define SHADER(str) #str
+
+static cc8* _particleShaderFSH = SHADER (
+
+	varying LOWP vec4 colorVarying;
+	varying MEDP vec2 uvVarying;
+	
+	uniform sampler2D sampler;
+
+	void main () {
+		gl_FragColor = texture2D ( sampler, uvVarying ) * colorVarying;
+	}
+);
+
+#endif
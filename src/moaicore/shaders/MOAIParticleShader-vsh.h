@@ -0,0 +1,41 @@
+// Copyright (c) 2010-2011 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#ifndef	MOAIPARTICLESHADER_VSH_H
+#define	MOAIPARTICLESHADER_VSH_H
+
+#define SHADER(str) #str
+
+static cc8* _particleShaderVSH = SHADER (
+
+	attribute vec4 corner;
+	attribute vec4 sprite;
+	attribute float rotation;
+	attribute vec4 color;
+
+	uniform mat4 transform;
+	uniform vec4 ucolor;
+
+	varying LOWP vec4 colorVarying;
+	varying MEDP vec2 uvVarying;
+
+	void main () {
+		
+		vec2 offset = corner.xy * sprite.zw;
+		float c = cos ( rotation );
+		float s = sin ( rotation );
+		
+		vec4 position = vec4 (
+			sprite.x + ( offset.x * c ) - ( offset.y * s ),
+			sprite.y + ( offset.x * s ) + ( offset.y * c ),
+			0.0,
+			1.0
+		);
+		
+		gl_Position = position * transform;
+		uvVarying = corner.zw;
+		colorVarying = color * ucolor;
+	}
+);
+
+#endif
@@ -16,6 +16,19 @@ MOAITest::MOAITest () {
 MOAITest::~MOAITest () {
 }
 
+//----------------------------------------------------------------//
+// runs a chunk of Lua in the runtime's state; false if it doesn't compile or raises an error
+bool MOAITest::RunScript ( cc8* script ) {
+
+	MOAILuaStateHandle state = MOAILuaRuntime::Get ().State ();
+	if ( luaL_loadstring ( state, script )) {
+		state.Pop ( 1 );
+		return false;
+	}
+	return state.DebugCall ( 0, 0 ) == 0;
+}
+
 //----------------------------------------------------------------//
 void MOAITest::Staging ( MOAITestMgr& testMgr ) {
 }
+
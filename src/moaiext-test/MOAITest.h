@@ -14,6 +14,23 @@ class MOAITestMgr;
 // MOAITest
 //================================================================//
 class MOAITest {
+protected:
+
+	//----------------------------------------------------------------//
+	// the object held by a global set up with RunScript, or 0
+	template < typename TYPE >
+	static TYPE* GetGlobal ( cc8* name ) {
+
+		MOAILuaStateHandle state = MOAILuaRuntime::Get ().State ();
+		lua_getglobal ( state, name );
+		TYPE* object = state.GetLuaObject < TYPE >( -1, false );
+		state.Pop ( 1 );
+		return object;
+	}
+
+	//----------------------------------------------------------------//
+	static bool			RunScript			( cc8* script );
+
 public:
 
 	//----------------------------------------------------------------//
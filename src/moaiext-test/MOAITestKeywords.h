@@ -6,8 +6,9 @@
 
 #include <moaicore/moaicore.h>
 
-#define		MOAI_TEST_MATH		"math"
-#define		MOAI_TEST_SAMPLE	"sample"
-#define		MOAI_TEST_UTIL		"util"
+#define		MOAI_TEST_MATH			"math"
+#define		MOAI_TEST_PERFORMANCE	"performance"
+#define		MOAI_TEST_SAMPLE		"sample"
+#define		MOAI_TEST_UTIL			"util"
 
 #endif
@@ -285,9 +285,10 @@ void MOAITestMgr::PushTestList ( MOAILuaState& state ) {
 //----------------------------------------------------------------//
 void MOAITestMgr::RegisterLuaClass ( MOAILuaState& state ) {
 	
-	state.SetField ( -1, "MATH",		MOAI_TEST_MATH );
-	state.SetField ( -1, "SAMPLE",		MOAI_TEST_SAMPLE );
-	state.SetField ( -1, "UTIL",		MOAI_TEST_UTIL );
+	state.SetField ( -1, "MATH",			MOAI_TEST_MATH );
+	state.SetField ( -1, "PERFORMANCE",		MOAI_TEST_PERFORMANCE );
+	state.SetField ( -1, "SAMPLE",			MOAI_TEST_SAMPLE );
+	state.SetField ( -1, "UTIL",			MOAI_TEST_UTIL );
 	
 	luaL_Reg regTable [] = {
 		{ "beginTest",				_beginTest },
@@ -0,0 +1,176 @@
+// Copyright (c) 2010-2011 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#ifndef	MOAITEST_MOAIGRIDMESH_H
+#define	MOAITEST_MOAIGRIDMESH_H
+
+#include <moaicore/moaicore.h>
+#include <moaiext-test/MOAITest.h>
+#include <moaiext-test/MOAITestKeywords.h>
+#include <moaiext-test/MOAITestMgr.h>
+
+#include <moaicore/MOAIGridMesh.h>
+
+//================================================================//
+// MOAITest_MOAIGridMesh
+//================================================================//
+class MOAITest_MOAIGridMesh :
+	public MOAITest {
+public:
+
+	TEST_NAME ( "MOAIGridMesh" )
+
+	// 40 x 36 tiles gives one full block and three partial ones; every fourth tile is empty
+	static const int GRID_WIDTH		= 40;
+	static const int GRID_HEIGHT	= 36;
+
+	char messageBuffer [ 1024 ];
+
+	//----------------------------------------------------------------//
+	// checks that a block holds exactly its non empty tiles, one quad each, in row major order
+	bool CheckChunk ( MOAIGridMesh& mesh, MOAIGrid& grid, int xChunk, int yChunk, u32& totalQuads ) {
+
+		static const int CHUNK_SIZE = MOAIGridMesh::CHUNK_SIZE;
+
+		USLeanArray < MOAIQuadVertex > vtx;
+		vtx.Init ( CHUNK_SIZE * CHUNK_SIZE * 4 );
+
+		u32 count = mesh.WriteChunk ( xChunk, yChunk, vtx.Data ());
+		totalQuads += count;
+
+		u32 quad = 0;
+		for ( int y = yChunk * CHUNK_SIZE; y < MIN (( yChunk + 1 ) * CHUNK_SIZE, GRID_HEIGHT ); ++y ) {
+			for ( int x = xChunk * CHUNK_SIZE; x < MIN (( xChunk + 1 ) * CHUNK_SIZE, GRID_WIDTH ); ++x ) {
+
+				if ( !grid.GetTile ( x, y )) continue;
+				if ( quad >= count ) return false;
+
+				MOAIQuadVertex* corners = &vtx [ quad * 4 ];
+
+				USRect rect;
+				rect.Init ( corners [ 0 ].mX, corners [ 0 ].mY, corners [ 0 ].mX, corners [ 0 ].mY );
+				for ( u32 i = 1; i < 4; ++i ) {
+					USVec2D corner;
+					corner.Init ( corners [ i ].mX, corners [ i ].mY );
+					rect.Grow ( corner );
+				}
+
+				USVec2D center;
+				rect.GetCenter ( center );
+
+				USVec2D expected = grid.GetTilePoint ( MOAICellCoord ( x, y ), MOAIGridSpace::TILE_CENTER );
+				if ( !center.Equals ( expected )) return false;
+				if (( rect.Width () != grid.GetTileWidth ()) || ( rect.Height () != grid.GetTileHeight ())) return false;
+
+				quad++;
+			}
+		}
+		return quad == count;
+	}
+
+	//----------------------------------------------------------------//
+	void Staging ( MOAITestMgr& testMgr ) {
+
+		testMgr.SetFilter ( MOAI_TEST_UTIL, 0 );
+	}
+
+	//----------------------------------------------------------------//
+	void Test ( MOAITestMgr& testMgr ) {
+
+		bool ready = this->RunScript (
+			"testGrid = MOAIGrid.new ()\n"
+			"testGrid:initRectGrid ( 40, 36, 16, 16 )\n"
+			"for y = 1, 36 do\n"
+			"	for x = 1, 40 do\n"
+			"		testGrid:setTile ( x, y, ( x + y ) % 4 )\n"
+			"	end\n"
+			"end\n"
+			"testDeck = MOAITileDeck2D.new ()\n"
+			"testDeck:setSize ( 2, 2 )\n"
+		);
+
+		MOAIGrid* grid = ready ? this->GetGlobal < MOAIGrid >( "testGrid" ) : 0;
+		MOAITileDeck2D* deck = ready ? this->GetGlobal < MOAITileDeck2D >( "testDeck" ) : 0;
+
+		testMgr.BeginTest ( "Block contents and order" );
+
+		if ( grid && deck ) {
+
+			MOAIGridMesh mesh ( *grid, *deck );
+
+			u32 expected = 0;
+			for ( int y = 0; y < GRID_HEIGHT; ++y ) {
+				for ( int x = 0; x < GRID_WIDTH; ++x ) {
+					if ( grid->GetTile ( x, y )) expected++;
+				}
+			}
+
+			bool pass = true;
+			u32 totalQuads = 0;
+
+			int xChunks = ( GRID_WIDTH + MOAIGridMesh::CHUNK_SIZE - 1 ) / MOAIGridMesh::CHUNK_SIZE;
+			int yChunks = ( GRID_HEIGHT + MOAIGridMesh::CHUNK_SIZE - 1 ) / MOAIGridMesh::CHUNK_SIZE;
+
+			for ( int y = 0; y < yChunks; ++y ) {
+				for ( int x = 0; x < xChunks; ++x ) {
+					pass = this->CheckChunk ( mesh, *grid, x, y, totalQuads ) && pass;
+				}
+			}
+
+			sprintf ( messageBuffer, "%d quads in %d blocks", totalQuads, xChunks * yChunks );
+			testMgr.Comment ( messageBuffer );
+
+			if ( pass && ( totalQuads == expected )) {
+				testMgr.Success ( "Passed" );
+				testMgr.EndTest ( true );
+			}
+			else {
+				testMgr.Failure ( "Bad block", "a block is missing tiles, has extra tiles or is out of row major order" );
+				testMgr.EndTest ( false );
+			}
+		}
+		else {
+			testMgr.Failure ( "Setup", "couldn't create the grid and deck" );
+			testMgr.EndTest ( false );
+		}
+
+		testMgr.BeginTest ( "Only grids with non overlapping tiles use blocks" );
+
+		if ( grid && deck ) {
+
+			bool rect = MOAIGridMesh::CanDraw ( *grid, *deck );
+
+			this->RunScript ( "testGrid:initRectGrid ( 40, 36, 16, 16, 4, 4 )" );
+			bool gutter = MOAIGridMesh::CanDraw ( *grid, *deck );
+
+			this->RunScript ( "testDeck:setRect ( -1, -1, 1, 1 )" );
+			bool oversized = MOAIGridMesh::CanDraw ( *grid, *deck );
+
+			this->RunScript ( "testDeck:setRect ( -0.5, -0.5, 0.5, 0.5 ) testGrid:initHexGrid ( 40, 36, 16 )" );
+			bool hex = MOAIGridMesh::CanDraw ( *grid, *deck );
+
+			this->RunScript ( "testGrid:initDiamondGrid ( 40, 36, 16, 8 )" );
+			bool diamond = MOAIGridMesh::CanDraw ( *grid, *deck );
+
+			this->RunScript ( "testGrid:initObliqueGrid ( 40, 36, 16, 16 )" );
+			bool oblique = MOAIGridMesh::CanDraw ( *grid, *deck );
+
+			if ( rect && gutter && !oversized && !hex && !diamond && !oblique ) {
+				testMgr.Success ( "Passed" );
+				testMgr.EndTest ( true );
+			}
+			else {
+				testMgr.Failure ( "Bad shape check", "block drawing allowed for a grid whose tiles overlap, or refused for a plain rect grid" );
+				testMgr.EndTest ( false );
+			}
+		}
+		else {
+			testMgr.Failure ( "Setup", "couldn't create the grid and deck" );
+			testMgr.EndTest ( false );
+		}
+
+		this->RunScript ( "testGrid = nil testDeck = nil" );
+	}
+};
+
+#endif
@@ -0,0 +1,175 @@
+// Copyright (c) 2010-2011 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#ifndef	MOAITEST_MOAIKTXHEADER_H
+#define	MOAITEST_MOAIKTXHEADER_H
+
+#include <moaicore/moaicore.h>
+#include <moaiext-test/MOAITest.h>
+#include <moaiext-test/MOAITestKeywords.h>
+#include <moaiext-test/MOAITestMgr.h>
+
+#include <moaicore/MOAIKtxHeader.h>
+
+//================================================================//
+// MOAITest_MOAIKtxHeader
+//================================================================//
+class MOAITest_MOAIKtxHeader :
+	public MOAITest {
+public:
+
+	TEST_NAME ( "MOAIKtxHeader" )
+
+	// an odd width, so every format's rows need padding; 13 x 6 reduces to 6 x 3, 3 x 1 and 1 x 1
+	static const u32 IMAGE_WIDTH	= 13;
+	static const u32 IMAGE_HEIGHT	= 6;
+	static const u32 TOTAL_LEVELS	= 4;
+
+	char messageBuffer [ 1024 ];
+
+	//----------------------------------------------------------------//
+	// the size the loader expects of a level's record, without its size field
+	u32 GetLevelSize ( USColor::Format colorFormat, u32 level ) {
+
+		u32 width = MAX ( IMAGE_WIDTH >> level, 1 );
+		u32 height = MAX ( IMAGE_HEIGHT >> level, 1 );
+		return MOAIKtxHeader::GetPaddedSize ( width * USColor::GetSize ( colorFormat )) * height;
+	}
+
+	//----------------------------------------------------------------//
+	// checks the levels that follow the header, from baseLevel down, against the image they were written from
+	bool CheckLevels ( MOAIImage& image, const void* data, size_t size, u32 baseLevel ) {
+
+		MOAIKtxHeader* header = MOAIKtxHeader::GetHeader ( data, size );
+		if ( !header ) return false;
+
+		if (( header->mPixelWidth != IMAGE_WIDTH ) || ( header->mPixelHeight != IMAGE_HEIGHT )) return false;
+		if ( header->GetLevelCount () != TOTAL_LEVELS ) return false;
+
+		const u8* levelData = ( const u8* )MOAIKtxHeader::GetLevelData ( data, size );
+		const u8* end = ( const u8* )data + size;
+		if ( !levelData ) return false;
+
+		USColor::Format colorFormat = image.GetColorFormat ();
+
+		for ( u32 level = baseLevel; level < TOTAL_LEVELS; ++level ) {
+
+			if (( levelData + sizeof ( u32 )) > end ) return false;
+
+			u32 imageSize = *( const u32* )levelData;
+			levelData += sizeof ( u32 );
+
+			if ( imageSize != this->GetLevelSize ( colorFormat, level )) return false;
+			if (( levelData + imageSize ) > end ) return false;
+
+			// the top level should be the image itself, row for row
+			if ( level == 0 ) {
+				u32 paddedRowSize = MOAIKtxHeader::GetPaddedSize ( image.GetRowSize ());
+				for ( u32 y = 0; y < IMAGE_HEIGHT; ++y ) {
+					if ( memcmp ( levelData + ( y * paddedRowSize ), image.GetRowAddr ( y ), image.GetRowSize ())) return false;
+				}
+			}
+			levelData += MOAIKtxHeader::GetPaddedSize ( imageSize );
+		}
+		return levelData >= end;
+	}
+
+	//----------------------------------------------------------------//
+	// reads the levels from a copy of the first length bytes of a file
+	void* ReadLevels ( const void* file, size_t length, u32 baseLevel, size_t& size ) {
+
+		USByteStream stream;
+		stream.SetBuffer (( void* )file, length, length );
+		return MOAIKtxHeader::ReadLevels ( stream, baseLevel, size );
+	}
+
+	//----------------------------------------------------------------//
+	void Staging ( MOAITestMgr& testMgr ) {
+
+		testMgr.SetFilter ( MOAI_TEST_UTIL, 0 );
+	}
+
+	//----------------------------------------------------------------//
+	void Test ( MOAITestMgr& testMgr ) {
+
+		this->TestRoundTrip ( testMgr, USColor::RGB_888 );
+		this->TestRoundTrip ( testMgr, USColor::RGB_565 );
+		this->TestRoundTrip ( testMgr, USColor::RGBA_8888 );
+	}
+
+	//----------------------------------------------------------------//
+	void TestRoundTrip ( MOAITestMgr& testMgr, USColor::Format colorFormat ) {
+
+		MOAIImage image;
+		image.Init ( IMAGE_WIDTH, IMAGE_HEIGHT, colorFormat, USPixel::TRUECOLOR );
+
+		for ( u32 y = 0; y < IMAGE_HEIGHT; ++y ) {
+			for ( u32 x = 0; x < IMAGE_WIDTH; ++x ) {
+				image.SetColor ( x, y, USColor::PackRGBA ( x * 19, y * 41, ( x + y ) * 11, 255 ));
+			}
+		}
+
+		USMemStream stream;
+		bool written = image.WriteKTX ( stream, true );
+
+		size_t length = stream.GetLength ();
+		void* file = malloc ( length );
+		stream.Seek ( 0, SEEK_SET );
+		stream.ReadBytes ( file, length );
+
+		sprintf ( messageBuffer, "Write with mips and load back (%d bytes per pixel)", USColor::GetSize ( colorFormat ));
+		testMgr.BeginTest ( messageBuffer );
+
+		size_t size = 0;
+		void* data = written ? this->ReadLevels ( file, length, 0, size ) : 0;
+
+		bool whole = data && ( size == length ) && this->CheckLevels ( image, data, size, 0 );
+		free ( data );
+
+		data = written ? this->ReadLevels ( file, length, 2, size ) : 0;
+		bool coarse = data && this->CheckLevels ( image, data, size, 2 );
+		free ( data );
+
+		if ( whole && coarse ) {
+			testMgr.Success ( "Passed" );
+			testMgr.EndTest ( true );
+		}
+		else {
+			testMgr.Failure ( "Bad file", "the dimensions, level count or level sizes read back don't match the image that was written" );
+			testMgr.EndTest ( false );
+		}
+
+		testMgr.BeginTest ( "Truncated files are refused" );
+
+		// cut inside the header, just after it, inside the top level and inside the last level
+		size_t cuts [] = {
+			MOAIKtxHeader::HEADER_SIZE / 2,
+			MOAIKtxHeader::HEADER_SIZE,
+			MOAIKtxHeader::HEADER_SIZE + sizeof ( u32 ) + 8,
+			length - 1,
+		};
+
+		bool refused = written;
+		for ( u32 i = 0; refused && ( i < ( sizeof ( cuts ) / sizeof ( size_t ))); ++i ) {
+
+			data = this->ReadLevels ( file, cuts [ i ], 0, size );
+			refused = !( data || size );
+			free ( data );
+		}
+
+		refused = refused && !MOAIKtxHeader::GetHeader ( file, MOAIKtxHeader::HEADER_SIZE - 1 );
+
+		if ( refused ) {
+			testMgr.Success ( "Passed" );
+			testMgr.EndTest ( true );
+		}
+		else {
+			testMgr.Failure ( "Bad file", "a file cut short was read" );
+			testMgr.EndTest ( false );
+		}
+
+		free ( file );
+	}
+};
+
+#endif
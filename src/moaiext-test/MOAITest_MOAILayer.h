@@ -0,0 +1,118 @@
+// Copyright (c) 2010-2011 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#ifndef	MOAITEST_MOAILAYER_H
+#define	MOAITEST_MOAILAYER_H
+
+#include <moaicore/moaicore.h>
+#include <moaiext-test/MOAITest.h>
+#include <moaiext-test/MOAITestKeywords.h>
+#include <moaiext-test/MOAITestMgr.h>
+
+//================================================================//
+// MOAITest_MOAILayer
+//================================================================//
+class MOAITest_MOAILayer :
+	public MOAITest {
+public:
+
+	TEST_NAME ( "MOAILayer" )
+
+	static const u32 TOTAL_PROPS = 10;
+
+	char messageBuffer [ 1024 ];
+
+	//----------------------------------------------------------------//
+	void Staging ( MOAITestMgr& testMgr ) {
+
+		testMgr.SetFilter ( MOAI_TEST_UTIL, 0 );
+	}
+
+	//----------------------------------------------------------------//
+	void Test ( MOAITestMgr& testMgr ) {
+
+		this->TestStateSort ( testMgr );
+	}
+
+	//----------------------------------------------------------------//
+	// the pass setStateSort adds after the layer's sort; props are numbered by priority
+	void TestStateSort ( MOAITestMgr& testMgr ) {
+
+		testMgr.BeginTest ( "State sort groups textures without reordering overlaps" );
+
+		// textures alternate, so the priority order switches texture at every prop; props 1 - 4 are
+		// apart, prop 5 has no deck and so no bounds, and 6 - 8 each overlap the one before them
+		bool ready = this->RunScript (
+			"local textures = { a = MOAITexture.new (), b = MOAITexture.new ()}\n"
+			"local deck = MOAIGfxQuad2D.new ()\n"
+			"deck:setRect ( -8, -8, 8, 8 )\n"
+			"local layout = {\n"
+			"	{ 'a', 0, 0 }, { 'b', 100, 0 }, { 'a', 200, 0 }, { 'b', 300, 0 },\n"
+			"	{ 'a' },\n"
+			"	{ 'a', 0, 100 }, { 'b', 5, 100 }, { 'a', 10, 100 }, { 'b', 300, 100 }, { 'a', 400, 100 },\n"
+			"}\n"
+			"testPartition = MOAIPartition.new ()\n"
+			"testProps = {}\n"
+			"for i, entry in ipairs ( layout ) do\n"
+			"	local prop = MOAIProp.new ()\n"
+			"	if entry [ 2 ] then\n"
+			"		prop:setDeck ( deck )\n"
+			"		prop:setLoc ( entry [ 2 ], entry [ 3 ])\n"
+			"	end\n"
+			"	prop:setTexture ( textures [ entry [ 1 ]])\n"
+			"	prop:setPriority ( i )\n"
+			"	testPartition:insertProp ( prop )\n"
+			"	prop:forceUpdate ()\n"
+			"	testProps [ i ] = prop\n"
+			"end\n"
+		);
+
+		MOAIPartition* partition = ready ? this->GetGlobal < MOAIPartition >( "testPartition" ) : 0;
+
+		if ( !partition ) {
+			testMgr.Failure ( "Setup", "couldn't create the partition and props" );
+			testMgr.EndTest ( false );
+			return;
+		}
+
+		MOAIPartitionResultBuffer buffer;
+		partition->GatherProps ( buffer, 0 );
+		buffer.GenerateKeys ( MOAIPartitionResultBuffer::SORT_PRIORITY_ASCENDING, 0.0f, 0.0f, 0.0f, 1.0f );
+
+		USMatrix4x4 viewProj;
+		viewProj.Ident ();
+
+		u32 total = buffer.Sort ( MOAIPartitionResultBuffer::SORT_PRIORITY_ASCENDING, &viewProj );
+		total = ( total == TOTAL_PROPS ) ? buffer.SortByState ( &viewProj ) : 0;
+
+		// each run starts with its first prop's texture and sticks to it while any prop using it is
+		// free; in the second run, 8 can't move ahead of 7 or 7 ahead of 6
+		static const s32 expected [ TOTAL_PROPS ] = { 1, 3, 2, 4, 5, 6, 10, 9, 7, 8 };
+
+		STLString order;
+		bool pass = ( total == TOTAL_PROPS );
+
+		for ( u32 i = 0; i < total; ++i ) {
+			s32 priority = buffer.GetResultUnsafe ( i )->mPriority;
+			order.write ( "%d ", priority );
+			pass = pass && ( priority == expected [ i ]);
+		}
+
+		sprintf ( messageBuffer, "drew %s", order.c_str ());
+		testMgr.Comment ( messageBuffer );
+
+		if ( pass ) {
+			testMgr.Success ( "Passed" );
+			testMgr.EndTest ( true );
+		}
+		else {
+			testMgr.Failure ( "Bad order", "props weren't grouped by texture, an overlapping prop moved ahead of one below it, or a prop without bounds moved" );
+			testMgr.EndTest ( false );
+		}
+
+		buffer.Clear ();
+		this->RunScript ( "testPartition = nil testProps = nil collectgarbage ()" );
+	}
+};
+
+#endif
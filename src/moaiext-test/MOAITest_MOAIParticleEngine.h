@@ -0,0 +1,181 @@
+// Copyright (c) 2010-2011 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#ifndef	MOAITEST_MOAIPARTICLEENGINE_H
+#define	MOAITEST_MOAIPARTICLEENGINE_H
+
+#include <moaicore/moaicore.h>
+#include <moaiext-test/MOAITest.h>
+#include <moaiext-test/MOAITestKeywords.h>
+#include <moaiext-test/MOAITestMgr.h>
+
+#include <aku/AKU-particles.h>
+
+//================================================================//
+// MOAITest_MOAIParticleEngine
+//================================================================//
+class MOAITest_MOAIParticleEngine :
+	public MOAITest {
+public:
+
+	TEST_NAME ( "MOAIParticleEngine" )
+
+	static const u32 TOTAL_STEPS	= 16;
+
+	char messageBuffer [ 1024 ];
+
+	//----------------------------------------------------------------//
+	static STLString& GetLog () {
+
+		static STLString log;
+		return log;
+	}
+
+	//----------------------------------------------------------------//
+	static void OnRender ( float* particle, float* registers, AKUParticleSprite* sprite, float t0, float t1, float term ) {
+
+		GetLog ().write ( "%.4f %.4f %.4f %.4f %.4f %.4f %.4f %.4f %.4f\n",
+			particle [ MOAIParticle::PARTICLE_X ],
+			particle [ MOAIParticle::PARTICLE_Y ],
+			registers [ 0 ],
+			registers [ 1 ],
+			registers [ 2 ],
+			registers [ 3 ],
+			t0,
+			t1,
+			term
+		);
+		memset ( sprite, 0, sizeof ( AKUParticleSprite ));
+	}
+
+	//----------------------------------------------------------------//
+	// particles pass through two states, so some are in each at once and some change state
+	// every step; both init scripts draw, and the render scripts draw if renderRand is set
+	bool Simulate ( bool vectorized, bool renderRand, u32 seed, STLString& log ) {
+
+		MOAILuaStateHandle state = MOAILuaRuntime::Get ().State ();
+
+		AKUNewParticlePlugin ( state, 0, OnRender, 4 );
+		lua_setglobal ( state, "testPlugin" );
+
+		state.Push ( vectorized );
+		lua_setglobal ( state, "testVectorized" );
+
+		state.Push ( renderRand );
+		lua_setglobal ( state, "testRenderRand" );
+
+		bool ready = this->RunScript (
+			"local reg = MOAIParticleScript.packReg\n"
+			"local const = MOAIParticleScript.packConst\n"
+			"local function newState ( lower, upper )\n"
+			"	local init = MOAIParticleScript.new ()\n"
+			"	init:rand ( reg ( 3 ), const ( lower ), const ( upper ))\n"
+			"	local render = MOAIParticleScript.new ()\n"
+			"	if testRenderRand then\n"
+			"		render:rand ( reg ( 1 ), const ( 0 ), const ( 10 ))\n"
+			"		render:randVec ( reg ( 2 ), reg ( 4 ), const ( 1 ), const ( 2 ))\n"
+			"	end\n"
+			"	render:add ( MOAIParticleScript.PARTICLE_X, MOAIParticleScript.PARTICLE_X, reg ( 3 ))\n"
+			"	local state = MOAIParticleState.new ()\n"
+			"	state:setTerm ( 0.5, 1.5 )\n"
+			"	state:setInitScript ( init )\n"
+			"	state:setRenderScript ( render )\n"
+			"	state:setPlugin ( testPlugin )\n"
+			"	return state\n"
+			"end\n"
+			"local first = newState ( 0, 10 )\n"
+			"local second = newState ( 20, 30 )\n"
+			"first:setNext ( second )\n"
+			"testSystem = MOAIParticleSystem.new ()\n"
+			"testSystem:reserveParticles ( 128, 4 )\n"
+			"testSystem:reserveSprites ( 128 )\n"
+			"testSystem:reserveStates ( 1 )\n"
+			"testSystem:setVectorized ( testVectorized )\n"
+			"testSystem:setState ( 1, first )\n"
+			"testSystem:start ()\n"
+		);
+
+		MOAIParticleSystem* system = 0;
+
+		if ( ready ) {
+			lua_getglobal ( state, "testSystem" );
+			system = state.GetLuaObject < MOAIParticleSystem >( -1, false );
+			state.Pop ( 1 );
+		}
+
+		if ( system ) {
+
+			GetLog ().clear ();
+			srand ( seed );
+
+			for ( u32 step = 0; step < TOTAL_STEPS; ++step ) {
+
+				for ( u32 i = 0; i < 3; ++i ) {
+					system->PushParticle (( float )step, ( float )i );
+				}
+				MOAIActionMgr::Get ().Update ( 0.25f );
+			}
+			log = GetLog ();
+		}
+
+		this->RunScript (
+			"if testSystem then testSystem:stop () end\n"
+			"testSystem = nil\n"
+			"testPlugin = nil\n"
+			"collectgarbage ()\n"
+		);
+		return system != 0;
+	}
+
+	//----------------------------------------------------------------//
+	void Staging ( MOAITestMgr& testMgr ) {
+
+		testMgr.SetFilter ( MOAI_TEST_UTIL, 0 );
+	}
+
+	//----------------------------------------------------------------//
+	void Test ( MOAITestMgr& testMgr ) {
+
+		STLString list;
+		STLString vectorized;
+
+		testMgr.BeginTest ( "Same seed, same draws with rand in init scripts" );
+
+		if ( this->Simulate ( false, false, 3, list ) && this->Simulate ( true, false, 3, vectorized )) {
+
+			if ( list.size () && ( list == vectorized )) {
+				testMgr.Success ( "Passed" );
+				testMgr.EndTest ( true );
+			}
+			else {
+				testMgr.Failure ( "Bad draws", "the vectorized system's init scripts drew in a different order than the particle list's" );
+				testMgr.EndTest ( false );
+			}
+		}
+		else {
+			testMgr.Failure ( "Setup", "couldn't create the particle system" );
+			testMgr.EndTest ( false );
+		}
+
+		testMgr.BeginTest ( "Same seed, same draws with rand in render scripts" );
+
+		if ( this->Simulate ( false, true, 5, list ) && this->Simulate ( true, true, 5, vectorized )) {
+
+			if ( list.size () && ( list == vectorized )) {
+				testMgr.Success ( "Passed" );
+				testMgr.EndTest ( true );
+			}
+			else {
+				sprintf ( messageBuffer, "logged %d bytes from the list and %d from the vectorized system; draws came out in a different order", ( int )list.size (), ( int )vectorized.size ());
+				testMgr.Failure ( "Bad draws", messageBuffer );
+				testMgr.EndTest ( false );
+			}
+		}
+		else {
+			testMgr.Failure ( "Setup", "couldn't create the particle system" );
+			testMgr.EndTest ( false );
+		}
+	}
+};
+
+#endif
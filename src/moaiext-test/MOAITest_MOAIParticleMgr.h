@@ -0,0 +1,228 @@
+// Copyright (c) 2010-2011 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#ifndef	MOAITEST_MOAIPARTICLEMGR_H
+#define	MOAITEST_MOAIPARTICLEMGR_H
+
+#include <moaicore/moaicore.h>
+#include <moaiext-test/MOAITest.h>
+#include <moaiext-test/MOAITestKeywords.h>
+#include <moaiext-test/MOAITestMgr.h>
+
+#include <aku/AKU-particles.h>
+
+//================================================================//
+// MOAITest_MOAIParticleMgr
+//================================================================//
+class MOAITest_MOAIParticleMgr :
+	public MOAITest {
+public:
+
+	TEST_NAME ( "MOAIParticleMgr" )
+
+	// enough systems to keep every worker busy; the second half use the vectorized engine
+	static const u32 TOTAL_SYSTEMS	= 8;
+	static const u32 TOTAL_STEPS	= 12;
+
+	char messageBuffer [ 1024 ];
+
+	//----------------------------------------------------------------//
+	// one log per system; the init script stores the system's number in the particle's second register
+	static STLString* GetLogs () {
+
+		static STLString logs [ TOTAL_SYSTEMS ];
+		return logs;
+	}
+
+	//----------------------------------------------------------------//
+	static void OnRender ( float* particle, float* registers, AKUParticleSprite* sprite, float t0, float t1, float term ) {
+
+		u32 system = ( u32 )registers [ 1 ] - 1;
+		if ( system < TOTAL_SYSTEMS ) {
+			GetLogs ()[ system ].write ( "%.4f %.4f %.4f %.4f %.4f %.4f\n", particle [ MOAIParticle::PARTICLE_X ], particle [ MOAIParticle::PARTICLE_Y ], registers [ 0 ], t0, t1, term );
+		}
+		memset ( sprite, 0, sizeof ( AKUParticleSprite ));
+	}
+
+	//----------------------------------------------------------------//
+	bool InRange ( cc8* log, float min, float max, u32 column ) {
+
+		STLString text = log;
+		STLArray < STLString > lines;
+		text.tokenize ( lines, "\n" );
+
+		for ( u32 i = 0; i < lines.size (); ++i ) {
+
+			STLArray < STLString > values;
+			lines [ i ].tokenize ( values );
+
+			float value = ( float )atof ( values [ column ].c_str ());
+			if (( value < min ) || ( value > max )) return false;
+		}
+		return lines.size () > 0;
+	}
+
+	//----------------------------------------------------------------//
+	// even systems get a particle before the action tree updates them, odd ones after, as from
+	// emitters on either side of the system; returns false if the systems couldn't be made
+	bool Simulate ( bool parallel, bool randomize, u32 seed, STLString* logs ) {
+
+		MOAILuaStateHandle state = MOAILuaRuntime::Get ().State ();
+
+		AKUNewParticlePlugin ( state, 0, OnRender, 2 );
+		lua_setglobal ( state, "testPlugin" );
+
+		state.Push ( randomize );
+		lua_setglobal ( state, "testRandomize" );
+
+		bool ready = this->RunScript (
+			"local reg = MOAIParticleScript.packReg\n"
+			"local const = MOAIParticleScript.packConst\n"
+			"testSystems = {}\n"
+			"for i = 1, 8 do\n"
+			"	local init = MOAIParticleScript.new ()\n"
+			"	init:set ( reg ( 2 ), const ( i ))\n"
+			"	local render = MOAIParticleScript.new ()\n"
+			"	if testRandomize then\n"
+			"		render:rand ( reg ( 1 ), const ( 0 ), const ( 10 ))\n"
+			"	end\n"
+			"	render:add ( MOAIParticleScript.PARTICLE_X, MOAIParticleScript.PARTICLE_X, const ( 1 ))\n"
+			"	local state = MOAIParticleState.new ()\n"
+			"	state:setTerm ( testRandomize and 0.5 or 1, testRandomize and 1.5 or 1 )\n"
+			"	state:setInitScript ( init )\n"
+			"	state:setRenderScript ( render )\n"
+			"	state:setPlugin ( testPlugin )\n"
+			"	local system = MOAIParticleSystem.new ()\n"
+			"	system:reserveParticles ( 64, 2 )\n"
+			"	system:reserveSprites ( 64 )\n"
+			"	system:reserveStates ( 1 )\n"
+			"	system:setVectorized ( i > 4 )\n"
+			"	system:setState ( 1, state )\n"
+			"	system:start ()\n"
+			"	testSystems [ i ] = system\n"
+			"end\n"
+		);
+
+		MOAIParticleSystem* systems [ TOTAL_SYSTEMS ];
+
+		lua_getglobal ( state, "testSystems" );
+		for ( u32 i = 0; i < TOTAL_SYSTEMS; ++i ) {
+			lua_rawgeti ( state, -1, i + 1 );
+			systems [ i ] = ready ? state.GetLuaObject < MOAIParticleSystem >( -1, false ) : 0;
+			ready = ready && systems [ i ];
+			state.Pop ( 1 );
+		}
+		state.Pop ( 1 );
+
+		if ( ready ) {
+
+			for ( u32 i = 0; i < TOTAL_SYSTEMS; ++i ) {
+				GetLogs ()[ i ].clear ();
+			}
+
+			srand ( seed );
+			MOAIParticleMgr::Get ().SetParallelUpdate ( parallel );
+
+			for ( u32 step = 0; step < TOTAL_STEPS; ++step ) {
+
+				for ( u32 i = 0; i < TOTAL_SYSTEMS; i += 2 ) {
+					systems [ i ]->PushParticle (( float )step, 0.0f );
+				}
+
+				MOAIActionMgr::Get ().Update ( 0.25f );
+
+				for ( u32 i = 1; i < TOTAL_SYSTEMS; i += 2 ) {
+					systems [ i ]->PushParticle (( float )step, 0.0f );
+				}
+
+				MOAIParticleMgr::Get ().Update ();
+			}
+
+			MOAIParticleMgr::Get ().SetParallelUpdate ( false );
+
+			for ( u32 i = 0; i < TOTAL_SYSTEMS; ++i ) {
+				logs [ i ] = GetLogs ()[ i ];
+			}
+		}
+
+		this->RunScript (
+			"for i, system in ipairs ( testSystems ) do\n"
+			"	system:stop ()\n"
+			"end\n"
+			"testSystems = nil\n"
+			"testPlugin = nil\n"
+			"collectgarbage ()\n"
+		);
+		return ready;
+	}
+
+	//----------------------------------------------------------------//
+	void Staging ( MOAITestMgr& testMgr ) {
+
+		testMgr.SetFilter ( MOAI_TEST_UTIL, 0 );
+	}
+
+	//----------------------------------------------------------------//
+	void Test ( MOAITestMgr& testMgr ) {
+
+		STLString serial [ TOTAL_SYSTEMS ];
+		STLString parallel [ TOTAL_SYSTEMS ];
+		STLString repeat [ TOTAL_SYSTEMS ];
+
+		testMgr.BeginTest ( "Parallel update matches serial update" );
+
+		if ( this->Simulate ( false, false, 1, serial ) && this->Simulate ( true, false, 1, parallel )) {
+
+			u32 mismatch = TOTAL_SYSTEMS;
+			for ( u32 i = 0; i < TOTAL_SYSTEMS; ++i ) {
+				if (( serial [ i ] != parallel [ i ]) || !serial [ i ].size ()) {
+					mismatch = i;
+					break;
+				}
+			}
+
+			if ( mismatch == TOTAL_SYSTEMS ) {
+				testMgr.Success ( "Passed" );
+				testMgr.EndTest ( true );
+			}
+			else {
+				sprintf ( messageBuffer, "system %d rendered differently; a particle pushed after its system was updated may have been simulated early", mismatch + 1 );
+				testMgr.Failure ( "Bad order", messageBuffer );
+				testMgr.EndTest ( false );
+			}
+		}
+		else {
+			testMgr.Failure ( "Setup", "couldn't create the particle systems" );
+			testMgr.EndTest ( false );
+		}
+
+		testMgr.BeginTest ( "Random numbers drawn off the main thread" );
+
+		if ( this->Simulate ( true, true, 7, parallel ) && this->Simulate ( true, true, 7, repeat )) {
+
+			bool pass = true;
+			for ( u32 i = 0; i < TOTAL_SYSTEMS; ++i ) {
+
+				// same seed, same draws; script draws and terms stay within their ranges
+				pass = pass && ( parallel [ i ] == repeat [ i ]);
+				pass = pass && this->InRange ( parallel [ i ].c_str (), 0.0f, 10.0f, 2 );
+				pass = pass && this->InRange ( parallel [ i ].c_str (), 0.5f, 1.5f, 5 );
+			}
+
+			if ( pass ) {
+				testMgr.Success ( "Passed" );
+				testMgr.EndTest ( true );
+			}
+			else {
+				testMgr.Failure ( "Bad draws", "two parallel runs from the same seed differed, or a draw fell outside its range" );
+				testMgr.EndTest ( false );
+			}
+		}
+		else {
+			testMgr.Failure ( "Setup", "couldn't create the particle systems" );
+			testMgr.EndTest ( false );
+		}
+	}
+};
+
+#endif
@@ -0,0 +1,152 @@
+// Copyright (c) 2010-2011 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#ifndef	MOAITEST_MOAIPARTICLESYSTEM_H
+#define	MOAITEST_MOAIPARTICLESYSTEM_H
+
+#include <moaicore/moaicore.h>
+#include <moaiext-test/MOAITest.h>
+#include <moaiext-test/MOAITestKeywords.h>
+#include <moaiext-test/MOAITestMgr.h>
+
+#include <aku/AKU-particles.h>
+
+//================================================================//
+// MOAITest_MOAIParticleSystem
+//================================================================//
+class MOAITest_MOAIParticleSystem :
+	public MOAITest {
+public:
+
+	TEST_NAME ( "MOAIParticleSystem" )
+
+	// seven sprites pushed into five slots: the first two are overwritten and the fifth has no
+	// deck item, so four quads come out, from sprites 2, 3, 5 and 6
+	static const u32 MAX_SPRITES	= 5;
+	static const u32 TOTAL_SPRITES	= 7;
+	static const u32 HIDDEN_SPRITE	= 4;
+	static const u32 TOTAL_QUADS	= 4;
+
+	char messageBuffer [ 1024 ];
+
+	//----------------------------------------------------------------//
+	// checks a quad written for the shader against the deck quad placed the way the per sprite
+	// path places it, with a matrix from the sprite's location, rotation and scale
+	bool CheckQuad ( MOAIDeck& deck, const AKUParticleSprite& sprite, const MOAIParticleVertex* vtx ) {
+
+		MOAIQuadVertex quad [ 4 ];
+		if ( !deck.WriteQuad (( u32 )sprite.mGfxID, quad, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f )) return false;
+
+		USAffine3D spriteMtx;
+		spriteMtx.ScRoTr ( sprite.mXScl, sprite.mYScl, 1.0f, 0.0f, 0.0f, sprite.mZRot * ( float )D2R, sprite.mXLoc, sprite.mYLoc, 0.0f );
+
+		USColorVec color;
+		color.Set ( sprite.mRed, sprite.mGreen, sprite.mBlue, sprite.mAlpha );
+
+		for ( u32 i = 0; i < 4; ++i ) {
+
+			USVec2D expected ( quad [ i ].mX, quad [ i ].mY );
+			spriteMtx.Transform ( expected );
+
+			// what the particle shader does with the vertex
+			float xOff = vtx [ i ].mCornerX * vtx [ i ].mXScl;
+			float yOff = vtx [ i ].mCornerY * vtx [ i ].mYScl;
+			float c = Cos ( vtx [ i ].mZRot );
+			float s = Sin ( vtx [ i ].mZRot );
+
+			float xError = vtx [ i ].mXLoc + ( xOff * c ) - ( yOff * s ) - expected.mX;
+			float yError = vtx [ i ].mYLoc + ( xOff * s ) + ( yOff * c ) - expected.mY;
+
+			if (( ABS ( xError ) > 0.001f ) || ( ABS ( yError ) > 0.001f )) return false;
+			if (( vtx [ i ].mU != quad [ i ].mU ) || ( vtx [ i ].mV != quad [ i ].mV )) return false;
+			if ( vtx [ i ].mColor != color.PackRGBA ()) return false;
+		}
+		return true;
+	}
+
+	//----------------------------------------------------------------//
+	void Staging ( MOAITestMgr& testMgr ) {
+
+		testMgr.SetFilter ( MOAI_TEST_UTIL, 0 );
+	}
+
+	//----------------------------------------------------------------//
+	void Test ( MOAITestMgr& testMgr ) {
+
+		testMgr.BeginTest ( "Sprites written for the particle shader" );
+
+		bool ready = this->RunScript (
+			"testDeck = MOAITileDeck2D.new ()\n"
+			"testDeck:setSize ( 2, 2 )\n"
+			"testDeck:setRect ( -8, -4, 8, 4 )\n"
+			"testSystem = MOAIParticleSystem.new ()\n"
+			"testSystem:reserveSprites ( 5 )\n"
+			"testSystem:setDeck ( testDeck )\n"
+		);
+
+		MOAIDeck* deck = ready ? this->GetGlobal < MOAIDeck >( "testDeck" ) : 0;
+		MOAIParticleSystem* system = ready ? this->GetGlobal < MOAIParticleSystem >( "testSystem" ) : 0;
+
+		if ( !( deck && system )) {
+			testMgr.Failure ( "Setup", "couldn't create the deck and particle system" );
+			testMgr.EndTest ( false );
+			return;
+		}
+
+		AKUParticleSprite sprites [ TOTAL_SPRITES ];
+
+		for ( u32 i = 0; i < TOTAL_SPRITES; ++i ) {
+
+			AKUParticleSprite& sprite = sprites [ i ];
+
+			sprite.mXLoc	= ( float )i * 10.0f;
+			sprite.mYLoc	= ( float )i * -5.0f;
+			sprite.mZRot	= ( float )i * 35.0f;
+			sprite.mXScl	= 1.0f + (( float )i * 0.5f );
+			sprite.mYScl	= 2.0f - (( float )i * 0.25f );
+			sprite.mRed		= ( float )i / ( float )TOTAL_SPRITES;
+			sprite.mGreen	= 0.5f;
+			sprite.mBlue	= 1.0f - sprite.mRed;
+			sprite.mAlpha	= 1.0f;
+			sprite.mGfxID	= ( i == HIDDEN_SPRITE ) ? 0 : ( int )( i % 4 ) + 1;
+
+			system->PushSprite ( sprite );
+		}
+
+		MOAIParticleVertex whole [ MAX_SPRITES * 4 ];
+		MOAIParticleVertex split [ MAX_SPRITES * 4 ];
+
+		u32 cursor = 0;
+		u32 totalQuads = system->WriteSprites ( whole, cursor, MAX_SPRITES );
+		bool pass = ( totalQuads == TOTAL_QUADS ) && ( cursor == MAX_SPRITES );
+
+		u32 quad = 0;
+		for ( u32 i = TOTAL_SPRITES - MAX_SPRITES; pass && ( i < TOTAL_SPRITES ); ++i ) {
+			if ( i == HIDDEN_SPRITE ) continue;
+			pass = this->CheckQuad ( *deck, sprites [ i ], &whole [ quad++ * 4 ]);
+		}
+
+		// two quads at a time, as when the sprites outnumber the quads one draw call can take
+		u32 splitQuads = 0;
+		for ( cursor = 0; pass && ( cursor < MAX_SPRITES ); ) {
+			splitQuads += system->WriteSprites ( &split [ splitQuads * 4 ], cursor, 2 );
+		}
+		pass = pass && ( splitQuads == totalQuads ) && !memcmp ( whole, split, totalQuads * 4 * sizeof ( MOAIParticleVertex ));
+
+		sprintf ( messageBuffer, "%d quads from %d sprites", totalQuads, MAX_SPRITES );
+		testMgr.Comment ( messageBuffer );
+
+		if ( pass ) {
+			testMgr.Success ( "Passed" );
+			testMgr.EndTest ( true );
+		}
+		else {
+			testMgr.Failure ( "Bad vertices", "a sprite the shader would place differently from the per sprite draw, or sprites written out of order, twice or not at all" );
+			testMgr.EndTest ( false );
+		}
+
+		this->RunScript ( "testSystem = nil testDeck = nil collectgarbage ()" );
+	}
+};
+
+#endif
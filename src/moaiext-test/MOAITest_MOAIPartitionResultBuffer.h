@@ -0,0 +1,179 @@
+// Copyright (c) 2010-2011 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#ifndef	MOAITEST_MOAIPARTITIONRESULTBUFFER_H
+#define	MOAITEST_MOAIPARTITIONRESULTBUFFER_H
+
+#include <moaicore/moaicore.h>
+#include <moaiext-test/MOAITest.h>
+#include <moaiext-test/MOAITestKeywords.h>
+#include <moaiext-test/MOAITestMgr.h>
+
+//================================================================//
+// MOAITest_MOAIPartitionResultBuffer
+//================================================================//
+class MOAITest_MOAIPartitionResultBuffer :
+	public MOAITest {
+public:
+
+	TEST_NAME ( "MOAIPartitionResultBuffer" )
+
+	char messageBuffer [ 1024 ];
+	u32 mSeed;
+
+	//----------------------------------------------------------------//
+	u32 Random ( u32 range ) {
+
+		this->mSeed = ( this->mSeed * 1103515245 ) + 12345;
+		return ( this->mSeed >> 16 ) % range;
+	}
+
+	//----------------------------------------------------------------//
+	// fills the buffer with tile sized boxes scattered over an iso map; no two boxes share a tile
+	void BuildMap ( MOAIPartitionResultBuffer& buffer, MOAIProp& prop, u32 totalProps ) {
+
+		u32 mapSize = ( u32 )sqrtf (( float )totalProps * 2.0f ) + 1;
+
+		USLeanArray < bool > tiles;
+		tiles.Init ( mapSize * mapSize );
+		tiles.Fill ( false );
+
+		buffer.Reset ();
+		this->mSeed = totalProps;
+
+		for ( u32 i = 0; i < totalProps; ++i ) {
+
+			u32 tile = this->Random ( mapSize * mapSize );
+			while ( tiles [ tile ]) {
+				tile = ( tile + 1 ) % ( mapSize * mapSize );
+			}
+			tiles [ tile ] = true;
+
+			float x = ( float )( tile % mapSize ) * 32.0f;
+			float y = ( float )( tile / mapSize ) * 32.0f;
+			float height = ( float )( this->Random ( 4 ) + 1 ) * 16.0f;
+
+			USBox bounds;
+			bounds.Init ( x, y + 31.0f, x + 31.0f, y, 0.0f, height );
+
+			USVec3D loc;
+			bounds.GetCenter ( loc );
+
+			buffer.PushResult ( prop, 0, ( int )i, 0, loc, bounds );
+		}
+	}
+
+	//----------------------------------------------------------------//
+	void GetIsoViewProj ( USMatrix4x4& viewProj ) {
+
+		USMatrix4x4 tilt;
+		tilt.RotateX (( float )( -60.0 * D2R ));
+
+		viewProj.RotateZ (( float )( 45.0 * D2R ));
+		viewProj.Append ( tilt );
+	}
+
+	//----------------------------------------------------------------//
+	// checks that every pair of props with overlapping footprints and a definite front/back
+	// relationship is drawn back to front
+	bool IsSorted ( MOAIPartitionResultBuffer& buffer, u32 total, const USMatrix4x4& viewProj ) {
+
+		USLeanArray < USRect > rects;
+		rects.Init ( total );
+
+		for ( u32 i = 0; i < total; ++i ) {
+
+			const USBox& bounds = buffer.GetResultUnsafe ( i )->mBounds;
+
+			for ( u32 j = 0; j < 8; ++j ) {
+
+				USVec3D corner (
+					( j & 0x01 ) ? bounds.mMax.mX : bounds.mMin.mX,
+					( j & 0x02 ) ? bounds.mMax.mY : bounds.mMin.mY,
+					( j & 0x04 ) ? bounds.mMax.mZ : bounds.mMin.mZ
+				);
+				viewProj.Project ( corner );
+
+				if ( j ) {
+					rects [ i ].Grow ( corner );
+				}
+				else {
+					rects [ i ].Init ( corner );
+				}
+			}
+		}
+
+		for ( u32 i = 0; i < total; ++i ) {
+
+			const USBox& back = buffer.GetResultUnsafe ( i )->mBounds;
+
+			for ( u32 j = i + 1; j < total; ++j ) {
+
+				if ( !rects [ i ].OverlapWithoutEdges ( rects [ j ])) continue;
+
+				const USBox& front = buffer.GetResultUnsafe ( j )->mBounds;
+
+				bool inFront = (( back.mMax.mX < front.mMin.mX ) || ( back.mMax.mY < front.mMin.mY ) || ( back.mMax.mZ < front.mMin.mZ ));
+				bool behind = (( front.mMax.mX < back.mMin.mX ) || ( front.mMax.mY < back.mMin.mY ) || ( front.mMax.mZ < back.mMin.mZ ));
+
+				if ( behind && !inFront ) return false;
+			}
+		}
+		return true;
+	}
+
+	//----------------------------------------------------------------//
+	void Staging ( MOAITestMgr& testMgr ) {
+
+		testMgr.SetFilter ( MOAI_TEST_PERFORMANCE, 0 );
+	}
+
+	//----------------------------------------------------------------//
+	void Test ( MOAITestMgr& testMgr ) {
+
+		static const u32 TOTAL_SIZES = 3;
+		static const u32 sizes [ TOTAL_SIZES ] = { 500, 5000, 50000 };
+
+		MOAIProp* prop = new MOAIProp ();
+		MOAIPartitionResultBuffer buffer;
+
+		USMatrix4x4 viewProj;
+		this->GetIsoViewProj ( viewProj );
+
+		for ( u32 i = 0; i < TOTAL_SIZES; ++i ) {
+
+			u32 totalProps = sizes [ i ];
+
+			sprintf ( messageBuffer, "Iso sort %d props", totalProps );
+			testMgr.BeginTest ( messageBuffer );
+
+			this->BuildMap ( buffer, *prop, totalProps );
+			double t0 = USDeviceTime::GetTimeInSeconds ();
+			buffer.Sort ( MOAIPartitionResultBuffer::SORT_ISO, &viewProj );
+			double isoTime = USDeviceTime::GetTimeInSeconds () - t0;
+
+			this->BuildMap ( buffer, *prop, totalProps );
+			t0 = USDeviceTime::GetTimeInSeconds ();
+			u32 total = buffer.Sort ( MOAIPartitionResultBuffer::SORT_ISO_GRAPH, &viewProj );
+			double graphTime = USDeviceTime::GetTimeInSeconds () - t0;
+
+			sprintf ( messageBuffer, "SORT_ISO %.3fms, SORT_ISO_GRAPH %.3fms", isoTime * 1000.0, graphTime * 1000.0 );
+			testMgr.Comment ( messageBuffer );
+
+			// the exhaustive check is quadratic; skip it for the largest map
+			if (( total == totalProps ) && (( totalProps > 5000 ) || this->IsSorted ( buffer, total, viewProj ))) {
+				testMgr.Success ( "Passed" );
+				testMgr.EndTest ( true );
+			}
+			else {
+				testMgr.Failure ( "Bad order", "SORT_ISO_GRAPH drew a prop in front of a prop it is behind" );
+				testMgr.EndTest ( false );
+			}
+		}
+
+		buffer.Clear ();
+		delete prop;
+	}
+};
+
+#endif
@@ -0,0 +1,228 @@
+// Copyright (c) 2010-2011 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#ifndef	MOAITEST_MOAITEXTUREATLAS_H
+#define	MOAITEST_MOAITEXTUREATLAS_H
+
+#include <moaicore/moaicore.h>
+#include <moaiext-test/MOAITest.h>
+#include <moaiext-test/MOAITestKeywords.h>
+#include <moaiext-test/MOAITestMgr.h>
+
+#include <moaicore/MOAIGridMesh.h>
+
+//================================================================//
+// MOAITest_MOAITextureAtlas
+//================================================================//
+class MOAITest_MOAITextureAtlas :
+	public MOAITest {
+public:
+
+	TEST_NAME ( "MOAITextureAtlas" )
+
+	static const u32 GRID_SIZE = 2;
+
+	char messageBuffer [ 1024 ];
+
+	//----------------------------------------------------------------//
+	u32 GetPageCount () {
+
+		MOAILuaStateHandle state = MOAILuaRuntime::Get ().State ();
+
+		lua_getglobal ( state, "testAtlas" );
+		lua_getfield ( state, -1, "getPageCount" );
+		lua_pushvalue ( state, -2 );
+		u32 count = ( state.DebugCall ( 1, 1 ) == 0 ) ? state.GetValue < u32 >( -1, 0 ) : 0;
+		state.Pop ( 2 );
+		return count;
+	}
+
+	//----------------------------------------------------------------//
+	void Staging ( MOAITestMgr& testMgr ) {
+
+		testMgr.SetFilter ( MOAI_TEST_UTIL, 0 );
+	}
+
+	//----------------------------------------------------------------//
+	void Test ( MOAITestMgr& testMgr ) {
+
+		this->TestInsertAndFree ( testMgr );
+		this->TestRemap ( testMgr );
+		this->TestReject ( testMgr );
+
+		this->RunScript (
+			"testAtlas = nil testRegions = nil testRegion = nil testDeck = nil testGrid = nil\n"
+			"testTooBig = nil testRejected = nil\n"
+			"collectgarbage ()\n"
+		);
+	}
+
+	//----------------------------------------------------------------//
+	void TestInsertAndFree ( MOAITestMgr& testMgr ) {
+
+		testMgr.BeginTest ( "Insert and free" );
+
+		// 64 x 64 pages hold four 30 x 30 images once they're padded out to 32 x 32
+
+		bool ready = this->RunScript (
+			"testAtlas = MOAITextureAtlas.new ()\n"
+			"testAtlas:setPageSize ( 64 )\n"
+			"local image = MOAIImage.new ()\n"
+			"image:init ( 30, 30 )\n"
+			"testRegions = {}\n"
+			"for i = 1, 4 do\n"
+			"	testRegions [ i ] = testAtlas:insert ( image )\n"
+			"end\n"
+			"local big = MOAIImage.new ()\n"
+			"big:init ( 63, 8 )\n"
+			"testTooBig = testAtlas:insert ( big ) == nil\n"
+		);
+
+		if ( !ready ) {
+			testMgr.Failure ( "Setup", "couldn't create the atlas" );
+			testMgr.EndTest ( false );
+			return;
+		}
+
+		MOAILuaStateHandle state = MOAILuaRuntime::Get ().State ();
+
+		lua_getglobal ( state, "testTooBig" );
+		bool tooBig = state.GetValue < bool >( -1, false );
+		state.Pop ( 1 );
+
+		u32 fullPage = this->GetPageCount ();
+
+		// the third region's slot should be the one handed out next
+		lua_getglobal ( state, "testRegions" );
+		lua_rawgeti ( state, -1, 3 );
+		MOAITextureAtlasRegion* freed = state.GetLuaObject < MOAITextureAtlasRegion >( -1, false );
+		USRect freedRect = freed ? freed->GetUVRect () : USRect ();
+		state.Pop ( 2 );
+
+		this->RunScript (
+			"testRegions [ 3 ] = nil\n"
+			"collectgarbage ()\n"
+			"collectgarbage ()\n"
+			"local image = MOAIImage.new ()\n"
+			"image:init ( 30, 30 )\n"
+			"testRegion = testAtlas:insert ( image )\n"
+		);
+
+		MOAITextureAtlasRegion* reused = this->GetGlobal < MOAITextureAtlasRegion >( "testRegion" );
+		u32 afterReuse = this->GetPageCount ();
+
+		bool sameSlot = freed && reused &&
+			( freedRect.mXMin == reused->GetUVRect ().mXMin ) &&
+			( freedRect.mYMin == reused->GetUVRect ().mYMin ) &&
+			( freedRect.mXMax == reused->GetUVRect ().mXMax ) &&
+			( freedRect.mYMax == reused->GetUVRect ().mYMax );
+
+		this->RunScript (
+			"local image = MOAIImage.new ()\n"
+			"image:init ( 30, 30 )\n"
+			"testRegions [ 5 ] = testAtlas:insert ( image )\n"
+		);
+		u32 overflow = this->GetPageCount ();
+
+		sprintf ( messageBuffer, "pages: %d full, %d after reuse, %d after overflow", fullPage, afterReuse, overflow );
+		testMgr.Comment ( messageBuffer );
+
+		if ( tooBig && sameSlot && ( fullPage == 1 ) && ( afterReuse == 1 ) && ( overflow == 2 )) {
+			testMgr.Success ( "Passed" );
+			testMgr.EndTest ( true );
+		}
+		else {
+			testMgr.Failure ( "Bad packing", "a freed slot wasn't reused, a page was started too soon or too late, or an oversized image was packed" );
+			testMgr.EndTest ( false );
+		}
+	}
+
+	//----------------------------------------------------------------//
+	// the same grid drawn from a whole texture and from a region: every UV should land at the same spot inside the region
+	void TestRemap ( MOAITestMgr& testMgr ) {
+
+		testMgr.BeginTest ( "Tile UVs are mapped into the region" );
+
+		bool ready = this->RunScript (
+			"testGrid = MOAIGrid.new ()\n"
+			"testGrid:initRectGrid ( 2, 2, 16, 16 )\n"
+			"testGrid:setRow ( 1, 1, 2 )\n"
+			"testGrid:setRow ( 2, 3, 4 )\n"
+			"testDeck = MOAITileDeck2D.new ()\n"
+			"testDeck:setSize ( 2, 2 )\n"
+		);
+
+		MOAIGrid* grid = ready ? this->GetGlobal < MOAIGrid >( "testGrid" ) : 0;
+		MOAITileDeck2D* deck = ready ? this->GetGlobal < MOAITileDeck2D >( "testDeck" ) : 0;
+		MOAITextureAtlasRegion* region = this->GetGlobal < MOAITextureAtlasRegion >( "testRegion" );
+
+		if ( !( grid && deck && region )) {
+			testMgr.Failure ( "Setup", "couldn't create the grid, deck or region" );
+			testMgr.EndTest ( false );
+			return;
+		}
+
+		static const u32 TOTAL_VERTS = GRID_SIZE * GRID_SIZE * 4;
+		MOAIQuadVertex plain [ TOTAL_VERTS ];
+		MOAIQuadVertex mapped [ TOTAL_VERTS ];
+
+		u32 plainQuads = MOAIGridMesh ( *grid, *deck ).WriteChunk ( 0, 0, plain );
+
+		this->RunScript ( "testDeck:setTexture ( testRegion )" );
+		u32 mappedQuads = MOAIGridMesh ( *grid, *deck ).WriteChunk ( 0, 0, mapped );
+
+		const USRect& rect = region->GetUVRect ();
+		float uSize = rect.mXMax - rect.mXMin;
+		float vSize = rect.mYMax - rect.mYMin;
+
+		bool pass = ( plainQuads == ( GRID_SIZE * GRID_SIZE )) && ( mappedQuads == plainQuads );
+
+		for ( u32 i = 0; pass && ( i < TOTAL_VERTS ); ++i ) {
+
+			float uError = rect.mXMin + ( plain [ i ].mU * uSize ) - mapped [ i ].mU;
+			float vError = rect.mYMin + ( plain [ i ].mV * vSize ) - mapped [ i ].mV;
+
+			pass = pass && ( ABS ( uError ) < 0.0001f ) && ( ABS ( vError ) < 0.0001f );
+			pass = pass && ( mapped [ i ].mU >= rect.mXMin ) && ( mapped [ i ].mU <= rect.mXMax );
+			pass = pass && ( mapped [ i ].mV >= rect.mYMin ) && ( mapped [ i ].mV <= rect.mYMax );
+		}
+
+		if ( pass ) {
+			testMgr.Success ( "Passed" );
+			testMgr.EndTest ( true );
+		}
+		else {
+			testMgr.Failure ( "Bad UVs", "a tile's UVs weren't mapped into the region, or fell outside it" );
+			testMgr.EndTest ( false );
+		}
+	}
+
+	//----------------------------------------------------------------//
+	void TestReject ( MOAITestMgr& testMgr ) {
+
+		testMgr.BeginTest ( "Decks that can't remap UVs refuse regions" );
+
+		bool ready = this->RunScript (
+			"testDeck = MOAIScriptDeck.new ()\n"
+			"testRejected = testDeck:setTexture ( testRegion ) == nil\n"
+		);
+
+		MOAILuaStateHandle state = MOAILuaRuntime::Get ().State ();
+		lua_getglobal ( state, "testRejected" );
+		bool rejected = state.GetValue < bool >( -1, false );
+		state.Pop ( 1 );
+
+		MOAIScriptDeck* deck = ready ? this->GetGlobal < MOAIScriptDeck >( "testDeck" ) : 0;
+
+		if ( deck && rejected && !deck->GetTexture ()) {
+			testMgr.Success ( "Passed" );
+			testMgr.EndTest ( true );
+		}
+		else {
+			testMgr.Failure ( "Bad deck", "a deck that draws with its own UVs took a region and would draw the whole page" );
+			testMgr.EndTest ( false );
+		}
+	}
+};
+
+#endif
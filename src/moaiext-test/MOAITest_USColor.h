@@ -0,0 +1,425 @@
+// Copyright (c) 2010-2011 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#ifndef	MOAITEST_USCOLOR_H
+#define	MOAITEST_USCOLOR_H
+
+#include <moaicore/moaicore.h>
+#include <moaiext-test/MOAITest.h>
+#include <moaiext-test/MOAITestKeywords.h>
+#include <moaiext-test/MOAITestMgr.h>
+
+//================================================================//
+// MOAITest_USColor
+//================================================================//
+class MOAITest_USColor :
+	public MOAITest {
+public:
+
+	TEST_NAME ( "USColor" )
+
+	// every 16 bit pixel
+	static const u32 TOTAL_PIXELS = 0x10000;
+
+	// long enough for several vector blocks and a tail for the scalar loop
+	static const u32 ROW_SIZE	= 67;
+	static const u32 ROW_BYTES	= ROW_SIZE * 4 * 2;
+
+	static const u32 TOTAL_FORMATS = 6;
+
+	// CopyRect scales a 4 x 4 image with a color per column up to 16 x 16
+	static const u32 SRC_SIZE	= 4;
+	static const u32 DEST_SIZE	= 16;
+
+	char messageBuffer [ 1024 ];
+
+	//----------------------------------------------------------------//
+	// every row should come out the same, with the given color in the given column
+	bool CheckCopy ( const MOAIImage& dest, u32 x, u32 color ) {
+
+		for ( u32 y = 0; y < DEST_SIZE; ++y ) {
+
+			if ( dest.GetColor ( x, y ) != color ) return false;
+
+			for ( u32 i = 0; i < DEST_SIZE; ++i ) {
+				if ( dest.GetColor ( i, y ) != dest.GetColor ( i, 0 )) return false;
+			}
+		}
+		return true;
+	}
+
+	//----------------------------------------------------------------//
+	// same bytes every run
+	static void FillRow ( USLeanArray < u8 >& row, u32 seed ) {
+
+		row.Init ( ROW_BYTES );
+		for ( u32 i = 0; i < ROW_BYTES; ++i ) {
+			seed = ( seed * 1103515245 ) + 12345;
+			row [ i ] = ( u8 )( seed >> 0x10 );
+		}
+	}
+
+	//----------------------------------------------------------------//
+	static USColor::Format GetFormat ( u32 i ) {
+
+		static const USColor::Format formats [ TOTAL_FORMATS ] = {
+			USColor::A_8,
+			USColor::RGB_888,
+			USColor::RGB_565,
+			USColor::RGBA_5551,
+			USColor::RGBA_4444,
+			USColor::RGBA_8888,
+		};
+		return formats [ i ];
+	}
+
+	//----------------------------------------------------------------//
+	static u32 GetColumnColor ( u32 x ) {
+
+		static const u32 colors [ SRC_SIZE ] = { 0xff000000, 0xff404040, 0xff808080, 0xffffffff };
+		return colors [ x ];
+	}
+
+	//----------------------------------------------------------------//
+	void InitColumns ( MOAIImage& image, USPixel::Format pixelFmt ) {
+
+		image.Init ( SRC_SIZE, SRC_SIZE, USColor::RGBA_8888, pixelFmt );
+
+		for ( u32 x = 0; x < SRC_SIZE; ++x ) {
+
+			if ( pixelFmt == USPixel::TRUECOLOR ) {
+				for ( u32 y = 0; y < SRC_SIZE; ++y ) {
+					image.SetColor ( x, y, GetColumnColor ( x ));
+				}
+			}
+			else {
+				image.SetPaletteColor ( x, GetColumnColor ( x ));
+				for ( u32 y = 0; y < SRC_SIZE; ++y ) {
+					image.SetPixel ( x, y, x );
+				}
+			}
+		}
+	}
+
+	//----------------------------------------------------------------//
+	// every channel of the blend has to stay between the channels it blends
+	bool InRange ( u32 c0, u32 c1, u32 result ) {
+
+		for ( u32 shift = 0; shift < 32; shift += 8 ) {
+
+			u32 ch0 = ( c0 >> shift ) & 0xFF;
+			u32 ch1 = ( c1 >> shift ) & 0xFF;
+			u32 ch = ( result >> shift ) & 0xFF;
+
+			if (( ch < MIN ( ch0, ch1 )) || ( ch > MAX ( ch0, ch1 ))) return false;
+		}
+		return true;
+	}
+
+	//----------------------------------------------------------------//
+	// decodes every pixel of a 16 bit format to RGBA and back, a row at a time and one at a time
+	bool RoundTrips ( USColor::Format format, u32& failed ) {
+
+		USLeanArray < u16 > pixels;
+		USLeanArray < u32 > colors;
+		USLeanArray < u16 > encoded;
+
+		pixels.Init ( TOTAL_PIXELS );
+		colors.Init ( TOTAL_PIXELS );
+		encoded.Init ( TOTAL_PIXELS );
+
+		for ( u32 i = 0; i < TOTAL_PIXELS; ++i ) {
+			pixels [ i ] = ( u16 )i;
+		}
+
+		USColor::Convert ( colors.Data (), USColor::RGBA_8888, pixels.Data (), format, TOTAL_PIXELS );
+		USColor::Convert ( encoded.Data (), format, colors.Data (), USColor::RGBA_8888, TOTAL_PIXELS );
+
+		for ( u32 i = 0; i < TOTAL_PIXELS; ++i ) {
+
+			u32 color = USColor::ConvertToRGBA ( pixels [ i ], format );
+
+			if (( encoded [ i ] != pixels [ i ]) || ( USColor::ConvertFromRGBA ( color, format ) != pixels [ i ])) {
+				failed = i;
+				return false;
+			}
+		}
+		return true;
+	}
+
+	//----------------------------------------------------------------//
+	void Staging ( MOAITestMgr& testMgr ) {
+
+		testMgr.SetFilter ( MOAI_TEST_UTIL, 0 );
+	}
+
+	//----------------------------------------------------------------//
+	void Test ( MOAITestMgr& testMgr ) {
+
+		this->TestRowKernels ( testMgr );
+		this->TestRoundTrip565 ( testMgr );
+		this->TestRoundTrip4444 ( testMgr );
+		this->TestLerpFixed ( testMgr );
+		this->TestCopyRect ( testMgr );
+		this->TestConvertColorsInPlace ( testMgr );
+	}
+
+	//----------------------------------------------------------------//
+	void TestConvertColorsInPlace ( MOAITestMgr& testMgr ) {
+
+		testMgr.BeginTest ( "ConvertColors in place" );
+
+		MOAIImage image;
+		this->InitColumns ( image, USPixel::TRUECOLOR );
+
+		MOAIImage expected;
+		expected.ConvertColors ( image, USColor::RGB_565 );
+
+		image.ConvertColors ( image, USColor::RGB_565 );
+
+		bool pass = ( image.GetColorFormat () == USColor::RGB_565 ) && image.Compare ( expected );
+
+		for ( u32 y = 0; pass && ( y < SRC_SIZE ); ++y ) {
+			for ( u32 x = 0; pass && ( x < SRC_SIZE ); ++x ) {
+				pass = ( image.GetColor ( x, y ) == expected.GetColor ( x, y ));
+			}
+		}
+
+		if ( pass ) {
+			testMgr.Success ( "Passed" );
+			testMgr.EndTest ( true );
+		}
+		else {
+			testMgr.Failure ( "Bad colors", "converting an image onto itself gave different colors than converting it into a new image" );
+			testMgr.EndTest ( false );
+		}
+	}
+
+	//----------------------------------------------------------------//
+	// upscaling samples past the last row and column, and flipping starts on the source's far
+	// edge; both have to clamp to the source image, however big the dest image is
+	void TestCopyRect ( MOAITestMgr& testMgr ) {
+
+		testMgr.BeginTest ( "CopyRect clamps to the source image" );
+
+		static const u32 TOTAL_FORMATS = 2;
+		static const USPixel::Format formats [ TOTAL_FORMATS ] = { USPixel::TRUECOLOR, USPixel::INDEX_8 };
+
+		USIntRect srcRect;
+		srcRect.Init ( 0, 0, SRC_SIZE, SRC_SIZE );
+
+		USIntRect destRect;
+		destRect.Init ( 0, 0, DEST_SIZE, DEST_SIZE );
+
+		USIntRect flippedRect;
+		flippedRect.Init ( DEST_SIZE, 0, 0, DEST_SIZE );
+
+		bool pass = true;
+
+		for ( u32 i = 0; pass && ( i < TOTAL_FORMATS ); ++i ) {
+
+			MOAIImage src;
+			this->InitColumns ( src, formats [ i ]);
+
+			MOAIImage dest;
+			dest.Init ( DEST_SIZE, DEST_SIZE, USColor::RGBA_8888, USPixel::TRUECOLOR );
+
+			dest.CopyRect ( src, srcRect, destRect, MOAIImage::FILTER_LINEAR );
+			pass = this->CheckCopy ( dest, 0, GetColumnColor ( 0 ));
+			pass = pass && this->CheckCopy ( dest, DEST_SIZE - 1, GetColumnColor ( SRC_SIZE - 1 ));
+
+			dest.CopyRect ( src, srcRect, flippedRect, MOAIImage::FILTER_LINEAR );
+			pass = pass && this->CheckCopy ( dest, 0, GetColumnColor ( SRC_SIZE - 1 ));
+
+			if ( !pass ) {
+				sprintf ( messageBuffer, "%s source: an edge column or row blended in a pixel from outside the source", formats [ i ] == USPixel::TRUECOLOR ? "true color" : "indexed" );
+			}
+		}
+
+		if ( pass ) {
+			testMgr.Success ( "Passed" );
+			testMgr.EndTest ( true );
+		}
+		else {
+			testMgr.Failure ( "Bad resample", messageBuffer );
+			testMgr.EndTest ( false );
+		}
+	}
+
+	//----------------------------------------------------------------//
+	void TestLerpFixed ( MOAITestMgr& testMgr ) {
+
+		testMgr.BeginTest ( "LerpFixed with falling channels" );
+
+		// each pair has channels rising and falling side by side
+		static const u32 TOTAL_PAIRS = 4;
+		static const u32 pairs [ TOTAL_PAIRS ][ 2 ] = {
+			{ 0x000000ff, 0x0000ff00 },
+			{ 0xff00ff00, 0x00ff00ff },
+			{ 0x80402010, 0x10204080 },
+			{ 0x01ff01ff, 0xff01ff01 },
+		};
+
+		// red falling from 0xff to 0 can't borrow from green rising from 0 to 0xff
+		bool pass = ( USColor::LerpFixed ( 0x000000ff, 0x0000ff00, 128 ) == 0x00007f7f );
+		sprintf ( messageBuffer, "a falling channel borrowed from the one above it" );
+
+		for ( u32 i = 0; pass && ( i < TOTAL_PAIRS ); ++i ) {
+			for ( u32 t = 0; pass && ( t < 256 ); ++t ) {
+
+				u32 c0 = pairs [ i ][ 0 ];
+				u32 c1 = pairs [ i ][ 1 ];
+
+				pass = this->InRange ( c0, c1, USColor::LerpFixed ( c0, c1, ( u8 )t ));
+				pass = pass && this->InRange ( c0, c1, USColor::LerpFixed ( c1, c0, ( u8 )t ));
+
+				if ( !pass ) {
+					sprintf ( messageBuffer, "blending 0x%08x and 0x%08x at %d left a channel's range", c0, c1, t );
+				}
+			}
+		}
+
+		if ( pass ) {
+			testMgr.Success ( "Passed" );
+			testMgr.EndTest ( true );
+		}
+		else {
+			testMgr.Failure ( "Bad blend", messageBuffer );
+			testMgr.EndTest ( false );
+		}
+	}
+
+	//----------------------------------------------------------------//
+	// a whole row goes through the vector kernels where there are any; a pixel at a
+	// time only ever runs the scalar loop, so the two have to match bit for bit
+	void TestRowKernels ( MOAITestMgr& testMgr ) {
+
+		testMgr.BeginTest ( "Row kernels match the scalar loops" );
+
+		USLeanArray < u8 > src0;
+		USLeanArray < u8 > src1;
+		USLeanArray < u8 > row;
+		USLeanArray < u8 > pixels;
+
+		FillRow ( src0, 1 );
+		FillRow ( src1, 2 );
+		row.Init ( ROW_BYTES );
+		pixels.Init ( ROW_BYTES );
+
+		bool pass = true;
+
+		for ( u32 i = 0; pass && ( i < TOTAL_FORMATS ); ++i ) {
+
+			USColor::Format srcFmt = GetFormat ( i );
+			u32 srcSize = USColor::GetSize ( srcFmt );
+
+			for ( u32 j = 0; pass && ( j < TOTAL_FORMATS ); ++j ) {
+
+				USColor::Format destFmt = GetFormat ( j );
+				u32 destSize = USColor::GetSize ( destFmt );
+
+				memset ( row, 0, ROW_BYTES );
+				memset ( pixels, 0, ROW_BYTES );
+
+				USColor::Convert ( row, destFmt, src0, srcFmt, ROW_SIZE );
+				for ( u32 k = 0; k < ROW_SIZE; ++k ) {
+					USColor::Convert ( &pixels [ k * destSize ], destFmt, &src0 [ k * srcSize ], srcFmt, 1 );
+				}
+
+				pass = ( memcmp ( row, pixels, ROW_SIZE * destSize ) == 0 );
+				if ( !pass ) {
+					sprintf ( messageBuffer, "converting format %d to format %d", srcFmt, destFmt );
+				}
+			}
+
+			if ( !pass ) break;
+
+			// each dest pixel reduces two pixels from each source row
+			USColor::MipReduceRow ( row, src0, src1, srcFmt, ROW_SIZE );
+			for ( u32 k = 0; k < ROW_SIZE; ++k ) {
+				USColor::MipReduceRow ( &pixels [ k * srcSize ], &src0 [ k * srcSize * 2 ], &src1 [ k * srcSize * 2 ], srcFmt, 1 );
+			}
+
+			pass = ( memcmp ( row, pixels, ROW_SIZE * srcSize ) == 0 );
+			if ( !pass ) {
+				sprintf ( messageBuffer, "mip reducing format %d", srcFmt );
+				break;
+			}
+
+			memcpy ( row, src0, ROW_BYTES );
+			memcpy ( pixels, src0, ROW_BYTES );
+
+			USColor::PremultiplyAlpha ( row, srcFmt, ROW_SIZE );
+			for ( u32 k = 0; k < ROW_SIZE; ++k ) {
+				USColor::PremultiplyAlpha ( &pixels [ k * srcSize ], srcFmt, 1 );
+			}
+
+			pass = ( memcmp ( row, pixels, ROW_SIZE * srcSize ) == 0 );
+			if ( !pass ) {
+				sprintf ( messageBuffer, "premultiplying format %d", srcFmt );
+			}
+		}
+
+		if ( pass ) {
+			testMgr.Success ( "Passed" );
+			testMgr.EndTest ( true );
+		}
+		else {
+			testMgr.Failure ( "Rows differ", messageBuffer );
+			testMgr.EndTest ( false );
+		}
+	}
+
+	//----------------------------------------------------------------//
+	void TestRoundTrip565 ( MOAITestMgr& testMgr ) {
+
+		testMgr.BeginTest ( "RGB_565 round trip" );
+
+		u32 failed = 0;
+		bool roundTrips = this->RoundTrips ( USColor::RGB_565, failed );
+
+		// pure red, green and blue land in the right channels, with opaque alpha
+		bool channels =
+			( USColor::ConvertToRGBA ( 0xF800, USColor::RGB_565 ) == 0xff0000f8 ) &&
+			( USColor::ConvertToRGBA ( 0x07E0, USColor::RGB_565 ) == 0xff00fc00 ) &&
+			( USColor::ConvertToRGBA ( 0x001F, USColor::RGB_565 ) == 0xfff80000 );
+
+		if ( roundTrips && channels ) {
+			testMgr.Success ( "Passed" );
+			testMgr.EndTest ( true );
+		}
+		else {
+			sprintf ( messageBuffer, "pixel 0x%04x didn't survive a round trip, or a channel decoded to the wrong place", failed );
+			testMgr.Failure ( "Bad decode", messageBuffer );
+			testMgr.EndTest ( false );
+		}
+	}
+
+	//----------------------------------------------------------------//
+	void TestRoundTrip4444 ( MOAITestMgr& testMgr ) {
+
+		testMgr.BeginTest ( "RGBA_4444 round trip" );
+
+		u32 failed = 0;
+		bool roundTrips = this->RoundTrips ( USColor::RGBA_4444, failed );
+
+		// red is in the high nibble and alpha in the low one
+		bool channels =
+			( USColor::ConvertToRGBA ( 0xF000, USColor::RGBA_4444 ) == 0x000000f0 ) &&
+			( USColor::ConvertToRGBA ( 0x0F00, USColor::RGBA_4444 ) == 0x0000f000 ) &&
+			( USColor::ConvertToRGBA ( 0x00F0, USColor::RGBA_4444 ) == 0x00f00000 ) &&
+			( USColor::ConvertToRGBA ( 0x000F, USColor::RGBA_4444 ) == 0xf0000000 );
+
+		if ( roundTrips && channels ) {
+			testMgr.Success ( "Passed" );
+			testMgr.EndTest ( true );
+		}
+		else {
+			sprintf ( messageBuffer, "pixel 0x%04x didn't survive a round trip, or a channel decoded to the wrong place", failed );
+			testMgr.Failure ( "Bad decode", messageBuffer );
+			testMgr.EndTest ( false );
+		}
+	}
+};
+
+#endif
@@ -0,0 +1,182 @@
+// Copyright (c) 2010-2011 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#ifndef	MOAITEST_USCULL_H
+#define	MOAITEST_USCULL_H
+
+#include <moaicore/moaicore.h>
+#include <moaiext-test/MOAITest.h>
+#include <moaiext-test/MOAITestKeywords.h>
+#include <moaiext-test/MOAITestMgr.h>
+
+#include <uslscore/USCull.h>
+
+//================================================================//
+// MOAITest_USCull
+//================================================================//
+class MOAITest_USCull :
+	public MOAITest {
+public:
+
+	TEST_NAME ( "USCull" )
+
+	static const u32 TOTAL_BOXES = 100000;
+	static const u32 TOTAL_PASSES = 20;
+
+	char messageBuffer [ 1024 ];
+	u32 mSeed;
+
+	USLeanArray < USBox >	mBoxes;
+	USLeanArray < float >	mBounds [ 6 ];
+	USLeanArray < u32 >		mResults;
+	USCullBoxes				mCullBoxes;
+
+	//----------------------------------------------------------------//
+	float Random ( u32 range ) {
+
+		this->mSeed = ( this->mSeed * 1103515245 ) + 12345;
+		return ( float )(( this->mSeed >> 16 ) % range );
+	}
+
+	//----------------------------------------------------------------//
+	// scatters small boxes over a 2000 x 2000 x 200 volume, both as USBoxes and as arrays
+	void BuildBoxes () {
+
+		this->mSeed = TOTAL_BOXES;
+		this->mBoxes.Init ( TOTAL_BOXES );
+		this->mResults.Init ( TOTAL_BOXES );
+
+		for ( u32 i = 0; i < 6; ++i ) {
+			this->mBounds [ i ].Init ( TOTAL_BOXES );
+		}
+
+		for ( u32 i = 0; i < TOTAL_BOXES; ++i ) {
+
+			float x = this->Random ( 2000 ) - 1000.0f;
+			float y = this->Random ( 2000 ) - 1000.0f;
+			float z = this->Random ( 200 ) - 100.0f;
+
+			USBox& box = this->mBoxes [ i ];
+			box.mMin.Init ( x, y, z );
+			box.mMax.Init ( x + this->Random ( 20 ), y + this->Random ( 20 ), z + this->Random ( 20 ));
+
+			this->mBounds [ 0 ][ i ] = box.mMin.mX;
+			this->mBounds [ 1 ][ i ] = box.mMin.mY;
+			this->mBounds [ 2 ][ i ] = box.mMin.mZ;
+			this->mBounds [ 3 ][ i ] = box.mMax.mX;
+			this->mBounds [ 4 ][ i ] = box.mMax.mY;
+			this->mBounds [ 5 ][ i ] = box.mMax.mZ;
+		}
+
+		this->mCullBoxes.mXMin = this->mBounds [ 0 ];
+		this->mCullBoxes.mYMin = this->mBounds [ 1 ];
+		this->mCullBoxes.mZMin = this->mBounds [ 2 ];
+		this->mCullBoxes.mXMax = this->mBounds [ 3 ];
+		this->mCullBoxes.mYMax = this->mBounds [ 4 ];
+		this->mCullBoxes.mZMax = this->mBounds [ 5 ];
+	}
+
+	//----------------------------------------------------------------//
+	// the old path: one USFrustum::Cull per box
+	u32 CullEach ( const USFrustum& frustum ) {
+
+		u32 count = 0;
+		for ( u32 i = 0; i < TOTAL_BOXES; ++i ) {
+			if ( !frustum.Cull ( this->mBoxes [ i ])) {
+				this->mResults [ count++ ] = i;
+			}
+		}
+		return count;
+	}
+
+	//----------------------------------------------------------------//
+	void Staging ( MOAITestMgr& testMgr ) {
+
+		testMgr.SetFilter ( MOAI_TEST_PERFORMANCE, 0 );
+	}
+
+	//----------------------------------------------------------------//
+	void Test ( MOAITestMgr& testMgr ) {
+
+		this->BuildBoxes ();
+
+		// a rotated box shaped view volume over part of the scene
+		USMatrix4x4 invViewProj;
+		invViewProj.Scale ( 500.0f, 300.0f, 100.0f );
+
+		USMatrix4x4 mtx;
+		mtx.RotateZ ( 0.5f );
+		invViewProj.Append ( mtx );
+
+		mtx.Translate ( 100.0f, 0.0f, 0.0f );
+		invViewProj.Append ( mtx );
+
+		USFrustum frustum;
+		frustum.Init ( invViewProj );
+
+		USBox rect;
+		rect.Init ( -200.0f, 200.0f, 200.0f, -200.0f, -50.0f, 50.0f );
+
+		testMgr.BeginTest ( "Frustum cull" );
+
+		u32 expected = this->CullEach ( frustum );
+		u32 scalar = USCull::FrustumScalar ( this->mCullBoxes, 0, TOTAL_BOXES, frustum, this->mResults );
+		u32 vector = USCull::Frustum ( this->mCullBoxes, 0, TOTAL_BOXES, frustum, this->mResults );
+
+		double t0 = USDeviceTime::GetTimeInSeconds ();
+		for ( u32 i = 0; i < TOTAL_PASSES; ++i ) {
+			this->CullEach ( frustum );
+		}
+		double t1 = USDeviceTime::GetTimeInSeconds ();
+		for ( u32 i = 0; i < TOTAL_PASSES; ++i ) {
+			USCull::FrustumScalar ( this->mCullBoxes, 0, TOTAL_BOXES, frustum, this->mResults );
+		}
+		double t2 = USDeviceTime::GetTimeInSeconds ();
+		for ( u32 i = 0; i < TOTAL_PASSES; ++i ) {
+			USCull::Frustum ( this->mCullBoxes, 0, TOTAL_BOXES, frustum, this->mResults );
+		}
+		double t3 = USDeviceTime::GetTimeInSeconds ();
+
+		double boxes = ( double )( TOTAL_BOXES * TOTAL_PASSES );
+
+		sprintf ( messageBuffer, "Boxes culled per microsecond: USFrustum::Cull %.1f, scalar %.1f, %s %.1f",
+			boxes / (( t1 - t0 ) * 1000000.0 ),
+			boxes / (( t2 - t1 ) * 1000000.0 ),
+			USCull::IsVectorized () ? "vector" : "vector (unavailable; scalar)",
+			boxes / (( t3 - t2 ) * 1000000.0 )
+		);
+		testMgr.Comment ( messageBuffer );
+
+		if (( scalar == expected ) && ( vector == expected )) {
+			testMgr.Success ( "Passed" );
+			testMgr.EndTest ( true );
+		}
+		else {
+			sprintf ( messageBuffer, "Visible boxes: USFrustum::Cull %d, scalar %d, vector %d", expected, scalar, vector );
+			testMgr.Failure ( "Bad count", messageBuffer );
+			testMgr.EndTest ( false );
+		}
+
+		testMgr.BeginTest ( "Box cull" );
+
+		expected = 0;
+		for ( u32 i = 0; i < TOTAL_BOXES; ++i ) {
+			expected += this->mBoxes [ i ].Overlap ( rect ) ? 1 : 0;
+		}
+
+		scalar = USCull::BoxScalar ( this->mCullBoxes, 0, TOTAL_BOXES, rect, this->mResults );
+		vector = USCull::Box ( this->mCullBoxes, 0, TOTAL_BOXES, rect, this->mResults );
+
+		if (( scalar == expected ) && ( vector == expected )) {
+			testMgr.Success ( "Passed" );
+			testMgr.EndTest ( true );
+		}
+		else {
+			sprintf ( messageBuffer, "Overlapping boxes: USBox::Overlap %d, scalar %d, vector %d", expected, scalar, vector );
+			testMgr.Failure ( "Bad count", messageBuffer );
+			testMgr.EndTest ( false );
+		}
+	}
+};
+
+#endif
@@ -497,6 +497,30 @@ public:
 	//----------------------------------------------------------------//
 	void ScRoTr	( float scx, float scy, float scz, float rx, float ry, float rz, float tx, float ty, float tz ) {
 
+		// rotation about z only is the common (2D) case; skip the other four trig calls
+		if (( rx == 0.0f ) && ( ry == 0.0f )) {
+		
+			TYPE cz = Cos ( rz );
+			TYPE sz = Sin ( rz );
+		
+			m[C0_R0]	= cz*scx;
+			m[C0_R1]	= sz*scx;
+			m[C0_R2]	= 0;
+
+			m[C1_R0]	= -sz*scy;
+			m[C1_R1]	= cz*scy;
+			m[C1_R2]	= 0;
+
+			m[C2_R0]	= 0;
+			m[C2_R1]	= 0;
+			m[C2_R2]	= scz;
+
+			m[C3_R0]	= tx;
+			m[C3_R1]	= ty;
+			m[C3_R2]	= tz;
+			return;
+		}
+
 		TYPE cx = Cos ( rx );
 		TYPE sx = Sin ( rx );
 		TYPE cy = Cos ( ry );
@@ -0,0 +1,138 @@
+// Copyright (c) 2010-2011 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#include "pch.h"
+#include <uslscore/USAffineBatch.h>
+
+#if defined ( __SSE2__ ) || defined ( _M_X64 ) || ( defined ( _M_IX86_FP ) && ( _M_IX86_FP >= 2 ))
+	#define USAFFINEBATCH_SSE2
+	#include <emmintrin.h>
+#elif defined ( __ARM_NEON__ ) || defined ( __ARM_NEON )
+	#define USAFFINEBATCH_NEON
+	#include <arm_neon.h>
+#endif
+
+//================================================================//
+// local
+//================================================================//
+
+#if defined ( USAFFINEBATCH_SSE2 )
+
+	typedef __m128 USAffineVec;
+
+	//----------------------------------------------------------------//
+	static inline USAffineVec	_add		( USAffineVec a, USAffineVec b )					{ return _mm_add_ps ( a, b ); }
+	static inline USAffineVec	_load		( const float* src )								{ return _mm_loadu_ps ( src ); }
+	static inline USAffineVec	_mul		( USAffineVec a, USAffineVec b )					{ return _mm_mul_ps ( a, b ); }
+	static inline USAffineVec	_mulAdd		( USAffineVec a, USAffineVec b, USAffineVec c )		{ return _mm_add_ps ( c, _mm_mul_ps ( a, b )); }
+	static inline void			_store		( float* dst, USAffineVec v )						{ _mm_storeu_ps ( dst, v ); }
+
+#elif defined ( USAFFINEBATCH_NEON )
+
+	typedef float32x4_t USAffineVec;
+
+	//----------------------------------------------------------------//
+	static inline USAffineVec	_add		( USAffineVec a, USAffineVec b )					{ return vaddq_f32 ( a, b ); }
+	static inline USAffineVec	_load		( const float* src )								{ return vld1q_f32 ( src ); }
+	static inline USAffineVec	_mul		( USAffineVec a, USAffineVec b )					{ return vmulq_f32 ( a, b ); }
+	static inline USAffineVec	_mulAdd		( USAffineVec a, USAffineVec b, USAffineVec c )		{ return vaddq_f32 ( c, vmulq_f32 ( a, b )); }
+	static inline void			_store		( float* dst, USAffineVec v )						{ vst1q_f32 ( dst, v ); }
+
+#endif
+
+//================================================================//
+// USAffineArrays
+//================================================================//
+
+//----------------------------------------------------------------//
+void USAffineArrays::GetMtx ( u32 i, USAffine3D& mtx ) const {
+
+	for ( u32 e = 0; e < USAffine3D::SIZE; ++e ) {
+		mtx.m [ e ] = this->m [ e ][ i ];
+	}
+}
+
+//----------------------------------------------------------------//
+void USAffineArrays::SetMtx ( u32 i, const USAffine3D& mtx ) {
+
+	for ( u32 e = 0; e < USAffine3D::SIZE; ++e ) {
+		this->m [ e ][ i ] = mtx.m [ e ];
+	}
+}
+
+//================================================================//
+// USAffineBatch
+//================================================================//
+
+//----------------------------------------------------------------//
+void USAffineBatch::Append ( USAffineArrays& mtx, const USAffineArrays& parent, u32 base, u32 total ) {
+
+	#if defined ( USAFFINEBATCH_SSE2 ) || defined ( USAFFINEBATCH_NEON )
+
+		u32 i = base;
+		u32 end = base + total;
+
+		// the sums are taken in the same order as USAffine3D::Multiply, so the vector
+		// and scalar paths (and the per-node path) give the same results
+		for ( ; ( i + 4 ) <= end; i += 4 ) {
+
+			USAffineVec l [ USAffine3D::SIZE ];
+			USAffineVec p [ USAffine3D::SIZE ];
+
+			for ( u32 e = 0; e < USAffine3D::SIZE; ++e ) {
+				l [ e ] = _load ( mtx.m [ e ] + i );
+				p [ e ] = _load ( parent.m [ e ] + i );
+			}
+
+			for ( u32 c = 0; c < 4; ++c ) {
+
+				const USAffineVec* col = &l [ c * 3 ];
+
+				for ( u32 r = 0; r < 3; ++r ) {
+
+					USAffineVec v = _mul ( p [ USAffine3D::C0_R0 + r ], col [ 0 ]);
+					v = _mulAdd ( p [ USAffine3D::C1_R0 + r ], col [ 1 ], v );
+					v = _mulAdd ( p [ USAffine3D::C2_R0 + r ], col [ 2 ], v );
+
+					if ( c == 3 ) {
+						v = _add ( v, p [ USAffine3D::C3_R0 + r ]);
+					}
+					_store ( mtx.m [ ( c * 3 ) + r ] + i, v );
+				}
+			}
+		}
+
+		USAffineBatch::AppendScalar ( mtx, parent, i, end - i );
+
+	#else
+		USAffineBatch::AppendScalar ( mtx, parent, base, total );
+	#endif
+}
+
+//----------------------------------------------------------------//
+void USAffineBatch::AppendScalar ( USAffineArrays& mtx, const USAffineArrays& parent, u32 base, u32 total ) {
+
+	u32 end = base + total;
+
+	for ( u32 i = base; i < end; ++i ) {
+
+		USAffine3D local;
+		USAffine3D inherit;
+
+		mtx.GetMtx ( i, local );
+		parent.GetMtx ( i, inherit );
+
+		local.Append ( inherit );
+		mtx.SetMtx ( i, local );
+	}
+}
+
+//----------------------------------------------------------------//
+bool USAffineBatch::IsVectorized () {
+
+	#if defined ( USAFFINEBATCH_SSE2 ) || defined ( USAFFINEBATCH_NEON )
+		return true;
+	#else
+		return false;
+	#endif
+}
@@ -0,0 +1,40 @@
+// Copyright (c) 2010-2011 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#ifndef	USAFFINEBATCH_H
+#define	USAFFINEBATCH_H
+
+#include <uslscore/USAffine3D.h>
+
+//================================================================//
+// USAffineArrays
+//================================================================//
+// A run of affine matrices stored as structure-of-arrays: one array per
+// matrix element (USAffine3D::C0_R0 through C3_R2), all indexed the same way.
+class USAffineArrays {
+public:
+
+	float*	m [ USAffine3D::SIZE ];
+
+	//----------------------------------------------------------------//
+	void	GetMtx		( u32 i, USAffine3D& mtx ) const;
+	void	SetMtx		( u32 i, const USAffine3D& mtx );
+};
+
+//================================================================//
+// USAffineBatch
+//================================================================//
+// Batch affine kernels. Each works on the matrices in [ base, base + total ).
+// Append replaces each matrix in 'mtx' with itself appended by the matching
+// matrix in 'parent', exactly as USAffine3D::Append would. When SSE2 or NEON
+// is available four matrices are done at a time; the scalar versions are
+// always compiled and serve as the fallback.
+namespace USAffineBatch {
+
+	void	Append				( USAffineArrays& mtx, const USAffineArrays& parent, u32 base, u32 total );
+	void	AppendScalar		( USAffineArrays& mtx, const USAffineArrays& parent, u32 base, u32 total );
+	bool	IsVectorized		();
+
+} // namespace USAffineBatch
+
+#endif
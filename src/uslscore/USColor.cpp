@@ -12,6 +12,615 @@
 #define U_MAX 0.436f
 #define V_MAX 0.615f
 
+#if defined ( __SSE2__ ) || defined ( _M_X64 ) || ( defined ( _M_IX86_FP ) && ( _M_IX86_FP >= 2 ))
+	#define USCOLOR_SSE2
+	#include <emmintrin.h>
+#elif defined ( __ARM_NEON__ ) || defined ( __ARM_NEON )
+	#define USCOLOR_NEON
+	#include <arm_neon.h>
+#endif
+
+//================================================================//
+// USColorCodec
+//================================================================//
+// Packs and unpacks one color format, so the row kernels below can be
+// instantiated per format (or pair of formats) instead of switching on the
+// format for every pixel.
+template < USColor::Format FORMAT >
+class USColorCodec {
+};
+
+//----------------------------------------------------------------//
+template <>
+class USColorCodec < USColor::A_8 > {
+public:
+
+	static const u32 SIZE = 1;
+
+	static inline u32 Decode ( u32 pixel ) {
+		return ( pixel << 0x18 ) & 0xFF000000;
+	}
+
+	static inline u32 Encode ( u32 color ) {
+		return ( color >> 0x18 ) & 0x000000FF;
+	}
+
+	static inline u32 Read ( const u8* src ) {
+		return Decode ( src [ 0 ]);
+	}
+
+	static inline void Write ( u8* dest, u32 color ) {
+		dest [ 0 ] = ( u8 )Encode ( color );
+	}
+};
+
+//----------------------------------------------------------------//
+template <>
+class USColorCodec < USColor::RGB_888 > {
+public:
+
+	static const u32 SIZE = 3;
+
+	static inline u32 Decode ( u32 pixel ) {
+		return pixel | 0xFF000000;
+	}
+
+	static inline u32 Encode ( u32 color ) {
+		return color & 0x00FFFFFF;
+	}
+
+	static inline u32 Read ( const u8* src ) {
+		return Decode ( src [ 0 ] + ( src [ 1 ] << 0x08 ) + ( src [ 2 ] << 0x10 ));
+	}
+
+	static inline void Write ( u8* dest, u32 color ) {
+		dest [ 0 ] = color & 0xFF;
+		dest [ 1 ] = ( color >> 0x08 ) & 0xFF;
+		dest [ 2 ] = ( color >> 0x10 ) & 0xFF;
+	}
+};
+
+//----------------------------------------------------------------//
+template <>
+class USColorCodec < USColor::RGB_565 > {
+public:
+
+	static const u32 SIZE = 2;
+
+	static inline u32 Decode ( u32 pixel ) {
+		return	((( pixel >> 0x0B ) & 0x1F ) << 0x03 ) +
+				((( pixel >> 0x05 ) & 0x3F ) << 0x0A ) +
+				((( pixel >> 0x00 ) & 0x1F ) << 0x13 ) +
+				0xff000000;
+	}
+
+	static inline u32 Encode ( u32 color ) {
+		return	((( color >> 0x03 ) & 0x1F ) << 0x0B ) +
+				((( color >> 0x0A ) & 0x3F ) << 0x05 ) +
+				((( color >> 0x13 ) & 0x1F ) << 0x00 );
+	}
+
+	static inline u32 Read ( const u8* src ) {
+		return Decode ( *( const u16* )src );
+	}
+
+	static inline void Write ( u8* dest, u32 color ) {
+		*( u16* )dest = ( u16 )Encode ( color );
+	}
+};
+
+//----------------------------------------------------------------//
+template <>
+class USColorCodec < USColor::RGBA_5551 > {
+public:
+
+	static const u32 SIZE = 2;
+
+	static inline u32 Decode ( u32 pixel ) {
+		return	((( pixel >> 0x00 ) & 0x1F ) << 0x03 ) +
+				((( pixel >> 0x05 ) & 0x1F ) << 0x0B ) +
+				((( pixel >> 0x0A ) & 0x1F ) << 0x13 ) +
+				(((( pixel >> 0x0F ) & 0xff ) ? 0xff : 0x00 ) << 0x18 );
+	}
+
+	static inline u32 Encode ( u32 color ) {
+		return	((( color >> 0x03 ) & 0x1F ) << 0x00 ) +
+				((( color >> 0x0B ) & 0x1F ) << 0x05 ) +
+				((( color >> 0x13 ) & 0x1F ) << 0x0A ) +
+				(((( color >> 0x1C ) & 0x0F ) ? 0x01 : 0x00 ) << 0x0F );
+	}
+
+	static inline u32 Read ( const u8* src ) {
+		return Decode ( *( const u16* )src );
+	}
+
+	static inline void Write ( u8* dest, u32 color ) {
+		*( u16* )dest = ( u16 )Encode ( color );
+	}
+};
+
+//----------------------------------------------------------------//
+template <>
+class USColorCodec < USColor::RGBA_4444 > {
+public:
+
+	static const u32 SIZE = 2;
+
+	static inline u32 Decode ( u32 pixel ) {
+		return	((( pixel >> 0x0C ) & 0x0F ) << 0x04 ) +
+				((( pixel >> 0x08 ) & 0x0F ) << 0x0C ) +
+				((( pixel >> 0x04 ) & 0x0F ) << 0x14 ) +
+				((( pixel >> 0x00 ) & 0x0F ) << 0x1C );
+	}
+
+	static inline u32 Encode ( u32 color ) {
+		return	((( color >> 0x04 ) & 0x0F ) << 0x0C ) +
+				((( color >> 0x0C ) & 0x0F ) << 0x08 ) +
+				((( color >> 0x14 ) & 0x0F ) << 0x04 ) +
+				((( color >> 0x1C ) & 0x0F ) << 0x00 );
+	}
+
+	static inline u32 Read ( const u8* src ) {
+		return Decode ( *( const u16* )src );
+	}
+
+	static inline void Write ( u8* dest, u32 color ) {
+		*( u16* )dest = ( u16 )Encode ( color );
+	}
+};
+
+//----------------------------------------------------------------//
+template <>
+class USColorCodec < USColor::RGBA_8888 > {
+public:
+
+	static const u32 SIZE = 4;
+
+	static inline u32 Decode ( u32 pixel ) {
+		return pixel;
+	}
+
+	static inline u32 Encode ( u32 color ) {
+		return color;
+	}
+
+	static inline u32 Read ( const u8* src ) {
+		return *( const u32* )src;
+	}
+
+	static inline void Write ( u8* dest, u32 color ) {
+		*( u32* )dest = color;
+	}
+};
+
+//================================================================//
+// vector kernels
+//================================================================//
+// Four pixels to a register, one per 32 bit lane; 16 bit formats are widened
+// on load and narrowed on store. Every kernel gives the same bits as its
+// scalar counterpart, so the scalar loops just pick up where these stop.
+#if defined ( USCOLOR_SSE2 ) || defined ( USCOLOR_NEON )
+
+	#if defined ( USCOLOR_SSE2 )
+	
+		typedef __m128i USColorLanes;
+	
+		#define LANES_SET(n)		_mm_set1_epi32 (( int )( n ))
+		#define LANES_ADD(a,b)		_mm_add_epi32 ( a, b )
+		#define LANES_AND(a,b)		_mm_and_si128 ( a, b )
+		#define LANES_OR(a,b)		_mm_or_si128 ( a, b )
+		#define LANES_SHL(v,n)		_mm_slli_epi32 ( v, n )
+		#define LANES_SHR(v,n)		_mm_srli_epi32 ( v, n )
+		#define LANES_MUL16(a,b)	_mm_mullo_epi16 ( a, b )
+		#define LANES_SHR16(v,n)	_mm_srli_epi16 ( v, n )
+		
+		//----------------------------------------------------------------//
+		static inline USColorLanes _load32 ( const void* src ) {
+			return _mm_loadu_si128 (( const __m128i* )src );
+		}
+		
+		//----------------------------------------------------------------//
+		static inline void _load16 ( const void* src, USColorLanes& lo, USColorLanes& hi ) {
+			__m128i pixels = _mm_loadu_si128 (( const __m128i* )src );
+			lo = _mm_unpacklo_epi16 ( pixels, _mm_setzero_si128 ());
+			hi = _mm_unpackhi_epi16 ( pixels, _mm_setzero_si128 ());
+		}
+		
+		//----------------------------------------------------------------//
+		static inline void _store32 ( void* dest, USColorLanes colors ) {
+			_mm_storeu_si128 (( __m128i* )dest, colors );
+		}
+		
+		//----------------------------------------------------------------//
+		static inline void _store16 ( void* dest, USColorLanes lo, USColorLanes hi ) {
+			// sign extend so the saturating pack keeps the low 16 bits as they are
+			lo = _mm_srai_epi32 ( _mm_slli_epi32 ( lo, 16 ), 16 );
+			hi = _mm_srai_epi32 ( _mm_slli_epi32 ( hi, 16 ), 16 );
+			_mm_storeu_si128 (( __m128i* )dest, _mm_packs_epi32 ( lo, hi ));
+		}
+		
+		//----------------------------------------------------------------//
+		static inline void _unzip ( USColorLanes a, USColorLanes b, USColorLanes& even, USColorLanes& odd ) {
+			even = _mm_castps_si128 ( _mm_shuffle_ps ( _mm_castsi128_ps ( a ), _mm_castsi128_ps ( b ), _MM_SHUFFLE ( 2, 0, 2, 0 )));
+			odd = _mm_castps_si128 ( _mm_shuffle_ps ( _mm_castsi128_ps ( a ), _mm_castsi128_ps ( b ), _MM_SHUFFLE ( 3, 1, 3, 1 )));
+		}
+	
+	#else
+	
+		typedef uint32x4_t USColorLanes;
+	
+		#define LANES_SET(n)		vdupq_n_u32 ( n )
+		#define LANES_ADD(a,b)		vaddq_u32 ( a, b )
+		#define LANES_AND(a,b)		vandq_u32 ( a, b )
+		#define LANES_OR(a,b)		vorrq_u32 ( a, b )
+		#define LANES_SHL(v,n)		vshlq_n_u32 ( v, n )
+		#define LANES_SHR(v,n)		vshrq_n_u32 ( v, n )
+		#define LANES_MUL16(a,b)	vreinterpretq_u32_u16 ( vmulq_u16 ( vreinterpretq_u16_u32 ( a ), vreinterpretq_u16_u32 ( b )))
+		#define LANES_SHR16(v,n)	vreinterpretq_u32_u16 ( vshrq_n_u16 ( vreinterpretq_u16_u32 ( v ), n ))
+		
+		//----------------------------------------------------------------//
+		static inline USColorLanes _load32 ( const void* src ) {
+			return vreinterpretq_u32_u8 ( vld1q_u8 (( const u8* )src ));
+		}
+		
+		//----------------------------------------------------------------//
+		static inline void _load16 ( const void* src, USColorLanes& lo, USColorLanes& hi ) {
+			uint16x8_t pixels = vreinterpretq_u16_u8 ( vld1q_u8 (( const u8* )src ));
+			lo = vmovl_u16 ( vget_low_u16 ( pixels ));
+			hi = vmovl_u16 ( vget_high_u16 ( pixels ));
+		}
+		
+		//----------------------------------------------------------------//
+		static inline void _store32 ( void* dest, USColorLanes colors ) {
+			vst1q_u8 (( u8* )dest, vreinterpretq_u8_u32 ( colors ));
+		}
+		
+		//----------------------------------------------------------------//
+		static inline void _store16 ( void* dest, USColorLanes lo, USColorLanes hi ) {
+			vst1q_u8 (( u8* )dest, vreinterpretq_u8_u16 ( vcombine_u16 ( vmovn_u32 ( lo ), vmovn_u32 ( hi ))));
+		}
+		
+		//----------------------------------------------------------------//
+		static inline void _unzip ( USColorLanes a, USColorLanes b, USColorLanes& even, USColorLanes& odd ) {
+			uint32x4x2_t unzipped = vuzpq_u32 ( a, b );
+			even = unzipped.val [ 0 ];
+			odd = unzipped.val [ 1 ];
+		}
+	
+	#endif
+	
+	#define LANES_FIELD(v,shift,mask)		LANES_AND ( LANES_SHR ( v, shift ), LANES_SET ( mask ))
+	
+	//----------------------------------------------------------------//
+	static inline USColorLanes _average ( USColorLanes c0, USColorLanes c1, USColorLanes c2, USColorLanes c3, u32 shift, u32 mask ) {
+	
+		// sum one field of four pixels in place; the masks leave room for the carry
+		USColorLanes m = LANES_SET ( mask << shift );
+		USColorLanes sum = LANES_ADD ( LANES_ADD ( LANES_AND ( c0, m ), LANES_AND ( c1, m )), LANES_ADD ( LANES_AND ( c2, m ), LANES_AND ( c3, m )));
+		return LANES_AND ( LANES_SHR ( sum, 2 ), m );
+	}
+	
+	//----------------------------------------------------------------//
+	static inline USColorLanes _decode4444 ( USColorLanes p ) {
+		return	LANES_OR ( LANES_OR ( LANES_SHL ( LANES_FIELD ( p, 0x0C, 0x0F ), 0x04 ), LANES_SHL ( LANES_FIELD ( p, 0x08, 0x0F ), 0x0C )),
+				LANES_OR ( LANES_SHL ( LANES_FIELD ( p, 0x04, 0x0F ), 0x14 ), LANES_SHL ( p, 0x1C )));
+	}
+	
+	//----------------------------------------------------------------//
+	static inline USColorLanes _decode565 ( USColorLanes p ) {
+		return	LANES_OR ( LANES_OR ( LANES_SHL ( LANES_FIELD ( p, 0x0B, 0x1F ), 0x03 ), LANES_SHL ( LANES_FIELD ( p, 0x05, 0x3F ), 0x0A )),
+				LANES_OR ( LANES_SHL ( LANES_FIELD ( p, 0x00, 0x1F ), 0x13 ), LANES_SET ( 0xff000000 )));
+	}
+	
+	//----------------------------------------------------------------//
+	static inline USColorLanes _encode4444 ( USColorLanes c ) {
+		return	LANES_OR ( LANES_OR ( LANES_SHL ( LANES_FIELD ( c, 0x04, 0x0F ), 0x0C ), LANES_SHL ( LANES_FIELD ( c, 0x0C, 0x0F ), 0x08 )),
+				LANES_OR ( LANES_SHL ( LANES_FIELD ( c, 0x14, 0x0F ), 0x04 ), LANES_SHR ( c, 0x1C )));
+	}
+	
+	//----------------------------------------------------------------//
+	static inline USColorLanes _encode565 ( USColorLanes c ) {
+		return	LANES_OR ( LANES_OR ( LANES_SHL ( LANES_FIELD ( c, 0x03, 0x1F ), 0x0B ), LANES_SHL ( LANES_FIELD ( c, 0x0A, 0x3F ), 0x05 )),
+				LANES_FIELD ( c, 0x13, 0x1F ));
+	}
+	
+	//----------------------------------------------------------------//
+	static inline USColorLanes _mipReduce4444 ( USColorLanes c0, USColorLanes c1, USColorLanes c2, USColorLanes c3 ) {
+		return	LANES_OR ( LANES_OR ( _average ( c0, c1, c2, c3, 0x0C, 0x0F ), _average ( c0, c1, c2, c3, 0x08, 0x0F )),
+				LANES_OR ( _average ( c0, c1, c2, c3, 0x04, 0x0F ), _average ( c0, c1, c2, c3, 0x00, 0x0F )));
+	}
+	
+	//----------------------------------------------------------------//
+	static inline USColorLanes _mipReduce565 ( USColorLanes c0, USColorLanes c1, USColorLanes c2, USColorLanes c3 ) {
+		return	LANES_OR ( LANES_OR ( _average ( c0, c1, c2, c3, 0x0B, 0x1F ), _average ( c0, c1, c2, c3, 0x05, 0x3F )),
+				_average ( c0, c1, c2, c3, 0x00, 0x1F ));
+	}
+	
+	//----------------------------------------------------------------//
+	static inline USColorLanes _mipReduce8888 ( USColorLanes c0, USColorLanes c1, USColorLanes c2, USColorLanes c3 ) {
+	
+		// red and blue, then green and alpha, two 16 bit sums to a lane
+		USColorLanes m = LANES_SET ( 0x00FF00FF );
+		USColorLanes rb = LANES_ADD ( LANES_ADD ( LANES_AND ( c0, m ), LANES_AND ( c1, m )), LANES_ADD ( LANES_AND ( c2, m ), LANES_AND ( c3, m )));
+		
+		c0 = LANES_SHR ( c0, 0x08 );
+		c1 = LANES_SHR ( c1, 0x08 );
+		c2 = LANES_SHR ( c2, 0x08 );
+		c3 = LANES_SHR ( c3, 0x08 );
+		USColorLanes ga = LANES_ADD ( LANES_ADD ( LANES_AND ( c0, m ), LANES_AND ( c1, m )), LANES_ADD ( LANES_AND ( c2, m ), LANES_AND ( c3, m )));
+		
+		return LANES_OR ( LANES_AND ( LANES_SHR ( rb, 2 ), m ), LANES_SHL ( LANES_AND ( LANES_SHR ( ga, 2 ), m ), 0x08 ));
+	}
+	
+	//----------------------------------------------------------------//
+	static inline USColorLanes _premultiply4444 ( USColorLanes p ) {
+	
+		USColorLanes a = LANES_AND ( p, LANES_SET ( 0x0F ));
+		
+		// each product fits in the low 16 bits of its lane
+		return	LANES_OR ( LANES_OR ( a, LANES_SHL ( LANES_SHR16 ( LANES_MUL16 ( LANES_FIELD ( p, 0x04, 0x0F ), a ), 0x04 ), 0x04 )),
+				LANES_OR ( LANES_SHL ( LANES_SHR16 ( LANES_MUL16 ( LANES_FIELD ( p, 0x08, 0x0F ), a ), 0x04 ), 0x08 ), LANES_SHL ( LANES_SHR16 ( LANES_MUL16 ( LANES_SHR ( p, 0x0C ), a ), 0x04 ), 0x0C )));
+	}
+	
+	//----------------------------------------------------------------//
+	static inline USColorLanes _premultiply8888 ( USColorLanes c ) {
+	
+		// alpha in both halves of each lane, then red and blue, green and alpha
+		// are multiplied as 16 bit pairs; 255 * 255 still fits
+		USColorLanes m = LANES_SET ( 0x00FF00FF );
+		USColorLanes a = LANES_SHR ( c, 0x18 );
+		a = LANES_OR ( a, LANES_SHL ( a, 0x10 ));
+		
+		USColorLanes rb = LANES_AND ( LANES_SHR16 ( LANES_MUL16 ( LANES_AND ( c, m ), a ), 0x08 ), m );
+		USColorLanes g = LANES_AND ( LANES_SHR16 ( LANES_MUL16 ( LANES_AND ( LANES_SHR ( c, 0x08 ), m ), a ), 0x08 ), LANES_SET ( 0xFF ));
+		
+		return LANES_OR ( LANES_OR ( rb, LANES_SHL ( g, 0x08 )), LANES_AND ( c, LANES_SET ( 0xFF000000 )));
+	}
+
+#endif
+
+//================================================================//
+// row kernels
+//================================================================//
+
+//----------------------------------------------------------------//
+// colors handled by a vector kernel, if there is one for the pair
+template < USColor::Format SRC, USColor::Format DEST >
+static inline u32 _convertRowVec ( void* dest, const void* src, u32 nColors ) {
+	UNUSED ( dest );
+	UNUSED ( src );
+	UNUSED ( nColors );
+	return 0;
+}
+
+//----------------------------------------------------------------//
+template < USColor::Format FORMAT >
+static inline u32 _mipReduceRowVec ( void* dest, const void* src0, const void* src1, u32 nColors ) {
+	UNUSED ( dest );
+	UNUSED ( src0 );
+	UNUSED ( src1 );
+	UNUSED ( nColors );
+	return 0;
+}
+
+//----------------------------------------------------------------//
+template < USColor::Format FORMAT >
+static inline u32 _premultiplyRowVec ( void* colors, u32 nColors ) {
+	UNUSED ( colors );
+	UNUSED ( nColors );
+	return 0;
+}
+
+#if defined ( USCOLOR_SSE2 ) || defined ( USCOLOR_NEON )
+
+	//----------------------------------------------------------------//
+	template <>
+	inline u32 _convertRowVec < USColor::RGB_565, USColor::RGBA_8888 >( void* dest, const void* src, u32 nColors ) {
+	
+		u32 i = 0;
+		for ( ; ( i + 8 ) <= nColors; i += 8 ) {
+			USColorLanes lo, hi;
+			_load16 (( const u16* )src + i, lo, hi );
+			_store32 (( u32* )dest + i, _decode565 ( lo ));
+			_store32 (( u32* )dest + i + 4, _decode565 ( hi ));
+		}
+		return i;
+	}
+	
+	//----------------------------------------------------------------//
+	template <>
+	inline u32 _convertRowVec < USColor::RGBA_4444, USColor::RGBA_8888 >( void* dest, const void* src, u32 nColors ) {
+	
+		u32 i = 0;
+		for ( ; ( i + 8 ) <= nColors; i += 8 ) {
+			USColorLanes lo, hi;
+			_load16 (( const u16* )src + i, lo, hi );
+			_store32 (( u32* )dest + i, _decode4444 ( lo ));
+			_store32 (( u32* )dest + i + 4, _decode4444 ( hi ));
+		}
+		return i;
+	}
+	
+	//----------------------------------------------------------------//
+	template <>
+	inline u32 _convertRowVec < USColor::RGBA_8888, USColor::RGB_565 >( void* dest, const void* src, u32 nColors ) {
+	
+		u32 i = 0;
+		for ( ; ( i + 8 ) <= nColors; i += 8 ) {
+			USColorLanes lo = _encode565 ( _load32 (( const u32* )src + i ));
+			USColorLanes hi = _encode565 ( _load32 (( const u32* )src + i + 4 ));
+			_store16 (( u16* )dest + i, lo, hi );
+		}
+		return i;
+	}
+	
+	//----------------------------------------------------------------//
+	template <>
+	inline u32 _convertRowVec < USColor::RGBA_8888, USColor::RGBA_4444 >( void* dest, const void* src, u32 nColors ) {
+	
+		u32 i = 0;
+		for ( ; ( i + 8 ) <= nColors; i += 8 ) {
+			USColorLanes lo = _encode4444 ( _load32 (( const u32* )src + i ));
+			USColorLanes hi = _encode4444 ( _load32 (( const u32* )src + i + 4 ));
+			_store16 (( u16* )dest + i, lo, hi );
+		}
+		return i;
+	}
+	
+	//----------------------------------------------------------------//
+	template <>
+	inline u32 _mipReduceRowVec < USColor::RGB_565 >( void* dest, const void* src0, const void* src1, u32 nColors ) {
+	
+		u32 i = 0;
+		for ( ; ( i + 4 ) <= nColors; i += 4 ) {
+		
+			USColorLanes lo0, hi0, lo1, hi1, c0, c1, c2, c3;
+			_load16 (( const u16* )src0 + ( i << 1 ), lo0, hi0 );
+			_load16 (( const u16* )src1 + ( i << 1 ), lo1, hi1 );
+			_unzip ( lo0, hi0, c0, c1 );
+			_unzip ( lo1, hi1, c2, c3 );
+			
+			USColorLanes mip = _mipReduce565 ( c0, c1, c2, c3 );
+			
+			// only four pixels come out; narrow them alongside a copy and keep the first half
+			u16 buffer [ 8 ];
+			_store16 ( buffer, mip, mip );
+			memcpy (( u16* )dest + i, buffer, 4 * sizeof ( u16 ));
+		}
+		return i;
+	}
+	
+	//----------------------------------------------------------------//
+	template <>
+	inline u32 _mipReduceRowVec < USColor::RGBA_4444 >( void* dest, const void* src0, const void* src1, u32 nColors ) {
+	
+		u32 i = 0;
+		for ( ; ( i + 4 ) <= nColors; i += 4 ) {
+		
+			USColorLanes lo0, hi0, lo1, hi1, c0, c1, c2, c3;
+			_load16 (( const u16* )src0 + ( i << 1 ), lo0, hi0 );
+			_load16 (( const u16* )src1 + ( i << 1 ), lo1, hi1 );
+			_unzip ( lo0, hi0, c0, c1 );
+			_unzip ( lo1, hi1, c2, c3 );
+			
+			USColorLanes mip = _mipReduce4444 ( c0, c1, c2, c3 );
+			
+			u16 buffer [ 8 ];
+			_store16 ( buffer, mip, mip );
+			memcpy (( u16* )dest + i, buffer, 4 * sizeof ( u16 ));
+		}
+		return i;
+	}
+	
+	//----------------------------------------------------------------//
+	template <>
+	inline u32 _mipReduceRowVec < USColor::RGBA_8888 >( void* dest, const void* src0, const void* src1, u32 nColors ) {
+	
+		u32 i = 0;
+		for ( ; ( i + 4 ) <= nColors; i += 4 ) {
+		
+			USColorLanes c0, c1, c2, c3;
+			_unzip ( _load32 (( const u32* )src0 + ( i << 1 )), _load32 (( const u32* )src0 + ( i << 1 ) + 4 ), c0, c1 );
+			_unzip ( _load32 (( const u32* )src1 + ( i << 1 )), _load32 (( const u32* )src1 + ( i << 1 ) + 4 ), c2, c3 );
+			
+			_store32 (( u32* )dest + i, _mipReduce8888 ( c0, c1, c2, c3 ));
+		}
+		return i;
+	}
+	
+	//----------------------------------------------------------------//
+	template <>
+	inline u32 _premultiplyRowVec < USColor::RGBA_4444 >( void* colors, u32 nColors ) {
+	
+		u32 i = 0;
+		for ( ; ( i + 8 ) <= nColors; i += 8 ) {
+			USColorLanes lo, hi;
+			_load16 (( u16* )colors + i, lo, hi );
+			_store16 (( u16* )colors + i, _premultiply4444 ( lo ), _premultiply4444 ( hi ));
+		}
+		return i;
+	}
+	
+	//----------------------------------------------------------------//
+	template <>
+	inline u32 _premultiplyRowVec < USColor::RGBA_8888 >( void* colors, u32 nColors ) {
+	
+		u32 i = 0;
+		for ( ; ( i + 4 ) <= nColors; i += 4 ) {
+			_store32 (( u32* )colors + i, _premultiply8888 ( _load32 (( u32* )colors + i )));
+		}
+		return i;
+	}
+
+#endif
+
+//----------------------------------------------------------------//
+template < USColor::Format SRC, USColor::Format DEST >
+static void _convertRow ( void* dest, const void* src, u32 nColors ) {
+
+	u32 i = _convertRowVec < SRC, DEST >( dest, src, nColors );
+
+	const u8* srcBytes = ( const u8* )src + ( i * USColorCodec < SRC >::SIZE );
+	u8* destBytes = ( u8* )dest + ( i * USColorCodec < DEST >::SIZE );
+	
+	for ( ; i < nColors; ++i ) {
+		USColorCodec < DEST >::Write ( destBytes, USColorCodec < SRC >::Read ( srcBytes ));
+		srcBytes += USColorCodec < SRC >::SIZE;
+		destBytes += USColorCodec < DEST >::SIZE;
+	}
+}
+
+//----------------------------------------------------------------//
+template < USColor::Format FORMAT >
+static void _mipReduceRow ( void* dest, const void* src0, const void* src1, u32 nColors ) {
+
+	static const u32 SIZE = USColorCodec < FORMAT >::SIZE;
+
+	u32 i = _mipReduceRowVec < FORMAT >( dest, src0, src1, nColors );
+
+	const u8* row0 = ( const u8* )src0 + ( i * SIZE * 2 );
+	const u8* row1 = ( const u8* )src1 + ( i * SIZE * 2 );
+	u8* destBytes = ( u8* )dest + ( i * SIZE );
+	
+	for ( ; i < nColors; ++i ) {
+	
+		u32 c0 = USColorCodec < FORMAT >::Read ( row0 );
+		u32 c1 = USColorCodec < FORMAT >::Read ( row0 + SIZE );
+		u32 c2 = USColorCodec < FORMAT >::Read ( row1 );
+		u32 c3 = USColorCodec < FORMAT >::Read ( row1 + SIZE );
+		
+		USColorCodec < FORMAT >::Write ( destBytes, USColor::Average ( c0, c1, c2, c3 ));
+		
+		row0 += SIZE * 2;
+		row1 += SIZE * 2;
+		destBytes += SIZE;
+	}
+}
+
+//----------------------------------------------------------------//
+typedef void ( *ConvertRowFunc )( void* dest, const void* src, u32 nColors );
+
+#define CONVERT_ROW_FUNCS(src) {						\
+	_convertRow < src, USColor::A_8 >,					\
+	_convertRow < src, USColor::RGB_888 >,				\
+	_convertRow < src, USColor::RGB_565 >,				\
+	_convertRow < src, USColor::RGBA_5551 >,			\
+	_convertRow < src, USColor::RGBA_4444 >,			\
+	_convertRow < src, USColor::RGBA_8888 >,			\
+}
+
+// indexed by source format, then destination format
+static const ConvertRowFunc sConvertRowFuncs [ USColor::CLR_FMT_UNKNOWN ][ USColor::CLR_FMT_UNKNOWN ] = {
+	CONVERT_ROW_FUNCS ( USColor::A_8 ),
+	CONVERT_ROW_FUNCS ( USColor::RGB_888 ),
+	CONVERT_ROW_FUNCS ( USColor::RGB_565 ),
+	CONVERT_ROW_FUNCS ( USColor::RGBA_5551 ),
+	CONVERT_ROW_FUNCS ( USColor::RGBA_4444 ),
+	CONVERT_ROW_FUNCS ( USColor::RGBA_8888 ),
+};
+
+#undef CONVERT_ROW_FUNCS
+
 //================================================================//
 // USColor
 //================================================================//
@@ -50,217 +659,29 @@ u32 USColor::BilerpFixed ( u32 c0, u32 c1, u32 c2, u32 c3, u8 xt, u8 yt ) {
 //----------------------------------------------------------------//
 void USColor::Convert ( void* dest, Format destFmt, const void* src, Format srcFmt, u32 nColors ) {
 
-	static const u32 MAX_COLORS = 2048;
+	if (( srcFmt >= CLR_FMT_UNKNOWN ) || ( destFmt >= CLR_FMT_UNKNOWN )) return;
 
-	u32 buffer [ MAX_COLORS ];
-	u32* bufferPtr = buffer;
-	u32 color;
-	
-	while ( nColors ) {
-	
-		u32 copy = nColors;
-		if ( copy > MAX_COLORS ) {
-			copy = MAX_COLORS;
-		}
-		nColors -= copy;
-	
-		switch ( srcFmt ) {
-			
-			case A_8:
-			
-				for ( u32 i = 0; i < copy; ++i ) {
-				
-					color = *( u8* )src;
-					src = ( void* )(( uintptr )src + 1 );
-					
-					buffer [ i ] = color << 0x18;
-				}
-				bufferPtr = buffer;
-				break;
-			
-			case RGB_888:
-				
-				for ( u32 i = 0; i < copy; ++i ) {
-					
-					color = *( u32* )src;
-					src = ( void* )(( uintptr )src + 3 );
-					
-					buffer [ i ]= color | 0xff000000;
-				}
-				bufferPtr = buffer;
-				break;
-				
-			case RGB_565:
-				
-				for ( u32 i = 0; i < copy; ++i ) {
-					
-					color = *( u16* )src;
-					src = ( void* )(( uintptr )src + 2 );
-					
-					buffer [ i ] =	((( color >> 0x00 ) & 0x1F ) << 0x03 ) +
-									((( color >> 0x05 ) & 0x3F ) << 0x02 ) +
-									((( color >> 0x0B ) & 0x1F ) << 0x03 ) +
-									0xff000000;
-					
-				}
-				bufferPtr = buffer;
-				break;
-			
-			case RGBA_5551: 
-				
-				for ( u32 i = 0; i < copy; ++i ) {
-				
-					color = *( u16* )src;
-					src = ( void* )(( uintptr )src + 2 );
-					
-					buffer [ i ] =	((( color >> 0x00 ) & 0x1F ) << 0x03 ) +
-									((( color >> 0x05 ) & 0x1F ) << 0x0B ) +
-									((( color >> 0x0A ) & 0x1F ) << 0x13 ) +
-									(((( color >> 0x0F ) & 0xff ) ? 0xff : 0x00 ) << 0x18 );
-				}
-				bufferPtr = buffer;
-				break;
-
-			case RGBA_4444:
-			
-				for ( u32 i = 0; i < copy; ++i ) {
-				
-					color = *( u32* )src;
-					src = ( void* )(( uintptr )src + 2 );
-					
-					buffer [ i ] =	((( color >> 0x00 ) & 0x0F ) << 0x04 ) +
-									((( color >> 0x04 ) & 0x0F ) << 0x0C ) +
-									((( color >> 0x08 ) & 0x0F ) << 0x14 ) +
-									((( color >> 0x0C ) & 0x0F ) << 0x1C );
-				}
-				bufferPtr = buffer;
-				break;
-
-			case RGBA_8888:
-				bufferPtr = ( u32* )src;
-				break;
-			
-			default:
-				return;
-		}
-		
-		switch ( destFmt ) {
-		
-			case A_8:
-				
-				for ( u32 i = 0; i < copy; ++i ) {
-				
-					color = bufferPtr [ i ];
-					
-					(( u8* )dest )[ 0 ] = ( color >> 0x18 ) & 0xFF;
-					dest = ( void* )(( uintptr )dest + 1 );
-				}
-				break;
-		
-			case RGB_888:
-			
-				for ( u32 i = 0; i < copy; ++i ) {
-				
-					color = bufferPtr [ i ];
-					
-					(( u8* )dest )[ 0 ] = color & 0xFF;
-					(( u8* )dest )[ 1 ] = ( color >> 8 ) & 0xFF;
-					(( u8* )dest )[ 2 ] = ( color >> 16 ) & 0xFF;
-					dest = ( void* )(( uintptr )dest + 3 );
-				}
-				break;
-				
-			case RGB_565:
-			
-				for ( u32 i = 0; i < copy; ++i ) {
-				
-					color = bufferPtr [ i ];
-					
-					*( u16* )dest =	((( color >> 0x03 ) & 0x1F ) << 0x0B ) +
-									((( color >> 0x0A ) & 0x3F ) << 0x05 ) +
-									((( color >> 0x13 ) & 0x1F ) << 0x00 );
-					dest = ( void* )(( uintptr )dest + 2 );
-				}
-				break;
-						
-			case RGBA_5551: 
-				
-				for ( u32 i = 0; i < copy; ++i ) {
-				
-					color = bufferPtr [ i ];
-					
-					*( u16* )dest =		((( color >> 0x03 ) & 0x1F ) << 0x00 ) +
-										((( color >> 0x0B ) & 0x1F ) << 0x05 ) +
-										((( color >> 0x13 ) & 0x1F ) << 0x0A ) +
-										(((( color >> 0x1C ) & 0x0F ) ? 0x01 : 0x00 ) << 0x0F );
-					dest = ( void* )(( uintptr )dest + 2 );
-				}
-				break;
-
-			case RGBA_4444:
-				
-				for ( u32 i = 0; i < copy; ++i ) {
-				
-					color = bufferPtr [ i ];
-					
-					*( u16* )dest =		((( color >> 0x04 ) & 0x0F ) << 0x0C ) +
-										((( color >> 0x0C ) & 0x0F ) << 0x08 ) +
-										((( color >> 0x14 ) & 0x0F ) << 0x04 ) +
-										((( color >> 0x1C ) & 0x0F ) << 0x00 );
-					dest = ( void* )(( uintptr )dest + 2 );
-				}
-				break;
-
-			case RGBA_8888:
-				
-				memcpy ( dest, bufferPtr, copy * sizeof ( u32 ));
-				dest = ( void* )(( uintptr )dest + ( copy * sizeof ( u32 )));
-				break;
-			
-			default:
-				break;
+	if ( srcFmt == destFmt ) {
+		if ( dest != src ) {
+			memcpy ( dest, src, nColors * USColor::GetSize ( srcFmt ));
 		}
+		return;
 	}
+	sConvertRowFuncs [ srcFmt ][ destFmt ]( dest, src, nColors );
 }
 
 //----------------------------------------------------------------//
 u32 USColor::ConvertFromRGBA ( u32 color, Format format ) {
 
 	switch ( format ) {
-		
-		case A_8:
-			return ( color >> 0x18 ) & 0x000000FF;
-		
-		case RGB_888:
-			return color & 0x00FFFFFF;
-			
-		case RGB_565:
-		
-			return	((( color >> 0x03 ) & 0x1F ) << 0x0B ) +
-					((( color >> 0x0A ) & 0x3F ) << 0x05 ) +
-					((( color >> 0x13 ) & 0x1F ) << 0x00 );
-					
-		case RGBA_5551: 
-			
-			return	((( color >> 0x03 ) & 0x1F ) << 0x00 ) +
-					((( color >> 0x0B ) & 0x1F ) << 0x05 ) +
-					((( color >> 0x13 ) & 0x1F ) << 0x0A ) +
-					(((( color >> 0x1C ) & 0x0F ) ? 0x01 : 0x00 ) << 0x0F );
-
-		case RGBA_4444:
-			
-			return	((( color >> 0x04 ) & 0x0F ) << 0x0C ) +
-					((( color >> 0x0C ) & 0x0F ) << 0x08 ) +
-					((( color >> 0x14 ) & 0x0F ) << 0x04 ) +
-					((( color >> 0x1C ) & 0x0F ) << 0x00 );
-
-		case RGBA_8888:
-			return color;
-		
-		default:
-			break;
+		case A_8:			return USColorCodec < A_8 >::Encode ( color );
+		case RGB_888:		return USColorCodec < RGB_888 >::Encode ( color );
+		case RGB_565:		return USColorCodec < RGB_565 >::Encode ( color );
+		case RGBA_5551:		return USColorCodec < RGBA_5551 >::Encode ( color );
+		case RGBA_4444:		return USColorCodec < RGBA_4444 >::Encode ( color );
+		case RGBA_8888:		return USColorCodec < RGBA_8888 >::Encode ( color );
+		default:			break;
 	}
-	
 	return 0;
 }
 
@@ -268,41 +689,14 @@ u32 USColor::ConvertFromRGBA ( u32 color, Format format ) {
 u32 USColor::ConvertToRGBA ( u32 color, Format format ) {
 
 	switch ( format ) {
-		
-		case A_8:
-			return ( color << 0x18 ) & 0xFF000000;
-		
-		case RGB_888:
-			return color | 0xFF000000;
-			
-		case RGB_565:
-		
-			return	((( color >> 0x00 ) & 0x1F ) << 0x03 ) +
-					((( color >> 0x05 ) & 0x3F ) << 0x02 ) +
-					((( color >> 0x0B ) & 0x1F ) << 0x03 ) +
-					0xff000000;
-					
-		case RGBA_5551: 
-			
-			return	((( color >> 0x00 ) & 0x1F ) << 0x03 ) +
-					((( color >> 0x05 ) & 0x1F ) << 0x0B ) +
-					((( color >> 0x0A ) & 0x1F ) << 0x13 ) +
-					(((( color >> 0x0F ) & 0xff ) ? 0xff : 0x00 ) << 0x18 );
-
-		case RGBA_4444:
-		
-			return	((( color >> 0x00 ) & 0x0F ) << 0x04 ) +
-					((( color >> 0x04 ) & 0x0F ) << 0x0C ) +
-					((( color >> 0x08 ) & 0x0F ) << 0x14 ) +
-					((( color >> 0x0C ) & 0x0F ) << 0x1C );
-
-		case RGBA_8888:
-			return color;
-		
-		default:
-			break;
+		case A_8:			return USColorCodec < A_8 >::Decode ( color );
+		case RGB_888:		return USColorCodec < RGB_888 >::Decode ( color );
+		case RGB_565:		return USColorCodec < RGB_565 >::Decode ( color );
+		case RGBA_5551:		return USColorCodec < RGBA_5551 >::Decode ( color );
+		case RGBA_4444:		return USColorCodec < RGBA_4444 >::Decode ( color );
+		case RGBA_8888:		return USColorCodec < RGBA_8888 >::Decode ( color );
+		default:			break;
 	}
-	
 	return 0;
 }
 
@@ -354,24 +748,39 @@ u32 USColor::GetSize ( Format format ) {
 //----------------------------------------------------------------//
 u32 USColor::LerpFixed ( u32 c0, u32 c1, u8 t ) {
 	
-	u32 r0 = ( c0 ) & 0xFF;
-	u32 g0 = ( c0 >> 0x08 ) & 0xFF;
-	u32 b0 = ( c0 >> 0x10 ) & 0xFF;
-	u32 a0 = ( c0 >> 0x18 ) & 0xFF;
+	// signed, so a falling channel can't borrow from the one above it
+	int r0 = ( c0 ) & 0xFF;
+	int g0 = ( c0 >> 0x08 ) & 0xFF;
+	int b0 = ( c0 >> 0x10 ) & 0xFF;
+	int a0 = ( c0 >> 0x18 ) & 0xFF;
 	
-	u32 r1 = ( c1 ) & 0xFF;
-	u32 g1 = ( c1 >> 0x08 ) & 0xFF;
-	u32 b1 = ( c1 >> 0x10 ) & 0xFF;
-	u32 a1 = ( c1 >> 0x18 ) & 0xFF;
+	int r1 = ( c1 ) & 0xFF;
+	int g1 = ( c1 >> 0x08 ) & 0xFF;
+	int b1 = ( c1 >> 0x10 ) & 0xFF;
+	int a1 = ( c1 >> 0x18 ) & 0xFF;
 	
-	u32 r = r0 + ((( r1 - r0 ) * t ) >> 0x08 );
-	u32 g = g0 + ((( g1 - g0 ) * t ) >> 0x08 );
-	u32 b = b0 + ((( b1 - b0 ) * t ) >> 0x08 );
-	u32 a = a0 + ((( a1 - a0 ) * t ) >> 0x08 );
+	u32 r = ( u32 )( r0 + ((( r1 - r0 ) * t ) >> 0x08 ));
+	u32 g = ( u32 )( g0 + ((( g1 - g0 ) * t ) >> 0x08 ));
+	u32 b = ( u32 )( b0 + ((( b1 - b0 ) * t ) >> 0x08 ));
+	u32 a = ( u32 )( a0 + ((( a1 - a0 ) * t ) >> 0x08 ));
 	
 	return r + ( g << 0x08 ) + ( b << 0x10 ) + ( a << 0x18 );
 }
 
+//----------------------------------------------------------------//
+void USColor::MipReduceRow ( void* dest, const void* src0, const void* src1, Format format, u32 nColors ) {
+
+	switch ( format ) {
+		case A_8:			_mipReduceRow < A_8 >( dest, src0, src1, nColors ); break;
+		case RGB_888:		_mipReduceRow < RGB_888 >( dest, src0, src1, nColors ); break;
+		case RGB_565:		_mipReduceRow < RGB_565 >( dest, src0, src1, nColors ); break;
+		case RGBA_5551:		_mipReduceRow < RGBA_5551 >( dest, src0, src1, nColors ); break;
+		case RGBA_4444:		_mipReduceRow < RGBA_4444 >( dest, src0, src1, nColors ); break;
+		case RGBA_8888:		_mipReduceRow < RGBA_8888 >( dest, src0, src1, nColors ); break;
+		default:			break;
+	}
+}
+
 //----------------------------------------------------------------//
 u32 USColor::NearestNeighbor ( u32 c0, u32 c1, u32 c2, u32 c3, u8 xt, u8 yt ) {
 
@@ -435,9 +844,12 @@ void USColor::PremultiplyAlpha ( void* colors, Format format, u32 nColors ) {
 			}
 			break;
 
-		case RGBA_4444:
+		case RGBA_4444: {
 		
-			for ( u32 i = 0; i < nColors; ++i ) {
+			u32 done = _premultiplyRowVec < RGBA_4444 >( colors, nColors );
+			colors = ( void* )(( uintptr )colors + ( done * 2 ));
+		
+			for ( u32 i = done; i < nColors; ++i ) {
 				color = *( u16* )colors;
 				alpha = color & 0x0F;
 				*( u16* )colors = ( u16 )(	alpha +
@@ -447,10 +859,14 @@ void USColor::PremultiplyAlpha ( void* colors, Format format, u32 nColors ) {
 				colors = ( void* )(( uintptr )colors + 2 );
 			}
 			break;
-
-		case RGBA_8888:
+		}
 		
-			for ( u32 i = 0; i < nColors; ++i ) {
+		case RGBA_8888: {
+		
+			u32 done = _premultiplyRowVec < RGBA_8888 >( colors, nColors );
+			colors = ( void* )(( uintptr )colors + ( done * 4 ));
+		
+			for ( u32 i = done; i < nColors; ++i ) {
 				color = *( u32* )colors;
 				alpha = ( color >> 0x18 ) & 0xFF;
 				*( u32* )colors =	((((( color >> 0x00 ) & 0xFF ) * alpha ) >> 0x08 ) << 0x00 ) +
@@ -460,6 +876,7 @@ void USColor::PremultiplyAlpha ( void* colors, Format format, u32 nColors ) {
 				colors = ( void* )(( uintptr )colors + 4 );
 			}
 			break;
+		}
 		
 		default:
 			break;
@@ -0,0 +1,320 @@
+// Copyright (c) 2010-2011 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#include "pch.h"
+#include <uslscore/USCull.h>
+#include <uslscore/USFrustum.h>
+
+#if defined ( __SSE2__ ) || defined ( _M_X64 ) || ( defined ( _M_IX86_FP ) && ( _M_IX86_FP >= 2 ))
+	#define USCULL_SSE2
+	#include <emmintrin.h>
+#elif defined ( __ARM_NEON__ ) || defined ( __ARM_NEON )
+	#define USCULL_NEON
+	#include <arm_neon.h>
+#endif
+
+// same threshold USDist::VecToPlane snaps to; keeps results in line with USFrustum::Cull
+#define	CULL_NEAR 0.000001f
+
+//================================================================//
+// local
+//================================================================//
+
+//----------------------------------------------------------------//
+// Planes are tested with doubled centers and extents (min + max, max - min)
+// so the vector and scalar paths share the same math.
+class USCullPlane {
+public:
+
+	float	mNX;
+	float	mNY;
+	float	mNZ;
+	float	mAX; // absolute value of the normal
+	float	mAY;
+	float	mAZ;
+	float	mDist2;
+
+	//----------------------------------------------------------------//
+	void Init ( const USPlane3D& plane ) {
+	
+		this->mNX = plane.mNorm.mX;
+		this->mNY = plane.mNorm.mY;
+		this->mNZ = plane.mNorm.mZ;
+		this->mAX = ABS ( plane.mNorm.mX );
+		this->mAY = ABS ( plane.mNorm.mY );
+		this->mAZ = ABS ( plane.mNorm.mZ );
+		this->mDist2 = plane.mDist * 2.0f;
+	}
+};
+
+//----------------------------------------------------------------//
+static inline bool _boxOutside ( const USCullBoxes& boxes, u32 i, const USBox& box ) {
+
+	if (( boxes.mXMin [ i ] > box.mMax.mX ) || ( boxes.mXMax [ i ] < box.mMin.mX )) return true;
+	if (( boxes.mYMin [ i ] > box.mMax.mY ) || ( boxes.mYMax [ i ] < box.mMin.mY )) return true;
+	if (( boxes.mZMin [ i ] > box.mMax.mZ ) || ( boxes.mZMax [ i ] < box.mMin.mZ )) return true;
+	return false;
+}
+
+//----------------------------------------------------------------//
+static inline bool _boxInFront ( const USCullBoxes& boxes, u32 i, const USCullPlane& plane ) {
+
+	float cx = boxes.mXMin [ i ] + boxes.mXMax [ i ];
+	float cy = boxes.mYMin [ i ] + boxes.mYMax [ i ];
+	float cz = boxes.mZMin [ i ] + boxes.mZMax [ i ];
+	
+	float ex = boxes.mXMax [ i ] - boxes.mXMin [ i ];
+	float ey = boxes.mYMax [ i ] - boxes.mYMin [ i ];
+	float ez = boxes.mZMax [ i ] - boxes.mZMin [ i ];
+
+	float d = ( cx * plane.mNX ) + ( cy * plane.mNY ) + ( cz * plane.mNZ ) + plane.mDist2;
+	float r = ( ex * plane.mAX ) + ( ey * plane.mAY ) + ( ez * plane.mAZ );
+
+	return ( d > r ) && ( d >= ( CULL_NEAR * 2.0f ));
+}
+
+//----------------------------------------------------------------//
+static inline void _initPlanes ( const USFrustum& frustum, USCullPlane* planes ) {
+
+	for ( u32 i = 0; i < USFrustum::TOTAL_PLANES; ++i ) {
+		planes [ i ].Init ( frustum.mPlanes [ i ]);
+	}
+}
+
+//================================================================//
+// USCull
+//================================================================//
+
+//----------------------------------------------------------------//
+u32 USCull::Box ( const USCullBoxes& boxes, u32 base, u32 total, const USBox& box, u32* results ) {
+
+	#if defined ( USCULL_SSE2 ) || defined ( USCULL_NEON )
+	
+		u32 count = 0;
+		u32 i = base;
+		u32 end = base + total;
+	
+		#if defined ( USCULL_SSE2 )
+		
+			__m128 bxMin = _mm_set1_ps ( box.mMin.mX );
+			__m128 byMin = _mm_set1_ps ( box.mMin.mY );
+			__m128 bzMin = _mm_set1_ps ( box.mMin.mZ );
+			__m128 bxMax = _mm_set1_ps ( box.mMax.mX );
+			__m128 byMax = _mm_set1_ps ( box.mMax.mY );
+			__m128 bzMax = _mm_set1_ps ( box.mMax.mZ );
+		
+			for ( ; ( i + 4 ) <= end; i += 4 ) {
+			
+				__m128 out = _mm_or_ps ( _mm_cmpgt_ps ( _mm_loadu_ps ( boxes.mXMin + i ), bxMax ), _mm_cmplt_ps ( _mm_loadu_ps ( boxes.mXMax + i ), bxMin ));
+				out = _mm_or_ps ( out, _mm_or_ps ( _mm_cmpgt_ps ( _mm_loadu_ps ( boxes.mYMin + i ), byMax ), _mm_cmplt_ps ( _mm_loadu_ps ( boxes.mYMax + i ), byMin )));
+				out = _mm_or_ps ( out, _mm_or_ps ( _mm_cmpgt_ps ( _mm_loadu_ps ( boxes.mZMin + i ), bzMax ), _mm_cmplt_ps ( _mm_loadu_ps ( boxes.mZMax + i ), bzMin )));
+				
+				u32 keep = ~( u32 )_mm_movemask_ps ( out );
+				
+				results [ count ] = i;		count += keep & 0x01;
+				results [ count ] = i + 1;	count += ( keep >> 1 ) & 0x01;
+				results [ count ] = i + 2;	count += ( keep >> 2 ) & 0x01;
+				results [ count ] = i + 3;	count += ( keep >> 3 ) & 0x01;
+			}
+		
+		#else
+		
+			float32x4_t bxMin = vdupq_n_f32 ( box.mMin.mX );
+			float32x4_t byMin = vdupq_n_f32 ( box.mMin.mY );
+			float32x4_t bzMin = vdupq_n_f32 ( box.mMin.mZ );
+			float32x4_t bxMax = vdupq_n_f32 ( box.mMax.mX );
+			float32x4_t byMax = vdupq_n_f32 ( box.mMax.mY );
+			float32x4_t bzMax = vdupq_n_f32 ( box.mMax.mZ );
+		
+			for ( ; ( i + 4 ) <= end; i += 4 ) {
+			
+				uint32x4_t out = vorrq_u32 ( vcgtq_f32 ( vld1q_f32 ( boxes.mXMin + i ), bxMax ), vcltq_f32 ( vld1q_f32 ( boxes.mXMax + i ), bxMin ));
+				out = vorrq_u32 ( out, vorrq_u32 ( vcgtq_f32 ( vld1q_f32 ( boxes.mYMin + i ), byMax ), vcltq_f32 ( vld1q_f32 ( boxes.mYMax + i ), byMin )));
+				out = vorrq_u32 ( out, vorrq_u32 ( vcgtq_f32 ( vld1q_f32 ( boxes.mZMin + i ), bzMax ), vcltq_f32 ( vld1q_f32 ( boxes.mZMax + i ), bzMin )));
+				
+				results [ count ] = i;		count += ( vgetq_lane_u32 ( out, 0 ) & 0x01 ) ^ 0x01;
+				results [ count ] = i + 1;	count += ( vgetq_lane_u32 ( out, 1 ) & 0x01 ) ^ 0x01;
+				results [ count ] = i + 2;	count += ( vgetq_lane_u32 ( out, 2 ) & 0x01 ) ^ 0x01;
+				results [ count ] = i + 3;	count += ( vgetq_lane_u32 ( out, 3 ) & 0x01 ) ^ 0x01;
+			}
+		
+		#endif
+		
+		return count + USCull::BoxScalar ( boxes, i, end - i, box, &results [ count ]);
+	
+	#else
+		return USCull::BoxScalar ( boxes, base, total, box, results );
+	#endif
+}
+
+//----------------------------------------------------------------//
+u32 USCull::BoxScalar ( const USCullBoxes& boxes, u32 base, u32 total, const USBox& box, u32* results ) {
+
+	u32 count = 0;
+	u32 end = base + total;
+	
+	for ( u32 i = base; i < end; ++i ) {
+		if ( !_boxOutside ( boxes, i, box )) {
+			results [ count++ ] = i;
+		}
+	}
+	return count;
+}
+
+//----------------------------------------------------------------//
+u32 USCull::Frustum ( const USCullBoxes& boxes, u32 base, u32 total, const USFrustum& frustum, u32* results ) {
+
+	#if defined ( USCULL_SSE2 ) || defined ( USCULL_NEON )
+	
+		// the bounding box pass is cheap and rejects most boxes
+		u32 count = USCull::Box ( boxes, base, total, frustum.mAABB, results );
+		if ( !( count && frustum.mUsePlanes )) return count;
+		
+		USCullPlane planes [ USFrustum::TOTAL_PLANES ];
+		_initPlanes ( frustum, planes );
+		
+		// survivors are no longer contiguous, so gather them four at a time
+		u32 kept = 0;
+		u32 i = 0;
+		
+		for ( ; ( i + 4 ) <= count; i += 4 ) {
+		
+			u32 idx0 = results [ i ];
+			u32 idx1 = results [ i + 1 ];
+			u32 idx2 = results [ i + 2 ];
+			u32 idx3 = results [ i + 3 ];
+			
+			#if defined ( USCULL_SSE2 )
+			
+				#define GATHER(array) _mm_set_ps ( array [ idx3 ], array [ idx2 ], array [ idx1 ], array [ idx0 ])
+			
+				__m128 xMin = GATHER ( boxes.mXMin );
+				__m128 yMin = GATHER ( boxes.mYMin );
+				__m128 zMin = GATHER ( boxes.mZMin );
+				__m128 xMax = GATHER ( boxes.mXMax );
+				__m128 yMax = GATHER ( boxes.mYMax );
+				__m128 zMax = GATHER ( boxes.mZMax );
+				
+				#undef GATHER
+				
+				__m128 cx = _mm_add_ps ( xMin, xMax );
+				__m128 cy = _mm_add_ps ( yMin, yMax );
+				__m128 cz = _mm_add_ps ( zMin, zMax );
+				
+				__m128 ex = _mm_sub_ps ( xMax, xMin );
+				__m128 ey = _mm_sub_ps ( yMax, yMin );
+				__m128 ez = _mm_sub_ps ( zMax, zMin );
+				
+				__m128 near2 = _mm_set1_ps ( CULL_NEAR * 2.0f );
+				__m128 out = _mm_setzero_ps ();
+				
+				for ( u32 j = 0; j < USFrustum::TOTAL_PLANES; ++j ) {
+				
+					const USCullPlane& plane = planes [ j ];
+				
+					__m128 d = _mm_add_ps ( _mm_add_ps ( _mm_mul_ps ( cx, _mm_set1_ps ( plane.mNX )), _mm_mul_ps ( cy, _mm_set1_ps ( plane.mNY ))), _mm_add_ps ( _mm_mul_ps ( cz, _mm_set1_ps ( plane.mNZ )), _mm_set1_ps ( plane.mDist2 )));
+					__m128 r = _mm_add_ps ( _mm_add_ps ( _mm_mul_ps ( ex, _mm_set1_ps ( plane.mAX )), _mm_mul_ps ( ey, _mm_set1_ps ( plane.mAY ))), _mm_mul_ps ( ez, _mm_set1_ps ( plane.mAZ )));
+					
+					out = _mm_or_ps ( out, _mm_and_ps ( _mm_cmpgt_ps ( d, r ), _mm_cmpge_ps ( d, near2 )));
+				}
+				
+				u32 keep = ~( u32 )_mm_movemask_ps ( out );
+				
+				results [ kept ] = idx0;	kept += keep & 0x01;
+				results [ kept ] = idx1;	kept += ( keep >> 1 ) & 0x01;
+				results [ kept ] = idx2;	kept += ( keep >> 2 ) & 0x01;
+				results [ kept ] = idx3;	kept += ( keep >> 3 ) & 0x01;
+			
+			#else
+			
+				float32x4_t xMin = { boxes.mXMin [ idx0 ], boxes.mXMin [ idx1 ], boxes.mXMin [ idx2 ], boxes.mXMin [ idx3 ]};
+				float32x4_t yMin = { boxes.mYMin [ idx0 ], boxes.mYMin [ idx1 ], boxes.mYMin [ idx2 ], boxes.mYMin [ idx3 ]};
+				float32x4_t zMin = { boxes.mZMin [ idx0 ], boxes.mZMin [ idx1 ], boxes.mZMin [ idx2 ], boxes.mZMin [ idx3 ]};
+				float32x4_t xMax = { boxes.mXMax [ idx0 ], boxes.mXMax [ idx1 ], boxes.mXMax [ idx2 ], boxes.mXMax [ idx3 ]};
+				float32x4_t yMax = { boxes.mYMax [ idx0 ], boxes.mYMax [ idx1 ], boxes.mYMax [ idx2 ], boxes.mYMax [ idx3 ]};
+				float32x4_t zMax = { boxes.mZMax [ idx0 ], boxes.mZMax [ idx1 ], boxes.mZMax [ idx2 ], boxes.mZMax [ idx3 ]};
+				
+				float32x4_t cx = vaddq_f32 ( xMin, xMax );
+				float32x4_t cy = vaddq_f32 ( yMin, yMax );
+				float32x4_t cz = vaddq_f32 ( zMin, zMax );
+				
+				float32x4_t ex = vsubq_f32 ( xMax, xMin );
+				float32x4_t ey = vsubq_f32 ( yMax, yMin );
+				float32x4_t ez = vsubq_f32 ( zMax, zMin );
+				
+				float32x4_t near2 = vdupq_n_f32 ( CULL_NEAR * 2.0f );
+				uint32x4_t out = vdupq_n_u32 ( 0 );
+				
+				for ( u32 j = 0; j < USFrustum::TOTAL_PLANES; ++j ) {
+				
+					const USCullPlane& plane = planes [ j ];
+					
+					float32x4_t d = vaddq_f32 ( vaddq_f32 ( vmulq_n_f32 ( cx, plane.mNX ), vmulq_n_f32 ( cy, plane.mNY )), vaddq_f32 ( vmulq_n_f32 ( cz, plane.mNZ ), vdupq_n_f32 ( plane.mDist2 )));
+					float32x4_t r = vaddq_f32 ( vaddq_f32 ( vmulq_n_f32 ( ex, plane.mAX ), vmulq_n_f32 ( ey, plane.mAY )), vmulq_n_f32 ( ez, plane.mAZ ));
+					
+					out = vorrq_u32 ( out, vandq_u32 ( vcgtq_f32 ( d, r ), vcgeq_f32 ( d, near2 )));
+				}
+				
+				results [ kept ] = idx0;	kept += ( vgetq_lane_u32 ( out, 0 ) & 0x01 ) ^ 0x01;
+				results [ kept ] = idx1;	kept += ( vgetq_lane_u32 ( out, 1 ) & 0x01 ) ^ 0x01;
+				results [ kept ] = idx2;	kept += ( vgetq_lane_u32 ( out, 2 ) & 0x01 ) ^ 0x01;
+				results [ kept ] = idx3;	kept += ( vgetq_lane_u32 ( out, 3 ) & 0x01 ) ^ 0x01;
+			
+			#endif
+		}
+		
+		for ( ; i < count; ++i ) {
+		
+			u32 idx = results [ i ];
+			bool culled = false;
+			
+			for ( u32 j = 0; ( j < USFrustum::TOTAL_PLANES ) && !culled; ++j ) {
+				culled = _boxInFront ( boxes, idx, planes [ j ]);
+			}
+			
+			if ( !culled ) {
+				results [ kept++ ] = idx;
+			}
+		}
+		return kept;
+	
+	#else
+		return USCull::FrustumScalar ( boxes, base, total, frustum, results );
+	#endif
+}
+
+//----------------------------------------------------------------//
+u32 USCull::FrustumScalar ( const USCullBoxes& boxes, u32 base, u32 total, const USFrustum& frustum, u32* results ) {
+
+	USCullPlane planes [ USFrustum::TOTAL_PLANES ];
+	_initPlanes ( frustum, planes );
+
+	u32 count = 0;
+	u32 end = base + total;
+	
+	for ( u32 i = base; i < end; ++i ) {
+		
+		if ( _boxOutside ( boxes, i, frustum.mAABB )) continue;
+		
+		if ( frustum.mUsePlanes ) {
+		
+			bool culled = false;
+			for ( u32 j = 0; ( j < USFrustum::TOTAL_PLANES ) && !culled; ++j ) {
+				culled = _boxInFront ( boxes, i, planes [ j ]);
+			}
+			if ( culled ) continue;
+		}
+		results [ count++ ] = i;
+	}
+	return count;
+}
+
+//----------------------------------------------------------------//
+bool USCull::IsVectorized () {
+
+	#if defined ( USCULL_SSE2 ) || defined ( USCULL_NEON )
+		return true;
+	#else
+		return false;
+	#endif
+}
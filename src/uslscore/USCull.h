@@ -0,0 +1,45 @@
+// Copyright (c) 2010-2011 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#ifndef	USCULL_H
+#define	USCULL_H
+
+#include <uslscore/USBox.h>
+
+class USFrustum;
+
+//================================================================//
+// USCullBoxes
+//================================================================//
+// A run of boxes stored as structure-of-arrays. All arrays are indexed
+// the same way.
+class USCullBoxes {
+public:
+
+	const float*	mXMin;
+	const float*	mYMin;
+	const float*	mZMin;
+	const float*	mXMax;
+	const float*	mYMax;
+	const float*	mZMax;
+};
+
+//================================================================//
+// USCull
+//================================================================//
+// Batch culling kernels. Each tests the boxes in [ base, base + total ) and
+// writes the indices of the boxes that survive to 'results', returning the
+// count. 'results' must have room for 'total' indices. When SSE2 or NEON is
+// available four boxes are tested at a time; the scalar versions are always
+// compiled and serve as the fallback.
+namespace USCull {
+
+	u32		Box					( const USCullBoxes& boxes, u32 base, u32 total, const USBox& box, u32* results );
+	u32		BoxScalar			( const USCullBoxes& boxes, u32 base, u32 total, const USBox& box, u32* results );
+	u32		Frustum				( const USCullBoxes& boxes, u32 base, u32 total, const USFrustum& frustum, u32* results );
+	u32		FrustumScalar		( const USCullBoxes& boxes, u32 base, u32 total, const USFrustum& frustum, u32* results );
+	bool	IsVectorized		();
+	
+} // namespace USCull
+
+#endif
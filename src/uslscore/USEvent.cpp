@@ -0,0 +1,37 @@
+// Copyright (c) 2010-2011 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#include "pch.h"
+#include <uslscore/USEvent.h>
+#include <uslscore/USEvent_posix.h>
+#include <uslscore/USEvent_win32.h>
+
+//================================================================//
+// USEvent
+//================================================================//
+
+//----------------------------------------------------------------//
+void USEvent::Signal () {
+
+	this->mImpl->Signal ();
+}
+
+//----------------------------------------------------------------//
+USEvent::USEvent () {
+
+	// created up front (unlike USMutex) since the first Signal and Wait may race
+	this->mImpl = new USEventImpl ();
+	this->mImpl->Init ();
+}
+
+//----------------------------------------------------------------//
+USEvent::~USEvent () {
+
+	delete this->mImpl;
+}
+
+//----------------------------------------------------------------//
+void USEvent::Wait () {
+
+	this->mImpl->Wait ();
+}
@@ -0,0 +1,35 @@
+// Copyright (c) 2010-2011 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#ifndef USEVENT_H
+#define USEVENT_H
+
+#include <uslscore/USTypedPtr.h>
+
+class USEventImpl;
+
+//================================================================//
+// USEvent
+//================================================================//
+// Lets one thread sleep until another signals it. A signal sent while
+// nobody is waiting is kept until the next Wait, which then returns at
+// once; several signals before a Wait count as one.
+class USEvent {
+private:
+
+	USEventImpl*	mImpl;
+
+	//----------------------------------------------------------------//
+					USEvent			( const USEvent& ) {}
+	USEvent&		operator =		( const USEvent& ) { return *this; }
+
+public:
+
+	//----------------------------------------------------------------//
+	void			Signal				();
+					USEvent				();
+					~USEvent			();
+	void			Wait				();
+};
+
+#endif
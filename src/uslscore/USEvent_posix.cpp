@@ -0,0 +1,58 @@
+// Copyright (c) 2010-2011 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#include "pch.h"
+#ifndef _WIN32
+
+#include <uslscore/USEvent_posix.h>
+
+//================================================================//
+// USEventImpl
+//================================================================//
+
+//----------------------------------------------------------------//
+void USEventImpl::Init () {
+
+	pthread_mutex_init ( &this->mMutex, 0 );
+	pthread_cond_init ( &this->mCondition, 0 );
+}
+
+//----------------------------------------------------------------//
+void USEventImpl::Signal () {
+
+	pthread_mutex_lock ( &this->mMutex );
+	this->mSignaled = true;
+	pthread_cond_signal ( &this->mCondition );
+	pthread_mutex_unlock ( &this->mMutex );
+}
+
+//----------------------------------------------------------------//
+USEventImpl::USEventImpl () :
+	mSignaled ( false ) {
+
+	memset ( &this->mMutex, 0, sizeof ( pthread_mutex_t ));
+	memset ( &this->mCondition, 0, sizeof ( pthread_cond_t ));
+}
+
+//----------------------------------------------------------------//
+USEventImpl::~USEventImpl () {
+
+	pthread_cond_destroy ( &this->mCondition );
+	pthread_mutex_destroy ( &this->mMutex );
+}
+
+//----------------------------------------------------------------//
+void USEventImpl::Wait () {
+
+	pthread_mutex_lock ( &this->mMutex );
+	
+	// loop since the wait may wake up without a signal
+	while ( !this->mSignaled ) {
+		pthread_cond_wait ( &this->mCondition, &this->mMutex );
+	}
+	this->mSignaled = false;
+	
+	pthread_mutex_unlock ( &this->mMutex );
+}
+
+#endif
@@ -0,0 +1,32 @@
+// Copyright (c) 2010-2011 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#ifndef USEVENT_POSIX_H
+#define USEVENT_POSIX_H
+
+#ifndef _WIN32
+
+#include <uslscore/USThread.h>
+
+//================================================================//
+// USEventImpl
+//================================================================//
+class USEventImpl {
+private:
+
+	friend class USEvent;
+
+	pthread_mutex_t		mMutex;
+	pthread_cond_t		mCondition;
+	bool				mSignaled;
+
+	//----------------------------------------------------------------//
+	void			Init				();
+	void			Signal				();
+					USEventImpl			();
+					~USEventImpl		();
+	void			Wait				();
+};
+
+#endif
+#endif
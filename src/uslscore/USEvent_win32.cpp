@@ -0,0 +1,44 @@
+// Copyright (c) 2010-2011 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#include "pch.h"
+#ifdef _WIN32
+
+#include <uslscore/USEvent_win32.h>
+
+//================================================================//
+// USEventImpl
+//================================================================//
+
+//----------------------------------------------------------------//
+void USEventImpl::Init () {
+}
+
+//----------------------------------------------------------------//
+void USEventImpl::Signal () {
+
+	SetEvent ( this->mEventHandle );
+}
+
+//----------------------------------------------------------------//
+USEventImpl::USEventImpl () {
+
+	// auto reset: a waiting thread clears the signal as it wakes
+	this->mEventHandle = CreateEvent ( NULL, FALSE, FALSE, NULL );
+	assert ( this->mEventHandle );
+}
+
+//----------------------------------------------------------------//
+USEventImpl::~USEventImpl () {
+
+	CloseHandle ( this->mEventHandle );
+	this->mEventHandle = NULL;
+}
+
+//----------------------------------------------------------------//
+void USEventImpl::Wait () {
+
+	WaitForSingleObject ( this->mEventHandle, INFINITE );
+}
+
+#endif
@@ -0,0 +1,31 @@
+// Copyright (c) 2010-2011 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#ifndef USEVENT_WIN32_H
+#define USEVENT_WIN32_H
+
+#ifdef _WIN32
+
+#include <uslscore/USEvent.h>
+#include <windows.h>
+
+//================================================================//
+// USEventImpl
+//================================================================//
+class USEventImpl {
+private:
+
+	friend class USEvent;
+
+	HANDLE			mEventHandle;
+
+	//----------------------------------------------------------------//
+	void			Init				();
+	void			Signal				();
+					USEventImpl			();
+					~USEventImpl		();
+	void			Wait				();
+};
+
+#endif
+#endif
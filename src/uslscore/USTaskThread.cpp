@@ -14,9 +14,10 @@ void USTaskThread::_main ( void* param, USThreadState& threadState ) {
 
 	USTaskThread* taskThread = ( USTaskThread* )param;
 	
+	// sleep between batches instead of polling; PushTask and Stop wake the thread
 	while ( threadState.IsRunning ()) {
 		taskThread->Process ();
-		USThread::Sleep ();
+		taskThread->mWakeEvent.Wait ();
 	}
 }
 
@@ -25,40 +26,65 @@ void USTaskThread::_main ( void* param, USThreadState& threadState ) {
 //================================================================//
 
 //----------------------------------------------------------------//
-void USTaskThread::Process () {
+// Blocks until every task pushed so far has executed, then publishes them.
+void USTaskThread::Drain () {
+
+	while ( true ) {
+	
+		this->mMutex.Lock ();
+		bool busy = this->mTaskCount > 0;
+		this->mMutex.Unlock ();
+		
+		if ( !busy ) break;
+		this->mIdleEvent.Wait ();
+	}
+	this->Publish ();
+}
 
-	USLeanLink< USTaskBase* >* i = this->mPendingTasks.Head ();
+//----------------------------------------------------------------//
+void USTaskThread::Process () {
 
-	while ( i ) {
+	while ( true ) {
 
+		// the list is also pushed to from the main thread, so only look at it under the lock
 		this->mMutex.Lock ();
-		USLeanLink< USTaskBase* >* link = i;
-		i = i->Next ();
-		this->mPendingTasks.PopFront ();
-		USTaskBase *task = link->Data ();
+		USLeanLink< USTaskBase* >* link = this->mPendingTasks.Head ();
+		if ( link ) {
+			this->mPendingTasks.PopFront ();
+		}
 		this->mMutex.Unlock ();
-	
+		
+		if ( !link ) break;
+		
+		USTaskBase *task = link->Data ();
 		task->Execute ();
 		
 		this->mMutex.Lock ();
 		this->mCompletedTasks.PushBack ( *link );
+		bool idle = ( --this->mTaskCount == 0 );
 		this->mMutex.Unlock ();
+		
+		if ( idle ) {
+			this->mIdleEvent.Signal ();
+		}
 	}
 }
 
 //----------------------------------------------------------------//
 void USTaskThread::Publish () {
 
-	USLeanLink < USTaskBase* >* i = this->mCompletedTasks.Head ();
-	while ( i ) {
+	while ( true ) {
 
 		this->mMutex.Lock ();
-		USLeanLink< USTaskBase* >* link = i;
-		USTaskBase *task = link->Data ();
-		i = i->Next ();
-		this->mCompletedTasks.PopFront ();
+		USLeanLink< USTaskBase* >* link = this->mCompletedTasks.Head ();
+		if ( link ) {
+			this->mCompletedTasks.PopFront ();
+		}
 		this->mMutex.Unlock ();
+		
+		if ( !link ) break;
 
+		USTaskBase *task = link->Data ();
 		task->Publish ();
 
 		delete link;
@@ -70,20 +96,24 @@ void USTaskThread::PushTask ( USTaskBase& task ) {
 
 	this->mMutex.Lock ();
 	this->mPendingTasks.PushBack ( *new USLeanLink < USTaskBase * >( &task ));
+	this->mTaskCount++;
 	this->mMutex.Unlock ();
 	
 	this->mThread.Start ( _main, this, 0 );
+	this->mWakeEvent.Signal ();
 }
 
 //----------------------------------------------------------------//
 void USTaskThread::Stop () {
 
 	this->mThread.Stop ();
+	this->mWakeEvent.Signal ();
 	this->mThread.Join ();
 }
 
 //----------------------------------------------------------------//
-USTaskThread::USTaskThread () {
+USTaskThread::USTaskThread () :
+	mTaskCount ( 0 ) {
 }
 
 //----------------------------------------------------------------//
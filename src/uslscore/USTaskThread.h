@@ -4,6 +4,7 @@
 #ifndef USTASKTHREAD_H
 #define USTASKTHREAD_H
 
+#include <uslscore/USEvent.h>
 #include <uslscore/USLeanList.h>
 #include <uslscore/USMutex.h>
 #include <uslscore/USThread.h>
@@ -21,6 +22,10 @@ private:
 	USThread					mThread;
 	USMutex						mMutex;
 	
+	u32							mTaskCount;		// pushed but not yet executed; guarded by mMutex
+	USEvent						mWakeEvent;		// signaled when a task is pushed or the thread is stopped
+	USEvent						mIdleEvent;		// signaled when the last pending task has executed
+	
 	//----------------------------------------------------------------//
 	static void		_main					( void* param, USThreadState& threadState );
 
@@ -33,6 +38,7 @@ public:
 	friend class USTaskBase;
 
 	//----------------------------------------------------------------//
+	void			Drain					();
 	void			Publish					();
 	void			Stop					();
 					USTaskThread			();
@@ -16,6 +16,7 @@
 #include <uslscore/USAdapterInfo.h>
 #include <uslscore/USAccessors.h>
 #include <uslscore/USAffine2D.h>
+#include <uslscore/USAffineBatch.h>
 #include <uslscore/USBase64Encoder.h>
 #include <uslscore/USBase64Reader.h>
 #include <uslscore/USBase64Writer.h>
@@ -24,6 +25,7 @@
 #include <uslscore/USByteStream.h>
 #include <uslscore/USCgt.h>
 #include <uslscore/USColor.h>
+#include <uslscore/USCull.h>
 #include <uslscore/USCurve.h>
 #include <uslscore/USData.h>
 #include <uslscore/USDataIOTask.h>
@@ -33,6 +35,9 @@
 #include <uslscore/USDeviceTime.h>
 #include <uslscore/USDirectoryItr.h>
 #include <uslscore/USDistance.h>
+#include <uslscore/USEvent.h>
+#include <uslscore/USEvent_posix.h>
+#include <uslscore/USEvent_win32.h>
 #include <uslscore/USFactory.h>
 #include <uslscore/USFileStream.h>
 #include <uslscore/USFileSys.h>
@@ -0,0 +1,98 @@
+----------------------------------------------------------------
+-- Copyright (c) 2010-2011 Zipline Games, Inc. 
+-- All Rights Reserved. 
+-- http://getmoai.com
+----------------------------------------------------------------
+
+local function evaluate ( pass, str )
+	if not pass then
+		MOAITestMgr.comment ( "FAILED\t" .. str )
+		success = false
+	end
+end
+
+local TOTAL_KEYS = 64
+local TOLERANCE = 0.01
+
+function makeCurve ()
+
+	local curve = MOAIAnimCurve.new ()
+	curve:reserveKeys ( TOTAL_KEYS )
+	
+	math.randomseed ( 1 )
+	
+	for i = 1, TOTAL_KEYS do
+		curve:setKey ( i, ( i - 1 ) * 0.25, math.random () * 10, MOAIEaseType.LINEAR )
+	end
+	return curve
+end
+
+function test ()
+
+	MOAITestMgr.beginTest ( 'MOAIAnimCurve' )
+	success = true
+	
+	local curve = makeCurve ()
+	local length = curve:getLength ()
+	
+	for _, mode in ipairs ({ MOAIAnimCurve.CLAMP, MOAIAnimCurve.WRAP, MOAIAnimCurve.MIRROR, MOAIAnimCurve.APPEND }) do
+	
+		curve:setWrapMode ( mode )
+		
+		-- sample forward past the end, then at random, so the cached key is both reused and missed
+		local times = {}
+		for t = -1, length * 2.5, 0.01 do
+			table.insert ( times, t )
+		end
+		for i = 1, 200 do
+			table.insert ( times, ( math.random () * 3 - 1 ) * length )
+		end
+		
+		local reference = {}
+		for i, t in ipairs ( times ) do
+			reference [ i ] = curve:getValueAtTime ( t )
+		end
+		
+		-- one link through ApplyAttrOp, one written in place
+		local anim = MOAIAnim.new ()
+		local target = MOAIAnimCurve.new ()
+		local transform = MOAITransform.new ()
+		anim:reserveLinks ( 2 )
+		anim:setLink ( 1, curve, target, MOAIAnimCurve.ATTR_VALUE )
+		anim:setLink ( 2, curve, transform, MOAITransform.ATTR_X_LOC )
+		
+		for i, t in ipairs ( times ) do
+			anim:apply ( t )
+			if target:getAttr ( MOAIAnimCurve.ATTR_VALUE ) ~= reference [ i ] then
+				evaluate ( false, string.format ( 'mode %d: linked value at %f does not match', mode, t ))
+				break
+			end
+			if transform:getAttr ( MOAITransform.ATTR_X_LOC ) ~= reference [ i ] then
+				evaluate ( false, string.format ( 'mode %d: linked location at %f does not match', mode, t ))
+				break
+			end
+		end
+		
+		-- keys are a quarter apart and linear, so a table at 4x the key rate lands on every key
+		curve:bake ( 16 )
+		
+		for i, t in ipairs ( times ) do
+			if math.abs ( curve:getValueAtTime ( t ) - reference [ i ]) > TOLERANCE then
+				evaluate ( false, string.format ( 'mode %d: baked value at %f out of tolerance', mode, t ))
+				break
+			end
+		end
+		
+		curve:bake ()
+	end
+	
+	MOAITestMgr.endTest ( success )
+end
+
+function stage ()
+	MOAITestMgr.comment ( 'staging MOAIAnimCurve' )
+end
+
+MOAITestMgr.setStagingFunc ( stage )
+MOAITestMgr.setTestFunc ( test )
+MOAITestMgr.setFilter ( MOAITestMgr.UTIL )
@@ -0,0 +1,127 @@
+----------------------------------------------------------------
+-- Copyright (c) 2010-2011 Zipline Games, Inc.
+-- All Rights Reserved.
+-- http://getmoai.com
+----------------------------------------------------------------
+
+local function evaluate ( pass, str )
+	if not pass then
+		MOAITestMgr.comment ( "FAILED\t" .. str )
+		success = false
+	end
+end
+
+local FONT_A = '../MOAITextBox/arial-rounded.TTF'
+local FONT_B = '../MOAITextBox/Dwarves.TTF'
+
+local MAX_FRAMES = 120
+
+-- each batch is preloaded into both fonts; the async font renders its
+-- batches on the glyph thread, reopening the face only when the file changes
+local batches = {
+	{ FONT_A, 'abcdefghijklm', 24 },
+	{ FONT_A, 'nopqrstuvwxyz', 24 },
+	{ FONT_A, 'ABCDEFGHIJKLMNOPQRSTUVWXYZ', 16 },
+	{ FONT_B, '0123456789.,!?', 24 },
+}
+
+function grabFrame ()
+
+	local img = MOAIImage.new ()
+	local grabbed = false
+
+	MOAIRenderMgr.grabNextFrame ( img, function ()
+		grabbed = true
+	end )
+
+	repeat coroutine.yield () until grabbed
+	return img
+end
+
+-- yields until the async font's cache matches the sync font's
+function waitForGlyphs ()
+
+	for i = 1, MAX_FRAMES do
+		local syncImage = syncFont:getImage ()
+		local asyncImage = asyncFont:getImage ()
+		if syncImage and asyncImage and syncImage:compare ( asyncImage ) then
+			return true
+		end
+		coroutine.yield ()
+	end
+	return false
+end
+
+function compare ()
+
+	for i, batch in ipairs ( batches ) do
+
+		local filename, charcodes, size = unpack ( batch )
+
+		if syncFont:getFilename () ~= filename then
+			syncFont:load ( filename )
+			asyncFont:load ( filename )
+		end
+
+		syncFont:preloadGlyphs ( charcodes, size )
+		asyncFont:preloadGlyphs ( charcodes, size )
+
+		textbox:setTextSize ( size )
+		textbox:setString ( charcodes )
+
+		-- draw before the glyphs arrive so the page's texture already exists and
+		-- the rendered glyphs go up as a partial update
+		textbox:setFont ( asyncFont )
+		grabFrame ()
+
+		evaluate ( waitForGlyphs (), string.format ( 'async glyphs in batch %d never matched the sync glyphs', i ))
+
+		local asyncFrame = grabFrame ()
+
+		textbox:setFont ( syncFont )
+		local syncFrame = grabFrame ()
+
+		evaluate ( asyncFrame:compare ( syncFrame ), string.format ( 'text drawn from the async font differs in batch %d', i ))
+	end
+
+	MOAITestMgr.endTest ( success )
+end
+
+function stage ()
+	MOAITestMgr.comment ( 'staging MOAIFont' )
+end
+
+function test ()
+
+	MOAITestMgr.beginTest ( 'MOAIFont async glyphs' )
+	success = true
+
+	MOAISim.openWindow ( "MOAIFont", 320, 480 )
+
+	viewport = MOAIViewport.new ()
+	viewport:setSize ( 320, 480 )
+	viewport:setScale ( 320, 480 )
+
+	layer = MOAILayer.new ()
+	layer:setViewport ( viewport )
+	MOAISim.pushRenderPass ( layer )
+
+	syncFont = MOAIFont.new ()
+	syncFont:load ( FONT_A )
+
+	asyncFont = MOAIFont.new ()
+	asyncFont:setFlags ( MOAIFont.FONT_ASYNC_RENDER )
+	asyncFont:load ( FONT_A )
+
+	textbox = MOAITextBox.new ()
+	textbox:setRect ( -150, -230, 150, 230 )
+	textbox:setYFlip ( true )
+	layer:insertProp ( textbox )
+
+	thread = MOAIThread.new ()
+	thread:run ( compare )
+end
+
+MOAITestMgr.setStagingFunc ( stage )
+MOAITestMgr.setTestFunc ( test )
+MOAITestMgr.setFilter ( MOAITestMgr.UTIL )
@@ -0,0 +1,176 @@
+----------------------------------------------------------------
+-- Copyright (c) 2010-2011 Zipline Games, Inc.
+-- All Rights Reserved.
+-- http://getmoai.com
+----------------------------------------------------------------
+
+local function evaluate ( pass, str )
+	if not pass then
+		MOAITestMgr.comment ( "FAILED\t" .. str )
+		success = false
+	end
+end
+
+-- 64 x 64 RGBA textures are 16k each; the budget holds three of them
+local TEXTURE_SIZE = 64 * 64 * 4
+local BUDGET = TEXTURE_SIZE * 3
+local MIN_AGE = 4
+
+function grabFrame ()
+
+	local grabbed = false
+
+	MOAIRenderMgr.grabNextFrame ( img, function ()
+		grabbed = true
+	end )
+
+	repeat coroutine.yield () until grabbed
+end
+
+function newTexturedProp ( texture, x )
+
+	local quad = MOAIGfxQuad2D.new ()
+	quad:setTexture ( texture )
+	quad:setRect ( -16, -16, 16, 16 )
+
+	local prop = MOAIProp.new ()
+	prop:setDeck ( quad )
+	prop:setLoc ( x, 0 )
+	layer:insertProp ( prop )
+	return prop
+end
+
+function newTexture ()
+
+	local image = MOAIImage.new ()
+	image:init ( 64, 64 )
+	image:fillRect ( 0, 0, 64, 64, 1, 1, 1, 1 )
+
+	local texture = MOAITexture.new ()
+	texture:load ( image )
+	return texture
+end
+
+function residency ()
+
+	local bytes, budget, resident, evicted, evictions, evictable = MOAIGfxDevice.getTextureResidency ()
+	return {
+		bytes = bytes,
+		budget = budget,
+		resident = resident,
+		evicted = evicted,
+		evictions = evictions,
+		evictable = evictable,
+	}
+end
+
+function evict ()
+
+	grabFrame ()
+
+	local before = residency ()
+	evaluate ( before.resident == 4, string.format ( 'expected 4 resident textures, got %d', before.resident ))
+	evaluate ( before.evicted == 0, string.format ( 'expected no evicted textures, got %d', before.evicted ))
+	evaluate ( before.evictable == ( TEXTURE_SIZE * 4 ), string.format ( 'expected %d evictable bytes, got %d', TEXTURE_SIZE * 4, before.evictable ))
+	evaluate ( before.bytes > before.evictable, 'the image texture should count toward bytes but not evictable bytes' )
+	evaluate ( before.budget == 0, 'there should be no budget by default' )
+
+	MOAIGfxDevice.setTextureBudget ( BUDGET, MIN_AGE )
+	evaluate ( residency ().budget == BUDGET, 'getTextureResidency should report the budget' )
+
+	-- A goes idle first and B two frames later; only one has to go to meet the budget,
+	-- and it should be the one bound longest ago. D is drawn every other frame, and with
+	-- the image texture left out of the budget, the device never needs to evict it.
+	propA:setVisible ( false )
+
+	for frame = 1, MIN_AGE * 3 do
+
+		if frame == 3 then
+			propB:setVisible ( false )
+		end
+		propD:setVisible ( frame % 2 == 0 )
+
+		grabFrame ()
+
+		if frame < MIN_AGE then
+			evaluate ( textureA:isResident (), string.format ( 'A was evicted after only %d frames unbound', frame ))
+		end
+	end
+
+	evaluate ( not textureA:isResident (), 'A should have been evicted' )
+	evaluate ( textureB:isResident (), 'B was evicted, but A had gone unbound longer' )
+	evaluate ( textureC:isResident (), 'C was evicted while being drawn every frame' )
+	evaluate ( textureD:getEvictionCount () == 0, 'D was evicted while being drawn every other frame' )
+	evaluate ( imageTexture:isResident (), 'the image texture was evicted' )
+
+	local after = residency ()
+	evaluate ( after.resident == 3, string.format ( 'expected 3 resident textures, got %d', after.resident ))
+	evaluate ( after.evicted == 1, string.format ( 'expected 1 evicted texture, got %d', after.evicted ))
+	evaluate ( after.evictions == ( before.evictions + 1 ), string.format ( 'expected 1 eviction, got %d', after.evictions - before.evictions ))
+	evaluate ( after.evictable <= BUDGET, 'evictable textures are still over budget' )
+
+	-- a texture bound for a single frame is the newest; B is the one to go
+	local textureE = newTexture ()
+	local propE = newTexturedProp ( textureE, 96 )
+	grabFrame ()
+	propE:setVisible ( false )
+	grabFrame ()
+
+	evaluate ( textureE:isResident (), 'a just uploaded texture was evicted' )
+	evaluate ( not textureB:isResident (), 'B should have been evicted to make room for E' )
+
+	-- binding A again brings it back
+	propA:setVisible ( true )
+	grabFrame ()
+	evaluate ( textureA:isResident (), 'A did not come back after it was bound again' )
+	evaluate ( textureA:getEvictionCount () == 1, string.format ( 'A was evicted %d times', textureA:getEvictionCount ()))
+
+	MOAIGfxDevice.setTextureBudget ()
+	MOAITestMgr.endTest ( success )
+end
+
+function stage ()
+	MOAITestMgr.comment ( 'staging MOAIGfxDevice' )
+end
+
+function test ()
+
+	MOAITestMgr.beginTest ( 'MOAIGfxDevice texture eviction' )
+	success = true
+
+	MOAISim.openWindow ( "MOAIGfxDevice", 320, 480 )
+
+	viewport = MOAIViewport.new ()
+	viewport:setSize ( 320, 480 )
+	viewport:setScale ( 320, 480 )
+
+	layer = MOAILayer.new ()
+	layer:setViewport ( viewport )
+	MOAISim.pushRenderPass ( layer )
+
+	img = MOAIImage.new ()
+
+	textureA = newTexture ()
+	textureB = newTexture ()
+	textureC = newTexture ()
+	textureD = newTexture ()
+
+	propA = newTexturedProp ( textureA, -128 )
+	propB = newTexturedProp ( textureB, -64 )
+	propC = newTexturedProp ( textureC, 0 )
+	propD = newTexturedProp ( textureD, 64 )
+
+	-- font pages and other image textures can't be evicted
+	imageTexture = MOAIImageTexture.new ()
+	imageTexture:init ( 64, 64 )
+	imageTexture:fillRect ( 0, 0, 64, 64, 1, 1, 1, 1 )
+	imageTexture:invalidate ()
+	newTexturedProp ( imageTexture, 128 )
+
+	thread = MOAIThread.new ()
+	thread:run ( evict )
+end
+
+MOAITestMgr.setStagingFunc ( stage )
+MOAITestMgr.setTestFunc ( test )
+MOAITestMgr.setFilter ( MOAITestMgr.UTIL )
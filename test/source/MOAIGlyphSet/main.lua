@@ -0,0 +1,118 @@
+----------------------------------------------------------------
+-- Copyright (c) 2010-2011 Zipline Games, Inc.
+-- All Rights Reserved.
+-- http://getmoai.com
+----------------------------------------------------------------
+
+local function evaluate ( pass, str )
+	if not pass then
+		MOAITestMgr.comment ( "FAILED\t" .. str )
+		success = false
+	end
+end
+
+-- glyphs.fnt has glyphs on code pages 0x00, 0x04, 0xAC and 0x1F6, and kerning
+-- between glyphs on the same page and on different pages
+local WIDTH		= { [ 65 ] = 10, [ 86 ] = 11, [ 87 ] = 14, [ 1046 ] = 12, [ 44032 ] = 16, [ 128512 ] = 17 }
+local ADVANCE	= { [ 65 ] = 12, [ 86 ] = 13, [ 87 ] = 16, [ 1046 ] = 14, [ 44032 ] = 18, [ 128512 ] = 19 }
+
+local KERNING = {
+	[ 65 ] = { [ 86 ] = -3, [ 44032 ] = -1 },
+	[ 86 ] = { [ 65 ] = -2 },
+	[ 1046 ] = { [ 65 ] = 2 },
+	[ 44032 ] = { [ 128512 ] = -4 },
+	[ 128512 ] = { [ 1046 ] = 5 },
+}
+
+-- encodes a code point as UTF-8
+local function encode ( c )
+
+	if c < 0x80 then
+		return string.char ( c )
+	elseif c < 0x800 then
+		return string.char ( 0xC0 + math.floor ( c / 0x40 ), 0x80 + ( c % 0x40 ))
+	elseif c < 0x10000 then
+		return string.char ( 0xE0 + math.floor ( c / 0x1000 ), 0x80 + ( math.floor ( c / 0x40 ) % 0x40 ), 0x80 + ( c % 0x40 ))
+	end
+	return string.char ( 0xF0 + math.floor ( c / 0x40000 ), 0x80 + ( math.floor ( c / 0x1000 ) % 0x40 ), 0x80 + ( math.floor ( c / 0x40 ) % 0x40 ), 0x80 + ( c % 0x40 ))
+end
+
+-- lays out the code points and checks each glyph's left edge and width against
+-- the advances and kerning above; a glyph the font doesn't have is skipped and
+-- breaks the kerning between its neighbors
+function checkLayout ( name, codes )
+
+	local text = ''
+	local starts = {}
+
+	for i, c in ipairs ( codes ) do
+		starts [ i ] = #text + 1
+		text = text .. encode ( c )
+	end
+
+	textbox:setString ( text )
+
+	local pen = 0
+	local prev = nil
+	local origin = nil
+
+	for i, c in ipairs ( codes ) do
+
+		local xMin, yMin, xMax, yMax = textbox:getStringBounds ( starts [ i ], 1 )
+
+		if WIDTH [ c ] then
+
+			if prev then
+				pen = pen + (( KERNING [ prev ] and KERNING [ prev ][ c ]) or 0 )
+			end
+
+			evaluate ( xMin ~= nil, string.format ( '%s: no glyph for 0x%x', name, c ))
+
+			if xMin then
+				origin = origin or ( xMin - pen )
+				evaluate ( xMin - origin == pen, string.format ( '%s: glyph %d (0x%x) at %g instead of %g', name, i, c, xMin - origin, pen ))
+				evaluate ( xMax - xMin == WIDTH [ c ], string.format ( '%s: glyph %d (0x%x) is %g wide instead of %g', name, i, c, xMax - xMin, WIDTH [ c ]))
+			end
+
+			pen = pen + ADVANCE [ c ]
+			prev = c
+		else
+			evaluate ( xMin == nil, string.format ( '%s: drew a glyph for 0x%x, which the font does not have', name, c ))
+			prev = nil
+		end
+	end
+end
+
+function stage ()
+	MOAITestMgr.comment ( 'staging MOAIGlyphSet' )
+end
+
+function test ()
+
+	MOAITestMgr.beginTest ( 'MOAIGlyphSet lookup and kerning' )
+	success = true
+
+	font = MOAIFont.new ()
+	font:loadFromBMFont ( 'glyphs.fnt' )
+
+	textbox = MOAITextBox.new ()
+	textbox:setFont ( font )
+	textbox:setTextSize ( 32, 72 )
+	textbox:setRect ( -200, -50, 200, 50 )
+
+	-- pairs on one page, and on neighboring and distant pages
+	checkLayout ( 'same page', { 65, 86, 65, 86 })
+	checkLayout ( 'across pages', { 65, 44032, 128512, 1046, 65 })
+
+	-- A and W have no pair; neither do V and the Hangul syllable
+	checkLayout ( 'missing pair', { 65, 87, 65, 86, 44032, 86 })
+
+	-- B isn't in the font, on a page that has glyphs; U+4100 is on a page that has none
+	checkLayout ( 'missing glyph', { 65, 66, 86, 0x4100, 65 })
+
+	MOAITestMgr.endTest ( success )
+end
+
+MOAITestMgr.setStagingFunc ( stage )
+MOAITestMgr.setTestFunc ( test )
+MOAITestMgr.setFilter ( MOAITestMgr.UTIL )
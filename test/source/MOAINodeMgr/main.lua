@@ -0,0 +1,122 @@
+----------------------------------------------------------------
+-- Copyright (c) 2010-2011 Zipline Games, Inc. 
+-- All Rights Reserved. 
+-- http://getmoai.com
+----------------------------------------------------------------
+
+local function evaluate ( pass, str )
+	if not pass then
+		MOAITestMgr.comment ( "FAILED\t" .. str )
+		success = false
+	end
+end
+
+-- levels need at least 64 nodes that can update in parallel before any go to the workers
+local LEVEL_COUNT = 4
+local LEVEL_SIZE = 256
+local TOTAL_STEPS = 8
+
+-- a mix of classes that opt in to parallel updates and classes that don't
+local CLASSES = {
+	MOAITransform,
+	MOAICamera,
+	MOAIScissorRect,
+	MOAIParticleForce,
+	MOAILayoutFrame,
+	MOAIProp,
+}
+
+function makeTree ()
+
+	local nodes = {}
+	local previous = {}
+	
+	math.randomseed ( 1 )
+	
+	for level = 1, LEVEL_COUNT do
+		local current = {}
+		for i = 1, LEVEL_SIZE do
+			local class = CLASSES [ math.random ( #CLASSES )]
+			local node = class.new ()
+			if #previous > 0 then
+				node:setParent ( previous [ math.random ( #previous )])
+			end
+			table.insert ( current, node )
+			table.insert ( nodes, node )
+		end
+		previous = current
+	end
+	return nodes
+end
+
+-- sets every node so every node is scheduled, whatever the previous step did
+function pose ( nodes, seed )
+
+	math.randomseed ( seed )
+	
+	for i, node in ipairs ( nodes ) do
+		node:setLoc ( math.random ( -100, 100 ), math.random ( -100, 100 ), math.random ( -100, 100 ))
+		node:setRot ( math.random ( 0, 360 ), math.random ( 0, 360 ), math.random ( 0, 360 ))
+		node:setScl ( math.random ( 50, 150 ) / 100, math.random ( 50, 150 ) / 100, 1 )
+		node:setPiv ( math.random ( -10, 10 ), math.random ( -10, 10 ), 0 )
+	end
+end
+
+function record ( nodes )
+
+	local results = {}
+	for i, node in ipairs ( nodes ) do
+		local x, y, z = node:getWorldLoc ()
+		local rot = node:getWorldRot ()
+		local sx, sy, sz = node:getWorldScl ()
+		results [ i ] = string.format ( '%.4f %.4f %.4f %.4f %.4f %.4f %.4f', x, y, z, rot, sx, sy, sz )
+	end
+	return results
+end
+
+-- poses the tree, lets the node manager update it and records the world transforms
+function update ( nodes, seed, parallel )
+
+	MOAISim.setParallelNodeUpdate ( parallel )
+	pose ( nodes, seed )
+	coroutine.yield ()
+	return record ( nodes )
+end
+
+function compare ()
+
+	local nodes = makeTree ()
+	
+	for step = 1, TOTAL_STEPS do
+	
+		local parallel = update ( nodes, step, true )
+		local serial = update ( nodes, step, false )
+		
+		for i = 1, #nodes do
+			if parallel [ i ] ~= serial [ i ] then
+				evaluate ( false, string.format ( 'node %d differs at step %d: "%s" instead of "%s"', i, step, parallel [ i ], serial [ i ]))
+				break
+			end
+		end
+	end
+	
+	MOAISim.setParallelNodeUpdate ( false )
+	MOAITestMgr.endTest ( success )
+end
+
+function stage ()
+	MOAITestMgr.comment ( 'staging MOAINodeMgr' )
+end
+
+function test ()
+
+	MOAITestMgr.beginTest ( 'MOAINodeMgr' )
+	success = true
+	
+	local thread = MOAIThread.new ()
+	thread:run ( compare )
+end
+
+MOAITestMgr.setStagingFunc ( stage )
+MOAITestMgr.setTestFunc ( test )
+MOAITestMgr.setFilter ( MOAITestMgr.UTIL )
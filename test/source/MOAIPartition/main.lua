@@ -0,0 +1,106 @@
+----------------------------------------------------------------
+-- Copyright (c) 2010-2011 Zipline Games, Inc. 
+-- All Rights Reserved. 
+-- http://getmoai.com
+----------------------------------------------------------------
+
+local function evaluate ( pass, str )
+	if not pass then
+		MOAITestMgr.comment ( "FAILED\t" .. str )
+		success = false
+	end
+end
+
+local TOTAL_PROPS = 10000
+local TOTAL_FRAMES = 30
+local WORLD_SIZE = 1024
+
+function makeProps ( partition )
+
+	local props = {}
+	
+	for i = 1, TOTAL_PROPS do
+		local prop = MOAIProp.new ()
+		prop:setBounds ( -2, -2, 0, 2, 2, 0 )
+		prop:setLoc ( math.random ( 0, WORLD_SIZE ), math.random ( 0, WORLD_SIZE ))
+		partition:insertProp ( prop )
+		prop:forceUpdate ()
+		props [ i ] = prop
+	end
+	return props
+end
+
+-- count the props overlapping a rect the slow way
+function countInRect ( props, xMin, yMin, xMax, yMax )
+
+	local count = 0
+	for i, prop in ipairs ( props ) do
+		local x0, y0, z0, x1, y1, z1 = prop:getWorldBounds ()
+		if x0 and x0 <= xMax and x1 >= xMin and y0 <= yMax and y1 >= yMin then
+			count = count + 1
+		end
+	end
+	return count
+end
+
+function stage ()
+	MOAITestMgr.comment ( 'staging MOAIPartition' )
+end
+
+function test ()
+	
+	MOAITestMgr.beginTest ( 'MOAIPartition' )
+	success = true
+	
+	local partition = MOAIPartition.new ()
+	partition:reserveLevels ( 1 )
+	partition:setLevel ( 1, 16, WORLD_SIZE / 16, WORLD_SIZE / 16 )
+	
+	local props = makeProps ( partition )
+	
+	local rect = { 256, 256, 512, 512 }
+	local moveTime = 0
+	local queryTime = 0
+	
+	for frame = 1, TOTAL_FRAMES do
+	
+		-- most moves stay inside the prop's cell; a few cross into the next one
+		local t0 = MOAISim.getDeviceTime ()
+		for i, prop in ipairs ( props ) do
+			prop:addLoc ( math.random ( -2, 2 ), math.random ( -2, 2 ))
+			prop:forceUpdate ()
+		end
+		local t1 = MOAISim.getDeviceTime ()
+		local total = #{ partition:propListForRect ( unpack ( rect ))}
+		local t2 = MOAISim.getDeviceTime ()
+		
+		moveTime = moveTime + ( t1 - t0 )
+		queryTime = queryTime + ( t2 - t1 )
+		
+		evaluate ( total == countInRect ( props, unpack ( rect )), string.format ( 'frame %d: wrong prop count in rect', frame ))
+	end
+	
+	MOAITestMgr.comment ( string.format ( 'moving %d props: %.3fms per frame', TOTAL_PROPS, ( moveTime / TOTAL_FRAMES ) * 1000 ))
+	MOAITestMgr.comment ( string.format ( 'querying rect: %.3fms per frame', ( queryTime / TOTAL_FRAMES ) * 1000 ))
+	
+	-- removing props with moves still queued must leave the partition consistent
+	for i = 1, TOTAL_PROPS, 2 do
+		props [ i ]:addLoc ( 64, 64 )
+		props [ i ]:forceUpdate ()
+		partition:removeProp ( props [ i ])
+	end
+	
+	local remaining = {}
+	for i = 2, TOTAL_PROPS, 2 do
+		table.insert ( remaining, props [ i ])
+	end
+	
+	local total = #{ partition:propListForRect ( unpack ( rect ))}
+	evaluate ( total == countInRect ( remaining, unpack ( rect )), 'wrong prop count after removal' )
+	
+	MOAITestMgr.endTest ( success )
+end
+
+MOAITestMgr.setStagingFunc ( stage )
+MOAITestMgr.setTestFunc ( test )
+MOAITestMgr.setFilter ( MOAITestMgr.PERFORMANCE )
@@ -0,0 +1,114 @@
+----------------------------------------------------------------
+-- Copyright (c) 2010-2011 Zipline Games, Inc. 
+-- All Rights Reserved. 
+-- http://getmoai.com
+----------------------------------------------------------------
+
+local function evaluate ( pass, str )
+	if not pass then
+		MOAITestMgr.comment ( "FAILED\t" .. str )
+		success = false
+	end
+end
+
+local GRID_SIZE = 256
+local TOTAL_QUERIES = 200
+
+-- open grid with a wall across every 32nd row; each wall has a single gap at alternating ends
+function makeGrid ()
+
+	local grid = MOAIGrid.new ()
+	grid:initRectGrid ( GRID_SIZE, GRID_SIZE, 1, 1 )
+	
+	for y = 1, GRID_SIZE do
+		local wall = ( y % 32 ) == 0
+		local gap = (( y / 32 ) % 2 ) == 0 and GRID_SIZE or 1
+		for x = 1, GRID_SIZE do
+			grid:setTile ( x, y, ( wall and x ~= gap ) and 0 or 1 )
+		end
+	end
+	return grid
+end
+
+function makeQueries ( grid )
+
+	local queries = {}
+	math.randomseed ( 1 )
+	
+	while #queries < TOTAL_QUERIES do
+		local x0, y0 = math.random ( GRID_SIZE ), math.random ( GRID_SIZE )
+		local x1, y1 = math.random ( GRID_SIZE ), math.random ( GRID_SIZE )
+		if grid:getTile ( x0, y0 ) ~= 0 and grid:getTile ( x1, y1 ) ~= 0 then
+			table.insert ( queries, { grid:getCellAddr ( x0, y0 ), grid:getCellAddr ( x1, y1 )})
+		end
+	end
+	return queries
+end
+
+function solve ()
+
+	local grid = makeGrid ()
+	local queries = makeQueries ( grid )
+	
+	local pathFinder = MOAIPathFinder.new ()
+	pathFinder:setGraph ( grid )
+	pathFinder:setHeuristic ( MOAIGridPathGraph.DIAGONAL_DISTANCE )
+	
+	local batch = MOAIPathBatch.new ()
+	batch:init ( pathFinder )
+	
+	for i, query in ipairs ( queries ) do
+		evaluate ( batch:addQuery ( query [ 1 ], query [ 2 ]) == i, 'unexpected query index' )
+	end
+	
+	local t0 = MOAISim.getDeviceTime ()
+	
+	batch:start ()
+	
+	-- the batch works on a copy of the grid, so this must not affect the results
+	grid:setTile ( 1, 32, 0 )
+	evaluate ( batch:addQuery ( 1, 1 ) == nil, 'query added to a running batch' )
+	
+	MOAIThread.blockOnAction ( batch )
+	
+	local elapsed = MOAISim.getDeviceTime () - t0
+	MOAITestMgr.comment ( string.format ( '%d queries in %.3fms', #queries, elapsed * 1000 ))
+	
+	grid:setTile ( 1, 32, 1 )
+	
+	-- results must match the same queries solved on the main thread
+	for i, query in ipairs ( queries ) do
+	
+		pathFinder:init ( query [ 1 ], query [ 2 ])
+		pathFinder:findPath ()
+		
+		local size = pathFinder:getPathSize ()
+		evaluate ( batch:getPathSize ( i ) == size, string.format ( 'path size mismatch for query %d', i ))
+		
+		for j = 1, size do
+			if batch:getPathEntry ( i, j ) ~= pathFinder:getPathEntry ( j ) then
+				evaluate ( false, string.format ( 'path mismatch for query %d', i ))
+				break
+			end
+		end
+	end
+	
+	MOAITestMgr.endTest ( success )
+end
+
+function stage ()
+	MOAITestMgr.comment ( 'staging MOAIPathBatch' )
+end
+
+function test ()
+	
+	MOAITestMgr.beginTest ( 'MOAIPathBatch' )
+	success = true
+	
+	local thread = MOAIThread.new ()
+	thread:run ( solve )
+end
+
+MOAITestMgr.setStagingFunc ( stage )
+MOAITestMgr.setTestFunc ( test )
+MOAITestMgr.setFilter ( MOAITestMgr.PERFORMANCE )
@@ -0,0 +1,157 @@
+----------------------------------------------------------------
+-- Copyright (c) 2010-2011 Zipline Games, Inc. 
+-- All Rights Reserved. 
+-- http://getmoai.com
+----------------------------------------------------------------
+
+local function evaluate ( pass, str )
+	if not pass then
+		MOAITestMgr.comment ( "FAILED\t" .. str )
+		success = false
+	end
+end
+
+local GRID_SIZE = 512
+
+-- open grid with a wall across every 32nd row; each wall has a single gap at alternating ends
+function makeGrid ()
+
+	local grid = MOAIGrid.new ()
+	grid:initRectGrid ( GRID_SIZE, GRID_SIZE, 1, 1 )
+	
+	for y = 1, GRID_SIZE do
+		local wall = ( y % 32 ) == 0
+		local gap = (( y / 32 ) % 2 ) == 0 and GRID_SIZE or 1
+		for x = 1, GRID_SIZE do
+			grid:setTile ( x, y, ( wall and x ~= gap ) and 0 or 1 )
+		end
+	end
+	return grid
+end
+
+function findPath ( graph, flags, x0, y0, x1, y1 )
+
+	local grid = graph.grid
+
+	local pathFinder = MOAIPathFinder.new ()
+	pathFinder:setGraph ( graph.graph )
+	pathFinder:setFlags ( flags )
+	pathFinder:setHeuristic ( MOAIGridPathGraph.DIAGONAL_DISTANCE )
+	pathFinder:init ( grid:getCellAddr ( x0, y0 ), grid:getCellAddr ( x1, y1 ))
+	
+	-- step one node at a time so we can count expansions
+	local nodes = 0
+	local t0 = MOAISim.getDeviceTime ()
+	while pathFinder:findPath ( 1 ) do
+		nodes = nodes + 1
+	end
+	local elapsed = MOAISim.getDeviceTime () - t0
+	
+	return pathFinder, nodes, elapsed
+end
+
+-- waypoints must be joined by a straight or diagonal run of open cells
+function checkRun ( grid, x0, y0, x1, y1 )
+
+	local dx = x1 - x0
+	local dy = y1 - y0
+	
+	if dx ~= 0 and dy ~= 0 and math.abs ( dx ) ~= math.abs ( dy ) then return false end
+	
+	local steps = math.max ( math.abs ( dx ), math.abs ( dy ))
+	local sx = dx == 0 and 0 or dx / math.abs ( dx )
+	local sy = dy == 0 and 0 or dy / math.abs ( dy )
+	
+	for i = 1, steps do
+		if grid:getTile ( x0 + ( sx * i ), y0 + ( sy * i )) == 0 then return false end
+	end
+	return true
+end
+
+function checkPath ( grid, flags, pathFinder, x0, y0, x1, y1 )
+
+	local size = pathFinder:getPathSize ()
+	evaluate ( size > 0, 'no path found' )
+	if size == 0 then return end
+	
+	local px, py = grid:cellAddrToCoord ( pathFinder:getPathEntry ( 1 ))
+	evaluate ( px == x0 and py == y0, 'path does not start at start node' )
+	
+	for i = 2, size do
+		local x, y = grid:cellAddrToCoord ( pathFinder:getPathEntry ( i ))
+		
+		if flags == MOAIGridPathGraph.JUMP_POINT_SEARCH then
+			evaluate ( checkRun ( grid, px, py, x, y ), 'jump crosses a wall' )
+		elseif flags == MOAIGridPathGraph.HIERARCHICAL then
+			evaluate ( grid:getTile ( x, y ) ~= 0, 'waypoint is in a wall' )
+		else
+			evaluate ( math.abs ( x - px ) <= 1 and math.abs ( y - py ) <= 1, 'path is not contiguous' )
+			evaluate ( grid:getTile ( x, y ) ~= 0, 'path crosses a wall' )
+		end
+		px, py = x, y
+	end
+	evaluate ( px == x1 and py == y1, 'path does not end at target node' )
+end
+
+function stage ()
+	MOAITestMgr.comment ( 'staging MOAIPathFinder' )
+end
+
+function test ()
+	
+	MOAITestMgr.beginTest ( 'MOAIPathFinder' )
+	success = true
+	
+	local grid = makeGrid ()
+	
+	-- share one graph so the hierarchical abstraction is only built once
+	local graph = { grid = grid, graph = MOAIGridPathGraph.new ()}
+	graph.graph:setGrid ( grid )
+	
+	local queries = {
+		{ 1, 1, GRID_SIZE, GRID_SIZE },
+		{ GRID_SIZE, 1, 1, GRID_SIZE },
+		{ 1, GRID_SIZE / 2, GRID_SIZE, GRID_SIZE / 2 },
+	}
+	
+	local modes = {
+		{ 'A*', 0 },
+		{ 'jump point search', MOAIGridPathGraph.JUMP_POINT_SEARCH },
+		{ 'hierarchical', MOAIGridPathGraph.HIERARCHICAL },
+	}
+	
+	for i, mode in ipairs ( modes ) do
+	
+		local name, flags = unpack ( mode )
+		local totalNodes = 0
+		local totalTime = 0
+		
+		for j, query in ipairs ( queries ) do
+			local pathFinder, nodes, elapsed = findPath ( graph, flags, unpack ( query ))
+			checkPath ( grid, flags, pathFinder, unpack ( query ))
+			
+			MOAITestMgr.comment ( string.format ( '%s path %d: %d nodes, path size %d, %.3fms', name, j, nodes, pathFinder:getPathSize (), elapsed * 1000 ))
+			
+			totalNodes = totalNodes + nodes
+			totalTime = totalTime + elapsed
+		end
+		
+		if totalTime > 0 then
+			MOAITestMgr.comment ( string.format ( '%s: %d nodes per second', name, totalNodes / totalTime ))
+		end
+	end
+	
+	-- move the gap in the first wall; the abstraction should follow the change
+	local query = queries [ 1 ]
+	grid:setTile ( 1, 32, 0 )
+	grid:setTile ( GRID_SIZE / 2, 32, 1 )
+	
+	local pathFinder = findPath ( graph, MOAIGridPathGraph.HIERARCHICAL, unpack ( query ))
+	checkPath ( grid, MOAIGridPathGraph.HIERARCHICAL, pathFinder, unpack ( query ))
+	
+	MOAITestMgr.endTest ( success )
+end
+
+MOAITestMgr.setStagingFunc ( stage )
+MOAITestMgr.setTestFunc ( test )
+MOAITestMgr.setFilter ( MOAITestMgr.PERFORMANCE )
@@ -0,0 +1,133 @@
+----------------------------------------------------------------
+-- Copyright (c) 2010-2011 Zipline Games, Inc. 
+-- All Rights Reserved. 
+-- http://getmoai.com
+----------------------------------------------------------------
+
+local function evaluate ( pass, str )
+	if not pass then
+		MOAITestMgr.comment ( "FAILED\t" .. str )
+		success = false
+	end
+end
+
+local LAYER_COUNT = 7
+local TOTAL_STEPS = 16
+
+-- appends every tile drawn while a frame is being captured
+function onDraw ( index, xOff, yOff, xScl, yScl )
+	if drawn then
+		table.insert ( drawn, string.format ( '%d %.3f %.3f %.3f %.3f', index, xOff, yOff, xScl, yScl ))
+	end
+end
+
+-- the first grab marks the start of a frame and the second its end, so
+-- the list holds the tiles drawn in exactly one frame
+function captureFrame ()
+
+	captured = nil
+	drawn = nil
+	
+	MOAIRenderMgr.grabNextFrame ( img, function ()
+		drawn = {}
+		MOAIRenderMgr.grabNextFrame ( img, function ()
+			captured = drawn
+			drawn = nil
+		end )
+	end )
+	
+	repeat coroutine.yield () until captured
+	return captured
+end
+
+function compare ()
+
+	math.randomseed ( 1 )
+
+	for step = 1, TOTAL_STEPS do
+	
+		-- move the shared transform and resize the shared deck; the resize leaves
+		-- the deck's bounds stale until the next cull
+		local size = math.random ( 4, 24 )
+		parent:setLoc ( math.random ( -160, 160 ), math.random ( -240, 240 ))
+		parent:setRot ( math.random ( 0, 90 ))
+		
+		deck:setRect ( -size, -size, size, size )
+		MOAIRenderMgr.setParallelCull ( false )
+		local serial = captureFrame ()
+		
+		deck:setRect ( -size, -size, size, size )
+		MOAIRenderMgr.setParallelCull ( true )
+		local parallel = captureFrame ()
+		
+		evaluate ( #serial > 0, string.format ( 'nothing drawn at step %d', step ))
+		evaluate ( #serial == #parallel, string.format ( 'parallel cull drew %d tiles instead of %d at step %d', #parallel, #serial, step ))
+		
+		for i = 1, math.min ( #serial, #parallel ) do
+			if serial [ i ] ~= parallel [ i ] then
+				evaluate ( false, string.format ( 'tile %d differs at step %d: "%s" instead of "%s"', i, step, parallel [ i ], serial [ i ]))
+				break
+			end
+		end
+	end
+	
+	MOAIRenderMgr.setParallelCull ( false )
+	MOAITestMgr.endTest ( success )
+end
+
+function stage ()
+	MOAITestMgr.comment ( 'staging MOAIRenderMgr' )
+end
+
+function test ()
+
+	MOAITestMgr.beginTest ( 'MOAIRenderMgr' )
+	success = true
+	
+	MOAISim.openWindow ( "MOAIRenderMgr", 320, 480 )
+	
+	viewport = MOAIViewport.new ()
+	viewport:setSize ( 320, 480 )
+	viewport:setScale ( 320, 480 )
+	
+	-- every layer draws the same deck under the same parent transform
+	deck = MOAIScriptDeck.new ()
+	deck:setRect ( -8, -8, 8, 8 )
+	deck:setDrawCallback ( onDraw )
+	
+	parent = MOAITransform.new ()
+	
+	local layers = {}
+	for i = 1, LAYER_COUNT do
+	
+		local grid = MOAIGrid.new ()
+		grid:initRectGrid ( 24, 24, 16, 16 )
+		for y = 1, 24 do
+			for x = 1, 24 do
+				grid:setTile ( x, y, (( x + y + i ) % 3 ) + 1 )
+			end
+		end
+		
+		local prop = MOAIProp.new ()
+		prop:setDeck ( deck )
+		prop:setGrid ( grid )
+		prop:setParent ( parent )
+		prop:setLoc ( -192 + ( i * 8 ), -192 - ( i * 8 ))
+		
+		local layer = MOAILayer.new ()
+		layer:setViewport ( viewport )
+		layer:insertProp ( prop )
+		
+		layers [ i ] = layer
+	end
+	MOAIRenderMgr.setRenderTable ( layers )
+	
+	img = MOAIImage.new ()
+	
+	thread = MOAIThread.new ()
+	thread:run ( compare )
+end
+
+MOAITestMgr.setStagingFunc ( stage )
+MOAITestMgr.setTestFunc ( test )
+MOAITestMgr.setFilter ( MOAITestMgr.UTIL )
@@ -400,8 +400,76 @@ function stage ()
 	thread:run ( getImages )
 end
 
+-- returns a line per glyph so two boxes can be compared with ==
+function describeLayout ( box, length )
+
+	local layout = {}
+	for i = 1, length do
+		local xMin, yMin, xMax, yMax = box:getStringBounds ( i, 1 )
+		if xMin then
+			table.insert ( layout, string.format ( '%d %.2f %.2f %.2f %.2f', i, xMin, yMin, xMax, yMax ))
+		end
+	end
+	table.insert ( layout, string.format ( 'more %s', tostring ( box:more ())))
+	return table.concat ( layout, '\n' )
+end
+
+function newTestBox ( font )
+
+	local box = MOAITextBox.new ()
+	box:setFont ( font )
+	box:setTextSize ( 12, 163 )
+	box:setRect ( -100, -60, 100, 60 )
+	return box
+end
+
 function test ()
-	
+
+	MOAITestMgr.beginTest ( 'MOAITextBox appendString' )
+	local success = true
+
+	local charcodes = 'ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789 .,:;!?()&/-'
+
+	local font = MOAIFont.new ()
+	font:loadFromTTF ( 'arial-rounded.TTF', charcodes, 12, 163 )
+
+	-- pieces with and without line breaks, running onto a second page
+	local pieces = {
+		'The quick brown fox ',
+		'jumps over\nthe lazy dog. ',
+		'Pack my box with five dozen liquor jugs.\n',
+		'\n',
+		'How vexingly quick daft zebras jump! ',
+		'Sphinx of black quartz, judge my vow.\nThe five boxing wizards jump quickly. ',
+		'Jackdaws love my big sphinx of quartz.',
+	}
+
+	local appended = newTestBox ( font )
+	local full = newTestBox ( font )
+	local text = ''
+
+	for i, piece in ipairs ( pieces ) do
+
+		text = text .. piece
+		appended:appendString ( piece )
+		full:setString ( text )
+
+		-- appended is laid out again from its last line break; full from scratch
+		if describeLayout ( appended, #text ) ~= describeLayout ( full, #text ) then
+			MOAITestMgr.comment ( string.format ( 'FAILED\tlayout differs after appending piece %d', i ))
+			success = false
+		end
+	end
+
+	appended:nextPage ()
+	full:nextPage ()
+
+	if describeLayout ( appended, #text ) ~= describeLayout ( full, #text ) then
+		MOAITestMgr.comment ( 'FAILED\tsecond page differs' )
+		success = false
+	end
+
+	MOAITestMgr.endTest ( success )
 end
 
 MOAITestMgr.setStagingFunc ( stage )
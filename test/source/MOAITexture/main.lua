@@ -0,0 +1,212 @@
+----------------------------------------------------------------
+-- Copyright (c) 2010-2011 Zipline Games, Inc.
+-- All Rights Reserved.
+-- http://getmoai.com
+----------------------------------------------------------------
+
+local function evaluate ( pass, str )
+	if not pass then
+		MOAITestMgr.comment ( "FAILED\t" .. str )
+		success = false
+	end
+end
+
+local MAX_FRAMES = 120
+
+-- each file is a 64 x 64 square of one color
+local files = {
+	{ 'async-red.png', 1, 0, 0 },
+	{ 'async-green.png', 0, 1, 0 },
+	{ 'async-blue.png', 0, 0, 1 },
+	{ 'async-white.png', 1, 1, 1 },
+}
+
+-- frames grabbed so far; callbacks fire as the frame starts, so they see the frame being drawn
+local frame = 0
+
+function grabFrame ()
+
+	local img = MOAIImage.new ()
+	local grabbed = false
+
+	MOAIRenderMgr.grabNextFrame ( img, function ()
+		grabbed = true
+	end )
+
+	repeat coroutine.yield () until grabbed
+	frame = frame + 1
+	return img
+end
+
+function newTexturedProp ( texture, x )
+
+	local quad = MOAIGfxQuad2D.new ()
+	quad:setTexture ( texture )
+	quad:setRect ( -32, -32, 32, 32 )
+
+	local prop = MOAIProp.new ()
+	prop:setDeck ( quad )
+	prop:setLoc ( x, 0 )
+	layer:insertProp ( prop )
+	return prop
+end
+
+function writeFiles ()
+
+	for i, file in ipairs ( files ) do
+
+		local filename, r, g, b = unpack ( file )
+
+		local image = MOAIImage.new ()
+		image:init ( 64, 64 )
+		image:fillRect ( 0, 0, 64, 64, r, g, b, 1 )
+		image:writePNG ( filename )
+	end
+end
+
+-- draws the texture alone and returns the frame
+function drawAlone ( texture )
+
+	local prop = newTexturedProp ( texture, 0 )
+	local img = grabFrame ()
+	layer:removeProp ( prop )
+	return img
+end
+
+-- the callback fires once, after which the texture draws the same as the file loaded in the foreground
+function testCallback ()
+
+	local texture = MOAITexture.new ()
+	local calls = 0
+	local called = nil
+
+	texture:setLoadCallback ( function ( loaded )
+		calls = calls + 1
+		called = loaded
+	end )
+	texture:loadAsync ( files [ 1 ][ 1 ])
+
+	local prop = newTexturedProp ( texture, 0 )
+
+	for i = 1, MAX_FRAMES do
+		if calls > 0 then break end
+		grabFrame ()
+	end
+	layer:removeProp ( prop )
+
+	evaluate ( calls > 0, string.format ( 'the load callback never fired within %d frames', MAX_FRAMES ))
+	evaluate ( called == texture, 'the load callback was passed something other than the texture' )
+	evaluate ( texture:isResident (), 'the texture was not resident once its load callback fired' )
+
+	local asyncFrame = drawAlone ( texture )
+
+	local syncTexture = MOAITexture.new ()
+	syncTexture:load ( files [ 1 ][ 1 ])
+	local syncFrame = drawAlone ( syncTexture )
+
+	evaluate ( asyncFrame:compare ( syncFrame ), 'the texture loaded in the background draws differently from the same file loaded in the foreground' )
+
+	grabFrame ()
+	evaluate ( calls == 1, string.format ( 'the load callback fired %d times', calls ))
+end
+
+-- with a budget smaller than any one texture, textures go up one per frame
+function testBudget ()
+
+	MOAIGfxDevice.setTextureUploadBudget ( 1 )
+
+	local textures = {}
+	local frames = {}
+
+	for i = 1, 3 do
+
+		local texture = MOAITexture.new ()
+		texture:setLoadCallback ( function ()
+			frames [ i ] = frames [ i ] or frame
+		end )
+		texture:loadAsync ( files [ i ][ 1 ])
+		textures [ i ] = texture
+	end
+
+	for i = 1, MAX_FRAMES do
+		if frames [ 1 ] and frames [ 2 ] and frames [ 3 ] then break end
+		grabFrame ()
+	end
+
+	MOAIGfxDevice.setTextureUploadBudget ()
+
+	for i = 1, 3 do
+		evaluate ( frames [ i ] ~= nil, string.format ( 'texture %d was never uploaded within %d frames', i, MAX_FRAMES ))
+	end
+
+	if frames [ 1 ] and frames [ 2 ] and frames [ 3 ] then
+		evaluate (( frames [ 1 ] ~= frames [ 2 ]) and ( frames [ 2 ] ~= frames [ 3 ]) and ( frames [ 1 ] ~= frames [ 3 ]),
+			string.format ( 'textures went up on frames %d, %d and %d; the budget allows one per frame', frames [ 1 ], frames [ 2 ], frames [ 3 ]))
+	end
+end
+
+-- a foreground load made while a background load is in flight wins
+function testSupersede ()
+
+	local texture = MOAITexture.new ()
+	local calls = 0
+
+	texture:setLoadCallback ( function ()
+		calls = calls + 1
+	end )
+	texture:loadAsync ( files [ 2 ][ 1 ])
+	texture:load ( files [ 4 ][ 1 ])
+
+	local prop = newTexturedProp ( texture, 0 )
+	for i = 1, 10 do
+		grabFrame ()
+	end
+	layer:removeProp ( prop )
+
+	local frameA = drawAlone ( texture )
+
+	local expected = MOAITexture.new ()
+	expected:load ( files [ 4 ][ 1 ])
+	local frameB = drawAlone ( expected )
+
+	evaluate ( calls == 0, 'the background load finished after a foreground load and still reported' )
+	evaluate ( frameA:compare ( frameB ), 'the background load replaced the file loaded in the foreground' )
+end
+
+function run ()
+
+	testCallback ()
+	testBudget ()
+	testSupersede ()
+
+	MOAITestMgr.endTest ( success )
+end
+
+function stage ()
+	MOAITestMgr.comment ( 'staging MOAITexture' )
+end
+
+function test ()
+
+	MOAITestMgr.beginTest ( 'MOAITexture background loads' )
+	success = true
+
+	MOAISim.openWindow ( "MOAITexture", 320, 480 )
+
+	viewport = MOAIViewport.new ()
+	viewport:setSize ( 320, 480 )
+	viewport:setScale ( 320, 480 )
+
+	layer = MOAILayer.new ()
+	layer:setViewport ( viewport )
+	MOAISim.pushRenderPass ( layer )
+
+	writeFiles ()
+
+	thread = MOAIThread.new ()
+	thread:run ( run )
+end
+
+MOAITestMgr.setStagingFunc ( stage )
+MOAITestMgr.setTestFunc ( test )
+MOAITestMgr.setFilter ( MOAITestMgr.UTIL )